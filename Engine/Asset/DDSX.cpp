@@ -1,4 +1,8 @@
 #include "DDSX.h"
+#include "Core/Coroutine/ReadOnlyFile.h"
+#include "Core/Coroutine/IOScheduler.h"
+#include "System/SystemEnvironment.h"
+#include <array>
 
 namespace dds {
 	EFormat DDSLoadingDesc::convert_fmts[][2] =
@@ -35,4 +39,51 @@ namespace dds {
 		{ EF_R16, EF_R16F },
 		{ EF_R16F, EF_R8 },
 	};
-}
\ No newline at end of file
+
+	white::coroutine::Task<std::shared_ptr<DDSLoadingDesc::AssetType>> DDSLoadingDesc::GetAwaiter()
+	{
+		co_await ReadDDSAsync();
+
+		//io completion resumes on io thread,format conversion belongs to worker pool
+		co_await Environment->Scheduler->schedule();
+
+		co_return ConvertFormat();
+	}
+
+	white::coroutine::Task<void> DDSLoadingDesc::ReadDDSAsync()
+	{
+		auto pAsset = dds_desc.dds_asset = std::make_shared<AssetType>();
+
+		auto file = white::coroutine::ReadOnlyFile::open(Environment->Scheduler->GetIOScheduler(), dds_desc.dds_path);
+
+		//magic + SURFACEDESC2 + optional HEADER_DXT10
+		std::array<white::byte, sizeof(uint32) + sizeof(SURFACEDESC2) + sizeof(HEADER_DXT10)> header;
+		auto const header_size = static_cast<std::size_t>(std::min<std::uint64_t>(header.size(), file.size()));
+		auto const header_read = co_await file.read(0, header.data(), header_size);
+
+		uint32 row_pitch, slice_pitch;
+		auto const offset = platform::X::GetImageInfo(white::span<const white::byte>(header.data(), header_read), pAsset->GetTextureTypeRef(),
+			pAsset->GetWidthRef(), pAsset->GetHeightRef(), pAsset->GetDepthRef(), pAsset->GetMipmapSizeRef(), pAsset->GetArraySizeRef(),
+			pAsset->GetFormatRef(), row_pitch, slice_pitch);
+
+		std::vector<std::size_t> base;
+		auto const data_size = platform::X::GetImageLayout(pAsset->GetTextureType(),
+			pAsset->GetWidth(), pAsset->GetHeight(), pAsset->GetDepth(), pAsset->GetMipmapSize(), pAsset->GetArraySize(),
+			pAsset->GetFormat(), row_pitch, pAsset->GetElementInitDatasRef(), base);
+
+		//payload is read straight into the asset data block,init datas point into it without staging copy
+		auto& data_block = pAsset->GetDataBlockRef();
+		data_block.resize(data_size);
+		for (std::size_t read = 0; read < data_size;)
+		{
+			auto const bytes = co_await file.read(offset + read, data_block.data() + read, data_size - read);
+			if (bytes == 0)
+				throw std::runtime_error(dds_desc.dds_path.string() + " payload is truncated");
+			read += bytes;
+		}
+
+		auto& init_data = pAsset->GetElementInitDatasRef();
+		for (std::size_t i = 0; i < base.size(); ++i)
+			init_data[i].data = data_block.data() + base[i];
+	}
+}
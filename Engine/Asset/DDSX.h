@@ -1076,7 +1076,6 @@ namespace dds {
 	private:
 		using path = std::filesystem::path;
 		struct DDSDesc {
-			platform::File file;
 			path dds_path;
 
 			std::shared_ptr<AssetType> dds_asset;
@@ -1086,10 +1085,6 @@ namespace dds {
 	public:
 		DDSLoadingDesc(path const& texpath) {
 			dds_desc.dds_path = texpath;
-			dds_desc.file = platform::File{ texpath.wstring(), platform::File::kToRead };
-
-			if (!dds_desc.file.IsOpen())
-				throw;
 		}
 
 		std::size_t Type() const override {
@@ -1104,21 +1099,15 @@ namespace dds {
 			return dds_desc.dds_path;
 		}
 
-		white::coroutine::Task<std::shared_ptr<AssetType>> GetAwaiter() override {
-			ReadDDS();
-			co_return ConvertFormat();
+		std::size_t GetAssetBytes(const AssetType& asset) const override {
+			return sizeof(AssetType) + asset.GetDataBlock().size();
 		}
 
+		white::coroutine::Task<std::shared_ptr<AssetType>> GetAwaiter() override;
+
 	private:
-		std::shared_ptr<AssetType> ReadDDS() {
-			auto pAsset = dds_desc.dds_asset = std::make_shared<AssetType>();
-			{
-				platform::X::GetImageInfo(dds_desc.file, pAsset->GetTextureTypeRef(),
-					pAsset->GetWidthRef(), pAsset->GetHeightRef(), pAsset->GetDepthRef(), pAsset->GetMipmapSizeRef(), pAsset->GetArraySizeRef(),
-					pAsset->GetFormatRef(), pAsset->GetElementInitDatasRef(), pAsset->GetDataBlockRef());
-			}
-			return nullptr;
-		}
+		//! \brief read header then whole payload in one request on io scheduler
+		white::coroutine::Task<void> ReadDDSAsync();
 
 		std::shared_ptr<AssetType> ConvertFormat() {
 			auto pAsset = dds_desc.dds_asset;
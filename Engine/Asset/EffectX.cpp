@@ -579,6 +579,10 @@ namespace platform {
 	{
 		return  AssetResourceScheduler::Instance().SyncLoad<EffectLoadingDesc>(effectpath);
 	}
+	white::coroutine::Task<std::shared_ptr<asset::EffectAsset>> X::AsyncLoadEffectAsset(path const& effectpath)
+	{
+		return AssetResourceScheduler::Instance().AsyncLoad<EffectLoadingDesc>(effectpath);
+	}
 	std::shared_ptr<Render::Effect::Effect> platform::X::LoadEffect(std::string const & name)
 	{
 		return  AssetResourceScheduler::Instance().SyncSpawnResource<Render::Effect::Effect>(name);
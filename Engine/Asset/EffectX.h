@@ -10,11 +10,13 @@
 #include "RenderInterface/Effect/Effect.hpp"
 #include <filesystem>
 #include <string_view>
+#include "Core/Coroutine/Task.h"
 namespace platform {
 	namespace X {
 		using path = std::filesystem::path;
 
 		std::shared_ptr<asset::EffectAsset> LoadEffectAsset(path const& effectpath);
+		white::coroutine::Task<std::shared_ptr<asset::EffectAsset>> AsyncLoadEffectAsset(path const& effectpath);
 		std::shared_ptr<Render::Effect::Effect> LoadEffect(std::string const& name);
 	}
 }
@@ -36,6 +36,12 @@ namespace asset {
 		using AssetType = T;
 
 		virtual white::coroutine::Task<std::shared_ptr<AssetType>> GetAwaiter() = 0;
+
+		//\brief approximate resident bytes of loaded asset,used by cache budget
+		virtual std::size_t GetAssetBytes(const AssetType& asset) const
+		{
+			return sizeof(AssetType);
+		}
 	};
 }
 
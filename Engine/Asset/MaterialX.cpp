@@ -5,6 +5,7 @@
 #include "EffectAsset.h"
 #include "Runtime/Renderer/Materail.h"
 #include "Runtime/AssetResourceScheduler.h"
+#include "Core/Coroutine/WhenAllReady.h"
 
 using namespace platform;
 using namespace scheme;
@@ -43,9 +44,10 @@ namespace details {
 		white::coroutine::Task<std::shared_ptr<AssetType>> GetAwaiter() override {
 			PreCreate();
 			LoadNode();
-			LoadEffect();
+			material_desc.effect_asset = co_await X::AsyncLoadEffectAsset(material_desc.effect_name + ".wsl");
 			ParseNode();
 			//load textures
+			std::vector<white::coroutine::Task<std::shared_ptr<dds::DDSAsset>>> texture_loads;
 			for (auto& pair : material_desc.material_asset->GetBindValues()) {
 				auto& effect_asset = material_desc.effect_asset;
 				auto param_index = std::find_if(effect_asset->GetParams().begin(), effect_asset->GetParams().end(), [&](const asset::ShaderParameterAsset& param) {
@@ -53,10 +55,13 @@ namespace details {
 				}) - effect_asset->GetParams().begin();
 
 				auto& param = effect_asset->GetParams()[param_index];
-				if (IsTextureReadType(param.GetType())) {
-					//TODO:preload single texture
+				if (IsTextureReadType(param.GetType()) && pair.second.GetContent().type() == white::type_id<std::string>()) {
+					//texture is created on render thread,just preload its asset
+					texture_loads.emplace_back(X::AsyncLoadDDSAsset(pair.second.Access<std::string>()));
 				}
 			}
+			//failed load is reported when texture is created
+			co_await white::coroutine::WhenAllReady(std::move(texture_loads));
 			co_return CreateAsset();
 		}
 
@@ -88,11 +93,6 @@ namespace details {
 		}
 
 
-		std::shared_ptr<AssetType> LoadEffect() {
-			material_desc.effect_asset =  X::LoadEffectAsset(material_desc.effect_name + ".wsl");
-			return nullptr;
-		}
-
 		std::shared_ptr<AssetType> ParseNode()
 		{
 			auto& material_node = material_desc.material_node;
@@ -108,7 +108,9 @@ namespace details {
 			//env-global
 			for (auto && env_node : X::SelectNodes("env-global", material_node)) {
 				auto path = white::Access<std::string>(*env_node.rbegin());
-				Material::GetInstanceEvaluator().LoadFile(path);
+				Material::AccessInstanceEvaluator([&](MaterialEvaluator& evaluator) {
+					evaluator.LoadFile(path);
+				});
 				material_node.Remove(env_node.GetName());
 			}
 
@@ -214,6 +216,11 @@ std::shared_ptr<asset::MaterailAsset> X::LoadMaterialAsset(path const & material
 	return  AssetResourceScheduler::Instance().SyncLoad<details::MaterailLoadingDesc>(materialpath);
 }
 
+white::coroutine::Task<std::shared_ptr<asset::MaterailAsset>> X::AsyncLoadMaterialAsset(path const& materialpath)
+{
+	return AssetResourceScheduler::Instance().AsyncLoad<details::MaterailLoadingDesc>(materialpath);
+}
+
 std::shared_ptr<Material> X::LoadMaterial(asset::path const& materialpath, const std::string& name) {
 	return  AssetResourceScheduler::Instance().SyncSpawnResource<Material>(materialpath, name);
 }
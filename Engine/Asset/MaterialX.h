@@ -8,6 +8,8 @@
 #include "EffectX.h"
 #include "MaterialAsset.h"
 #include "Runtime/Renderer/Materail.h"
+#include "Core/Coroutine/Task.h"
+#include <WBase/span.hpp>
 namespace platform {
 	namespace X {
 		using path = std::filesystem::path;
@@ -15,6 +17,15 @@ namespace platform {
 		std::shared_ptr<asset::MaterailAsset> LoadMaterialAsset(path const& materialpath);
 
 		std::shared_ptr<Material> LoadMaterial(path const& materialpath, const std::string& name);
+
+		white::coroutine::Task<std::shared_ptr<asset::MaterailAsset>> AsyncLoadMaterialAsset(path const& materialpath);
+
+		/*!
+		\brief batch load materials,duplicated (path,name) pairs share one Material
+		\note assets are loaded and evaluated on worker pool,Material objects are created on render thread
+		\exception white::GeneralEvent any material asset failed to load
+		*/
+		white::coroutine::Task<void> AsyncLoadMaterials(white::span<const path> pathes, white::span<const std::string> names, white::span<std::shared_ptr<Material>> materials);
 	}
 }
 
@@ -3,6 +3,7 @@
 #include <WBase/id.hpp>
 
 #include "Core/Coroutine/AsyncStream.h"
+#include "Core/Coroutine/WhenAllReady.h"
 
 #include "Runtime/AssetResourceScheduler.h"
 #include "Runtime/LFile.h"
@@ -13,6 +14,7 @@
 
 #include "MeshX.h"
 
+#include <algorithm>
 #include <ranges>
 
 namespace platform {
@@ -205,6 +207,25 @@ namespace platform {
 
 	using SectionLoaders = std::vector<std::unique_ptr<MeshSectionLoading>>;
 
+	static std::vector<WhiteEngine::FMeshLodTarget> mesh_lod_targets;
+
+	void X::SetMeshLodTargets(white::span<const WhiteEngine::FMeshLodTarget> targets)
+	{
+		mesh_lod_targets.assign(targets.begin(), targets.end());
+	}
+
+	//assets authored with lods keep them
+	static void BuildMissingLods(asset::MeshAsset& mesh_asset)
+	{
+		auto& sub_meshes = mesh_asset.GetSubMeshDesces();
+		if (mesh_lod_targets.empty() || sub_meshes.empty())
+			return;
+		if (std::ranges::any_of(sub_meshes, [](auto& sub_mesh) { return sub_mesh.LodsDescription.size() != 1; }))
+			return;
+
+		WhiteEngine::BuildMeshLods(mesh_asset, white::make_const_span(mesh_lod_targets));
+	}
+
 	template<typename... section_types>
 	class MeshLoadingDesc : public asset::AssetLoading<asset::MeshAsset> {
 	private:
@@ -242,6 +263,13 @@ namespace platform {
 			return mesh_desc.mesh_path;
 		}
 
+		std::size_t GetAssetBytes(const AssetType& asset) const override {
+			std::size_t bytes = sizeof(AssetType) + Render::NumFormatBytes(asset.GetIndexFormat()) * asset.GetIndexCount();
+			for (auto& element : asset.GetVertexElements())
+				bytes += element.GetElementSize() * asset.GetVertexCount();
+			return bytes;
+		}
+
 		template<typename AsyncStream>
 		static white::coroutine::Task<std::shared_ptr<asset::MeshAsset>> GetAwaiter(AsyncStream& stream, SectionLoaders& section_loaders)
 		{
@@ -282,6 +310,8 @@ namespace platform {
 				stream.SkipTo(common_header.NextSectionOffset);
 			}
 
+			BuildMissingLods(*mesh_asset);
+
 			co_return mesh_asset;
 		}
 
@@ -299,26 +329,34 @@ namespace platform {
 	class BatchMeshLoadingDesc
 	{
 	private:
+		//staging memory is split into two slabs,one is filled by IO while the other is decoded
+		static constexpr std::size_t StagingSlabCount = 2;
+
+		struct StagingSlab {
+			WhiteEngine::MemStackBase memory;
+			std::vector<white::coroutine::Task<void>> decode_tasks;
+		};
+
 		struct MeshDesc {
 			white::span<const X::path> pathes;
 			white::span<std::shared_ptr<asset::MeshAsset>> assets;
-			std::vector<std::unique_ptr<MeshSectionLoading>> section_loaders;
-			WhiteEngine::MemStackBase memory;
+			std::uint64_t staging_budget;
+			std::array<StagingSlab, StagingSlabCount> staging;
 		} mesh_desc;
 	public:
-		explicit BatchMeshLoadingDesc(white::span<const X::path> pathes, white::span<std::shared_ptr<asset::MeshAsset>> asset)
+		explicit BatchMeshLoadingDesc(white::span<const X::path> pathes, white::span<std::shared_ptr<asset::MeshAsset>> asset, std::uint64_t staging_budget)
 		{
 			mesh_desc.pathes = pathes;
 			mesh_desc.assets = asset;
-			ForEachSectionTypeImpl<std::tuple<section_types...>>(white::make_index_sequence<sizeof...(section_types)>(), {});
+			mesh_desc.staging_budget = staging_budget;
 		}
 
 		template<typename tuple, size_t... indices>
-		void ForEachSectionTypeImpl(white::index_sequence<indices...>, std::shared_ptr<asset::MeshAsset> asset) {
+		static void ForEachSectionTypeImpl(SectionLoaders& section_loaders, white::index_sequence<indices...>) {
 			int ignore[] = { (static_cast<void>(
-				mesh_desc.section_loaders
+				section_loaders
 				.emplace_back(
-					std::make_unique<std::tuple_element_t<indices,tuple>>(asset))),0)
+					std::make_unique<std::tuple_element_t<indices,tuple>>(std::shared_ptr<asset::MeshAsset>{}))),0)
 				...
 			};
 			(void)ignore;
@@ -334,36 +372,91 @@ namespace platform {
 				files.emplace_back(dstorage.OpenFile(path));
 			}
 
-			std::vector<white::observer_ptr<byte>> buffers;
-			for (auto& file : files)
+			std::size_t slab_index = 0;
+			std::size_t next = IssueReads(dstorage, mesh_desc.staging[slab_index], files, 0);
+
+			//reads already issued land in staging memory,so drain them before rethrow
+			std::exception_ptr decode_exception;
+			while (!mesh_desc.staging[slab_index].decode_tasks.empty())
 			{
-				buffers.emplace_back(white::make_observer(new (mesh_desc.memory) byte[file->file_size]));
+				auto& current = mesh_desc.staging[slab_index];
+				auto& following = mesh_desc.staging[(slab_index + 1) % StagingSlabCount];
+
+				//keep IO busy while current slab decoding
+				if (next != files.size() && !decode_exception)
+					next = IssueReads(dstorage, following, files, next);
+
+				auto decoded = co_await white::coroutine::WhenAllReady(std::move(current.decode_tasks));
+				for (auto& task : decoded)
+				{
+					try {
+						task.result();
+					}
+					catch (...) {
+						if (!decode_exception)
+							decode_exception = std::current_exception();
+					}
+				}
+
+				current.decode_tasks.clear();
+				current.memory.Flush();
+
+				slab_index = (slab_index + 1) % StagingSlabCount;
 			}
 
-			for (auto index : std::views::iota(0u, buffers.size()))
+			if (decode_exception)
+				std::rethrow_exception(decode_exception);
+		}
+	private:
+		std::size_t IssueReads(platform_ex::DirectStorage& dstorage, StagingSlab& slab, const std::vector<std::shared_ptr<platform_ex::DStorageFile>>& files, std::size_t first)
+		{
+			auto slab_budget = std::max<std::uint64_t>(mesh_desc.staging_budget / StagingSlabCount, 1);
+
+			std::uint64_t slab_bytes = 0;
+			auto index = first;
+			//at least one file per slab,oversized file occupy whole slab
+			for (; index != files.size(); ++index)
 			{
+				auto file_size = files[index]->file_size;
+				if (index != first && slab_bytes + file_size > slab_budget)
+					break;
+				slab_bytes += file_size;
+
+				auto buffer = new (slab.memory) byte[file_size];
+
 				platform_ex::DStorageFile2MemoryRequest Request;
 				Request.File = {
 					.Source = files[index],
 					.Offset = 0,
-					.Size = static_cast<uint32>(files[index]->file_size),
+					.Size = static_cast<uint32>(file_size),
 				};
 				Request.Memory = {
-					.Buffer = buffers[index].get(),
+					.Buffer = buffer,
 					.Size = Request.File.Size
 				};
 
 				dstorage.EnqueueRequest(Request);
+
+				//per-request submit,decode start as soon as it's bytes land
+				slab.decode_tasks.emplace_back(DecodeMesh(dstorage.SubmitUpload(platform_ex::DStorageQueueType::Memory),
+					white::make_span(buffer, file_size), mesh_desc.assets[index]));
 			}
 
-			co_await dstorage.SubmitUpload(platform_ex::DStorageQueueType::Memory);
+			return index;
+		}
 
-			for (auto index : std::views::iota(0u, buffers.size()))
-			{
-				white::coroutine::MemoryAsyncReadStream stream{ white::make_span(buffers[index].get(),files[index]->file_size) };
+		static white::coroutine::Task<void> DecodeMesh(std::shared_ptr<platform_ex::DStorageSyncPoint> syncpoint, white::span<byte> buffer, std::shared_ptr<asset::MeshAsset>& asset)
+		{
+			co_await syncpoint;
 
-				mesh_desc.assets[index] = co_await MeshLoadingDesc<section_types...>::GetAwaiter(stream, mesh_desc.section_loaders);
-			}
+			co_await Environment->Scheduler->schedule();
+
+			SectionLoaders section_loaders;
+			ForEachSectionTypeImpl<std::tuple<section_types...>>(section_loaders, white::make_index_sequence<sizeof...(section_types)>());
+
+			white::coroutine::MemoryAsyncReadStream stream{ buffer };
+
+			asset = co_await MeshLoadingDesc<section_types...>::GetAwaiter(stream, section_loaders);
 		}
 	};
 
@@ -381,11 +474,11 @@ namespace platform {
 		return platform::AssetResourceScheduler::Instance().AsyncLoad<MeshLoadingDesc<GeomertySection>>(meshpath);
 	}
 
-	white::coroutine::Task<void> platform::X::BatchLoadMeshAsset(white::span<const X::path> pathes, white::span<std::shared_ptr<asset::MeshAsset>> asset)
+	white::coroutine::Task<void> platform::X::BatchLoadMeshAsset(white::span<const X::path> pathes, white::span<std::shared_ptr<asset::MeshAsset>> asset, std::uint64_t staging_budget)
 	{
-		BatchMeshLoadingDesc<GeomertySection> desc{ pathes,asset };
+		BatchMeshLoadingDesc<GeomertySection> desc{ pathes,asset,staging_budget };
 
-		co_await desc.GetAwaiter();;
+		co_await desc.GetAwaiter();
 	}
 
 	
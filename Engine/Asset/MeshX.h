@@ -7,6 +7,7 @@
 
 
 #include "Runtime/Renderer/Mesh.h"
+#include "Developer/MeshSimplifier/MeshLodBuilder.h"
 #include <filesystem>
 #include <string_view>
 #include "Core/Coroutine/Task.h"
@@ -22,8 +23,14 @@ namespace platform {
 		white::coroutine::Task<std::shared_ptr<Mesh>> AsyncLoadMesh(path const& meshpath, const std::string& name);
 
 
-		white::coroutine::Task<void> BatchLoadMeshAsset(white::span<const path> pathes, white::span<std::shared_ptr<asset::MeshAsset>> asset);
+		//staging_budget bound the peak memory of raw file bytes,decode overlap with IO
+		wconstexpr std::uint64_t DefaultMeshStagingBudget = 256ull << 20;
+
+		white::coroutine::Task<void> BatchLoadMeshAsset(white::span<const path> pathes, white::span<std::shared_ptr<asset::MeshAsset>> asset, std::uint64_t staging_budget = DefaultMeshStagingBudget);
 		white::coroutine::Task<void> AsyncLoadMeshes(white::span<const path> pathes, white::span<std::shared_ptr<Mesh>> meshes);
+
+		//meshes loaded with only lod0 get lods built towards targets,empty by default,set before loading
+		void SetMeshLodTargets(white::span<const WhiteEngine::FMeshLodTarget> targets);
 	}
 }
 #endif
\ No newline at end of file
@@ -21,134 +21,172 @@ namespace platform {
 	using Render::TextureType;
 	using Render::Texture;
 	using WhiteEngine::lerp;
-	uint64 X::GetImageInfo(File const& file, Render::TextureType& type,
-		uint16& width, uint16& height, uint16& depth,
-		uint8& num_mipmaps, uint8& array_size, Render::EFormat& format,
-		uint32& row_pitch, uint32& slice_pitch)
+	namespace
 	{
-		FileRead tex_res{ file };
+		//in-memory counterpart of FileRead,used to parse prefetched header bytes
+		class SpanRead {
+		public:
+			SpanRead(white::span<const white::byte> buffer_)
+				:buffer(buffer_)
+			{}
+
+			std::size_t Read(void* pBuffer, std::size_t uBytesToRead) {
+				if (u64Offset + uBytesToRead > buffer.size())
+					throw std::invalid_argument("dds header is truncated");
+				std::memcpy(pBuffer, buffer.data() + u64Offset, uBytesToRead);
+				u64Offset += uBytesToRead;
+				return uBytesToRead;
+			}
 
-		uint32 magic;
-		tex_res.Read(&magic, sizeof(magic));
-		wassume(dds::header_magic == magic);
+			uint64 GetOffset() const {
+				return u64Offset;
+			}
 
-		dds::SURFACEDESC2 desc;
-		tex_res.Read(&desc, sizeof(desc));
+		private:
+			white::span<const white::byte> buffer;
+			uint64 u64Offset = 0;
+		};
 
-		dds::HEADER_DXT10 desc10;
-		if (asset::four_cc_v<'D', 'X', '1', '0'> == desc.pixel_format.four_cc) {
-			tex_res.Read(&desc10, sizeof(desc10));
-			array_size = desc10.array_size;
-		}
-		else {
-			std::memset(&desc10, 0, sizeof(desc10));
-			array_size = 1;
-			wassume(desc.flags & dds::DDSD_CAPS);
-			wassume(desc.flags & dds::DDSD_PIXELFORMAT);
-		}
+		template<typename _tReader>
+		uint64 ReadImageInfo(_tReader& tex_res, Render::TextureType& type,
+			uint16& width, uint16& height, uint16& depth,
+			uint8& num_mipmaps, uint8& array_size, Render::EFormat& format,
+			uint32& row_pitch, uint32& slice_pitch)
+		{
+			uint32 magic;
+			tex_res.Read(&magic, sizeof(magic));
+			wassume(dds::header_magic == magic);
 
-		wassume(desc.flags & dds::DDSD_WIDTH);
-		wassume(desc.flags & dds::DDSD_HEIGHT);
+			dds::SURFACEDESC2 desc;
+			tex_res.Read(&desc, sizeof(desc));
 
-		if (0 == (desc.flags & dds::DDSD_MIPMAPCOUNT))
-			desc.mip_map_count = 1;
+			dds::HEADER_DXT10 desc10;
+			if (asset::four_cc_v<'D', 'X', '1', '0'> == desc.pixel_format.four_cc) {
+				tex_res.Read(&desc10, sizeof(desc10));
+				array_size = desc10.array_size;
+			}
+			else {
+				std::memset(&desc10, 0, sizeof(desc10));
+				array_size = 1;
+				wassume(desc.flags & dds::DDSD_CAPS);
+				wassume(desc.flags & dds::DDSD_PIXELFORMAT);
+			}
 
-		format = dds::Convert(desc, desc10);
+			wassume(desc.flags & dds::DDSD_WIDTH);
+			wassume(desc.flags & dds::DDSD_HEIGHT);
 
-		if (desc.flags & dds::DDSD_PITCH)
-			row_pitch = desc.pitch;
-		else if (desc.flags & desc.pixel_format.flags & 0X00000040)
-			row_pitch = desc.width * desc.pixel_format.rgb_bit_count / 8;
-		else
-			row_pitch = desc.width * NumFormatBytes(format);
+			if (0 == (desc.flags & dds::DDSD_MIPMAPCOUNT))
+				desc.mip_map_count = 1;
 
-		slice_pitch = row_pitch * desc.height;
+			format = dds::Convert(desc, desc10);
 
-		if (desc.reserved1[0])
-			format = MakeSRGB(format);
+			if (desc.flags & dds::DDSD_PITCH)
+				row_pitch = desc.pitch;
+			else if (desc.flags & desc.pixel_format.flags & 0X00000040)
+				row_pitch = desc.width * desc.pixel_format.rgb_bit_count / 8;
+			else
+				row_pitch = desc.width * NumFormatBytes(format);
 
-		width = desc.width;
-		num_mipmaps = desc.mip_map_count;
+			slice_pitch = row_pitch * desc.height;
 
+			if (desc.reserved1[0])
+				format = MakeSRGB(format);
 
-		if ((asset::four_cc<'D', 'X', '1', '0'>::value == desc.pixel_format.four_cc))
-		{
-			if (dds::D3D_RESOURCE_MISC_TEXTURECUBE == desc10.misc_flag)
-			{
-				type = TextureType::T_Cube;
-				array_size /= 6;
-				height = desc.width;
-				depth = 1;
-			}
-			else
+			width = desc.width;
+			num_mipmaps = desc.mip_map_count;
+
+
+			if ((asset::four_cc<'D', 'X', '1', '0'>::value == desc.pixel_format.four_cc))
 			{
-				switch (desc10.resource_dim)
+				if (dds::D3D_RESOURCE_MISC_TEXTURECUBE == desc10.misc_flag)
 				{
-				case dds::D3D_RESOURCE_DIMENSION_TEXTURE1D:
-					type = TextureType::T_1D;
-					height = 1;
-					depth = 1;
-					break;
-
-				case dds::D3D_RESOURCE_DIMENSION_TEXTURE2D:
-					type = TextureType::T_2D;
-					height = desc.height;
+					type = TextureType::T_Cube;
+					array_size /= 6;
+					height = desc.width;
 					depth = 1;
-					break;
-
-				case dds::D3D_RESOURCE_DIMENSION_TEXTURE3D:
-					type = TextureType::T_3D;
-					height = desc.height;
-					depth = desc.depth;
-					break;
-
-				default:
-					wassume(false);
-					break;
 				}
-			}
-		}
-		else
-		{
-			if ((desc.dds_caps.caps2 & dds::DDSCAPS2_CUBEMAP) != 0)
-			{
-				type = TextureType::T_Cube;
-				height = desc.width;
-				depth = 1;
+				else
+				{
+					switch (desc10.resource_dim)
+					{
+					case dds::D3D_RESOURCE_DIMENSION_TEXTURE1D:
+						type = TextureType::T_1D;
+						height = 1;
+						depth = 1;
+						break;
+
+					case dds::D3D_RESOURCE_DIMENSION_TEXTURE2D:
+						type = TextureType::T_2D;
+						height = desc.height;
+						depth = 1;
+						break;
+
+					case dds::D3D_RESOURCE_DIMENSION_TEXTURE3D:
+						type = TextureType::T_3D;
+						height = desc.height;
+						depth = desc.depth;
+						break;
+
+					default:
+						wassume(false);
+						break;
+					}
+				}
 			}
 			else
 			{
-				if ((desc.dds_caps.caps2 & dds::DDSCAPS2_VOLUME) != 0)
+				if ((desc.dds_caps.caps2 & dds::DDSCAPS2_CUBEMAP) != 0)
 				{
-					type = TextureType::T_3D;
-					height = desc.height;
-					depth = desc.depth;
+					type = TextureType::T_Cube;
+					height = desc.width;
+					depth = 1;
 				}
 				else
 				{
-					type = TextureType::T_2D;
-					height = desc.height;
-					depth = 1;
+					if ((desc.dds_caps.caps2 & dds::DDSCAPS2_VOLUME) != 0)
+					{
+						type = TextureType::T_3D;
+						height = desc.height;
+						depth = desc.depth;
+					}
+					else
+					{
+						type = TextureType::T_2D;
+						height = desc.height;
+						depth = 1;
+					}
 				}
 			}
-		}
 
-		return tex_res.GetOffset();
+			return tex_res.GetOffset();
+		}
 	}
 
-	void X::GetImageInfo(File const& file, Render::TextureType& type,
+	uint64 X::GetImageInfo(File const& file, Render::TextureType& type,
 		uint16& width, uint16& height, uint16& depth,
 		uint8& num_mipmaps, uint8& array_size, Render::EFormat& format,
-		std::vector<Render::ElementInitData>& init_data,
-		std::vector<uint8>& data_block)
+		uint32& row_pitch, uint32& slice_pitch)
 	{
-		uint32 row_pitch, slice_pitch;
-		auto offset = GetImageInfo(file, type, width, height, depth, num_mipmaps, array_size, format,
-			row_pitch, slice_pitch);
-
 		FileRead tex_res{ file };
-		tex_res.SkipTo(offset);
+		return ReadImageInfo(tex_res, type, width, height, depth, num_mipmaps, array_size, format, row_pitch, slice_pitch);
+	}
 
+	uint64 X::GetImageInfo(white::span<const white::byte> header, Render::TextureType& type,
+		uint16& width, uint16& height, uint16& depth,
+		uint8& num_mipmaps, uint8& array_size, Render::EFormat& format,
+		uint32& row_pitch, uint32& slice_pitch)
+	{
+		SpanRead tex_res{ header };
+		return ReadImageInfo(tex_res, type, width, height, depth, num_mipmaps, array_size, format, row_pitch, slice_pitch);
+	}
+
+	std::size_t X::GetImageLayout(Render::TextureType type,
+		uint16 width, uint16 height, uint16 depth,
+		uint8 num_mipmaps, uint8 array_size, Render::EFormat format,
+		uint32 row_pitch,
+		std::vector<Render::ElementInitData>& init_data,
+		std::vector<std::size_t>& base)
+	{
 		auto const fmt_size = NumFormatBytes(format);
 		bool padding = false;
 		if (!IsCompressedFormat(format)) {
@@ -158,7 +196,7 @@ namespace platform {
 			}
 		}
 
-		std::vector<size_t> base;
+		std::size_t data_size = 0;
 		switch (type)
 		{
 		case TextureType::T_1D:
@@ -182,13 +220,11 @@ namespace platform {
 						image_size = (padding ? ((the_width + 3) & ~3) : the_width) * fmt_size;
 					}
 
-					base[index] = data_block.size();
-					data_block.resize(base[index] + image_size);
+					base[index] = data_size;
+					data_size += image_size;
 					init_data[index].row_pitch = image_size;
 					init_data[index].slice_pitch = image_size;
 
-					tex_res.Read(&data_block[base[index]], static_cast<std::streamsize>(image_size));
-
 					the_width = std::max<uint32>(the_width / 2, 1);
 				}
 			}
@@ -211,21 +247,17 @@ namespace platform {
 						uint32 const block_size = NumFormatBytes(format) * 4;
 						uint32 image_size = ((the_width + 3) / 4) * ((the_height + 3) / 4) * block_size;
 
-						base[index] = data_block.size();
-						data_block.resize(base[index] + image_size);
+						base[index] = data_size;
+						data_size += image_size;
 						init_data[index].row_pitch = (the_width + 3) / 4 * block_size;
 						init_data[index].slice_pitch = image_size;
-
-						tex_res.Read(&data_block[base[index]], static_cast<std::streamsize>(image_size));
 					}
 					else
 					{
 						init_data[index].row_pitch = (padding ? ((the_width + 3) & ~3) : the_width) * fmt_size;
 						init_data[index].slice_pitch = init_data[index].row_pitch * the_height;
-						base[index] = data_block.size();
-						data_block.resize(base[index] + init_data[index].slice_pitch);
-
-						tex_res.Read(&data_block[base[index]], static_cast<std::streamsize>(init_data[index].slice_pitch));
+						base[index] = data_size;
+						data_size += init_data[index].slice_pitch;
 					}
 
 					the_width = std::max<uint32>(the_width / 2, 1);
@@ -252,21 +284,17 @@ namespace platform {
 						uint32 const block_size = NumFormatBytes(format) * 4;
 						uint32 image_size = ((the_width + 3) / 4) * ((the_height + 3) / 4) * the_depth * block_size;
 
-						base[index] = data_block.size();
-						data_block.resize(base[index] + image_size);
+						base[index] = data_size;
+						data_size += image_size;
 						init_data[index].row_pitch = (the_width + 3) / 4 * block_size;
 						init_data[index].slice_pitch = ((the_width + 3) / 4) * ((the_height + 3) / 4) * block_size;
-
-						tex_res.Read(&data_block[base[index]], static_cast<std::streamsize>(image_size));
 					}
 					else
 					{
 						init_data[index].row_pitch = (padding ? ((the_width + 3) & ~3) : the_width) * fmt_size;
 						init_data[index].slice_pitch = init_data[index].row_pitch * the_height;
-						base[index] = data_block.size();
-						data_block.resize(base[index] + init_data[index].slice_pitch * the_depth);
-
-						tex_res.Read(&data_block[base[index]], static_cast<std::streamsize>(init_data[index].slice_pitch * the_depth));
+						base[index] = data_size;
+						data_size += init_data[index].slice_pitch * the_depth;
 					}
 
 					the_width = std::max<uint32>(the_width / 2, 1);
@@ -295,21 +323,17 @@ namespace platform {
 							uint32 const block_size = NumFormatBytes(format) * 4;
 							uint32 image_size = ((the_width + 3) / 4) * ((the_height + 3) / 4) * block_size;
 
-							base[index] = data_block.size();
-							data_block.resize(base[index] + image_size);
+							base[index] = data_size;
+							data_size += image_size;
 							init_data[index].row_pitch = (the_width + 3) / 4 * block_size;
 							init_data[index].slice_pitch = image_size;
-
-							tex_res.Read(&data_block[base[index]], static_cast<std::streamsize>(image_size));
 						}
 						else
 						{
 							init_data[index].row_pitch = (padding ? ((the_width + 3) & ~3) : the_width) * fmt_size;
 							init_data[index].slice_pitch = init_data[index].row_pitch * the_width;
-							base[index] = data_block.size();
-							data_block.resize(base[index] + init_data[index].slice_pitch);
-
-							tex_res.Read(&data_block[base[index]], static_cast<std::streamsize>(init_data[index].slice_pitch));
+							base[index] = data_size;
+							data_size += init_data[index].slice_pitch;
 						}
 
 						the_width = std::max<uint32>(the_width / 2, 1);
@@ -321,12 +345,40 @@ namespace platform {
 		break;
 		}
 
+		return data_size;
+	}
+
+	void X::GetImageInfo(File const& file, Render::TextureType& type,
+		uint16& width, uint16& height, uint16& depth,
+		uint8& num_mipmaps, uint8& array_size, Render::EFormat& format,
+		std::vector<Render::ElementInitData>& init_data,
+		std::vector<uint8>& data_block)
+	{
+		uint32 row_pitch, slice_pitch;
+		auto offset = GetImageInfo(file, type, width, height, depth, num_mipmaps, array_size, format,
+			row_pitch, slice_pitch);
+
+		std::vector<size_t> base;
+		auto data_size = GetImageLayout(type, width, height, depth, num_mipmaps, array_size, format, row_pitch,
+			init_data, base);
+
+		//subresources are tightly packed,read the whole payload at once
+		FileRead tex_res{ file };
+		tex_res.SkipTo(offset);
+		data_block.resize(data_size);
+		tex_res.Read(data_block.data(), data_size);
+
 		for (size_t i = 0; i < base.size(); ++i)
 		{
 			init_data[i].data = &data_block[base[i]];
 		}
 	}
 
+	white::coroutine::Task<std::shared_ptr<dds::DDSAsset>> X::AsyncLoadDDSAsset(path const& texpath)
+	{
+		return AssetResourceScheduler::Instance().AsyncLoad<dds::DDSLoadingDesc>(texpath);
+	}
+
 
 	Render::TexturePtr LoadDDSTexture(X::path const& texpath, uint32 access) {
 		auto pAsset = platform::AssetResourceScheduler::Instance().SyncLoad<dds::DDSLoadingDesc>(texpath);
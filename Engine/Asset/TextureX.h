@@ -9,9 +9,14 @@
 
 #include "RenderInterface/ITexture.hpp"
 #include "Runtime/LFile.h"
+#include "Core/Coroutine/Task.h"
 
 #include <filesystem>
 
+namespace dds {
+	class DDSAsset;
+}
+
 namespace platform {
 	namespace X {
 		using path = std::filesystem::path;
@@ -21,12 +26,30 @@ namespace platform {
 			uint16& width, uint16& height, uint16& depth, uint8& num_mipmaps, uint8& array_size,
 			Render::EFormat& format, uint32& row_pitch, uint32& slice_pitch);
 
+		//! \brief parse header bytes prefetched from file,return offset of the payload
+		uint64 GetImageInfo(white::span<const white::byte> header, Render::TextureType& type,
+			uint16& width, uint16& height, uint16& depth, uint8& num_mipmaps, uint8& array_size,
+			Render::EFormat& format, uint32& row_pitch, uint32& slice_pitch);
+
+		/*!
+		\brief compute pitches and payload offsets of all subresources
+		\return payload bytes,subresources are tightly packed in file order
+		*/
+		std::size_t GetImageLayout(Render::TextureType type,
+			uint16 width, uint16 height, uint16 depth, uint8 num_mipmaps, uint8 array_size,
+			Render::EFormat format, uint32 row_pitch,
+			std::vector<Render::ElementInitData>& init_data,
+			std::vector<std::size_t>& offsets);
+
 		void GetImageInfo(File const & file, Render::TextureType& type,
 			uint16& width, uint16& height, uint16& depth, uint8& num_mipmaps, uint8& array_size,
 			Render::EFormat& format,
 			std::vector<Render::ElementInitData> & init_data,
 			std::vector<uint8>& data_block);
 
+		//! \note header and payload are read on io scheduler,init datas reference the payload directly
+		white::coroutine::Task<std::shared_ptr<dds::DDSAsset>> AsyncLoadDDSAsset(path const& texpath);
+
 		Render::TexturePtr LoadTexture(path const& texpath, uint32 access);
 
 		void ResizeTexture(void* dst_data, uint32 dst_row_pitch, uint32 dst_slice_pitch,Render::EFormat dst_format,
@@ -4,6 +4,8 @@
 #include <WBase/type_traits.hpp>
 #include <WBase/memory.hpp>
 #include <bit>
+#include <new>
+#include <type_traits>
 namespace white
 {
 	/*-----------------------------------------------------------------------------
@@ -11,12 +13,20 @@ namespace white
 
 	Also known as a priority queue. Smallest key at top.
 	KeyType must implement operator<
+
+	Arity selects a d-ary layout, 4 trades a deeper binary tree for a single
+	scan over siblings. Keys are stored next to their index in heap order and
+	every group of children starts on a multiple of Arity nodes in a cache line
+	aligned block, so a sibling scan touches one cache line as long as
+	Arity * sizeof(FNode) divides it.
 -----------------------------------------------------------------------------*/
-	template< typename KeyType, typename IndexType = uint32 >
+	template< typename KeyType, typename IndexType = uint32, uint32 Arity = 2 >
 	class FBinaryHeap
 	{
 	public:
 		static_assert(!is_signed<IndexType>::value, "FBinaryHeap only supports unsigned index types");
+		static_assert(Arity >= 2 && std::has_single_bit(Arity), "FBinaryHeap arity must be a power of two");
+		static_assert(std::is_trivially_copyable_v<KeyType>, "FBinaryHeap only supports trivially copyable keys");
 
 		FBinaryHeap();
 		FBinaryHeap(uint32 InHeapSize, uint32 InIndexSize);
@@ -39,10 +49,23 @@ namespace white
 		void		Pop();
 
 		void		Add(KeyType Key, IndexType Index);
+		// Heapify Num entries in O(n), heap must be empty.
+		void		Build(const KeyType* InKeys, const IndexType* InIndexes, uint32 Num);
 		void		Update(KeyType Key, IndexType Index);
 		void		Remove(IndexType Index);
 
 	protected:
+		struct FNode
+		{
+			KeyType		Key;
+			IndexType	Index;
+		};
+
+		static constexpr std::size_t CacheLineSize = 64;
+
+		static FNode*	AllocateHeap(uint32 Num);
+		static void		FreeHeap(FNode* InHeap);
+
 		void		ResizeHeap(uint32 NewHeapSize);
 		void		ResizeIndexes(uint32 NewIndexSize);
 
@@ -53,66 +76,79 @@ namespace white
 		uint32		HeapSize;
 		uint32		IndexSize;
 
-		IndexType* Heap;
+		FNode* Heap;
 
-		KeyType* Keys;
 		IndexType* HeapIndexes;
 	};
 
-	template< typename KeyType, typename IndexType >
-	inline FBinaryHeap< KeyType, IndexType >::FBinaryHeap()
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline FBinaryHeap< KeyType, IndexType, Arity >::FBinaryHeap()
 		: HeapNum(0)
 		, HeapSize(0)
 		, IndexSize(0)
 		, Heap(nullptr)
-		, Keys(nullptr)
 		, HeapIndexes(nullptr)
 	{}
 
-	template< typename KeyType, typename IndexType >
-	inline FBinaryHeap< KeyType, IndexType >::FBinaryHeap(uint32 InHeapSize, uint32 InIndexSize)
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline FBinaryHeap< KeyType, IndexType, Arity >::FBinaryHeap(uint32 InHeapSize, uint32 InIndexSize)
 		: HeapNum(0)
 		, HeapSize(InHeapSize)
 		, IndexSize(InIndexSize)
 	{
-		Heap = new IndexType[HeapSize];
-		Keys = new KeyType[IndexSize];
+		Heap = HeapSize != 0 ? AllocateHeap(HeapSize) : nullptr;
 		HeapIndexes = new IndexType[IndexSize];
 
 		std::memset(HeapIndexes, 0xff, IndexSize * sizeof(IndexType));
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline FBinaryHeap< KeyType, IndexType >::~FBinaryHeap()
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline FBinaryHeap< KeyType, IndexType, Arity >::~FBinaryHeap()
 	{
 		Free();
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline void FBinaryHeap< KeyType, IndexType >::Clear()
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline void FBinaryHeap< KeyType, IndexType, Arity >::Clear()
 	{
 		HeapNum = 0;
 		std::memset(HeapIndexes, 0xff, IndexSize * sizeof(IndexType));
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline void FBinaryHeap< KeyType, IndexType >::Free()
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline void FBinaryHeap< KeyType, IndexType, Arity >::Free()
 	{
 		HeapNum = 0;
 		HeapSize = 0;
 		IndexSize = 0;
 
-		delete[] Heap;
-		delete[] Keys;
+		FreeHeap(Heap);
 		delete[] HeapIndexes;
 
 		Heap = nullptr;
-		Keys = nullptr;
 		HeapIndexes = nullptr;
 	}
 
-	template< typename KeyType, typename IndexType >
-	void FBinaryHeap< KeyType, IndexType >::ResizeHeap(uint32 NewHeapSize)
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	typename FBinaryHeap< KeyType, IndexType, Arity >::FNode* FBinaryHeap< KeyType, IndexType, Arity >::AllocateHeap(uint32 Num)
+	{
+		// Children of node i are Arity * i + 1 .. Arity * i + Arity, padding the front by Arity - 1 nodes
+		// moves every group onto a multiple of Arity.
+		void* Memory = ::operator new[]((Num + Arity - 1) * sizeof(FNode), std::align_val_t(CacheLineSize));
+		return static_cast<FNode*>(Memory) + (Arity - 1);
+	}
+
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	void FBinaryHeap< KeyType, IndexType, Arity >::FreeHeap(FNode* InHeap)
+	{
+		if (InHeap)
+		{
+			::operator delete[](InHeap - (Arity - 1), std::align_val_t(CacheLineSize));
+		}
+	}
+
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	void FBinaryHeap< KeyType, IndexType, Arity >::ResizeHeap(uint32 NewHeapSize)
 	{
 		wconstraint(NewHeapSize != HeapSize);
 
@@ -121,27 +157,27 @@ namespace white
 			HeapNum = 0;
 			HeapSize = 0;
 
-			delete[] Heap;
+			FreeHeap(Heap);
 			Heap = nullptr;
 
 			return;
 		}
 
-		IndexType* NewHeap = new IndexType[NewHeapSize];
+		FNode* NewHeap = AllocateHeap(NewHeapSize);
 
+		HeapNum = std::min(HeapNum, NewHeapSize);
 		if (HeapSize != 0)
 		{
-			std::memcpy(NewHeap, Heap, HeapSize * sizeof(IndexType));
-			delete[] Heap;
+			std::memcpy(NewHeap, Heap, HeapNum * sizeof(FNode));
+			FreeHeap(Heap);
 		}
 
-		HeapNum = std::min(HeapNum, NewHeapSize);
 		HeapSize = NewHeapSize;
 		Heap = NewHeap;
 	}
 
-	template< typename KeyType, typename IndexType >
-	void FBinaryHeap< KeyType, IndexType >::ResizeIndexes(uint32 NewIndexSize)
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	void FBinaryHeap< KeyType, IndexType, Arity >::ResizeIndexes(uint32 NewIndexSize)
 	{
 		wconstraint(NewIndexSize != IndexSize);
 
@@ -149,16 +185,12 @@ namespace white
 		{
 			IndexSize = 0;
 
-			delete[] Keys;
 			delete[] HeapIndexes;
-
-			Keys = nullptr;
 			HeapIndexes = nullptr;
 
 			return;
 		}
 
-		KeyType* NewKeys = new KeyType[NewIndexSize];
 		IndexType* NewHeapIndexes = new IndexType[NewIndexSize];
 
 		if (IndexSize != 0)
@@ -167,10 +199,8 @@ namespace white
 
 			for (uint32 i = 0; i < IndexSize; i++)
 			{
-				NewKeys[i] = Keys[i];
 				NewHeapIndexes[i] = HeapIndexes[i];
 			}
-			delete[] Keys;
 			delete[] HeapIndexes;
 		}
 
@@ -180,12 +210,11 @@ namespace white
 		}
 
 		IndexSize = NewIndexSize;
-		Keys = NewKeys;
 		HeapIndexes = NewHeapIndexes;
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline void FBinaryHeap< KeyType, IndexType >::Resize(uint32 NewHeapSize, uint32 NewIndexSize)
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline void FBinaryHeap< KeyType, IndexType, Arity >::Resize(uint32 NewHeapSize, uint32 NewIndexSize)
 	{
 		if (NewHeapSize != HeapSize)
 		{
@@ -198,8 +227,8 @@ namespace white
 		}
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline bool FBinaryHeap< KeyType, IndexType >::IsPresent(IndexType Index) const
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline bool FBinaryHeap< KeyType, IndexType, Arity >::IsPresent(IndexType Index) const
 	{
 		if (Index >= IndexSize)
 		{
@@ -208,45 +237,45 @@ namespace white
 		return HeapIndexes[Index] != (IndexType)-1;
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline KeyType FBinaryHeap< KeyType, IndexType >::GetKey(IndexType Index) const
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline KeyType FBinaryHeap< KeyType, IndexType, Arity >::GetKey(IndexType Index) const
 	{
 		wconstraint(IsPresent(Index));
-		return Keys[Index];
+		return Heap[HeapIndexes[Index]].Key;
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline IndexType FBinaryHeap< KeyType, IndexType >::Peek(IndexType Index) const
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline IndexType FBinaryHeap< KeyType, IndexType, Arity >::Peek(IndexType Index) const
 	{
 		wconstraint(Index < HeapNum);
-		return Heap[Index];
+		return Heap[Index].Index;
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline IndexType FBinaryHeap< KeyType, IndexType >::Top() const
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline IndexType FBinaryHeap< KeyType, IndexType, Arity >::Top() const
 	{
 		wconstraint(Heap);
 		wconstraint(HeapNum > 0);
-		return Heap[0];
+		return Heap[0].Index;
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline void FBinaryHeap< KeyType, IndexType >::Pop()
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline void FBinaryHeap< KeyType, IndexType, Arity >::Pop()
 	{
 		wconstraint(Heap);
 		wconstraint(HeapNum > 0);
 
-		IndexType Index = Heap[0];
+		IndexType Index = Heap[0].Index;
 
 		Heap[0] = Heap[--HeapNum];
-		HeapIndexes[Heap[0]] = 0;
+		HeapIndexes[Heap[0].Index] = 0;
 		HeapIndexes[Index] = (IndexType)-1;
 
 		DownHeap(0);
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline void FBinaryHeap< KeyType, IndexType >::Add(KeyType Key, IndexType Index)
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline void FBinaryHeap< KeyType, IndexType, Arity >::Add(KeyType Key, IndexType Index)
 	{
 		if (HeapNum == HeapSize)
 		{
@@ -261,25 +290,61 @@ namespace white
 		wconstraint(!IsPresent(Index));
 
 		IndexType HeapIndex = HeapNum++;
-		Heap[HeapIndex] = Index;
-
-		Keys[Index] = Key;
+		Heap[HeapIndex] = { Key, Index };
 		HeapIndexes[Index] = HeapIndex;
 
 		UpHeap(HeapIndex);
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline void FBinaryHeap< KeyType, IndexType >::Update(KeyType Key, IndexType Index)
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	void FBinaryHeap< KeyType, IndexType, Arity >::Build(const KeyType* InKeys, const IndexType* InIndexes, uint32 Num)
+	{
+		wconstraint(HeapNum == 0);
+
+		if (Num > HeapSize)
+		{
+			ResizeHeap(Num);
+		}
+
+		IndexType MaxIndex = 0;
+		for (uint32 i = 0; i < Num; i++)
+		{
+			MaxIndex = std::max(MaxIndex, InIndexes[i]);
+		}
+
+		if (Num > 0 && MaxIndex >= IndexSize)
+		{
+			ResizeIndexes(std::max<uint32>(32u, std::bit_ceil(MaxIndex + 1)));
+		}
+
+		for (uint32 i = 0; i < Num; i++)
+		{
+			IndexType Index = InIndexes[i];
+			wconstraint(!IsPresent(Index));
+
+			Heap[i] = { InKeys[i], Index };
+			HeapIndexes[Index] = i;
+		}
+		HeapNum = Num;
+
+		// Sift down every node that has children, last parent first.
+		for (uint32 i = (Num + Arity - 2) / Arity; i-- > 0;)
+		{
+			DownHeap(i);
+		}
+	}
+
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline void FBinaryHeap< KeyType, IndexType, Arity >::Update(KeyType Key, IndexType Index)
 	{
 		wconstraint(Heap);
 		wconstraint(IsPresent(Index));
 
-		Keys[Index] = Key;
-
 		IndexType HeapIndex = HeapIndexes[Index];
-		IndexType Parent = (HeapIndex - 1) >> 1;
-		if (HeapIndex > 0 && Key < Keys[Heap[Parent]])
+		Heap[HeapIndex].Key = Key;
+
+		IndexType Parent = (HeapIndex - 1) / Arity;
+		if (HeapIndex > 0 && Key < Heap[Parent].Key)
 		{
 			UpHeap(HeapIndex);
 		}
@@ -289,22 +354,27 @@ namespace white
 		}
 	}
 
-	template< typename KeyType, typename IndexType >
-	inline void FBinaryHeap< KeyType, IndexType >::Remove(IndexType Index)
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	inline void FBinaryHeap< KeyType, IndexType, Arity >::Remove(IndexType Index)
 	{
 		if (!IsPresent(Index))
 		{
 			return;
 		}
 
-		KeyType Key = Keys[Index];
 		IndexType HeapIndex = HeapIndexes[Index];
+		KeyType Key = Heap[HeapIndex].Key;
 
 		Heap[HeapIndex] = Heap[--HeapNum];
-		HeapIndexes[Heap[HeapIndex]] = HeapIndex;
+		HeapIndexes[Heap[HeapIndex].Index] = HeapIndex;
 		HeapIndexes[Index] = (IndexType)-1;
 
-		if (Key < Keys[Heap[HeapIndex]])
+		if (HeapIndex == HeapNum)
+		{
+			return;
+		}
+
+		if (Key < Heap[HeapIndex].Key)
 		{
 			DownHeap(HeapIndex);
 		}
@@ -314,53 +384,56 @@ namespace white
 		}
 	}
 
-	template< typename KeyType, typename IndexType >
-	void FBinaryHeap< KeyType, IndexType >::UpHeap(IndexType HeapIndex)
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	void FBinaryHeap< KeyType, IndexType, Arity >::UpHeap(IndexType HeapIndex)
 	{
-		IndexType Moving = Heap[HeapIndex];
+		FNode Moving = Heap[HeapIndex];
 		IndexType i = HeapIndex;
-		IndexType Parent = (i - 1) >> 1;
+		IndexType Parent = (i - 1) / Arity;
 
-		while (i > 0 && Keys[Moving] < Keys[Heap[Parent]])
+		while (i > 0 && Moving.Key < Heap[Parent].Key)
 		{
 			Heap[i] = Heap[Parent];
-			HeapIndexes[Heap[i]] = i;
+			HeapIndexes[Heap[i].Index] = i;
 
 			i = Parent;
-			Parent = (i - 1) >> 1;
+			Parent = (i - 1) / Arity;
 		}
 
 		if (i != HeapIndex)
 		{
 			Heap[i] = Moving;
-			HeapIndexes[Heap[i]] = i;
+			HeapIndexes[Heap[i].Index] = i;
 		}
 	}
 
-	template< typename KeyType, typename IndexType >
-	void FBinaryHeap< KeyType, IndexType >::DownHeap(IndexType HeapIndex)
+	template< typename KeyType, typename IndexType, uint32 Arity >
+	void FBinaryHeap< KeyType, IndexType, Arity >::DownHeap(IndexType HeapIndex)
 	{
-		IndexType Moving = Heap[HeapIndex];
+		FNode Moving = Heap[HeapIndex];
 		IndexType i = HeapIndex;
-		IndexType Left = (i << 1) + 1;
-		IndexType Right = Left + 1;
+		uint32 FirstChild = i * Arity + 1;
 
-		while (Left < HeapNum)
+		while (FirstChild < HeapNum)
 		{
-			IndexType Smallest = Left;
-			if (Right < HeapNum)
+			// Ties go to the later child, matching the binary left/right choice.
+			uint32 LastChild = std::min(FirstChild + Arity, HeapNum);
+			uint32 Smallest = FirstChild;
+			for (uint32 Child = FirstChild + 1; Child < LastChild; Child++)
 			{
-				Smallest = (Keys[Heap[Left]] < Keys[Heap[Right]]) ? Left : Right;
+				if (!(Heap[Smallest].Key < Heap[Child].Key))
+				{
+					Smallest = Child;
+				}
 			}
 
-			if (Keys[Heap[Smallest]] < Keys[Moving])
+			if (Heap[Smallest].Key < Moving.Key)
 			{
 				Heap[i] = Heap[Smallest];
-				HeapIndexes[Heap[i]] = i;
+				HeapIndexes[Heap[i].Index] = i;
 
 				i = Smallest;
-				Left = (i << 1) + 1;
-				Right = Left + 1;
+				FirstChild = i * Arity + 1;
 			}
 			else
 			{
@@ -371,7 +444,7 @@ namespace white
 		if (i != HeapIndex)
 		{
 			Heap[i] = Moving;
-			HeapIndexes[Heap[i]] = i;
+			HeapIndexes[Heap[i].Index] = i;
 		}
 	}
 }
\ No newline at end of file
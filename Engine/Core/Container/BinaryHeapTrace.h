@@ -0,0 +1,64 @@
+#pragma once
+#include <WBase/winttype.hpp>
+#include <WBase/span.hpp>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+namespace white
+{
+	/*-----------------------------------------------------------------------------
+	Operation trace of a float keyed FBinaryHeap.
+
+	Recorded by users such as FMeshSimplifier and replayed by Tools/HeapTraceBench
+	to compare heap layouts on real access patterns.
+-----------------------------------------------------------------------------*/
+	struct FBinaryHeapTraceOp
+	{
+		enum EType : uint32
+		{
+			Add,
+			Remove,
+			Pop,	// Index is the element that was on top
+			Build,	// Consecutive Build ops form one Build call
+		};
+
+		EType	Type;
+		uint32	Index;
+		float	Key;
+	};
+
+	inline constexpr uint32 BinaryHeapTraceMagic = 0x50414548; // "HEAP"
+
+	inline bool SaveBinaryHeapTrace(const std::filesystem::path& Path, span<const FBinaryHeapTraceOp> Ops)
+	{
+		std::ofstream File(Path, std::ios::binary);
+		if (!File)
+		{
+			return false;
+		}
+
+		uint64 Num = Ops.size();
+		File.write(reinterpret_cast<const char*>(&BinaryHeapTraceMagic), sizeof(BinaryHeapTraceMagic));
+		File.write(reinterpret_cast<const char*>(&Num), sizeof(Num));
+		File.write(reinterpret_cast<const char*>(Ops.data()), Num * sizeof(FBinaryHeapTraceOp));
+		return File.good();
+	}
+
+	inline bool LoadBinaryHeapTrace(const std::filesystem::path& Path, std::vector<FBinaryHeapTraceOp>& Ops)
+	{
+		std::ifstream File(Path, std::ios::binary);
+
+		uint32 Magic = 0;
+		uint64 Num = 0;
+		File.read(reinterpret_cast<char*>(&Magic), sizeof(Magic));
+		File.read(reinterpret_cast<char*>(&Num), sizeof(Num));
+		if (!File || Magic != BinaryHeapTraceMagic)
+		{
+			return false;
+		}
+
+		Ops.resize(Num);
+		File.read(reinterpret_cast<char*>(Ops.data()), Num * sizeof(FBinaryHeapTraceOp));
+		return File.good();
+	}
+}
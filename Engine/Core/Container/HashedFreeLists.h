@@ -0,0 +1,123 @@
+#pragma once
+#include <WBase/winttype.hpp>
+#include <WBase/cassert.h>
+#include <WBase/smart_ptr.hpp>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+namespace white
+{
+	/*-----------------------------------------------------------------------------
+	Hashed free lists of ref counted pooled objects.
+
+	Objects are bucketed by a hash of their desc. An object is free while the
+	pool holds its only reference. Each bucket keeps the objects handed out
+	since the last Tick in front of the free ones, so Find is O(1) while the
+	bucket has free objects left.
+	PooledType keeps its own uint32 LastUsedFrame, which Find and Add stamp.
+
+	Releases happen outside the pool without notice. When a bucket runs out
+	of free objects Find looks for one released since the last Tick among
+	the handed out ones, Tick moves the released ones back to the free lists
+	and drops the ones that were not requested for more than
+	FramesUntilRelease frames.
+-----------------------------------------------------------------------------*/
+	template< typename PooledType >
+	class THashedFreeLists
+	{
+	public:
+		using PooledRef = ref_ptr<PooledType>;
+
+		uint32 Num() const { return NumPooled; }
+
+		// Returns a free object with a matching hash and marks it in use, null if there is none.
+		PooledRef Find(uint32 Hash, uint32 FrameCounter)
+		{
+			auto Itr = Buckets.find(Hash);
+			if (Itr == Buckets.end())
+			{
+				return {};
+			}
+
+			auto& Bucket = Itr->second;
+			if (Bucket.NumInUse == Bucket.Entries.size())
+			{
+				// Released again within the frame, it stays with the handed out ones.
+				auto Released = std::find_if(Bucket.Entries.begin(), Bucket.Entries.end(), [](const PooledRef& Pooled) { return Pooled.count() == 1; });
+				if (Released == Bucket.Entries.end())
+				{
+					return {};
+				}
+				(*Released)->LastUsedFrame = FrameCounter;
+				return *Released;
+			}
+
+			auto& Pooled = Bucket.Entries[Bucket.NumInUse++];
+			wassume(Pooled.count() == 1);
+			Pooled->LastUsedFrame = FrameCounter;
+			return Pooled;
+		}
+
+		// Adds a newly created object, in use.
+		void Add(uint32 Hash, PooledRef Pooled, uint32 FrameCounter)
+		{
+			Pooled->LastUsedFrame = FrameCounter;
+
+			auto& Bucket = Buckets[Hash];
+			Bucket.Entries.push_back(std::move(Pooled));
+			std::swap(Bucket.Entries[Bucket.NumInUse], Bucket.Entries.back());
+			++Bucket.NumInUse;
+			++NumPooled;
+		}
+
+		template<typename FunctionType>
+		void Tick(uint32 FrameCounter, uint32 FramesUntilRelease, FunctionType&& OnRelease)
+		{
+			for (auto Itr = Buckets.begin(); Itr != Buckets.end();)
+			{
+				auto& Entries = Itr->second.Entries;
+
+				auto FreeBegin = std::partition(Entries.begin(), Entries.end(), [](const PooledRef& Pooled) { return Pooled.count() > 1; });
+				auto FreeEnd = std::partition(FreeBegin, Entries.end(), [&](const PooledRef& Pooled) { return (FrameCounter - Pooled->LastUsedFrame) <= FramesUntilRelease; });
+
+				Itr->second.NumInUse = static_cast<uint32>(FreeBegin - Entries.begin());
+
+				// Hand out the most recently used first so a surplus ages out instead of being rotated through.
+				std::sort(FreeBegin, FreeEnd, [](const PooledRef& A, const PooledRef& B) { return A->LastUsedFrame > B->LastUsedFrame; });
+
+				for (auto Released = FreeEnd; Released != Entries.end(); ++Released)
+				{
+					OnRelease(*Released);
+				}
+				NumPooled -= static_cast<uint32>(Entries.end() - FreeEnd);
+				Entries.erase(FreeEnd, Entries.end());
+
+				if (Entries.empty())
+				{
+					Itr = Buckets.erase(Itr);
+				}
+				else
+				{
+					++Itr;
+				}
+			}
+		}
+
+		void Clear()
+		{
+			Buckets.clear();
+			NumPooled = 0;
+		}
+
+	private:
+		struct FBucket
+		{
+			// [0, NumInUse) handed out since the last Tick, the rest are free.
+			std::vector<PooledRef> Entries;
+			uint32 NumInUse = 0;
+		};
+
+		std::unordered_map<uint32, FBucket> Buckets;
+		uint32 NumPooled = 0;
+	};
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <WBase/winttype.hpp>
+#include <WBase/span.hpp>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+namespace white
+{
+	/*-----------------------------------------------------------------------------
+	Request trace of a hashed resource pool.
+
+	Recorded by RenderGraph::RGBufferPool and replayed by Tools/PoolTraceBench
+	against THashedFreeLists and a linear scan. Requests of a frame are assumed
+	to be held until the frame ends, as render graph transients are.
+-----------------------------------------------------------------------------*/
+	struct FPoolRequestTraceOp
+	{
+		uint32	Frame;
+		uint32	Hash;
+		uint64	Size;
+	};
+
+	inline constexpr uint32 PoolRequestTraceMagic = 0x4C4F4F50; // "POOL"
+
+	inline bool SavePoolRequestTrace(const std::filesystem::path& Path, span<const FPoolRequestTraceOp> Ops)
+	{
+		std::ofstream File(Path, std::ios::binary);
+		if (!File)
+		{
+			return false;
+		}
+
+		uint64 Num = Ops.size();
+		File.write(reinterpret_cast<const char*>(&PoolRequestTraceMagic), sizeof(PoolRequestTraceMagic));
+		File.write(reinterpret_cast<const char*>(&Num), sizeof(Num));
+		File.write(reinterpret_cast<const char*>(Ops.data()), Num * sizeof(FPoolRequestTraceOp));
+		return File.good();
+	}
+
+	inline bool LoadPoolRequestTrace(const std::filesystem::path& Path, std::vector<FPoolRequestTraceOp>& Ops)
+	{
+		std::ifstream File(Path, std::ios::binary);
+
+		uint32 Magic = 0;
+		uint64 Num = 0;
+		File.read(reinterpret_cast<char*>(&Magic), sizeof(Magic));
+		File.read(reinterpret_cast<char*>(&Num), sizeof(Num));
+		if (!File || Magic != PoolRequestTraceMagic)
+		{
+			return false;
+		}
+
+		Ops.resize(Num);
+		File.read(reinterpret_cast<char*>(Ops.data()), Num * sizeof(FPoolRequestTraceOp));
+		return File.good();
+	}
+}
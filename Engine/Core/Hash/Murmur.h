@@ -2,6 +2,7 @@
 
 #include<initializer_list>
 #include<WBase/winttype.hpp>
+#include<WBase/wmathtype.hpp>
 
 inline white::uint32 MurmurFinalize32(white::uint32 Hash)
 {
@@ -38,4 +39,22 @@ inline white::uint32 Murmur32(std::initializer_list< white::uint32 > InitList)
 	}
 
 	return MurmurFinalize32(Hash);
+}
+
+//+0.0 and -0.0 hash the same
+inline white::uint32 HashPosition(const white::math::float3& Position)
+{
+	union { float f; white::uint32 i; } x;
+	union { float f; white::uint32 i; } y;
+	union { float f; white::uint32 i; } z;
+
+	x.f = Position.x;
+	y.f = Position.y;
+	z.f = Position.z;
+
+	return Murmur32({
+		Position.x == 0.0f ? 0u : x.i,
+		Position.y == 0.0f ? 0u : y.i,
+		Position.z == 0.0f ? 0u : z.i
+		});
 }
\ No newline at end of file
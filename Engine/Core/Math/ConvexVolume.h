@@ -0,0 +1,90 @@
+#pragma once
+#include <WBase/wmath.hpp>
+#include "Sphere.h"
+
+namespace WhiteEngine
+{
+	using namespace white::inttype;
+	namespace wm = white::math;
+
+	/*
+	\brief Intersection of up to MaxPlanes half spaces.
+	Planes are (normal, d) with the normal pointing inside, a point p is inside when dot(normal, p) + d >= 0.
+	*/
+	struct ConvexVolume
+	{
+		static constexpr uint32 MaxPlanes = 8;
+
+		wm::float4 Planes[MaxPlanes];
+		uint32 NumPlanes = 0;
+
+		enum class EIntersect
+		{
+			Outside,
+			Intersect,
+			Inside,
+		};
+
+		void AddPlane(const wm::float4& Plane)
+		{
+			wconstraint(NumPlanes < MaxPlanes);
+
+			auto Length = wm::length(wm::float3(Plane.x, Plane.y, Plane.z));
+			Planes[NumPlanes++] = Length > 0 ? Plane / Length : Plane;
+		}
+
+		EIntersect IntersectBox(const wm::float3& Origin, const wm::float3& Extent) const
+		{
+			auto Result = EIntersect::Inside;
+			for (uint32 Index = 0; Index != NumPlanes; ++Index)
+			{
+				auto& Plane = Planes[Index];
+				float Distance = Plane.x * Origin.x + Plane.y * Origin.y + Plane.z * Origin.z + Plane.w;
+				float PushOut = std::fabs(Plane.x) * Extent.x + std::fabs(Plane.y) * Extent.y + std::fabs(Plane.z) * Extent.z;
+
+				if (Distance < -PushOut)
+					return EIntersect::Outside;
+				if (Distance < PushOut)
+					Result = EIntersect::Intersect;
+			}
+			return Result;
+		}
+
+		//! \brief Frustum of a row vector view projection matrix with clip z in [0,1].
+		static ConvexVolume FromViewProjection(const wm::float4x4& ViewProjection)
+		{
+			auto Column = [&](int Index) {
+				return wm::float4(ViewProjection[0][Index], ViewProjection[1][Index], ViewProjection[2][Index], ViewProjection[3][Index]);
+				};
+
+			ConvexVolume Result;
+			Result.AddPlane(Column(3) + Column(0));
+			Result.AddPlane(Column(3) - Column(0));
+			Result.AddPlane(Column(3) + Column(1));
+			Result.AddPlane(Column(3) - Column(1));
+			Result.AddPlane(Column(2));
+			Result.AddPlane(Column(3) - Column(2));
+			return Result;
+		}
+
+		/*!
+		\brief Bounds swept without end along Direction in both senses, a prism around the cylinder
+		whole scene shadow casters of a directional light cascade have to touch.
+		*/
+		static ConvexVolume FromDirectionalSweep(const Sphere& Bounds, const wm::float3& Direction)
+		{
+			auto Up = std::fabs(Direction.y) < 0.99f ? wm::float3(0, 1, 0) : wm::float3(1, 0, 0);
+			auto U = wm::normalize(wm::cross(Direction, Up));
+			auto V = wm::cross(Direction, U);
+
+			ConvexVolume Result;
+			for (auto& Axis : { U,V })
+			{
+				auto Center = wm::dot(Axis, Bounds.Center);
+				Result.AddPlane(wm::float4(Axis, Bounds.W - Center));
+				Result.AddPlane(wm::float4(-Axis, Bounds.W + Center));
+			}
+			return Result;
+		}
+	};
+}
@@ -0,0 +1,229 @@
+#include "VectorKernels.h"
+#include "PlatformMath.h"
+#include "Core/Hash/Murmur.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace white::math
+{
+	namespace
+	{
+		uint32 MortonEncode3Scalar(const float3& Center, const float3& Min, const float3& Extent)
+		{
+			auto CenterLocal = (Center - Min) / Extent;
+
+			uint32 Morton;
+			Morton = MortonCode3(static_cast<uint32>(CenterLocal.x * 1023));
+			Morton |= MortonCode3(static_cast<uint32>(CenterLocal.y * 1023)) << 1;
+			Morton |= MortonCode3(static_cast<uint32>(CenterLocal.z * 1023)) << 2;
+			return Morton;
+		}
+
+		bool CullBoxScalar(const float4* Planes, uint32 NumPlanes, const float3& Origin, const float3& Extent)
+		{
+			for (uint32 Index = 0; Index != NumPlanes; ++Index)
+			{
+				auto& Plane = Planes[Index];
+				float Distance = Plane.x * Origin.x + Plane.y * Origin.y + Plane.z * Origin.z + Plane.w;
+				float PushOut = std::fabs(Plane.x) * Extent.x + std::fabs(Plane.y) * Extent.y + std::fabs(Plane.z) * Extent.z;
+				if (Distance < -PushOut)
+					return false;
+			}
+			return true;
+		}
+
+#if defined(__AVX2__)
+		inline __m256i Rotl(__m256i Value, int Shift)
+		{
+			return _mm256_or_si256(_mm256_slli_epi32(Value, Shift), _mm256_srli_epi32(Value, 32 - Shift));
+		}
+
+		inline __m256i MurmurMix(__m256i Hash, __m256i Element)
+		{
+			Element = _mm256_mullo_epi32(Element, _mm256_set1_epi32(0xcc9e2d51));
+			Element = Rotl(Element, 15);
+			Element = _mm256_mullo_epi32(Element, _mm256_set1_epi32(0x1b873593));
+
+			Hash = _mm256_xor_si256(Hash, Element);
+			Hash = Rotl(Hash, 13);
+			return _mm256_add_epi32(_mm256_mullo_epi32(Hash, _mm256_set1_epi32(5)), _mm256_set1_epi32(0xe6546b64));
+		}
+
+		inline __m256i MurmurFinalize(__m256i Hash)
+		{
+			Hash = _mm256_xor_si256(Hash, _mm256_srli_epi32(Hash, 16));
+			Hash = _mm256_mullo_epi32(Hash, _mm256_set1_epi32(0x85ebca6b));
+			Hash = _mm256_xor_si256(Hash, _mm256_srli_epi32(Hash, 13));
+			Hash = _mm256_mullo_epi32(Hash, _mm256_set1_epi32(0xc2b2ae35));
+			return _mm256_xor_si256(Hash, _mm256_srli_epi32(Hash, 16));
+		}
+
+		//+0.0 and -0.0 hash the same
+		inline __m256i FloatBits(__m256 Value)
+		{
+			auto ZeroMask = _mm256_cmp_ps(Value, _mm256_setzero_ps(), _CMP_EQ_OQ);
+			return _mm256_castps_si256(_mm256_andnot_ps(ZeroMask, Value));
+		}
+
+		inline __m256i MortonSpread(__m256i x)
+		{
+			x = _mm256_and_si256(x, _mm256_set1_epi32(0x000003ff));
+			x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_slli_epi32(x, 16)), _mm256_set1_epi32(0xff0000ff));
+			x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_slli_epi32(x, 8)), _mm256_set1_epi32(0x0300f00f));
+			x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_slli_epi32(x, 4)), _mm256_set1_epi32(0x030c30c3));
+			x = _mm256_and_si256(_mm256_xor_si256(x, _mm256_slli_epi32(x, 2)), _mm256_set1_epi32(0x09249249));
+			return x;
+		}
+#endif
+	}
+
+	void HashPositions(const float3* Positions, std::size_t StrideInBytes, const uint32* Indexes, uint32 Count, uint32* OutHashes)
+	{
+		auto Base = reinterpret_cast<const uint8*>(Positions);
+
+		uint32 i = 0;
+#if defined(__AVX2__)
+		{
+			auto Stride = _mm256_set1_epi32(static_cast<int32>(StrideInBytes));
+			for (; i + 8 <= Count; i += 8)
+			{
+				auto VertIndex = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Indexes + i));
+
+				//gather offset is int32,fallback when byte offset exceed it
+				uint32 MaxIndex = 0;
+				for (uint32 Lane = 0; Lane != 8; ++Lane)
+					MaxIndex = std::max(MaxIndex, Indexes[i + Lane]);
+				if (static_cast<std::size_t>(MaxIndex) * StrideInBytes + sizeof(float3) > static_cast<std::size_t>(std::numeric_limits<int32>::max()))
+				{
+					for (uint32 Lane = 0; Lane != 8; ++Lane)
+						OutHashes[i + Lane] = ::HashPosition(*reinterpret_cast<const float3*>(Base + Indexes[i + Lane] * StrideInBytes));
+					continue;
+				}
+
+				auto Offset = _mm256_mullo_epi32(VertIndex, Stride);
+				auto X = _mm256_i32gather_ps(reinterpret_cast<const float*>(Base), Offset, 1);
+				auto Y = _mm256_i32gather_ps(reinterpret_cast<const float*>(Base + sizeof(float)), Offset, 1);
+				auto Z = _mm256_i32gather_ps(reinterpret_cast<const float*>(Base + sizeof(float) * 2), Offset, 1);
+
+				auto Hash = _mm256_setzero_si256();
+				Hash = MurmurMix(Hash, FloatBits(X));
+				Hash = MurmurMix(Hash, FloatBits(Y));
+				Hash = MurmurMix(Hash, FloatBits(Z));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(OutHashes + i), MurmurFinalize(Hash));
+			}
+		}
+#endif
+		for (; i < Count; ++i)
+			OutHashes[i] = ::HashPosition(*reinterpret_cast<const float3*>(Base + Indexes[i] * StrideInBytes));
+	}
+
+	void HashPairs(const uint32* A, const uint32* B, uint32 Count, uint32* OutHashes)
+	{
+		uint32 i = 0;
+#if defined(__AVX2__)
+		for (; i + 8 <= Count; i += 8)
+		{
+			auto Hash = _mm256_setzero_si256();
+			Hash = MurmurMix(Hash, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(A + i)));
+			Hash = MurmurMix(Hash, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(B + i)));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(OutHashes + i), MurmurFinalize(Hash));
+		}
+#endif
+		for (; i < Count; ++i)
+			OutHashes[i] = Murmur32({ A[i], B[i] });
+	}
+
+	void MortonEncode3(const float3* Centers, uint32 Count, const float3& Min, const float3& Extent, uint32* OutCodes)
+	{
+		uint32 i = 0;
+#if defined(__AVX2__)
+		auto MinX = _mm256_set1_ps(Min.x), MinY = _mm256_set1_ps(Min.y), MinZ = _mm256_set1_ps(Min.z);
+		auto ExtentX = _mm256_set1_ps(Extent.x), ExtentY = _mm256_set1_ps(Extent.y), ExtentZ = _mm256_set1_ps(Extent.z);
+		auto Scale = _mm256_set1_ps(1023.f);
+
+		const auto Lanes = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+		for (; i + 8 <= Count; i += 8)
+		{
+			auto Base = reinterpret_cast<const float*>(Centers + i);
+			auto X = _mm256_i32gather_ps(Base, Lanes, 4);
+			auto Y = _mm256_i32gather_ps(Base + 1, Lanes, 4);
+			auto Z = _mm256_i32gather_ps(Base + 2, Lanes, 4);
+
+			//keep the same operation order as scalar path:(c - min) / extent * 1023
+			X = _mm256_mul_ps(_mm256_div_ps(_mm256_sub_ps(X, MinX), ExtentX), Scale);
+			Y = _mm256_mul_ps(_mm256_div_ps(_mm256_sub_ps(Y, MinY), ExtentY), Scale);
+			Z = _mm256_mul_ps(_mm256_div_ps(_mm256_sub_ps(Z, MinZ), ExtentZ), Scale);
+
+			auto Morton = MortonSpread(_mm256_cvttps_epi32(X));
+			Morton = _mm256_or_si256(Morton, _mm256_slli_epi32(MortonSpread(_mm256_cvttps_epi32(Y)), 1));
+			Morton = _mm256_or_si256(Morton, _mm256_slli_epi32(MortonSpread(_mm256_cvttps_epi32(Z)), 2));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(OutCodes + i), Morton);
+		}
+#endif
+		for (; i < Count; ++i)
+			OutCodes[i] = MortonEncode3Scalar(Centers[i], Min, Extent);
+	}
+
+	void CullBoxes(const float4* Planes, uint32 NumPlanes, const float3* Origins, const float3* Extents, uint32 Count, uint8* OutVisible)
+	{
+		uint32 i = 0;
+#if defined(__AVX2__)
+		const auto Lanes = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+		const auto SignMask = _mm256_set1_ps(-0.f);
+		for (; i + 8 <= Count; i += 8)
+		{
+			auto Origin = reinterpret_cast<const float*>(Origins + i);
+			auto OX = _mm256_i32gather_ps(Origin, Lanes, 4);
+			auto OY = _mm256_i32gather_ps(Origin + 1, Lanes, 4);
+			auto OZ = _mm256_i32gather_ps(Origin + 2, Lanes, 4);
+
+			auto Extent = reinterpret_cast<const float*>(Extents + i);
+			auto EX = _mm256_i32gather_ps(Extent, Lanes, 4);
+			auto EY = _mm256_i32gather_ps(Extent + 1, Lanes, 4);
+			auto EZ = _mm256_i32gather_ps(Extent + 2, Lanes, 4);
+
+			auto Outside = _mm256_setzero_ps();
+			for (uint32 Index = 0; Index != NumPlanes; ++Index)
+			{
+				auto& Plane = Planes[Index];
+
+				//keep the same operation order as scalar path
+				auto Distance = _mm256_mul_ps(_mm256_set1_ps(Plane.x), OX);
+				Distance = _mm256_add_ps(Distance, _mm256_mul_ps(_mm256_set1_ps(Plane.y), OY));
+				Distance = _mm256_add_ps(Distance, _mm256_mul_ps(_mm256_set1_ps(Plane.z), OZ));
+				Distance = _mm256_add_ps(Distance, _mm256_set1_ps(Plane.w));
+
+				auto PushOut = _mm256_mul_ps(_mm256_set1_ps(std::fabs(Plane.x)), EX);
+				PushOut = _mm256_add_ps(PushOut, _mm256_mul_ps(_mm256_set1_ps(std::fabs(Plane.y)), EY));
+				PushOut = _mm256_add_ps(PushOut, _mm256_mul_ps(_mm256_set1_ps(std::fabs(Plane.z)), EZ));
+
+				Outside = _mm256_or_ps(Outside, _mm256_cmp_ps(Distance, _mm256_xor_ps(PushOut, SignMask), _CMP_LT_OQ));
+			}
+
+			auto Bits = _mm256_movemask_ps(Outside);
+			for (uint32 Lane = 0; Lane != 8; ++Lane)
+				OutVisible[i + Lane] = ((Bits >> Lane) & 1) ? 0 : 1;
+		}
+#endif
+		for (; i < Count; ++i)
+			OutVisible[i] = CullBoxScalar(Planes, NumPlanes, Origins[i], Extents[i]) ? 1 : 0;
+	}
+
+	const char* GetKernelInstructionSet()
+	{
+#if defined(__AVX2__)
+		return "AVX2";
+#else
+		return "scalar";
+#endif
+	}
+}
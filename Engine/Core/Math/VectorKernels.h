@@ -0,0 +1,34 @@
+#pragma once
+
+#include <WBase/wmathtype.hpp>
+#include <WBase/winttype.hpp>
+
+//Batch kernels of hot scalar helpers,bit exact with the scalar versions.
+//AVX2 path is selected at compile time(__AVX2__),otherwise scalar loops are used.
+//Engine builds x64 configurations with /arch:AVX2,Win32 builds take the scalar loops.
+namespace white::math
+{
+	/*!
+	\brief OutHashes[i] = HashPosition(Positions[Indexes[i]])
+	\param StrideInBytes distance between two positions,e.g. sizeof(vertex)
+	*/
+	void HashPositions(const float3* Positions, std::size_t StrideInBytes, const uint32* Indexes, uint32 Count, uint32* OutHashes);
+
+	//! \brief OutHashes[i] = Murmur32({A[i],B[i]})
+	void HashPairs(const uint32* A, const uint32* B, uint32 Count, uint32* OutHashes);
+
+	/*!
+	\brief OutCodes[i] = Morton code of ((Centers[i] - Min) / Extent * 1023)
+	\note same as MortonCode3(x) | MortonCode3(y) << 1 | MortonCode3(z) << 2
+	*/
+	void MortonEncode3(const float3* Centers, uint32 Count, const float3& Min, const float3& Extent, uint32* OutCodes);
+
+	/*!
+	\brief OutVisible[i] = 0 when the box (Origins[i], Extents[i]) is fully outside one of the planes, 1 otherwise
+	\note planes are (normal, d) with the normal pointing inside
+	*/
+	void CullBoxes(const float4* Planes, uint32 NumPlanes, const float3* Origins, const float3* Extents, uint32 Count, uint8* OutVisible);
+
+	//! \brief the path the kernels were compiled with,"AVX2" or "scalar"
+	const char* GetKernelInstructionSet();
+}
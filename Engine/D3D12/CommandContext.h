@@ -264,8 +264,9 @@ namespace platform_ex::Windows::D3D12 {
 		void BeginFrame();
 
 		void EndFrame();
-	private:
+
 		void ClearState();
+	private:
 
 		void CommitGraphicsResourceTables();
 		void CommitNonComputeShaderConstants();
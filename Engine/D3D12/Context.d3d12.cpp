@@ -238,7 +238,9 @@ namespace platform_ex::Windows::D3D12 {
 			GraphicsPSOInit.ShaderPass.VertexShader = compose.GetVertexShader();
 			GraphicsPSOInit.ShaderPass.PixelShader = compose.GetPixelShader();
 
-			platform::Render::SetGraphicsPipelineState(CmdList, GraphicsPSOInit);
+			// still being created on a worker, the pass is skipped this frame
+			if (!platform::Render::TrySetGraphicsPipelineState(CmdList, GraphicsPSOInit))
+				return false;
 
 			//Vertex Stream
 			auto num_vertex_streams = layout.GetVertexStreamsSize();
@@ -276,6 +278,7 @@ namespace platform_ex::Windows::D3D12 {
 			SetShaderParamters.operator()<ShaderType::PixelShader > (compose.GetPixelShader());
 
 			compose.UnBind();
+			return true;
 		};
 
 		if (index_stream) {
@@ -285,7 +288,8 @@ namespace platform_ex::Windows::D3D12 {
 
 				auto& shader_compose = pass.GetShader(effect);
 				auto& pipe_state = pass.GetState();
-				BindLegacyPass(static_cast<ShaderCompose&>(shader_compose), pipe_state);
+				if (!BindLegacyPass(static_cast<ShaderCompose&>(shader_compose), pipe_state))
+					continue;
 				CmdList.DrawIndexedPrimitive(index_stream.get(),
 					layout.GetVertexStart(), 0, layout.GetNumVertices(),
 					layout.GetIndexStart(), prim_count, num_instances
@@ -298,7 +302,8 @@ namespace platform_ex::Windows::D3D12 {
 				auto& pass = tech.GetPass(i);
 				auto& shader_compose = pass.GetShader(effect);
 				auto& pipe_state = pass.GetState();
-				BindLegacyPass(static_cast<ShaderCompose&>(shader_compose), pipe_state);
+				if (!BindLegacyPass(static_cast<ShaderCompose&>(shader_compose), pipe_state))
+					continue;
 
 				CmdList.DrawPrimitive(layout.GetVertexStart(), 0, prim_count, num_instances);
 			}
@@ -329,6 +334,32 @@ namespace platform_ex::Windows::D3D12 {
 		return context;
 	}
 
+	CommandContext* D3D12::Context::ObtainParallelCommandContext()
+	{
+		return device->Devices[0]->ObtainCommandContext(QueueType::Direct);
+	}
+
+	void D3D12::Context::SubmitParallelCommandContexts(white::span<platform::Render::CommandContext* const> Contexts)
+	{
+		std::vector<D3D12Payload*> Payloads;
+
+		// The default context recorded everything before the parallel ranges.
+		auto& DefaultContext = *GetDefaultCommandContext();
+		DefaultContext.FlushResourceBarriers();
+		DefaultContext.Finalize(Payloads);
+
+		for (auto ParallelContext : Contexts)
+		{
+			auto& D3DContext = static_cast<CommandContext&>(*ParallelContext);
+			D3DContext.FlushResourceBarriers();
+			D3DContext.Finalize(Payloads);
+
+			device->Devices[0]->ReleaseCommandContext(&D3DContext);
+		}
+
+		SubmitPayloads(white::make_span(Payloads));
+	}
+
 	Context & Context::Instance()
 	{
 		static Context context;
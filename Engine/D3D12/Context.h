@@ -38,6 +38,10 @@ namespace platform_ex {
 				void AdvanceFrameFence() override;
 
 				void AdvanceDisplayBuffer() override;
+
+				CommandContext* ObtainParallelCommandContext() override;
+
+				void SubmitParallelCommandContexts(white::span<platform::Render::CommandContext* const> Contexts) override;
 			public:
 				void CreateDeviceAndDisplay(platform::Render::DisplaySetting setting) override;
 			private:
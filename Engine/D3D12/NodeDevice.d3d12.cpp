@@ -206,6 +206,26 @@ void platform_ex::Windows::D3D12::NodeDevice::ReleaseCommandList(CommandList* Cm
 	Queues[(uint32)Cmd->Type].ObjectPool.Lists.Push(Cmd);
 }
 
+CommandContext* NodeDevice::ObtainCommandContext(QueueType Type)
+{
+	auto Context = static_cast<CommandContext*>(Queues[(uint32)Type].ObjectPool.Contexts.Pop());
+	if (!Context)
+	{
+		Context = new CommandContext(this, Type, false);
+	}
+
+	return Context;
+}
+
+void NodeDevice::ReleaseCommandContext(CommandContext* Context)
+{
+	wassume(!Context->IsDefaultContext() && !Context->IsOpen());
+
+	Context->ClearState();
+
+	Queues[(uint32)(Context->IsAsyncComputeContext() ? QueueType::Async : QueueType::Direct)].ObjectPool.Contexts.Push(Context);
+}
+
 platform_ex::Windows::D3D12::NodeQueue::NodeQueue(NodeDevice* Device, QueueType QueueType)
 	:Device(Device),Fence(Device->GetParentAdapter(),0,Device->GetGPUIndex()),Type(QueueType)
 {
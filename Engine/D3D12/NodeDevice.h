@@ -85,6 +85,10 @@ namespace platform_ex::Windows::D3D12
 		CommandList* ObtainCommandList(CommandAllocator* CommandAllocator);
 		void ReleaseCommandList(CommandList* Cmd);
 
+		// Non default contexts, used to translate command list ranges in parallel.
+		CommandContext* ObtainCommandContext(QueueType Type);
+		void ReleaseCommandContext(CommandContext* Context);
+
 		NodeQueue& GetQueue(QueueType QueueType) { return Queues[(uint32)QueueType]; }
 		white::span<NodeQueue> GetQueues() { return white::make_span(Queues); }
 
@@ -0,0 +1,460 @@
+#include "MeshLodBuilder.h"
+#include "MeshSimplify.h"
+#include "RenderInterface/Color_T.hpp"
+#include "Developer/MeshBuild.h"
+#include "Core/Math/Float32.h"
+#include "Runtime/ParallelFor.h"
+
+#include "spdlog/spdlog.h"
+#include "spdlog/stopwatch.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace WhiteEngine
+{
+	using namespace platform::Render;
+	using asset::MeshAsset;
+
+	namespace
+	{
+		struct FVertexLayout
+		{
+			int32 PositionStream = -1;
+			int32 NormalStream = -1;
+			std::vector<int32> TexCoordStreams;
+
+			uint32 GetNumAttributes() const
+			{
+				return (NormalStream >= 0 ? 3 : 0) + 2 * static_cast<uint32>(TexCoordStreams.size());
+			}
+		};
+
+		struct FSubMeshSource
+		{
+			// Asset vertex of every local vertex.
+			std::vector<uint32> SourceVerts;
+			std::vector<float> Verts;
+			std::vector<uint32> Indexes;
+			float SurfaceArea = 0.0f;
+		};
+
+		struct FLodOutput
+		{
+			std::vector<uint32> SourceVerts;
+			std::vector<float> Verts;
+			std::vector<uint32> Indexes;
+			float Error = 0.0f;
+			double BuildSeconds = 0.0;
+		};
+
+		void CorrectNormal(float* Attributes)
+		{
+			wm::float3& Normal = *reinterpret_cast<wm::float3*>(Attributes);
+			Normal = wm::normalize(Normal);
+		}
+
+		uint32 ReadIndex(const MeshAsset& Mesh, uint32 Index)
+		{
+			const byte* Stream = Mesh.GetIndexStreams().get();
+			if (Mesh.GetIndexFormat() == EF_R16UI)
+				return reinterpret_cast<const uint16*>(Stream)[Index];
+			return reinterpret_cast<const uint32*>(Stream)[Index];
+		}
+
+		FVertexLayout GetVertexLayout(const MeshAsset& Mesh)
+		{
+			FVertexLayout Layout;
+
+			auto& Elements = Mesh.GetVertexElements();
+			for (int32 i = 0; i < static_cast<int32>(Elements.size()); i++)
+			{
+				auto& Element = Elements[i];
+				bool bFloat3 = Element.format == EF_BGR32F || Element.format == EF_ABGR32F;
+
+				if (Element.usage == Vertex::Position && Element.usage_index == 0 && bFloat3)
+					Layout.PositionStream = i;
+				else if (Element.usage == Vertex::Normal && Element.usage_index == 0 && bFloat3)
+					Layout.NormalStream = i;
+				else if (Element.usage == Vertex::TextureCoord && Element.format == EF_GR32F)
+					Layout.TexCoordStreams.emplace_back(i);
+			}
+
+			return Layout;
+		}
+
+		FSubMeshSource GatherSubMesh(const MeshAsset& Mesh, const FVertexLayout& Layout, const MeshAsset::SubMeshDescrption::LodDescription& Lod0)
+		{
+			FSubMeshSource Source;
+
+			Source.Indexes.resize(Lod0.IndexNum);
+			for (uint32 i = 0; i < Lod0.IndexNum; i++)
+			{
+				Source.Indexes[i] = ReadIndex(Mesh, Lod0.IndexBase + i) + Lod0.VertexBase;
+			}
+
+			// Only simplify the vertices referenced by this submesh.
+			Source.SourceVerts = Source.Indexes;
+			std::sort(Source.SourceVerts.begin(), Source.SourceVerts.end());
+			Source.SourceVerts.erase(std::unique(Source.SourceVerts.begin(), Source.SourceVerts.end()), Source.SourceVerts.end());
+
+			for (uint32& Index : Source.Indexes)
+			{
+				Index = static_cast<uint32>(std::lower_bound(Source.SourceVerts.begin(), Source.SourceVerts.end(), Index) - Source.SourceVerts.begin());
+			}
+
+			const uint32 VertSize = 3 + Layout.GetNumAttributes();
+			Source.Verts.resize(Source.SourceVerts.size() * VertSize);
+
+			auto& Elements = Mesh.GetVertexElements();
+			auto& Streams = Mesh.GetVertexStreams();
+			for (size_t i = 0; i < Source.SourceVerts.size(); i++)
+			{
+				float* Vert = &Source.Verts[i * VertSize];
+				auto Fetch = [&](int32 StreamIndex, uint32 NumFloats)
+				{
+					std::memcpy(Vert, Streams[StreamIndex].get() + Elements[StreamIndex].GetElementSize() * Source.SourceVerts[i], NumFloats * sizeof(float));
+					Vert += NumFloats;
+				};
+
+				Fetch(Layout.PositionStream, 3);
+				if (Layout.NormalStream >= 0)
+					Fetch(Layout.NormalStream, 3);
+				for (int32 StreamIndex : Layout.TexCoordStreams)
+					Fetch(StreamIndex, 2);
+			}
+
+			for (size_t TriIndex = 0; TriIndex < Source.Indexes.size() / 3; TriIndex++)
+			{
+				const wm::float3& Position0 = *reinterpret_cast<const wm::float3*>(&Source.Verts[Source.Indexes[TriIndex * 3 + 0] * VertSize]);
+				const wm::float3& Position1 = *reinterpret_cast<const wm::float3*>(&Source.Verts[Source.Indexes[TriIndex * 3 + 1] * VertSize]);
+				const wm::float3& Position2 = *reinterpret_cast<const wm::float3*>(&Source.Verts[Source.Indexes[TriIndex * 3 + 2] * VertSize]);
+
+				Source.SurfaceArea += 0.5f * wm::length(wm::cross(Position1 - Position0, Position0 - Position2));
+			}
+
+			return Source;
+		}
+
+		// Empty output means the target does not reduce lod0.
+		FLodOutput SimplifyLod(const FSubMeshSource& Source, const FVertexLayout& Layout, const FMeshLodTarget& Target)
+		{
+			spdlog::stopwatch sw;
+
+			FLodOutput Output;
+
+			const uint32 NumAttributes = Layout.GetNumAttributes();
+			const uint32 VertSize = 3 + NumAttributes;
+			const uint32 NumVerts = static_cast<uint32>(Source.SourceVerts.size());
+			const uint32 NumTris = static_cast<uint32>(Source.Indexes.size() / 3);
+			const uint32 TargetNumTris = std::max(1u, static_cast<uint32>(NumTris * Target.TriangleRatio));
+
+			if (TargetNumTris >= NumTris)
+				return Output;
+
+			Output.Verts = Source.Verts;
+			Output.Indexes = Source.Indexes;
+			std::vector<int32> MaterialIndexes(NumTris, 0);
+
+			// Same lossless scaling as FCluster::Simplify.
+			float TriangleSize = std::sqrt(Source.SurfaceArea / NumTris);
+
+			white::FFloat32 CurrentSize(std::max(TriangleSize, THRESH_POINTS_ARE_SAME));
+			white::FFloat32 DesiredSize(0.25f);
+			white::FFloat32 FloatScale(1.0f);
+
+			int32 Exponent = wm::clamp((int)DesiredSize.Components.Exponent - (int)CurrentSize.Components.Exponent, -126, 127);
+			FloatScale.Components.Exponent = Exponent + 127;
+			float PositionScale = FloatScale.FloatValue;
+
+			const uint32 NumTexCoords = static_cast<uint32>(Layout.TexCoordStreams.size());
+			const uint32 TexCoordOffset = 3 + (Layout.NormalStream >= 0 ? 3 : 0);
+
+			std::vector<float> MinUV(NumTexCoords, +FLT_MAX);
+			std::vector<float> MaxUV(NumTexCoords, -FLT_MAX);
+			for (uint32 i = 0; i < NumVerts; i++)
+			{
+				float* Vert = &Output.Verts[i * VertSize];
+				Vert[0] *= PositionScale;
+				Vert[1] *= PositionScale;
+				Vert[2] *= PositionScale;
+
+				for (uint32 UVIndex = 0; UVIndex < NumTexCoords; UVIndex++)
+				{
+					float U = Vert[TexCoordOffset + 2 * UVIndex + 0];
+					float V = Vert[TexCoordOffset + 2 * UVIndex + 1];
+					if (!std::isfinite(U)) U = 0.0f;
+					if (!std::isfinite(V)) V = 0.0f;
+					MinUV[UVIndex] = std::min({ MinUV[UVIndex], U, V });
+					MaxUV[UVIndex] = std::max({ MaxUV[UVIndex], U, V });
+				}
+			}
+
+			std::vector<float> AttributeWeights(NumAttributes);
+			if (Layout.NormalStream >= 0)
+			{
+				AttributeWeights[0] = 1.0f;
+				AttributeWeights[1] = 1.0f;
+				AttributeWeights[2] = 1.0f;
+			}
+			for (uint32 UVIndex = 0; UVIndex < NumTexCoords; UVIndex++)
+			{
+				float Range = std::max(1.0f, MaxUV[UVIndex] - MinUV[UVIndex]);
+				AttributeWeights[TexCoordOffset - 3 + 2 * UVIndex + 0] = 1.0f / (1024.0f * NumTexCoords * Range);
+				AttributeWeights[TexCoordOffset - 3 + 2 * UVIndex + 1] = 1.0f / (1024.0f * NumTexCoords * Range);
+			}
+
+			FMeshSimplifier Simplifier(Output.Verts.data(), NumVerts, Output.Indexes.data(), static_cast<uint32>(Output.Indexes.size()), MaterialIndexes.data(), NumAttributes);
+
+			Simplifier.SetAttributeWeights(AttributeWeights.data());
+			if (Layout.NormalStream >= 0)
+				Simplifier.SetCorrectAttributes(CorrectNormal);
+			Simplifier.SetEdgeWeight(2.0f);
+
+			float LimitErrorSqr = FLT_MAX;
+			if (Target.MaxError < FLT_MAX)
+			{
+				float LimitError = Target.MaxError * PositionScale;
+				LimitErrorSqr = LimitError * LimitError;
+			}
+
+			float MaxErrorSqr = Simplifier.Simplify(NumVerts, TargetNumTris, LimitErrorSqr);
+
+			if (Simplifier.GetRemainingNumTris() == 0 || Simplifier.GetRemainingNumTris() == NumTris)
+				return {};
+
+			std::vector<uint32> LocalVerts;
+			Simplifier.GetRemainingVerts(LocalVerts);
+			Simplifier.Compact();
+
+			Output.Verts.resize(Simplifier.GetRemainingNumVerts() * VertSize);
+			Output.Indexes.resize(Simplifier.GetRemainingNumTris() * 3);
+
+			Output.SourceVerts.resize(LocalVerts.size());
+			for (size_t i = 0; i < LocalVerts.size(); i++)
+			{
+				Output.SourceVerts[i] = Source.SourceVerts[LocalVerts[i]];
+			}
+
+			float InvScale = 1.0f / PositionScale;
+			for (uint32 i = 0; i < Simplifier.GetRemainingNumVerts(); i++)
+			{
+				float* Vert = &Output.Verts[i * VertSize];
+				Vert[0] *= InvScale;
+				Vert[1] *= InvScale;
+				Vert[2] *= InvScale;
+			}
+
+			Output.Error = std::sqrt(MaxErrorSqr) * InvScale;
+			Output.BuildSeconds = sw.elapsed().count();
+
+			return Output;
+		}
+	}
+
+	std::vector<FMeshLodReport> BuildMeshLods(MeshAsset& Mesh, white::span<const FMeshLodTarget> Targets)
+	{
+		std::vector<FMeshLodReport> Reports;
+
+		auto& SubMeshes = Mesh.GetSubMeshDescesRef();
+		if (Targets.empty() || SubMeshes.empty())
+			return Reports;
+
+		spdlog::stopwatch sw;
+
+		const FVertexLayout Layout = GetVertexLayout(Mesh);
+		wconstraint(Layout.PositionStream >= 0);
+
+		const int32 NumSubMeshes = static_cast<int32>(SubMeshes.size());
+		const int32 NumLods = static_cast<int32>(Targets.size());
+
+		std::vector<FSubMeshSource> Sources(NumSubMeshes);
+		ParallelFor(NumSubMeshes,
+			[&](int32 SubMeshIndex)
+			{
+				Sources[SubMeshIndex] = GatherSubMesh(Mesh, Layout, SubMeshes[SubMeshIndex].LodsDescription[0]);
+			});
+
+		std::vector<FLodOutput> Outputs(NumSubMeshes * NumLods);
+		ParallelFor(NumSubMeshes * NumLods,
+			[&](int32 JobIndex)
+			{
+				Outputs[JobIndex] = SimplifyLod(Sources[JobIndex / NumLods], Layout, Targets[JobIndex % NumLods]);
+			});
+
+		Sources.clear();
+
+		const uint32 VertexCount = Mesh.GetVertexCount();
+		const uint32 IndexCount = Mesh.GetIndexCount();
+
+		// Only the lod0 ranges survive, lods of an earlier build are dropped. Ranges stay contiguous, so indices relative to VertexBase hold.
+		std::vector<uint32> VertexRemap(VertexCount + 1, 0);
+		std::vector<uint32> IndexRemap(IndexCount + 1, 0);
+		for (auto& SubMesh : SubMeshes)
+		{
+			auto& Lod0 = SubMesh.LodsDescription[0];
+
+			uint32 VertexEnd = Lod0.VertexBase + Lod0.VertexNum;
+			for (uint32 i = 0; i < Lod0.IndexNum; i++)
+			{
+				VertexEnd = std::max(VertexEnd, Lod0.VertexBase + ReadIndex(Mesh, Lod0.IndexBase + i) + 1);
+			}
+
+			std::fill(VertexRemap.begin() + Lod0.VertexBase, VertexRemap.begin() + std::min(VertexEnd, VertexCount), 1);
+			std::fill(IndexRemap.begin() + Lod0.IndexBase, IndexRemap.begin() + Lod0.IndexBase + Lod0.IndexNum, 1);
+		}
+
+		// Flags to exclusive prefix sums, the new position of every kept element.
+		auto PrefixSum = [](std::vector<uint32>& Remap)
+		{
+			uint32 Sum = 0;
+			for (uint32& Value : Remap)
+			{
+				Sum += std::exchange(Value, Sum);
+			}
+		};
+		PrefixSum(VertexRemap);
+		PrefixSum(IndexRemap);
+
+		const uint32 KeptVertexCount = VertexRemap[VertexCount];
+		const uint32 KeptIndexCount = IndexRemap[IndexCount];
+
+		uint32 NewVertexCount = KeptVertexCount;
+		uint32 NewIndexCount = KeptIndexCount;
+		for (auto& Output : Outputs)
+		{
+			NewVertexCount += static_cast<uint32>(Output.SourceVerts.size());
+			NewIndexCount += static_cast<uint32>(Output.Indexes.size());
+		}
+
+		auto& Elements = Mesh.GetVertexElements();
+		auto& Streams = Mesh.GetVertexStreamsRef();
+
+		std::vector<std::unique_ptr<byte[]>> NewStreams(Elements.size());
+		for (size_t i = 0; i < Elements.size(); ++i)
+		{
+			const size_t ElementSize = Elements[i].GetElementSize();
+			NewStreams[i] = std::make_unique<byte[]>(ElementSize * NewVertexCount);
+			for (uint32 Vertex = 0; Vertex < VertexCount; ++Vertex)
+			{
+				if (VertexRemap[Vertex] != VertexRemap[Vertex + 1])
+					std::memcpy(NewStreams[i].get() + ElementSize * VertexRemap[Vertex], Streams[i].get() + ElementSize * Vertex, ElementSize);
+			}
+		}
+
+		// The geometry section stores counts and bases in the index format, 16 bits can't address the appended lods.
+		const EFormat IndexFormat = Mesh.GetIndexFormat() == EF_R16UI && std::max(NewVertexCount, NewIndexCount) > 0xFFFF ? EF_R32UI : Mesh.GetIndexFormat();
+
+		const size_t IndexSize = NumFormatBytes(IndexFormat);
+		auto NewIndexStream = std::make_unique<byte[]>(IndexSize * NewIndexCount);
+		if (IndexFormat != Mesh.GetIndexFormat())
+			spdlog::info("Mesh lods promote the index format to 32 bits, verts: {}, indices: {}", NewVertexCount, NewIndexCount);
+		for (uint32 i = 0; i < IndexCount; ++i)
+		{
+			if (IndexRemap[i] == IndexRemap[i + 1])
+				continue;
+			if (IndexFormat == EF_R16UI)
+				reinterpret_cast<uint16*>(NewIndexStream.get())[IndexRemap[i]] = static_cast<uint16>(ReadIndex(Mesh, i));
+			else
+				reinterpret_cast<uint32*>(NewIndexStream.get())[IndexRemap[i]] = ReadIndex(Mesh, i);
+		}
+
+		const uint32 VertSize = 3 + Layout.GetNumAttributes();
+		const uint32 TexCoordOffset = 3 + (Layout.NormalStream >= 0 ? 3 : 0);
+
+		uint32 VertexBase = KeptVertexCount;
+		uint32 IndexBase = KeptIndexCount;
+		for (int32 SubMeshIndex = 0; SubMeshIndex < NumSubMeshes; ++SubMeshIndex)
+		{
+			auto& LodsDescription = SubMeshes[SubMeshIndex].LodsDescription;
+			LodsDescription.resize(1);
+			LodsDescription[0].VertexBase = VertexRemap[LodsDescription[0].VertexBase];
+			LodsDescription[0].IndexBase = IndexRemap[LodsDescription[0].IndexBase];
+
+			float PrevError = 0.0f;
+			for (int32 LodIndex = 0; LodIndex < NumLods; ++LodIndex)
+			{
+				auto& Output = Outputs[SubMeshIndex * NumLods + LodIndex];
+
+				FMeshLodReport Report;
+				Report.SubMeshIndex = SubMeshIndex;
+				Report.LodIndex = LodIndex + 1;
+				Report.BuildSeconds = Output.BuildSeconds;
+
+				if (Output.Indexes.empty())
+				{
+					// Target does not reduce, keep drawing the previous lod.
+					LodsDescription.emplace_back(LodsDescription.back());
+					Report.Error = PrevError;
+				}
+				else
+				{
+					const uint32 NumVerts = static_cast<uint32>(Output.SourceVerts.size());
+					for (uint32 i = 0; i < NumVerts; ++i)
+					{
+						const float* Vert = &Output.Verts[i * VertSize];
+						for (int32 StreamIndex = 0; StreamIndex < static_cast<int32>(Elements.size()); ++StreamIndex)
+						{
+							const size_t ElementSize = Elements[StreamIndex].GetElementSize();
+							byte* Dst = NewStreams[StreamIndex].get() + ElementSize * (VertexBase + i);
+
+							// Elements which are not simplified keep the surviving source vertex.
+							std::memcpy(Dst, Streams[StreamIndex].get() + ElementSize * Output.SourceVerts[i], ElementSize);
+
+							if (StreamIndex == Layout.PositionStream)
+								std::memcpy(Dst, Vert, 3 * sizeof(float));
+							else if (StreamIndex == Layout.NormalStream)
+								std::memcpy(Dst, Vert + 3, 3 * sizeof(float));
+						}
+						for (size_t UVIndex = 0; UVIndex < Layout.TexCoordStreams.size(); ++UVIndex)
+						{
+							const int32 StreamIndex = Layout.TexCoordStreams[UVIndex];
+							std::memcpy(NewStreams[StreamIndex].get() + Elements[StreamIndex].GetElementSize() * (VertexBase + i),
+								Vert + TexCoordOffset + 2 * UVIndex, 2 * sizeof(float));
+						}
+					}
+
+					const uint32 NumIndexes = static_cast<uint32>(Output.Indexes.size());
+					for (uint32 i = 0; i < NumIndexes; ++i)
+					{
+						if (IndexFormat == EF_R16UI)
+							reinterpret_cast<uint16*>(NewIndexStream.get())[IndexBase + i] = static_cast<uint16>(Output.Indexes[i]);
+						else
+							reinterpret_cast<uint32*>(NewIndexStream.get())[IndexBase + i] = Output.Indexes[i];
+					}
+
+					MeshAsset::SubMeshDescrption::LodDescription Lod;
+					Lod.VertexNum = NumVerts;
+					Lod.VertexBase = VertexBase;
+					Lod.IndexNum = NumIndexes;
+					Lod.IndexBase = IndexBase;
+					LodsDescription.emplace_back(Lod);
+
+					VertexBase += NumVerts;
+					IndexBase += NumIndexes;
+
+					Report.Error = Output.Error;
+					PrevError = Output.Error;
+				}
+
+				Report.NumVerts = LodsDescription.back().VertexNum;
+				Report.NumTris = LodsDescription.back().IndexNum / 3;
+
+				spdlog::info("Lod {} of submesh {} [{}s], tris: {} -> {}, error: {}", Report.LodIndex, SubMeshIndex,
+					Report.BuildSeconds, LodsDescription[0].IndexNum / 3, Report.NumTris, Report.Error);
+
+				Reports.emplace_back(Report);
+			}
+		}
+
+		Streams = std::move(NewStreams);
+		Mesh.GetIndexStreamsRef() = std::move(NewIndexStream);
+		Mesh.SetIndexFormat(IndexFormat);
+		Mesh.SetVertexCount(NewVertexCount);
+		Mesh.SetIndexCount(NewIndexCount);
+
+		spdlog::info("Mesh lods [{}s], submeshes: {}, lods: {}, verts: {} -> {}", sw, NumSubMeshes, NumLods, VertexCount, NewVertexCount);
+
+		return Reports;
+	}
+}
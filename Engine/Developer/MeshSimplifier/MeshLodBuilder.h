@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "Asset/MeshAsset.h"
+#include <WBase/span.hpp>
+#include <cfloat>
+#include <vector>
+
+namespace WhiteEngine
+{
+	struct FMeshLodTarget
+	{
+		// Fraction of lod0 triangles to keep.
+		float TriangleRatio = 1.0f;
+		// Max deviation in mesh units, simplification stops early once exceeded.
+		float MaxError = FLT_MAX;
+	};
+
+	struct FMeshLodReport
+	{
+		uint32 SubMeshIndex;
+		uint32 LodIndex;
+		uint32 NumVerts;
+		uint32 NumTris;
+		float Error;
+		double BuildSeconds;
+	};
+
+	/**
+	 * Simplify lod0 of every submesh towards each target, submeshes and lods are built in parallel.
+	 * The asset streams are rebuilt from the lod0 ranges followed by the simplified vertices and indices, whose ranges go to
+	 * LodsDescription with indices relative to VertexBase as in the geometry section. Lods beyond lod0 are replaced and
+	 * their geometry dropped, so lod0 ranges may move.
+	 * Float normals and texcoords are simplified as attributes, other elements copy the surviving source vertex.
+	 * A 16 bit index format is promoted to 32 bits once the vertex or index count no longer fits in 16 bits.
+	 */
+	std::vector<FMeshLodReport> BuildMeshLods(asset::MeshAsset& Mesh, white::span<const FMeshLodTarget> Targets);
+}
@@ -1,6 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MeshSimplify.h"
+#include "Runtime/ParallelFor.h"
+#include <atomic>
+#include <thread>
 #if WB_IMPL_MSCPP
 #pragma warning(disable:4267)
 #endif
@@ -284,7 +287,7 @@ void FMeshSimplifier::GetBoundaryUnlocked( white::TBitArray<>& UnlockedBoundaryE
 	wconstraint( OutputEdgeIndex == RemainingNumTris * 3 );
 }
 
-void FMeshSimplifier::GatherAdjTris( const wm::float3& Position, uint32 Flag, std::vector< uint32>& AdjTris, int32& VertDegree, uint32& FlagsUnion )
+void FMeshSimplifier::GatherAdjTris( const wm::float3& Position, uint32 Flag, FMergeScratch& Scratch, int32& VertDegree, uint32& FlagsUnion ) const
 {
 	struct FWedgeVert
 	{
@@ -294,34 +297,26 @@ void FMeshSimplifier::GatherAdjTris( const wm::float3& Position, uint32 Flag, st
 	std::vector< FWedgeVert > WedgeVerts;
 
 	ForAllCorners( Position,
-		[ this, &AdjTris, &WedgeVerts, &VertDegree, Flag, &FlagsUnion ]( uint32 Corner )
+		[ this, &Scratch, &WedgeVerts, &VertDegree, Flag, &FlagsUnion ]( uint32 Corner )
 		{
 			VertDegree++;
 			
-			{
-				uint8& wrestrict CornerFlag = CornerFlags[ Corner ];
-				FlagsUnion |= CornerFlag;
-				CornerFlag |= Flag;
-			}
+			FlagsUnion |= CornerFlags[ Corner ];
 			
 			uint32 TriIndex = Corner / 3;
-			uint32 AdjTriIndex;
-			bool bNewTri = true;
+			bool bNewTri = false;
 			
-			uint8& wrestrict FirstCornerFlag = CornerFlags[ TriIndex * 3 ];
-			if( ( FirstCornerFlag & TriMask ) == 0 )
-			{
-				FirstCornerFlag |= TriMask;
-				AdjTriIndex = AdjTris.size();
-				AdjTris.emplace_back(TriIndex);
-				WedgeDisjointSet.AddDefaulted();
-			}
-			else
+			// Merge flags are kept in the scratch instead of in CornerFlags so concurrent evaluations don't race.
+			uint32& AdjTriIndex = Scratch.AdjTriSlots[ TriIndex ];
+			if( AdjTriIndex >= Scratch.AdjTris.size() || Scratch.AdjTris[ AdjTriIndex ] != TriIndex )
 			{
-				// Should only happen 2 times per collapse on average
-				AdjTriIndex = white::find_index(AdjTris, TriIndex );
-				bNewTri = false;
+				AdjTriIndex = Scratch.AdjTris.size();
+				Scratch.AdjTris.emplace_back(TriIndex);
+				Scratch.AdjCornerFlags.resize( Scratch.AdjCornerFlags.size() + 3 );
+				Scratch.WedgeDisjointSet.AddDefaulted();
+				bNewTri = true;
 			}
+			Scratch.AdjCornerFlags[ AdjTriIndex * 3 + Corner % 3 ] |= Flag;
 
 			uint32 VertIndex = Indexes[ Corner ];
 			uint32 OtherAdjTriIndex = ~0u;
@@ -340,29 +335,34 @@ void FMeshSimplifier::GatherAdjTris( const wm::float3& Position, uint32 Flag, st
 			else
 			{
 				if( bNewTri )
-					WedgeDisjointSet.UnionSequential( AdjTriIndex, OtherAdjTriIndex );
+					Scratch.WedgeDisjointSet.UnionSequential( AdjTriIndex, OtherAdjTriIndex );
 				else
-					WedgeDisjointSet.Union( AdjTriIndex, OtherAdjTriIndex );
+					Scratch.WedgeDisjointSet.Union( AdjTriIndex, OtherAdjTriIndex );
 			}
 		} );
 }
 
-float FMeshSimplifier::EvaluateMerge( const wm::float3& Position0, const wm::float3& Position1, bool bMoveVerts )
+float FMeshSimplifier::EvaluateMerge( const wm::float3& Position0, const wm::float3& Position1, bool bMoveVerts, FMergeScratch& Scratch )
 {
 	wconstraint( Position0 != Position1 );
 
 	// Find unique adjacent triangles
-	std::vector< uint32> AdjTris;
+	std::vector< uint32>& AdjTris = Scratch.AdjTris;
+	std::vector< uint8 >& AdjCornerFlags = Scratch.AdjCornerFlags;
+	white::FDisjointSet& WedgeDisjointSet = Scratch.WedgeDisjointSet;
 
+	AdjTris.clear();
+	AdjCornerFlags.clear();
 	WedgeDisjointSet.Reset();
+	Scratch.AdjTriSlots.resize( NumTris );
 
 	int32 VertDegree = 0;
 
 	uint32 FlagsUnion0 = 0;
 	uint32 FlagsUnion1 = 0;
 
-	GatherAdjTris( Position0, 1, AdjTris, VertDegree, FlagsUnion0 );
-	GatherAdjTris( Position1, 2, AdjTris, VertDegree, FlagsUnion1 );
+	GatherAdjTris( Position0, 1, Scratch, VertDegree, FlagsUnion0 );
+	GatherAdjTris( Position1, 2, Scratch, VertDegree, FlagsUnion1 );
 
 	if( VertDegree == 0 )
 	{
@@ -435,8 +435,11 @@ float FMeshSimplifier::EvaluateMerge( const wm::float3& Position0, const wm::flo
 	FQuadric EdgeQuadric;
 	EdgeQuadric.Zero();
 
-	for( uint32 TriIndex : AdjTris )
+	for( uint32 AdjTriIndex = 0, Num = AdjTris.size(); AdjTriIndex < Num; AdjTriIndex++ )
 	{
+		uint32 TriIndex = AdjTris[ AdjTriIndex ];
+		const uint8* TriCornerFlags = &AdjCornerFlags[ AdjTriIndex * 3 ];
+
 		for( uint32 CornerIndex = 0; CornerIndex < 3; CornerIndex++ )
 		{
 			uint32 Corner = TriIndex * 3 + CornerIndex;
@@ -450,8 +453,8 @@ float FMeshSimplifier::EvaluateMerge( const wm::float3& Position0, const wm::flo
 			{
 				// Only if edge is part of this pair
 				uint32 EdgeFlags;
-				EdgeFlags  = CornerFlags[ Corner ];
-				EdgeFlags |= CornerFlags[ TriIndex * 3 + ( ( 1 << CornerIndex ) & 3 ) ];
+				EdgeFlags  = TriCornerFlags[ CornerIndex ];
+				EdgeFlags |= TriCornerFlags[ ( 1 << CornerIndex ) & 3 ];
 				if( EdgeFlags & MergeMask )
 				{
 #if SIMP_REBASE
@@ -470,15 +473,15 @@ float FMeshSimplifier::EvaluateMerge( const wm::float3& Position0, const wm::flo
 	QuadricOptimizer.AddQuadric( EdgeQuadric );
 	
 	auto IsValidPosition =
-		[ this, &AdjTris, &BoundsMin, &BoundsMax ]( const wm::float3& Position ) -> bool
+		[ this, &AdjTris, &AdjCornerFlags, &BoundsMin, &BoundsMax ]( const wm::float3& Position ) -> bool
 		{
 			// Limit position to be near the neighborhood bounds
 			if( ComputeSquaredDistanceFromBoxToPoint( BoundsMin, BoundsMax, Position ) > wm::length_sq( BoundsMax - BoundsMin ) * 4.0f )
 				return false;
 
-			for( uint32 TriIndex : AdjTris )
+			for( uint32 AdjTriIndex = 0, Num = AdjTris.size(); AdjTriIndex < Num; AdjTriIndex++ )
 			{
-				if( TriWillInvert( TriIndex, Position ) )
+				if( TriWillInvert( AdjTris[ AdjTriIndex ], &AdjCornerFlags[ AdjTriIndex * 3 ], Position ) )
 					return false;
 			}
 
@@ -549,7 +552,7 @@ float FMeshSimplifier::EvaluateMerge( const wm::float3& Position0, const wm::flo
 	}
 
 	int32 NumWedges = WedgeIDs.size();
-	WedgeAttributes.clear();
+	std::vector< float >& WedgeAttributes = Scratch.WedgeAttributes;
 	WedgeAttributes.resize( NumWedges * NumAttributes );
 
 	float Error = 0.0f;
@@ -677,6 +680,7 @@ float FMeshSimplifier::EvaluateMerge( const wm::float3& Position0, const wm::flo
 					// IsPresent used to mark Pairs we have already added to the list.
 					if( PairHeap.IsPresent( PairIndex ) )
 					{
+						TraceHeap( white::FBinaryHeapTraceOp::Remove, PairIndex );
 						PairHeap.Remove( PairIndex );
 						ReevaluatePairs.emplace_back( PairIndex );
 					}
@@ -693,17 +697,14 @@ float FMeshSimplifier::EvaluateMerge( const wm::float3& Position0, const wm::flo
 		Error += Penalty;
 	}
 
-	for( uint32 TriIndex : AdjTris )
+	if( bMoveVerts )
 	{
-		for( uint32 CornerIndex = 0; CornerIndex < 3; CornerIndex++ )
+		for( uint32 TriIndex : AdjTris )
 		{
-			uint32 Corner = TriIndex * 3 + CornerIndex;
-
-			if( bMoveVerts )
-				CalcEdgeQuadric( Corner );
-
-			// Clear flags
-			CornerFlags[ Corner ] &= ~( MergeMask | TriMask );
+			for( uint32 CornerIndex = 0; CornerIndex < 3; CornerIndex++ )
+			{
+				CalcEdgeQuadric( TriIndex * 3 + CornerIndex );
+			}
 		}
 	}
 
@@ -759,6 +760,7 @@ void FMeshSimplifier::EndMovePositions()
 		if( Pair.Position0 == Pair.Position1 || !AddUniquePair( Pair, PairIndex ) )
 		{
 			// Found invalid or duplicate pair
+			TraceHeap( white::FBinaryHeapTraceOp::Remove, PairIndex );
 			PairHeap.Remove( PairIndex );
 		}
 	}
@@ -768,14 +770,12 @@ void FMeshSimplifier::EndMovePositions()
 	MovedPairs.clear();
 }
 
-bool FMeshSimplifier::TriWillInvert( uint32 TriIndex, const wm::float3& NewPosition )
+bool FMeshSimplifier::TriWillInvert( uint32 TriIndex, const uint8* TriCornerFlags, const wm::float3& NewPosition ) const
 {
 	uint32 IndexMoved = 3;
 	for( uint32 CornerIndex = 0; CornerIndex < 3; CornerIndex++ )
 	{
-		uint32 Corner = TriIndex * 3 + CornerIndex;
-
-		if( CornerFlags[ Corner ] & MergeMask )
+		if( TriCornerFlags[ CornerIndex ] & MergeMask )
 		{
 			if( IndexMoved == 3 )
 				IndexMoved = CornerIndex;
@@ -927,40 +927,87 @@ void FMeshSimplifier::RemoveDuplicateVerts( uint32 Corner )
 	}
 }
 
-float FMeshSimplifier::Simplify( uint32 TargetNumVerts, uint32 TargetNumTris )
+float FMeshSimplifier::Simplify( uint32 TargetNumVerts, uint32 TargetNumTris, float LimitErrorSqr )
 {
 	wconstraint( TargetNumVerts < NumVerts || TargetNumTris < NumTris );
 
 	const uint32 QuadricSize = sizeof( FQuadricAttr ) + NumAttributes * 4 * sizeof( QScalar );
 
 	TriQuadrics.resize(TriQuadrics.size()+ NumTris * QuadricSize );
-	for( uint32 TriIndex = 0; TriIndex < NumTris; TriIndex++ )
-	{
-		CalcTriQuadric( TriIndex );
-	}
+	WhiteEngine::ParallelFor( NumTris,
+		[ this ]( int32 TriIndex )
+		{
+			CalcTriQuadric( TriIndex );
+		} );
 
-	for( uint32 i = 0; i < NumIndexes; i++ )
-	{
-		CalcEdgeQuadric(i);
-	}
+	// Batches cover whole words of EdgeQuadricsValid so no two tasks write the same word.
+	constexpr uint32 EdgeBatchSize = 1024;
+	WhiteEngine::ParallelFor( wm::DivideAndRoundUp( NumIndexes, EdgeBatchSize ),
+		[ this, EdgeBatchSize ]( int32 BatchIndex )
+		{
+			uint32 FirstEdge = BatchIndex * EdgeBatchSize;
+			uint32 LastEdge = std::min( FirstEdge + EdgeBatchSize, NumIndexes );
+			for( uint32 i = FirstEdge; i < LastEdge; i++ )
+			{
+				CalcEdgeQuadric(i);
+			}
+		} );
 
-	// Initialize heap
-	PairHeap.Resize( Pairs.size(), Pairs.size() );
-	
-	for( uint32 PairIndex = 0, Num = Pairs.size(); PairIndex < Num; PairIndex++ )
-	{
-		FPair& Pair = Pairs[ PairIndex ];
+	// Initialize heap. Evaluation without moving verts only reads the mesh, so pairs are costed
+	// in parallel and the heap is built in one pass. Results don't depend on the thread count.
+	// Each task owns a scratch and takes batches of pairs until none are left.
+	const uint32 NumPairs = Pairs.size();
+	std::vector< float > PairErrors( NumPairs );
+	std::vector< uint32 > PairIndexes( NumPairs );
+
+	constexpr uint32 PairBatchSize = 64;
+	const uint32 NumTasks = std::clamp( std::thread::hardware_concurrency(), 1u, wm::DivideAndRoundUp( std::max( NumPairs, 1u ), PairBatchSize ) );
+	MergeScratches.resize( NumTasks );
+
+	std::atomic< uint32 > NextPair = 0;
+	WhiteEngine::ParallelFor( NumTasks,
+		[ this, &PairErrors, &PairIndexes, &NextPair, NumPairs, PairBatchSize ]( int32 TaskIndex )
+		{
+			FMergeScratch& Scratch = MergeScratches[ TaskIndex ];
+			for( uint32 FirstPair = NextPair.fetch_add( PairBatchSize ); FirstPair < NumPairs; FirstPair = NextPair.fetch_add( PairBatchSize ) )
+			{
+				uint32 LastPair = std::min( FirstPair + PairBatchSize, NumPairs );
+				for( uint32 PairIndex = FirstPair; PairIndex < LastPair; PairIndex++ )
+				{
+					FPair& Pair = Pairs[ PairIndex ];
+
+					PairErrors[ PairIndex ] = EvaluateMerge( Pair.Position0, Pair.Position1, false, Scratch );
+					PairIndexes[ PairIndex ] = PairIndex;
+				}
+			}
+		} );
+
+	// Collapses are serial, only the first scratch stays
+	MergeScratches.resize( 1 );
+	FMergeScratch& Scratch = MergeScratches[0];
+
+	PairHeap.Resize( NumPairs, NumPairs );
+	PairHeap.Build( PairErrors.data(), PairIndexes.data(), NumPairs );
 
-		float MergeError = EvaluateMerge( Pair.Position0, Pair.Position1, false );
-		PairHeap.Add( MergeError, PairIndex );
+	for( uint32 PairIndex = 0; HeapTrace && PairIndex < NumPairs; PairIndex++ )
+	{
+		TraceHeap( white::FBinaryHeapTraceOp::Build, PairIndex, PairErrors[ PairIndex ] );
 	}
 
 	float MaxError = 0.0f;
+	bool bLimited = false;
 
 	while( PairHeap.Num() > 0 )
 	{
+		if( PairHeap.GetKey( PairHeap.Top() ) > LimitErrorSqr )
+		{
+			bLimited = true;
+			break;
+		}
+
 		{
 			uint32 PairIndex = PairHeap.Top();
+			TraceHeap( white::FBinaryHeapTraceOp::Pop, PairIndex );
 			PairHeap.Pop();
 
 			FPair& Pair = Pairs[ PairIndex ];
@@ -968,7 +1015,7 @@ float FMeshSimplifier::Simplify( uint32 TargetNumVerts, uint32 TargetNumTris )
 			PairHash0.Remove( HashPosition( Pair.Position0 ), PairIndex );
 			PairHash1.Remove( HashPosition( Pair.Position1 ), PairIndex );
 
-			float MergeError = EvaluateMerge( Pair.Position0, Pair.Position1, true );
+			float MergeError = EvaluateMerge( Pair.Position0, Pair.Position1, true, Scratch );
 			MaxError = std::max( MaxError, MergeError );
 		}
 
@@ -979,17 +1026,31 @@ float FMeshSimplifier::Simplify( uint32 TargetNumVerts, uint32 TargetNumTris )
 		{
 			FPair& Pair = Pairs[ PairIndex ];
 
-			float MergeError = EvaluateMerge( Pair.Position0, Pair.Position1, false );
+			float MergeError = EvaluateMerge( Pair.Position0, Pair.Position1, false, Scratch );
+			TraceHeap( white::FBinaryHeapTraceOp::Add, PairIndex, MergeError );
 			PairHeap.Add( MergeError, PairIndex );
 		}
 		ReevaluatePairs.clear();
 	}
 
-	wconstraint( RemainingNumVerts <= TargetNumVerts && RemainingNumTris <= TargetNumTris );
+	wconstraint( bLimited || ( RemainingNumVerts <= TargetNumVerts && RemainingNumTris <= TargetNumTris ) );
 	
 	return MaxError;
 }
 
+void FMeshSimplifier::GetRemainingVerts( std::vector< uint32 >& SourceVerts ) const
+{
+	SourceVerts.clear();
+	SourceVerts.reserve( RemainingNumVerts );
+	for( uint32 VertIndex = 0; VertIndex < NumVerts; VertIndex++ )
+	{
+		if( VertRefCount[ VertIndex ] > 0 )
+		{
+			SourceVerts.emplace_back( VertIndex );
+		}
+	}
+}
+
 void FMeshSimplifier::Compact()
 {
 	uint32 OutputVertIndex = 0;
@@ -14,28 +14,13 @@
 #include "Core/Container/HashTable.h"
 #include "Core/Container/BitArray.h"
 #include <unordered_set>
+#include <cfloat>
 #include "Core/Container/BinaryHeap.h"
+#include "Core/Container/BinaryHeapTrace.h"
 #include "Core/Container/DisjointSet.h"
 #include "Core/Math/BoxSphereBounds.h"
 
 
-inline uint32 HashPosition( const wm::float3& Position )
-{
-	union { float f; uint32 i; } x;
-	union { float f; uint32 i; } y;
-	union { float f; uint32 i; } z;
-
-	x.f = Position.x;
-	y.f = Position.y;
-	z.f = Position.z;
-
-	return Murmur32( {
-		Position.x == 0.0f ? 0u : x.i,
-		Position.y == 0.0f ? 0u : y.i,
-		Position.z == 0.0f ? 0u : z.i
-	} );
-}
-
 inline uint32 Cycle3( uint32 Value )
 {
 	uint32 ValueMod3 = Value % 3;
@@ -58,13 +43,19 @@ public:
 	void		SetAttributeWeights( const float* Weights )			{ AttributeWeights = Weights; }
 	void		SetEdgeWeight( float Weight )						{ EdgeWeight = Weight; }
 	void		SetCorrectAttributes( void (*Function)( float* ) )	{ CorrectAttributes = Function; }
+	// Records every PairHeap operation of Simplify, see Tools/HeapTraceBench.
+	void		SetHeapTrace( std::vector< white::FBinaryHeapTraceOp >* Trace )	{ HeapTrace = Trace; }
 
 	void	SetBoundaryLocked( const white::TBitArray<>& UnlockedBoundaryEdges );
 	void	GetBoundaryUnlocked(white::TBitArray<>& UnlockedBoundaryEdges );
 
-	float	Simplify( uint32 TargetNumVerts, uint32 TargetNumTris );
+	// Stops early once the cheapest collapse would exceed LimitErrorSqr.
+	float	Simplify( uint32 TargetNumVerts, uint32 TargetNumTris, float LimitErrorSqr = FLT_MAX );
 	void	Compact();
 
+	// Source index of each remaining vert in output order. Must be called before Compact.
+	void	GetRemainingVerts( std::vector< uint32 >& SourceVerts ) const;
+
 	uint32		GetRemainingNumVerts() const	{ return RemainingNumVerts; }
 	uint32		GetRemainingNumTris() const		{ return RemainingNumTris; }
 
@@ -105,7 +96,9 @@ protected:
 	std::vector< FPair >			Pairs;
 	white::FHashTable				PairHash0;
 	white::FHashTable				PairHash1;
-	white::FBinaryHeap< float >	PairHeap;
+	white::FBinaryHeap< float, uint32, 4 >	PairHeap;
+
+	std::vector< white::FBinaryHeapTraceOp >*	HeapTrace = nullptr;
 
 	std::vector< uint32 >	MovedVerts;
 	std::vector< uint32 >	MovedCorners;
@@ -119,17 +112,27 @@ protected:
 	std::vector< FEdgeQuadric >	EdgeQuadrics;
 	white::TBitArray<>				EdgeQuadricsValid;
 
-	std::vector< float > WedgeAttributes;
-	white::FDisjointSet	WedgeDisjointSet;
-
 	enum ECornerFlags
 	{
-		MergeMask		= 3,		// Merge position 0 or 1
-		TriMask			= (1 << 2),	// Has been added to AdjTris
+		MergeMask		= 3,		// Merge position 0 or 1, only set in the per evaluation flags
 		LockedVertMask	= (1 << 3),	// Vert is locked, disallowing position movement
 		LockedEdgeMask	= (1 << 4),	// Edge is locked, disallowing position movement
 	};
 
+	// Buffers of one EvaluateMerge, reused across calls. The collapse loop uses the first,
+	// the parallel initial costing one per task.
+	struct FMergeScratch
+	{
+		std::vector< uint32 >	AdjTris;
+		std::vector< uint8 >	AdjCornerFlags;		// MergeMask of each corner of AdjTris
+		// Stands in for the TriMask corner flag: TriIndex is in AdjTris if AdjTris[ AdjTriSlots[ TriIndex ] ] == TriIndex.
+		// Never cleared, stale slots fail the check.
+		std::vector< uint32 >	AdjTriSlots;
+		white::FDisjointSet		WedgeDisjointSet;
+		std::vector< float >	WedgeAttributes;
+	};
+	std::vector< FMergeScratch >	MergeScratches;
+
 protected:
 	wm::float3&		GetPosition( uint32 VertIndex );
 	const wm::float3&	GetPosition( uint32 VertIndex ) const;
@@ -146,7 +149,13 @@ protected:
 	template< typename FuncType >
 	void	ForAllPairs( const wm::float3& Position, FuncType&& Function ) const;
 
-	void	GatherAdjTris( const wm::float3& Position, uint32 Flag, std::vector< uint32>& AdjTris, int32& VertDegree, uint32& FlagUnion );
+	void	TraceHeap( white::FBinaryHeapTraceOp::EType Type, uint32 Index, float Key = 0.0f )
+	{
+		if( HeapTrace )
+			HeapTrace->push_back( { Type, Index, Key } );
+	}
+
+	void	GatherAdjTris( const wm::float3& Position, uint32 Flag, FMergeScratch& Scratch, int32& VertDegree, uint32& FlagUnion ) const;
 	bool	AddUniquePair( FPair& Pair, uint32 PairIndex );
 
 	void	CalcTriQuadric( uint32 TriIndex );
@@ -154,12 +163,12 @@ protected:
 
 	bool	IsBoundaryEdge( uint32 EdgeIndex ) const;
 
-	float	EvaluateMerge( const wm::float3& Position0, const wm::float3& Position1, bool bMoveVerts );
+	float	EvaluateMerge( const wm::float3& Position0, const wm::float3& Position1, bool bMoveVerts, FMergeScratch& Scratch );
 	
 	void	BeginMovePosition( const wm::float3& Position );
 	void	EndMovePositions();
 
-	bool	TriWillInvert( uint32 TriIndex, const wm::float3& NewPosition );
+	bool	TriWillInvert( uint32 TriIndex, const uint8* TriCornerFlags, const wm::float3& NewPosition ) const;
 
 	void	FixUpTri( uint32 TriIndex );
 	bool	IsDuplicateTri( uint32 TriIndex ) const;
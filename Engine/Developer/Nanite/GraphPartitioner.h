@@ -5,6 +5,7 @@
 #include "Runtime/Sorting.h"
 #include "Core/Container/DisjointSet.h"
 #include "Core/Math/PlatformMath.h"
+#include "Core/Math/VectorKernels.h"
 #include "Bounds.h"
 #include "metis.h"
 #include <atomic>
@@ -91,17 +92,21 @@ namespace WhiteEngine
 		SortedTo.resize(NumElements);
 
 		const bool bSingleThreaded = NumElements < 5000;
-		ParallelFor(NumElements,
-			[&](uint32 Index)
+
+		constexpr uint32 BatchSize = 1024;
+		const int32 NumBatches = wm::DivideAndRoundUp<int32>(NumElements, BatchSize);
+		ParallelFor(NumBatches,
+			[&](int32 BatchIndex)
 			{
-				auto Center = GetCenter(Index);
-				auto CenterLocal = (Center - Bounds.Min) / (Bounds.Max - Bounds.Min);
+				uint32 First = BatchIndex * BatchSize;
+				uint32 Num = std::min<uint32>(BatchSize, NumElements - First);
 
-				uint32 Morton;
-				Morton = wm::MortonCode3(CenterLocal.x * 1023);
-				Morton |= wm::MortonCode3(CenterLocal.y * 1023) << 1;
-				Morton |= wm::MortonCode3(CenterLocal.z * 1023) << 2;
-				SortKeys[Index] = Morton;
+				wm::float3 Centers[BatchSize];
+				for (uint32 i = 0; i < Num; i++)
+				{
+					Centers[i] = GetCenter(First + i);
+				}
+				wm::MortonEncode3(Centers, Num, Bounds.Min, Bounds.Max - Bounds.Min, &SortKeys[First]);
 			}, bSingleThreaded?ParallelForFlags::SingleThread:ParallelForFlags::None);
 
 		RadixSort32(SortedTo.data(), Indexes.data(), NumElements,
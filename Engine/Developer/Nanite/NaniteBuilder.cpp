@@ -7,6 +7,7 @@
 #include "Core/Container/HashTable.h"
 #include "Core/Container/DisjointSet.h"
 #include "Runtime/ParallelFor.h"
+#include "Core/Math/VectorKernels.h"
 #include "Developer/MeshSimplifier/MeshSimplify.h"
 
 #define NumBitsPerDWORD ((int32)32)
@@ -53,23 +54,47 @@ namespace Nanite
 
 		FHashTable EdgeHash(1 << wm::FloorLog2(Indexes.size()), Indexes.size());
 
-		ParallelFor(Indexes.size(),
-			[&](int32 EdgeIndex)
-			{
+		// Position hash of every corner and both directed edge hashes are computed once in batches and shared by the insert and match passes.
+		std::vector< uint32 > CornerHashes(Indexes.size());
+		std::vector< uint32 > NextCornerHashes(Indexes.size());
+		std::vector< uint32 > EdgeHashes(Indexes.size());
+		std::vector< uint32 > OppositeEdgeHashes(Indexes.size());
+		{
+			constexpr uint32 BatchSize = 4096;
+			const int32 NumBatches = wm::DivideAndRoundUp<int32>(Indexes.size(), BatchSize);
 
-				uint32 VertIndex0 = Indexes[EdgeIndex];
-				uint32 VertIndex1 = Indexes[Cycle3(EdgeIndex)];
+			ParallelFor(NumBatches,
+				[&](int32 BatchIndex)
+				{
+					uint32 First = BatchIndex * BatchSize;
+					uint32 Num = std::min<uint32>(BatchSize, Indexes.size() - First);
+					wm::HashPositions(&Verts[0].Position, sizeof(FStaticMeshBuildVertex), &Indexes[First], Num, &CornerHashes[First]);
+				});
 
-				const auto& Position0 = Verts[VertIndex0].Position;
-				const auto& Position1 = Verts[VertIndex1].Position;
+			ParallelFor(Indexes.size(),
+				[&](int32 EdgeIndex)
+				{
+					NextCornerHashes[EdgeIndex] = CornerHashes[Cycle3(EdgeIndex)];
+				});
 
-				uint32 Hash0 = HashPosition(Position0);
-				uint32 Hash1 = HashPosition(Position1);
-				uint32 Hash = Murmur32({ Hash0, Hash1 });
+			ParallelFor(NumBatches,
+				[&](int32 BatchIndex)
+				{
+					uint32 First = BatchIndex * BatchSize;
+					uint32 Num = std::min<uint32>(BatchSize, Indexes.size() - First);
+					wm::HashPairs(&CornerHashes[First], &NextCornerHashes[First], Num, &EdgeHashes[First]);
+					wm::HashPairs(&NextCornerHashes[First], &CornerHashes[First], Num, &OppositeEdgeHashes[First]);
+				});
+		}
 
-				EdgeHash.Add_Concurrent(Hash, EdgeIndex);
+		ParallelFor(Indexes.size(),
+			[&](int32 EdgeIndex)
+			{
+				EdgeHash.Add_Concurrent(EdgeHashes[EdgeIndex], EdgeIndex);
 			});
 
+		// Matching stays scalar: every edge walks a hash chain of its own length, which does not map to SIMD lanes.
+		// The cached hashes reject most candidates before vertex data is read, boundary bits are gathered a dword at a time.
 		const int32 NumDwords = wm::DivideAndRoundUp<int32>(BoundaryEdges.size(), NumBitsPerDWORD);
 
 		ParallelFor(NumDwords,
@@ -90,9 +115,9 @@ namespace Nanite
 					const auto& Position0 = Verts[VertIndex0].Position;
 					const auto& Position1 = Verts[VertIndex1].Position;
 
-					uint32 Hash0 = HashPosition(Position0);
-					uint32 Hash1 = HashPosition(Position1);
-					uint32 Hash = Murmur32({ Hash1, Hash0 });
+					uint32 Hash0 = CornerHashes[EdgeIndex];
+					uint32 Hash1 = NextCornerHashes[EdgeIndex];
+					uint32 Hash = OppositeEdgeHashes[EdgeIndex];
 
 					// Find edge with opposite direction that shares these 2 verts.
 					/*
@@ -106,6 +131,10 @@ namespace Nanite
 					uint32 FoundEdge = ~0u;
 					for (uint32 OtherEdgeIndex = EdgeHash.First(Hash); EdgeHash.IsValid(OtherEdgeIndex); OtherEdgeIndex = EdgeHash.Next(OtherEdgeIndex))
 					{
+						// Equal positions always have equal hashes, reject by cached hash before touching vertex data.
+						if (CornerHashes[OtherEdgeIndex] != Hash1 || NextCornerHashes[OtherEdgeIndex] != Hash0)
+							continue;
+
 						uint32 OtherVertIndex0 = Indexes[OtherEdgeIndex];
 						uint32 OtherVertIndex1 = Indexes[Cycle3(OtherEdgeIndex)];
 
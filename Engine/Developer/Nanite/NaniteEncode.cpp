@@ -2903,7 +2903,9 @@ namespace Nanite
 					PageResult.UncompressedSize = DataCopy.size();
 
 					int32 CompressedSize = PageResult.Data.size();
-					wconstraint(Compression::CompressMemory(NAME_LZ4, PageResult.Data.data(), CompressedSize, DataCopy.data(), DataCopy.size()));
+					// max level HC cost a lot for every page but gain little ratio
+					const bool bCompressed = Compression::CompressMemory(Compression::ECodec::LZ4HC, Compression::GetCodecInfo(Compression::ECodec::LZ4HC).DefaultLevel, PageResult.Data.data(), CompressedSize, DataCopy.data(), static_cast<int32>(DataCopy.size()));
+					wconstraint(bCompressed);
 
 					PageResult.Data.resize(CompressedSize, false);
 				}
@@ -0,0 +1,227 @@
+/*! \file Engine\NullRHI\Context.h
+\ingroup Engine
+\brief Headless render interface, records and counts what it is asked to do without a GPU.
+*/
+#ifndef WE_RENDER_NULL_Context_h
+#define WE_RENDER_NULL_Context_h 1
+
+#include "RenderInterface/IContext.h"
+#include "RenderInterface/ICommandContext.h"
+#include "RenderInterface/IFrameBuffer.h"
+#include "RenderInterface/IRayContext.h"
+#include "Resource.h"
+#include "Stats.h"
+#include <memory>
+#include <vector>
+
+namespace platform_ex::Null {
+
+	class DirectStorage : public platform_ex::DirectStorage {
+	public:
+		std::shared_ptr<DStorageFile> OpenFile(const fs::path& path) override;
+
+		// Memory requests are read synchronously so streaming code sees real data.
+		void EnqueueRequest(const DStorageFile2MemoryRequest& request) override;
+		void EnqueueRequest(const DStorageFile2GpuRequest& request) override;
+
+		std::shared_ptr<DStorageSyncPoint> SubmitUpload(DStorageQueueType type) override;
+	};
+
+	class Device : public platform::Render::Device {
+	public:
+		Texture1D* CreateTexture(uint16 width, uint8 num_mipmaps, uint8 array_size,
+			EFormat format, uint32 access, platform::Render::SampleDesc sample_info, ResourceCreateInfo init_data = {}) override;
+
+		Texture2D* CreateTexture(uint16 width, uint16 height, uint8 num_mipmaps, uint8 array_size,
+			EFormat format, uint32 access, platform::Render::SampleDesc sample_info, ResourceCreateInfo init_data = {}) override;
+
+		Texture3D* CreateTexture(const platform::Render::Texture3DInitializer& Initializer, ResourceCreateInfo init_data = {}) override;
+
+		TextureCube* CreateTextureCube(uint16 size, uint8 num_mipmaps, uint8 array_size,
+			EFormat format, uint32 access, platform::Render::SampleDesc sample_info, ResourceCreateInfo init_data = {}) override;
+
+		ShaderCompose* CreateShaderCompose(std::unordered_map<platform::Render::ShaderType, const asset::ShaderBlobAsset*> pShaderBlob, platform::Render::Effect::Effect* pEffect) override;
+
+		ConstantBuffer* CreateConstantBuffer(platform::Render::Buffer::Usage usage, uint32 size_in_byte, const void* init_data = nullptr) override;
+
+		GraphicsBuffer* CreateBuffer(platform::Render::Buffer::Usage usage, white::uint32 access, uint32 size_in_byte, uint32 stride, ResourceCreateInfo init_data = {}) override;
+
+		GraphicsBuffer* CreateVertexBuffer(platform::Render::Buffer::Usage usage, white::uint32 access, uint32 size_in_byte, EFormat format, ResourceCreateInfo init_data = {}) override;
+		GraphicsBuffer* CreateIndexBuffer(platform::Render::Buffer::Usage usage, white::uint32 access, uint32 size_in_byte, EFormat format, ResourceCreateInfo init_data = {}) override;
+
+		platform::Render::PipleState* CreatePipleState(const platform::Render::PipleState& state) override;
+
+		platform::Render::InputLayout* CreateInputLayout() override;
+
+		UnorderedAccessView* CreateUnorderedAccessView(platform::Render::Texture2D* InTexture) override;
+
+		GraphicsPipelineState* CreateGraphicsPipelineState(const platform::Render::GraphicsPipelineStateInitializer& initializer) override;
+		ComputePipelineState* CreateComputePipelineState(const platform::Render::ComputeHWShader* ComputeShader) override;
+
+		platform::Render::HardwareShader* CreateVertexShader(const white::span<const uint8>& Code) override;
+		platform::Render::HardwareShader* CreatePixelShader(const white::span<const uint8>& Code) override;
+		platform::Render::HardwareShader* CreateGeometryShader(const white::span<const uint8>& Code) override;
+		platform::Render::HardwareShader* CreateComputeShader(const white::span<const uint8>& Code) override;
+
+		platform::Render::SRVRIRef CreateShaderResourceView(const platform::Render::GraphicsBuffer* InBuffer, EFormat format = platform::Render::EF_Unknown) override;
+		platform::Render::UAVRIRef CreateUnorderedAccessView(const platform::Render::GraphicsBuffer* InBuffer, EFormat format = platform::Render::EF_Unknown) override;
+
+		CommandSignature* CreateCommandSignature(const platform::Render::CommandSignatureDesc& desc) override;
+
+		DirectStorage& GetDStorage() override;
+	private:
+		GraphicsBuffer* CreateBuffer(platform::Render::Buffer::Usage usage, white::uint32 access, uint32 size_in_byte, uint32 stride, EFormat format, const ResourceCreateInfo& init_data);
+
+		DirectStorage dstorage;
+	};
+
+	class FrameBuffer : public platform::Render::FrameBuffer {
+	public:
+		void Clear(white::uint32 flags, const white::math::float4& clr, float depth, white::int32 stencil) override;
+	};
+
+	class Display : public platform::Render::Display {
+	public:
+		Display(Device& device, const platform::Render::DisplaySetting& setting);
+
+		void SwapBuffers() override;
+		void WaitOnSwapBuffers() override;
+
+		const std::shared_ptr<FrameBuffer>& GetFrameBuffer() const { return frame_buffer; }
+	private:
+		std::shared_ptr<Texture2D> back_buffer;
+		std::shared_ptr<Texture2D> depth_stencil;
+		std::shared_ptr<FrameBuffer> frame_buffer;
+	};
+
+	/*
+	\brief Keeps the bound state the way a real context would, so redundant sets are filtered
+	and only actual changes are counted.
+	*/
+	class CommandContext : public platform::Render::CommandContext {
+	public:
+		void SetComputePipelineState(platform::Render::ComputePipelineState* ComputeState) override;
+
+		void DispatchComputeShader(uint32 ThreadGroupCountX, uint32 ThreadGroupCountY, uint32 ThreadGroupCountZ) override;
+
+		void SetShaderTexture(const platform::Render::ComputeHWShader* Shader, uint32 TextureIndex, platform::Render::Texture* Texture) override;
+
+		void SetShaderSampler(const platform::Render::ComputeHWShader* Shader, uint32 SamplerIndex, const platform::Render::TextureSampleDesc& Desc) override;
+
+		void SetUAVParameter(const platform::Render::ComputeHWShader* Shader, uint32 UAVIndex, platform::Render::UnorderedAccessView* UAV) override;
+
+		void SetUAVParameter(const platform::Render::ComputeHWShader* Shader, uint32 UAVIndex, platform::Render::UnorderedAccessView* UAV, uint32 InitialCount) override;
+
+		void SetShaderParameter(const platform::Render::ComputeHWShader* Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue) override;
+
+		void SetShaderResourceView(const platform::Render::ComputeHWShader* Shader, uint32 TextureIndex, platform::Render::ShaderResourceView* SRV) override;
+
+		void SetShaderConstantBuffer(const platform::Render::ComputeHWShader* Shader, uint32 BaseIndex, platform::Render::ConstantBuffer* Buffer) override;
+
+		void PushEvent(const char16_t* Name, platform::FColor Color) override;
+
+		void PopEvent() override;
+
+		void BeginRenderPass(const platform::Render::RenderPassInfo& Info, const char* Name) override;
+
+		void SetViewport(uint32 MinX, uint32 MinY, float MinZ, uint32 MaxX, uint32 MaxY, float MaxZ) override;
+
+		void SetScissorRect(bool bEnable, uint32 MinX, uint32 MinY, uint32 MaxX, uint32 MaxY) override;
+
+		void SetVertexBuffer(uint32 slot, platform::Render::GraphicsBuffer* VertexBuffer) override;
+		void SetIndexBuffer(platform::Render::GraphicsBuffer* IndexBuffer) override;
+
+		void SetGraphicsPipelineState(platform::Render::GraphicsPipelineState* pso) override;
+
+		void SetShaderSampler(platform::Render::VertexHWShader* Shader, uint32 SamplerIndex, const platform::Render::TextureSampleDesc& Desc) override;
+		void SetShaderSampler(platform::Render::PixelHWShader* Shader, uint32 SamplerIndex, const platform::Render::TextureSampleDesc& Desc) override;
+
+		void SetShaderTexture(platform::Render::VertexHWShader* Shader, uint32 TextureIndex, platform::Render::Texture* Texture) override;
+		void SetShaderTexture(platform::Render::PixelHWShader* Shader, uint32 TextureIndex, platform::Render::Texture* Texture) override;
+		void SetShaderResourceView(platform::Render::VertexHWShader* Shader, uint32 TextureIndex, platform::Render::ShaderResourceView* SRV) override;
+		void SetShaderResourceView(platform::Render::PixelHWShader* Shader, uint32 TextureIndex, platform::Render::ShaderResourceView* SRV) override;
+
+		void SetShaderConstantBuffer(platform::Render::VertexHWShader* Shader, uint32 BaseIndex, platform::Render::ConstantBuffer* Buffer) override;
+		void SetShaderConstantBuffer(platform::Render::PixelHWShader* Shader, uint32 BaseIndex, platform::Render::ConstantBuffer* Buffer) override;
+
+		void SetShaderParameter(platform::Render::VertexHWShader* Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue) override;
+		void SetShaderParameter(platform::Render::PixelHWShader* Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue) override;
+
+		void DrawIndexedPrimitive(platform::Render::GraphicsBuffer* IndexBuffer, int32 BaseVertexIndex, uint32 FirstInstance, uint32 NumVertices, uint32 StartIndex, uint32 NumPrimitives, uint32 NumInstances) override;
+
+		void DrawPrimitive(uint32 BaseVertexIndex, uint32 FirstInstance, uint32 NumPrimitives, uint32 NumInstances) override;
+
+		void DrawIndirect(platform::Render::CommandSignature* Sig, uint32 MaxCmdCount, platform::Render::GraphicsBuffer* IndirectBuffer, uint32 BufferOffset, platform::Render::GraphicsBuffer* CountBuffer, uint32 CountBufferOffset) override;
+
+		void BeginFrame() override;
+
+		void EndFrame() override;
+
+	private:
+		template<typename T>
+		void SetState(T& Current, T New)
+		{
+			Count(GetStats().Commands);
+			if (Current != New)
+			{
+				Current = New;
+				Count(GetStats().StateChanges);
+			}
+		}
+
+		platform::Render::GraphicsPipelineState* GraphicsPSO = nullptr;
+		platform::Render::ComputePipelineState* ComputePSO = nullptr;
+		platform::Render::GraphicsBuffer* IndexBuffer = nullptr;
+		static constexpr uint32 MaxVertexStreams = 16;
+		platform::Render::GraphicsBuffer* VertexBuffers[MaxVertexStreams] = {};
+
+		struct Rect
+		{
+			uint32 MinX = 0, MinY = 0, MaxX = 0, MaxY = 0;
+
+			friend bool operator==(const Rect&, const Rect&) = default;
+		};
+		Rect Viewport;
+		Rect Scissor;
+
+		uint32 EventDepth = 0;
+	};
+
+	class Context : public platform::Render::Context {
+	public:
+		Device& GetDevice() override;
+
+		Display& GetDisplay() override;
+
+		platform::Render::RayContext& GetRayContext() override;
+
+		void Render(platform::Render::CommandList& CmdList, const platform::Render::Effect::Effect& effect, const platform::Render::Effect::Technique& tech, const platform::Render::InputLayout& layout) override;
+
+		void BeginFrame() override;
+
+		CommandContext* GetDefaultCommandContext() override;
+
+		void AdvanceFrameFence() override;
+		void AdvanceDisplayBuffer() override;
+
+		CommandContext* ObtainParallelCommandContext() override;
+		void SubmitParallelCommandContexts(white::span<platform::Render::CommandContext* const> Contexts) override;
+	public:
+		void CreateDeviceAndDisplay(platform::Render::DisplaySetting setting) override;
+	private:
+		void DoBindFrameBuffer(const std::shared_ptr<platform::Render::FrameBuffer>&) override;
+	public:
+		static Context& Instance();
+	private:
+		Context() = default;
+
+		std::shared_ptr<Device> device;
+		std::shared_ptr<Display> display;
+		CommandContext command_context;
+
+		std::vector<std::unique_ptr<CommandContext>> parallel_contexts;
+		std::vector<CommandContext*> free_parallel_contexts;
+	};
+}
+
+#endif
@@ -0,0 +1,580 @@
+#include "Context.h"
+#include "RenderInterface/ICommandList.h"
+#include "RenderInterface/InputLayout.hpp"
+#include "RenderInterface/PipelineStateUtility.h"
+#include "RenderInterface/RenderResource.h"
+#include "RenderInterface/Effect/Effect.hpp"
+#include <WBase/exception_type.h>
+#include <fstream>
+
+namespace platform_ex::Null {
+	using namespace platform::Render;
+
+	void Stats::Reset()
+	{
+		for (auto* Counter : { &Commands, &Draws, &Dispatches, &StateChanges, &BytesUploaded,
+			&BuffersCreated, &TexturesCreated, &PipelineStatesCreated, &BytesAllocated })
+			Counter->store(0, std::memory_order_relaxed);
+	}
+
+	Stats& GetStats()
+	{
+		static Stats stats{};
+		return stats;
+	}
+
+	namespace
+	{
+		struct File : DStorageFile
+		{
+			File(const fs::path& InPath)
+				:DStorageFile(fs::file_size(InPath)), Path(InPath)
+			{}
+
+			fs::path Path;
+		};
+
+		struct ReadySyncPoint : DStorageSyncPoint
+		{
+			bool IsReady() const override
+			{
+				return true;
+			}
+
+			void Wait() override
+			{
+			}
+
+			void AwaitSuspend(std::coroutine_handle<> handle) override
+			{
+				handle.resume();
+			}
+		};
+	}
+
+	std::shared_ptr<DStorageFile> DirectStorage::OpenFile(const fs::path& path)
+	{
+		return std::make_shared<File>(path);
+	}
+
+	void DirectStorage::EnqueueRequest(const DStorageFile2MemoryRequest& request)
+	{
+		if (request.Compression != DStorageCompressionFormat::None)
+			throw white::unsupported();
+
+		auto& source = static_cast<const File&>(*request.File.Source);
+		std::ifstream stream(source.Path, std::ios::binary);
+		stream.seekg(request.File.Offset);
+		stream.read(reinterpret_cast<char*>(request.Memory.Buffer), request.File.Size);
+	}
+
+	void DirectStorage::EnqueueRequest(const DStorageFile2GpuRequest& request)
+	{
+		Count(GetStats().BytesUploaded, request.UncompressedSize);
+	}
+
+	std::shared_ptr<DStorageSyncPoint> DirectStorage::SubmitUpload(DStorageQueueType type)
+	{
+		return std::make_shared<ReadySyncPoint>();
+	}
+
+	Texture1D* Device::CreateTexture(uint16 width, uint8 num_mipmaps, uint8 array_size, EFormat format, uint32 access, SampleDesc sample_info, ResourceCreateInfo init_data)
+	{
+		auto texture = new Texture1D(width, num_mipmaps, array_size, format, access, sample_info);
+		if (!init_data.WithoutNativeResource)
+			texture->HWResourceCreate(init_data);
+		return texture;
+	}
+
+	Texture2D* Device::CreateTexture(uint16 width, uint16 height, uint8 num_mipmaps, uint8 array_size, EFormat format, uint32 access, SampleDesc sample_info, ResourceCreateInfo init_data)
+	{
+		auto texture = new Texture2D(width, height, num_mipmaps, array_size, format, access, sample_info);
+		if (!init_data.WithoutNativeResource)
+			texture->HWResourceCreate(init_data);
+		return texture;
+	}
+
+	Texture3D* Device::CreateTexture(const Texture3DInitializer& Initializer, ResourceCreateInfo init_data)
+	{
+		auto texture = new Texture3D(Initializer.Width, Initializer.Height, Initializer.Depth, Initializer.NumMipmaps, Initializer.ArraySize,
+			Initializer.Format, Initializer.Access, { Initializer.NumSamples, 0 });
+		if (!init_data.WithoutNativeResource)
+			texture->HWResourceCreate(init_data);
+		return texture;
+	}
+
+	TextureCube* Device::CreateTextureCube(uint16 size, uint8 num_mipmaps, uint8 array_size, EFormat format, uint32 access, SampleDesc sample_info, ResourceCreateInfo init_data)
+	{
+		auto texture = new TextureCube(size, num_mipmaps, array_size, format, access, sample_info);
+		if (!init_data.WithoutNativeResource)
+			texture->HWResourceCreate(init_data);
+		return texture;
+	}
+
+	ShaderCompose* Device::CreateShaderCompose(std::unordered_map<ShaderType, const asset::ShaderBlobAsset*> pShaderBlob, Effect::Effect* pEffect)
+	{
+		return new ShaderCompose();
+	}
+
+	ConstantBuffer* Device::CreateConstantBuffer(Buffer::Usage usage, uint32 size_in_byte, const void* init_data)
+	{
+		wconstraint(size_in_byte > 0);
+		auto buffer = new ConstantBuffer(size_in_byte);
+		if (init_data)
+			Count(GetStats().BytesUploaded, size_in_byte);
+		return buffer;
+	}
+
+	GraphicsBuffer* Device::CreateBuffer(Buffer::Usage usage, white::uint32 access, uint32 size_in_byte, uint32 stride, EFormat format, const ResourceCreateInfo& init_data)
+	{
+		auto buffer = new GraphicsBuffer(usage, access, size_in_byte, stride, format);
+		if (auto data = init_data.GetData())
+			buffer->UpdateSubresource(0, size_in_byte, data);
+		return buffer;
+	}
+
+	GraphicsBuffer* Device::CreateBuffer(Buffer::Usage usage, white::uint32 access, uint32 size_in_byte, uint32 stride, ResourceCreateInfo init_data)
+	{
+		return CreateBuffer(usage, access, size_in_byte, stride, EF_Unknown, init_data);
+	}
+
+	GraphicsBuffer* Device::CreateVertexBuffer(Buffer::Usage usage, white::uint32 access, uint32 size_in_byte, EFormat format, ResourceCreateInfo init_data)
+	{
+		return CreateBuffer(usage, access, size_in_byte, format == EF_Unknown ? 0 : NumFormatBytes(format), format, init_data);
+	}
+
+	GraphicsBuffer* Device::CreateIndexBuffer(Buffer::Usage usage, white::uint32 access, uint32 size_in_byte, EFormat format, ResourceCreateInfo init_data)
+	{
+		return CreateBuffer(usage, access, size_in_byte, NumFormatBytes(format), format, init_data);
+	}
+
+	PipleState* Device::CreatePipleState(const PipleState& state)
+	{
+		return new PipleState(state);
+	}
+
+	InputLayout* Device::CreateInputLayout()
+	{
+		return new InputLayout();
+	}
+
+	UnorderedAccessView* Device::CreateUnorderedAccessView(platform::Render::Texture2D* InTexture)
+	{
+		return new UnorderedAccessView(InTexture, InTexture->GetFormat());
+	}
+
+	GraphicsPipelineState* Device::CreateGraphicsPipelineState(const GraphicsPipelineStateInitializer& initializer)
+	{
+		Count(GetStats().PipelineStatesCreated);
+		return new GraphicsPipelineState(initializer);
+	}
+
+	ComputePipelineState* Device::CreateComputePipelineState(const ComputeHWShader* ComputeShader)
+	{
+		Count(GetStats().PipelineStatesCreated);
+		return new ComputePipelineState(ComputeShader);
+	}
+
+	platform::Render::HardwareShader* Device::CreateVertexShader(const white::span<const uint8>& Code)
+	{
+		return new HardwareShader<VertexHWShader>(Code);
+	}
+
+	platform::Render::HardwareShader* Device::CreatePixelShader(const white::span<const uint8>& Code)
+	{
+		return new HardwareShader<PixelHWShader>(Code);
+	}
+
+	platform::Render::HardwareShader* Device::CreateGeometryShader(const white::span<const uint8>& Code)
+	{
+		return new HardwareShader<GeometryHWShader>(Code);
+	}
+
+	platform::Render::HardwareShader* Device::CreateComputeShader(const white::span<const uint8>& Code)
+	{
+		return new HardwareShader<ComputeHWShader>(Code);
+	}
+
+	SRVRIRef Device::CreateShaderResourceView(const platform::Render::GraphicsBuffer* InBuffer, EFormat format)
+	{
+		return shared_raw_robject(new ShaderResourceView(InBuffer, format));
+	}
+
+	UAVRIRef Device::CreateUnorderedAccessView(const platform::Render::GraphicsBuffer* InBuffer, EFormat format)
+	{
+		return shared_raw_robject(new UnorderedAccessView(InBuffer, format));
+	}
+
+	CommandSignature* Device::CreateCommandSignature(const CommandSignatureDesc& desc)
+	{
+		return new CommandSignature(desc);
+	}
+
+	DirectStorage& Device::GetDStorage()
+	{
+		return dstorage;
+	}
+
+	void FrameBuffer::Clear(white::uint32 flags, const white::math::float4& clr, float depth, white::int32 stencil)
+	{
+		Count(GetStats().Commands);
+	}
+
+	Display::Display(Device& device, const DisplaySetting& setting)
+		:frame_buffer(std::make_shared<FrameBuffer>())
+	{
+		auto width = static_cast<uint16>(setting.screen_width);
+		auto height = static_cast<uint16>(setting.screen_height);
+		SampleDesc sample_info{ setting.sample_count, setting.sample_quality };
+
+		back_buffer = white::share_raw(device.CreateTexture(width, height, 1, 1, setting.color_format,
+			white::underlying(EAccessHint::RTV), sample_info, ResourceCreateInfo{ "backbuffer" }));
+
+		RenderTarget view;
+		view.Texture = back_buffer.get();
+		frame_buffer->Attach(platform::Render::FrameBuffer::Target0, view);
+
+		if (setting.depth_stencil_format != EF_Unknown) {
+			ResourceCreateInfo CreateInfo{ "Depth" };
+			CreateInfo.clear_value = &ClearValueBinding::DepthOne;
+			depth_stencil = white::share_raw(device.CreateTexture(width, height, 1, 1, setting.depth_stencil_format,
+				white::underlying(EAccessHint::DSV), sample_info, CreateInfo));
+
+			DepthRenderTarget depth_view;
+			depth_view.Texture = depth_stencil.get();
+			frame_buffer->Attach(platform::Render::FrameBuffer::DepthStencil, depth_view);
+		}
+	}
+
+	void Display::SwapBuffers()
+	{
+	}
+
+	void Display::WaitOnSwapBuffers()
+	{
+	}
+
+	void CommandContext::SetComputePipelineState(platform::Render::ComputePipelineState* ComputeState)
+	{
+		SetState(ComputePSO, ComputeState);
+	}
+
+	void CommandContext::DispatchComputeShader(uint32 ThreadGroupCountX, uint32 ThreadGroupCountY, uint32 ThreadGroupCountZ)
+	{
+		Count(GetStats().Commands);
+		Count(GetStats().Dispatches);
+	}
+
+	void CommandContext::SetShaderTexture(const ComputeHWShader* Shader, uint32 TextureIndex, platform::Render::Texture* Texture)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderSampler(const ComputeHWShader* Shader, uint32 SamplerIndex, const TextureSampleDesc& Desc)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetUAVParameter(const ComputeHWShader* Shader, uint32 UAVIndex, platform::Render::UnorderedAccessView* UAV)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetUAVParameter(const ComputeHWShader* Shader, uint32 UAVIndex, platform::Render::UnorderedAccessView* UAV, uint32 InitialCount)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderParameter(const ComputeHWShader* Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue)
+	{
+		Count(GetStats().Commands);
+		Count(GetStats().BytesUploaded, NumBytes);
+	}
+
+	void CommandContext::SetShaderResourceView(const ComputeHWShader* Shader, uint32 TextureIndex, platform::Render::ShaderResourceView* SRV)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderConstantBuffer(const ComputeHWShader* Shader, uint32 BaseIndex, platform::Render::ConstantBuffer* Buffer)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::PushEvent(const char16_t* Name, platform::FColor Color)
+	{
+		Count(GetStats().Commands);
+		++EventDepth;
+	}
+
+	void CommandContext::PopEvent()
+	{
+		Count(GetStats().Commands);
+		WAssert(EventDepth > 0, "PopEvent without PushEvent");
+		--EventDepth;
+	}
+
+	void CommandContext::BeginRenderPass(const RenderPassInfo& Info, const char* Name)
+	{
+		Count(GetStats().Commands);
+		Count(GetStats().StateChanges);
+	}
+
+	void CommandContext::SetViewport(uint32 MinX, uint32 MinY, float MinZ, uint32 MaxX, uint32 MaxY, float MaxZ)
+	{
+		SetState(Viewport, Rect{ MinX, MinY, MaxX, MaxY });
+	}
+
+	void CommandContext::SetScissorRect(bool bEnable, uint32 MinX, uint32 MinY, uint32 MaxX, uint32 MaxY)
+	{
+		SetState(Scissor, bEnable ? Rect{ MinX, MinY, MaxX, MaxY } : Viewport);
+	}
+
+	void CommandContext::SetVertexBuffer(uint32 slot, platform::Render::GraphicsBuffer* VertexBuffer)
+	{
+		WAssert(slot < MaxVertexStreams, "vertex stream slot out of range");
+		SetState(VertexBuffers[slot], VertexBuffer);
+	}
+
+	void CommandContext::SetIndexBuffer(platform::Render::GraphicsBuffer* InIndexBuffer)
+	{
+		SetState(IndexBuffer, InIndexBuffer);
+	}
+
+	void CommandContext::SetGraphicsPipelineState(platform::Render::GraphicsPipelineState* pso)
+	{
+		SetState(GraphicsPSO, pso);
+	}
+
+	void CommandContext::SetShaderSampler(VertexHWShader* Shader, uint32 SamplerIndex, const TextureSampleDesc& Desc)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderSampler(PixelHWShader* Shader, uint32 SamplerIndex, const TextureSampleDesc& Desc)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderTexture(VertexHWShader* Shader, uint32 TextureIndex, platform::Render::Texture* Texture)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderTexture(PixelHWShader* Shader, uint32 TextureIndex, platform::Render::Texture* Texture)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderResourceView(VertexHWShader* Shader, uint32 TextureIndex, platform::Render::ShaderResourceView* SRV)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderResourceView(PixelHWShader* Shader, uint32 TextureIndex, platform::Render::ShaderResourceView* SRV)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderConstantBuffer(VertexHWShader* Shader, uint32 BaseIndex, platform::Render::ConstantBuffer* Buffer)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderConstantBuffer(PixelHWShader* Shader, uint32 BaseIndex, platform::Render::ConstantBuffer* Buffer)
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::SetShaderParameter(VertexHWShader* Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue)
+	{
+		Count(GetStats().Commands);
+		Count(GetStats().BytesUploaded, NumBytes);
+	}
+
+	void CommandContext::SetShaderParameter(PixelHWShader* Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue)
+	{
+		Count(GetStats().Commands);
+		Count(GetStats().BytesUploaded, NumBytes);
+	}
+
+	void CommandContext::DrawIndexedPrimitive(platform::Render::GraphicsBuffer* InIndexBuffer, int32 BaseVertexIndex, uint32 FirstInstance, uint32 NumVertices, uint32 StartIndex, uint32 NumPrimitives, uint32 NumInstances)
+	{
+		SetIndexBuffer(InIndexBuffer);
+		Count(GetStats().Draws);
+	}
+
+	void CommandContext::DrawPrimitive(uint32 BaseVertexIndex, uint32 FirstInstance, uint32 NumPrimitives, uint32 NumInstances)
+	{
+		Count(GetStats().Commands);
+		Count(GetStats().Draws);
+	}
+
+	void CommandContext::DrawIndirect(platform::Render::CommandSignature* Sig, uint32 MaxCmdCount, platform::Render::GraphicsBuffer* IndirectBuffer, uint32 BufferOffset, platform::Render::GraphicsBuffer* CountBuffer, uint32 CountBufferOffset)
+	{
+		Count(GetStats().Commands);
+		Count(GetStats().Draws);
+	}
+
+	void CommandContext::BeginFrame()
+	{
+		Count(GetStats().Commands);
+	}
+
+	void CommandContext::EndFrame()
+	{
+		Count(GetStats().Commands);
+
+		// Nothing survives a frame on a real context either.
+		GraphicsPSO = nullptr;
+		ComputePSO = nullptr;
+		IndexBuffer = nullptr;
+		std::fill(std::begin(VertexBuffers), std::end(VertexBuffers), nullptr);
+		Viewport = {};
+		Scissor = {};
+
+		RObject::FlushPendingDeletes();
+	}
+
+	Device& Context::GetDevice()
+	{
+		return *device;
+	}
+
+	Display& Context::GetDisplay()
+	{
+		return *display;
+	}
+
+	RayContext& Context::GetRayContext()
+	{
+		throw white::unsupported();
+	}
+
+	void Context::Render(CommandList& CmdList, const Effect::Effect& effect, const Effect::Technique& tech, const InputLayout& layout)
+	{
+		GraphicsPipelineStateInitializer GraphicsPSOInit{};
+
+		CmdList.FillRenderTargetsInfo(GraphicsPSOInit);
+
+		GraphicsPSOInit.ShaderPass.VertexDeclaration = layout.GetVertexDeclaration();
+		GraphicsPSOInit.Primitive = layout.GetTopoType();
+
+		auto index_stream = layout.GetIndexStream();
+		auto vertex_count = index_stream ? layout.GetNumIndices() : layout.GetNumVertices();
+
+		auto prim_count = vertex_count;
+		switch (layout.GetTopoType())
+		{
+		case PrimtivteType::LineList:
+			prim_count /= 2;
+			break;
+		case PrimtivteType::TriangleList:
+			prim_count /= 3;
+			break;
+		case PrimtivteType::TriangleStrip:
+			prim_count -= 2;
+			break;
+		}
+
+		auto num_instances = layout.GetVertexStream(0).instance_freq;
+
+		// Legacy effects bind through the D3D12 shader compose, only their states and streams are replayed here.
+		for (auto i = 0; i != tech.NumPasses(); ++i) {
+			auto& pipe_state = tech.GetPass(i).GetState();
+			GraphicsPSOInit.BlendState = pipe_state.BlendState;
+			GraphicsPSOInit.DepthStencilState = pipe_state.DepthStencilState;
+			GraphicsPSOInit.RasterizerState = pipe_state.RasterizerState;
+
+			if (!TrySetGraphicsPipelineState(CmdList, GraphicsPSOInit))
+				continue;
+
+			for (uint32 stream = 0; stream != layout.GetVertexStreamsSize(); ++stream)
+				CmdList.SetVertexBuffer(stream, layout.GetVertexStream(stream).stream.get());
+
+			if (index_stream)
+				CmdList.DrawIndexedPrimitive(index_stream.get(), layout.GetVertexStart(), 0, layout.GetNumVertices(),
+					layout.GetIndexStart(), prim_count, num_instances);
+			else
+				CmdList.DrawPrimitive(layout.GetVertexStart(), 0, prim_count, num_instances);
+		}
+	}
+
+	void Context::BeginFrame()
+	{
+	}
+
+	CommandContext* Context::GetDefaultCommandContext()
+	{
+		return &command_context;
+	}
+
+	void Context::AdvanceFrameFence()
+	{
+	}
+
+	void Context::AdvanceDisplayBuffer()
+	{
+	}
+
+	CommandContext* Context::ObtainParallelCommandContext()
+	{
+		if (free_parallel_contexts.empty())
+			return parallel_contexts.emplace_back(std::make_unique<CommandContext>()).get();
+
+		auto context = free_parallel_contexts.back();
+		free_parallel_contexts.pop_back();
+		return context;
+	}
+
+	void Context::SubmitParallelCommandContexts(white::span<platform::Render::CommandContext* const> Contexts)
+	{
+		for (auto context : Contexts)
+		{
+			Count(GetStats().Commands);
+			free_parallel_contexts.emplace_back(static_cast<CommandContext*>(context));
+		}
+	}
+
+	void Context::CreateDeviceAndDisplay(DisplaySetting setting)
+	{
+		Caps.type = DeviceCaps::Type::Null;
+		Caps.max_texture_depth = 2048;
+		Caps.support_hdr = false;
+		Caps.TextureFormatSupport = [](EFormat) { return true; };
+		Caps.VertexFormatSupport = [](EFormat) { return true; };
+		Caps.RenderTargetMSAASupport = [](EFormat, SampleDesc) { return true; };
+		Caps.MaxDispatchThreadGroupsPerDimension = white::math::uint3(65535, 65535, 65535);
+
+		device = std::make_shared<Device>();
+		display = std::make_shared<Display>(*device, setting);
+
+		GCommandList.GetImmediateCommandList().SetContext(GetDefaultCommandContext());
+
+		screen_frame_buffer = display->GetFrameBuffer();
+		SetFrame(display->GetFrameBuffer());
+
+		RenderResource::InitResources();
+		Caps.IsInitialized = true;
+	}
+
+	void Context::DoBindFrameBuffer(const std::shared_ptr<platform::Render::FrameBuffer>&)
+	{
+	}
+
+	Context& Context::Instance()
+	{
+		static Context context;
+		return context;
+	}
+
+	bool Support()
+	{
+		return true;
+	}
+
+	platform::Render::Context& GetContext()
+	{
+		return Context::Instance();
+	}
+}
@@ -0,0 +1,258 @@
+/*! \file Engine\NullRHI\Resource.h
+\ingroup Engine
+\brief Null RHI resources, CPU bookkeeping only.
+*/
+#ifndef WE_RENDER_NULL_Resource_h
+#define WE_RENDER_NULL_Resource_h 1
+
+#include "RenderInterface/IGraphicsBuffer.hpp"
+#include "RenderInterface/ITexture.hpp"
+#include "RenderInterface/IGPUResourceView.h"
+#include "RenderInterface/IDevice.h"
+#include "RenderInterface/IShaderCompose.h"
+#include "RenderInterface/Indirect.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace platform_ex::Null {
+	using namespace platform::Render::IFormat;
+	using namespace white::inttype;
+
+	using platform::Render::EFormat;
+	using platform::Render::TextureMapAccess;
+	using platform::Render::ResourceCreateInfo;
+
+	class GraphicsBuffer : public platform::Render::GraphicsBuffer {
+	public:
+		GraphicsBuffer(platform::Render::Buffer::Usage usage, uint32 access_hint, uint32 size_in_byte, uint32 InStride, EFormat InFormat);
+		~GraphicsBuffer() override;
+
+		void CopyToBuffer(platform::Render::GraphicsBuffer& rhs) override;
+
+		void UpdateSubresource(white::uint32 offset, white::uint32 size, void const* data) override;
+
+		uint32 GetStride() const { return Stride; }
+		EFormat GetFormat() const { return Format; }
+	private:
+		void* Map(platform::Render::CommandListImmediate& CmdList, platform::Render::Buffer::Access ba) override;
+		void Unmap(platform::Render::CommandListImmediate& CmdList) override;
+
+		// CPU shadow, allocated on first write so large streaming buffers cost nothing until touched.
+		byte* GetShadow();
+
+		std::unique_ptr<byte[]> Shadow;
+		uint32 Stride;
+		EFormat Format;
+		platform::Render::Buffer::Access MappedAccess = platform::Render::Buffer::Read_Only;
+	};
+
+	class ConstantBuffer : public platform::Render::ConstantBuffer {
+	public:
+		explicit ConstantBuffer(uint32 InSize);
+
+		void Update(platform::Render::CommandList& CmdList, white::uint32 size, void const* data) override;
+
+		uint32 GetSize() const { return Size; }
+	private:
+		uint32 Size;
+	};
+
+	// Staging memory of a mapped subresource, written data counts as uploaded on unmap.
+	class Texture {
+	protected:
+		explicit Texture(uint16 InWidth, uint16 InHeight, uint16 InDepth, EFormat InFormat);
+
+		uint16 GetMipWidth(uint8 level) const;
+		uint16 GetMipHeight(uint8 level) const;
+		uint16 GetMipDepth(uint8 level) const;
+
+		// Bytes of one row of blocks, compressed formats map 4x4 blocks.
+		uint32 GetRowPitch(uint16 width) const;
+		uint32 GetNumRows(uint16 height) const;
+
+		void* MapStaging(TextureMapAccess tma, uint32 row_pitch, uint32 num_rows, uint16 depth);
+		void UnMapStaging();
+
+		uint64 GetSizeInBytes(uint8 num_mips, uint8 array_size) const;
+
+		uint16 Width;
+		uint16 Height;
+		uint16 Depth;
+		EFormat TexelFormat;
+		bool bHWResourceReady = false;
+	private:
+		std::vector<byte> Staging;
+		TextureMapAccess StagingAccess = TextureMapAccess::ReadOnly;
+	};
+
+	class Texture1D final : public Texture, public platform::Render::Texture1D {
+	public:
+		Texture1D(uint16 width, uint8 numMipMaps, uint8 array_size, EFormat format, uint32 access_hint, platform::Render::SampleDesc sample_info);
+	protected:
+		std::string Description() const override;
+	public:
+		void BuildMipSubLevels() override;
+
+		void HWResourceCreate(ResourceCreateInfo& init_data) override;
+		void HWResourceDelete() override;
+		bool HWResourceReady() const override;
+
+		uint16 GetWidth(uint8 level) const override;
+
+		void Map(TextureMapAccess tma, void*& data, const Box1D&) override;
+		void UnMap(const Sub1D&) override;
+
+		void CopyToTexture(platform::Render::Texture1D& target) override;
+		void CopyToSubTexture(platform::Render::Texture1D& target, const Box1D& dst, const Box1D& src) override;
+	protected:
+		void Resize(platform::Render::Texture1D& target, const Box1D& dst, const Box1D& src, bool linear) override;
+	};
+
+	class Texture2D final : public Texture, public platform::Render::Texture2D {
+	public:
+		Texture2D(uint16 width, uint16 height, uint8 numMipMaps, uint8 array_size, EFormat format, uint32 access_hint, platform::Render::SampleDesc sample_info);
+	protected:
+		std::string Description() const override;
+	public:
+		void BuildMipSubLevels() override;
+
+		void HWResourceCreate(ResourceCreateInfo& init_data) override;
+		void HWResourceDelete() override;
+		bool HWResourceReady() const override;
+
+		uint16 GetWidth(uint8 level) const override;
+		uint16 GetHeight(uint8 level) const override;
+
+		void Map(TextureMapAccess tma, void*& data, uint32& row_pitch, const Box2D&) override;
+		void UnMap(const Sub1D&) override;
+
+		void CopyToTexture(platform::Render::Texture2D& target) override;
+		void CopyToSubTexture(platform::Render::Texture2D& target, const Box2D& dst, const Box2D& src) override;
+	protected:
+		void Resize(platform::Render::Texture2D& target, const Box2D& dst, const Box2D& src, bool linear) override;
+	};
+
+	class Texture3D final : public Texture, public platform::Render::Texture3D {
+	public:
+		Texture3D(uint16 width, uint16 height, uint16 depth, uint8 numMipMaps, uint8 array_size, EFormat format, uint32 access_hint, platform::Render::SampleDesc sample_info);
+	protected:
+		std::string Description() const override;
+	public:
+		void BuildMipSubLevels() override;
+
+		void HWResourceCreate(ResourceCreateInfo& init_data) override;
+		void HWResourceDelete() override;
+		bool HWResourceReady() const override;
+
+		uint16 GetWidth(uint8 level) const override;
+		uint16 GetHeight(uint8 level) const override;
+		uint16 GetDepth(uint8 level) const override;
+
+		void Map(TextureMapAccess tma, void*& data, uint32& row_pitch, uint32& slice_pitch, const Box3D&) override;
+		void UnMap(const Sub1D&) override;
+
+		void CopyToTexture(platform::Render::Texture3D& target) override;
+		void CopyToSubTexture(platform::Render::Texture3D& target, const Box3D& dst, const Box3D& src) override;
+	protected:
+		void Resize(platform::Render::Texture3D& target, const Box3D& dst, const Box3D& src, bool linear) override;
+	};
+
+	class TextureCube final : public Texture, public platform::Render::TextureCube {
+	public:
+		TextureCube(uint16 size, uint8 numMipMaps, uint8 array_size, EFormat format, uint32 access_hint, platform::Render::SampleDesc sample_info);
+	protected:
+		std::string Description() const override;
+	public:
+		void BuildMipSubLevels() override;
+
+		void HWResourceCreate(ResourceCreateInfo& init_data) override;
+		void HWResourceDelete() override;
+		bool HWResourceReady() const override;
+
+		uint16 GetWidth(uint8 level) const override;
+		uint16 GetHeight(uint8 level) const override;
+
+		void Map(TextureMapAccess tma, void*& data, uint32& row_pitch, const BoxCube&) override;
+		void UnMap(const Sub1D&, CubeFaces face) override;
+
+		void CopyToTexture(platform::Render::TextureCube& target) override;
+		void CopyToSubTexture(platform::Render::TextureCube& target, const BoxCube& dst, const BoxCube& src) override;
+	protected:
+		void Resize(platform::Render::TextureCube& target, const BoxCube& dst, const BoxCube& src, bool linear) override;
+	};
+
+	class ShaderResourceView : public platform::Render::ShaderResourceView {
+	public:
+		explicit ShaderResourceView(const platform::Render::RObject* InResource, EFormat InFormat)
+			:Resource(InResource), Format(InFormat)
+		{}
+
+		const platform::Render::RObject* Resource;
+		EFormat Format;
+	};
+
+	class UnorderedAccessView : public platform::Render::UnorderedAccessView {
+	public:
+		explicit UnorderedAccessView(const platform::Render::RObject* InResource, EFormat InFormat)
+			:Resource(InResource), Format(InFormat)
+		{}
+
+		const platform::Render::RObject* Resource;
+		EFormat Format;
+	};
+
+	template<platform::Render::THardwareShader ShaderType>
+	class HardwareShader final : public ShaderType {
+	public:
+		explicit HardwareShader(const white::span<const uint8>& Code)
+			:CodeSize(static_cast<uint32>(Code.size()))
+		{}
+
+		uint32 CodeSize;
+	};
+
+	class RootSignature : public platform::Render::RootSignature {
+	};
+
+	class GraphicsPipelineState : public platform::Render::GraphicsPipelineState {
+	public:
+		explicit GraphicsPipelineState(const platform::Render::GraphicsPipelineStateInitializer& InInitializer)
+			:Initializer(InInitializer)
+		{}
+
+		const platform::Render::RootSignature* GetRootSignature() const override;
+
+		platform::Render::GraphicsPipelineStateInitializer Initializer;
+	};
+
+	class ComputePipelineState : public platform::Render::ComputePipelineState {
+	public:
+		explicit ComputePipelineState(const platform::Render::ComputeHWShader* InComputeShader)
+			:ComputeShader(InComputeShader)
+		{}
+
+		const platform::Render::RootSignature* GetRootSignature() const override;
+
+		const platform::Render::ComputeHWShader* ComputeShader;
+	};
+
+	class CommandSignature : public platform::Render::CommandSignature {
+	public:
+		explicit CommandSignature(const platform::Render::CommandSignatureDesc& desc);
+
+		// Bytes one indirect command reads from the argument buffer.
+		uint32 ByteStride;
+	};
+
+	class ShaderCompose : public platform::Render::ShaderCompose {
+	public:
+		void Bind() override;
+		void UnBind() override;
+	};
+
+	// Shared by every pipeline state, the null RHI has no binding layout to tell apart.
+	const RootSignature* GetRootSignature();
+}
+
+#endif
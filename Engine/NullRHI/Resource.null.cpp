@@ -0,0 +1,441 @@
+#include "Resource.h"
+#include "Stats.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+
+namespace platform_ex::Null {
+	using namespace platform::Render;
+
+	GraphicsBuffer::GraphicsBuffer(Buffer::Usage usage, uint32 access_hint, uint32 size_in_byte, uint32 InStride, EFormat InFormat)
+		:platform::Render::GraphicsBuffer(usage, access_hint, size_in_byte), Stride(InStride), Format(InFormat)
+	{
+		Count(GetStats().BuffersCreated);
+		Count(GetStats().BytesAllocated, size_in_byte);
+	}
+
+	GraphicsBuffer::~GraphicsBuffer() = default;
+
+	byte* GraphicsBuffer::GetShadow()
+	{
+		if (!Shadow)
+			Shadow = std::make_unique<byte[]>(size_in_byte);
+		return Shadow.get();
+	}
+
+	void GraphicsBuffer::CopyToBuffer(platform::Render::GraphicsBuffer& rhs)
+	{
+		auto& target = static_cast<GraphicsBuffer&>(rhs);
+		if (Shadow)
+			std::memcpy(target.GetShadow(), Shadow.get(), std::min(size_in_byte, target.size_in_byte));
+	}
+
+	void GraphicsBuffer::UpdateSubresource(white::uint32 offset, white::uint32 size, void const* data)
+	{
+		WAssert(offset + size <= size_in_byte, "UpdateSubresource out of buffer range");
+		std::memcpy(GetShadow() + offset, data, size);
+		Count(GetStats().BytesUploaded, size);
+	}
+
+	void* GraphicsBuffer::Map(CommandListImmediate& CmdList, Buffer::Access ba)
+	{
+		MappedAccess = ba;
+		return GetShadow();
+	}
+
+	void GraphicsBuffer::Unmap(CommandListImmediate& CmdList)
+	{
+		if (MappedAccess != Buffer::Read_Only)
+			Count(GetStats().BytesUploaded, size_in_byte);
+	}
+
+	ConstantBuffer::ConstantBuffer(uint32 InSize)
+		:Size(InSize)
+	{
+		Count(GetStats().BuffersCreated);
+		Count(GetStats().BytesAllocated, InSize);
+	}
+
+	void ConstantBuffer::Update(CommandList& CmdList, white::uint32 size, void const* data)
+	{
+		Count(GetStats().BytesUploaded, size);
+	}
+
+	Texture::Texture(uint16 InWidth, uint16 InHeight, uint16 InDepth, EFormat InFormat)
+		:Width(InWidth), Height(InHeight), Depth(InDepth), TexelFormat(InFormat)
+	{
+		Count(GetStats().TexturesCreated);
+	}
+
+	uint16 Texture::GetMipWidth(uint8 level) const
+	{
+		return std::max<uint16>(1, Width >> level);
+	}
+
+	uint16 Texture::GetMipHeight(uint8 level) const
+	{
+		return std::max<uint16>(1, Height >> level);
+	}
+
+	uint16 Texture::GetMipDepth(uint8 level) const
+	{
+		return std::max<uint16>(1, Depth >> level);
+	}
+
+	uint32 Texture::GetRowPitch(uint16 width) const
+	{
+		if (IsCompressedFormat(TexelFormat))
+			return (width + 3) / 4 * NumFormatBytes(TexelFormat) * 4;
+		return width * NumFormatBytes(TexelFormat);
+	}
+
+	uint32 Texture::GetNumRows(uint16 height) const
+	{
+		if (IsCompressedFormat(TexelFormat))
+			return (height + 3) / 4;
+		return height;
+	}
+
+	uint64 Texture::GetSizeInBytes(uint8 num_mips, uint8 array_size) const
+	{
+		uint64 size = 0;
+		for (uint8 level = 0; level != num_mips; ++level)
+			size += uint64(GetRowPitch(GetMipWidth(level))) * GetNumRows(GetMipHeight(level)) * GetMipDepth(level);
+		return size * array_size;
+	}
+
+	void* Texture::MapStaging(TextureMapAccess tma, uint32 row_pitch, uint32 num_rows, uint16 depth)
+	{
+		StagingAccess = tma;
+		Staging.resize(size_t(row_pitch) * num_rows * depth);
+		return Staging.data();
+	}
+
+	void Texture::UnMapStaging()
+	{
+		if (StagingAccess != TextureMapAccess::ReadOnly)
+			Count(GetStats().BytesUploaded, Staging.size());
+		Staging.clear();
+	}
+
+	namespace
+	{
+		// Init data is uploaded once at creation, like the D3D12 backend does through its upload heap.
+		void CountInitData(const ResourceCreateInfo& init_data, uint64 SizeInBytes)
+		{
+			Count(GetStats().BytesAllocated, SizeInBytes);
+			if (init_data.InitData)
+				Count(GetStats().BytesUploaded, SizeInBytes);
+		}
+	}
+
+	Texture1D::Texture1D(uint16 width, uint8 numMipMaps, uint8 array_size, EFormat format, uint32 access_hint, SampleDesc sample_info)
+		:Null::Texture(width, 1, 1, format), platform::Render::Texture1D(numMipMaps, array_size, format, access_hint, sample_info)
+	{
+		if (mipmap_size == 0)
+			mipmap_size = static_cast<uint8>(std::bit_width(width));
+	}
+
+	std::string Texture1D::Description() const
+	{
+		return std::format("Null Texture1D {} mips {} array {}", Width, mipmap_size, array_size);
+	}
+
+	void Texture1D::BuildMipSubLevels()
+	{
+	}
+
+	void Texture1D::HWResourceCreate(ResourceCreateInfo& init_data)
+	{
+		CountInitData(init_data, GetSizeInBytes(mipmap_size, array_size));
+		bHWResourceReady = true;
+	}
+
+	void Texture1D::HWResourceDelete()
+	{
+		bHWResourceReady = false;
+	}
+
+	bool Texture1D::HWResourceReady() const
+	{
+		return bHWResourceReady;
+	}
+
+	uint16 Texture1D::GetWidth(uint8 level) const
+	{
+		return GetMipWidth(level);
+	}
+
+	void Texture1D::Map(TextureMapAccess tma, void*& data, const Box1D& box)
+	{
+		data = MapStaging(tma, GetRowPitch(box.width), 1, 1);
+	}
+
+	void Texture1D::UnMap(const Sub1D&)
+	{
+		UnMapStaging();
+	}
+
+	void Texture1D::CopyToTexture(platform::Render::Texture1D& target)
+	{
+	}
+
+	void Texture1D::CopyToSubTexture(platform::Render::Texture1D& target, const Box1D& dst, const Box1D& src)
+	{
+	}
+
+	void Texture1D::Resize(platform::Render::Texture1D& target, const Box1D& dst, const Box1D& src, bool linear)
+	{
+	}
+
+	Texture2D::Texture2D(uint16 width, uint16 height, uint8 numMipMaps, uint8 array_size, EFormat format, uint32 access_hint, SampleDesc sample_info)
+		:Null::Texture(width, height, 1, format), platform::Render::Texture2D(numMipMaps, array_size, format, access_hint, sample_info)
+	{
+		if (mipmap_size == 0)
+			mipmap_size = static_cast<uint8>(std::bit_width(std::max(width, height)));
+	}
+
+	std::string Texture2D::Description() const
+	{
+		return std::format("Null Texture2D {}x{} mips {} array {}", Width, Height, mipmap_size, array_size);
+	}
+
+	void Texture2D::BuildMipSubLevels()
+	{
+	}
+
+	void Texture2D::HWResourceCreate(ResourceCreateInfo& init_data)
+	{
+		CountInitData(init_data, GetSizeInBytes(mipmap_size, array_size));
+		bHWResourceReady = true;
+	}
+
+	void Texture2D::HWResourceDelete()
+	{
+		bHWResourceReady = false;
+	}
+
+	bool Texture2D::HWResourceReady() const
+	{
+		return bHWResourceReady;
+	}
+
+	uint16 Texture2D::GetWidth(uint8 level) const
+	{
+		return GetMipWidth(level);
+	}
+
+	uint16 Texture2D::GetHeight(uint8 level) const
+	{
+		return GetMipHeight(level);
+	}
+
+	void Texture2D::Map(TextureMapAccess tma, void*& data, uint32& row_pitch, const Box2D& box)
+	{
+		row_pitch = GetRowPitch(box.width);
+		data = MapStaging(tma, row_pitch, GetNumRows(box.height), 1);
+	}
+
+	void Texture2D::UnMap(const Sub1D&)
+	{
+		UnMapStaging();
+	}
+
+	void Texture2D::CopyToTexture(platform::Render::Texture2D& target)
+	{
+	}
+
+	void Texture2D::CopyToSubTexture(platform::Render::Texture2D& target, const Box2D& dst, const Box2D& src)
+	{
+	}
+
+	void Texture2D::Resize(platform::Render::Texture2D& target, const Box2D& dst, const Box2D& src, bool linear)
+	{
+	}
+
+	Texture3D::Texture3D(uint16 width, uint16 height, uint16 depth, uint8 numMipMaps, uint8 array_size, EFormat format, uint32 access_hint, SampleDesc sample_info)
+		:Null::Texture(width, height, depth, format), platform::Render::Texture3D(numMipMaps, array_size, format, access_hint, sample_info)
+	{
+		if (mipmap_size == 0)
+			mipmap_size = static_cast<uint8>(std::bit_width(std::max({ width, height, depth })));
+	}
+
+	std::string Texture3D::Description() const
+	{
+		return std::format("Null Texture3D {}x{}x{} mips {} array {}", Width, Height, Depth, mipmap_size, array_size);
+	}
+
+	void Texture3D::BuildMipSubLevels()
+	{
+	}
+
+	void Texture3D::HWResourceCreate(ResourceCreateInfo& init_data)
+	{
+		CountInitData(init_data, GetSizeInBytes(mipmap_size, array_size));
+		bHWResourceReady = true;
+	}
+
+	void Texture3D::HWResourceDelete()
+	{
+		bHWResourceReady = false;
+	}
+
+	bool Texture3D::HWResourceReady() const
+	{
+		return bHWResourceReady;
+	}
+
+	uint16 Texture3D::GetWidth(uint8 level) const
+	{
+		return GetMipWidth(level);
+	}
+
+	uint16 Texture3D::GetHeight(uint8 level) const
+	{
+		return GetMipHeight(level);
+	}
+
+	uint16 Texture3D::GetDepth(uint8 level) const
+	{
+		return GetMipDepth(level);
+	}
+
+	void Texture3D::Map(TextureMapAccess tma, void*& data, uint32& row_pitch, uint32& slice_pitch, const Box3D& box)
+	{
+		row_pitch = GetRowPitch(box.width);
+		slice_pitch = row_pitch * GetNumRows(box.height);
+		data = MapStaging(tma, row_pitch, GetNumRows(box.height), box.depth);
+	}
+
+	void Texture3D::UnMap(const Sub1D&)
+	{
+		UnMapStaging();
+	}
+
+	void Texture3D::CopyToTexture(platform::Render::Texture3D& target)
+	{
+	}
+
+	void Texture3D::CopyToSubTexture(platform::Render::Texture3D& target, const Box3D& dst, const Box3D& src)
+	{
+	}
+
+	void Texture3D::Resize(platform::Render::Texture3D& target, const Box3D& dst, const Box3D& src, bool linear)
+	{
+	}
+
+	TextureCube::TextureCube(uint16 size, uint8 numMipMaps, uint8 array_size, EFormat format, uint32 access_hint, SampleDesc sample_info)
+		:Null::Texture(size, size, 1, format), platform::Render::TextureCube(numMipMaps, array_size, format, access_hint, sample_info)
+	{
+		if (mipmap_size == 0)
+			mipmap_size = static_cast<uint8>(std::bit_width(size));
+	}
+
+	std::string TextureCube::Description() const
+	{
+		return std::format("Null TextureCube {} mips {} array {}", Width, mipmap_size, array_size);
+	}
+
+	void TextureCube::BuildMipSubLevels()
+	{
+	}
+
+	void TextureCube::HWResourceCreate(ResourceCreateInfo& init_data)
+	{
+		CountInitData(init_data, GetSizeInBytes(mipmap_size, array_size) * 6);
+		bHWResourceReady = true;
+	}
+
+	void TextureCube::HWResourceDelete()
+	{
+		bHWResourceReady = false;
+	}
+
+	bool TextureCube::HWResourceReady() const
+	{
+		return bHWResourceReady;
+	}
+
+	uint16 TextureCube::GetWidth(uint8 level) const
+	{
+		return GetMipWidth(level);
+	}
+
+	uint16 TextureCube::GetHeight(uint8 level) const
+	{
+		return GetMipHeight(level);
+	}
+
+	void TextureCube::Map(TextureMapAccess tma, void*& data, uint32& row_pitch, const BoxCube& box)
+	{
+		row_pitch = GetRowPitch(box.width);
+		data = MapStaging(tma, row_pitch, GetNumRows(box.height), 1);
+	}
+
+	void TextureCube::UnMap(const Sub1D&, CubeFaces face)
+	{
+		UnMapStaging();
+	}
+
+	void TextureCube::CopyToTexture(platform::Render::TextureCube& target)
+	{
+	}
+
+	void TextureCube::CopyToSubTexture(platform::Render::TextureCube& target, const BoxCube& dst, const BoxCube& src)
+	{
+	}
+
+	void TextureCube::Resize(platform::Render::TextureCube& target, const BoxCube& dst, const BoxCube& src, bool linear)
+	{
+	}
+
+	const platform::Render::RootSignature* GraphicsPipelineState::GetRootSignature() const
+	{
+		return Null::GetRootSignature();
+	}
+
+	const platform::Render::RootSignature* ComputePipelineState::GetRootSignature() const
+	{
+		return Null::GetRootSignature();
+	}
+
+	CommandSignature::CommandSignature(const CommandSignatureDesc& desc)
+		:ByteStride(0)
+	{
+		for (auto& arg : desc.ArgDescs)
+		{
+			switch (arg.mType)
+			{
+			case IndirectArgumentType::INDIRECT_DRAW:
+				ByteStride += sizeof(DrawArguments);
+				break;
+			case IndirectArgumentType::INDIRECT_DRAW_INDEX:
+				ByteStride += sizeof(DrawIndexArguments);
+				break;
+			case IndirectArgumentType::INDIRECT_DISPATCH:
+				ByteStride += sizeof(uint32) * 3;
+				break;
+			default:
+				ByteStride += arg.mByteSize;
+				break;
+			}
+		}
+		if (!desc.mPacked)
+			ByteStride = (ByteStride + 15) & ~15u;
+	}
+
+	void ShaderCompose::Bind()
+	{
+	}
+
+	void ShaderCompose::UnBind()
+	{
+	}
+
+	const RootSignature* GetRootSignature()
+	{
+		static RootSignature Signature;
+		return &Signature;
+	}
+}
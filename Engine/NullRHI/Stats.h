@@ -0,0 +1,44 @@
+/*! \file Engine\NullRHI\Stats.h
+\ingroup Engine
+\brief Null RHI counters.
+*/
+#ifndef WE_RENDER_NULL_Stats_h
+#define WE_RENDER_NULL_Stats_h 1
+
+#include <WBase/winttype.hpp>
+#include <atomic>
+
+namespace platform_ex::Null {
+	using white::uint64;
+
+	/*
+	\brief What the render thread asked the null RHI to do.
+	\note Resources are created from any thread, counters are relaxed atomics.
+	*/
+	struct Stats {
+		// Every CommandContext call.
+		std::atomic<uint64> Commands;
+		std::atomic<uint64> Draws;
+		std::atomic<uint64> Dispatches;
+		// Bound pipeline state, render pass, viewport, scissor and stream changes, redundant sets excluded.
+		std::atomic<uint64> StateChanges;
+		// Shader parameters, constant buffers, buffer and texture writes and init data.
+		std::atomic<uint64> BytesUploaded;
+
+		std::atomic<uint64> BuffersCreated;
+		std::atomic<uint64> TexturesCreated;
+		std::atomic<uint64> PipelineStatesCreated;
+		std::atomic<uint64> BytesAllocated;
+
+		void Reset();
+	};
+
+	Stats& GetStats();
+
+	inline void Count(std::atomic<uint64>& Counter, uint64 Value = 1)
+	{
+		Counter.fetch_add(Value, std::memory_order_relaxed);
+	}
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "BuiltInShader.h"
 #include "Core/Container/map.hpp"
+#include "Core/Container/vector.hpp"
 using namespace platform::Render;
 
 ShaderRef<RenderShader> Shader::BuiltInShaderMapSection::GetShader(ShaderMeta* ShaderType, int32 PermutationId) const
@@ -66,3 +67,19 @@ RenderShader* Shader::BuiltInShaderMap::FindOrAddShader(const ShaderMeta* Shader
 
 	return section_itr->second->Content.FindOrAddShader(ShaderType->GetHash(),PermutationId,Shader);
 }
+
+HardwareShader* Shader::BuiltInShaderMap::FindHWShader(const Digest::SHAHash& InHash)
+{
+	std::shared_lock lock{ MapMutex };
+	for (auto& section : SectionMap)
+	{
+		auto Resource = static_cast<ShaderMapResource_InlineCode*>(section.second->GetResource());
+		if (!Resource)
+			continue;
+
+		auto ShaderIndex = Resource->Code->FindShaderIndex(InHash);
+		if (ShaderIndex != white::INDEX_NONE)
+			return Resource->GetShader(ShaderIndex);
+	}
+	return nullptr;
+}
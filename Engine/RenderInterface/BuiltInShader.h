@@ -154,6 +154,9 @@ inline namespace Shader
 		void AddSection(BuiltInShaderMapSection* InSection);
 		BuiltInShaderMapSection* FindSection(const FHashedName& HashedShaderFilename);
 		BuiltInShaderMapSection* FindOrAddSection(const ShaderMeta* ShaderType);
+
+		// Creates the hardware shader on first use, nullptr if no section has the code.
+		HardwareShader* FindHWShader(const Digest::SHAHash& InHash);
 	private:
 		std::shared_mutex MapMutex;
 		std::unordered_map<std::size_t, BuiltInShaderMapSection*> SectionMap;
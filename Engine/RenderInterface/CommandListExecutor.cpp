@@ -2,6 +2,8 @@
 #include "Core/Coroutine/ThreadScheduler.h"
 #include "Core/Threading/Thread.h"
 #include "System/SystemEnvironment.h"
+#include "Runtime/ParallelFor.h"
+#include "IContext.h"
 #include <spdlog/spdlog.h>
 #include <coroutine>
 
@@ -94,6 +96,9 @@ namespace white::coroutine
 
 using namespace platform::Render;
 
+bool platform::Render::GRenderInterfaceParallelTranslate = false;
+uint32 platform::Render::GRenderInterfaceMinCommandsPerTranslateRange = 256;
+
 SyncPoint::~SyncPoint() = default;
 
 class RenderTaskArray
@@ -182,6 +187,12 @@ using CommandListDebugIterator = CommandListIterator;
 
 void CommandListExecutor::Execute(CommandListBase& CmdList)
 {
+	if (GRenderInterfaceParallelTranslate)
+	{
+		ExecuteParallel(CmdList);
+		return;
+	}
+
 	CmdList.bExecuting = true;
 
 	CommandListContext Context;
@@ -196,6 +207,140 @@ void CommandListExecutor::Execute(CommandListBase& CmdList)
 	CmdList.Reset();
 }
 
+namespace
+{
+	struct TranslateRange
+	{
+		explicit TranslateRange(const CommandStreamState& InStart)
+			:Start(InStart)
+		{}
+
+		void Add(const CommandHeader* Header)
+		{
+			auto Next = NextCommand(Header);
+			if (!Spans.empty() && Spans.back().second == Header)
+				Spans.back().second = Next;
+			else
+				Spans.emplace_back(Header, Next);
+			++NumCommands;
+		}
+
+		bool StartsWithRenderPass() const
+		{
+			return Spans.front().first->Op == ECommandOp::BeginRenderPass;
+		}
+
+		void Translate(CommandContext& Context, ComputeContext& Compute) const
+		{
+			for (auto& [Begin, End] : Spans)
+				TranslateCommands(Begin, End, Context, Compute);
+		}
+
+		CommandStreamState Start;
+		std::vector<std::pair<const CommandHeader*, const CommandHeader*>> Spans;
+		uint32 NumCommands = 0;
+	};
+}
+
+// Runs of packets between other commands are split into ranges at render pass and pipeline state records.
+// The first range continues on the list's own context while the middle ones are translated on workers,
+// the last one goes back to the list's context after the middle ones are submitted, so every other
+// command still sees the context in stream order.
+void CommandListExecutor::ExecuteParallel(CommandListBase& CmdList)
+{
+	CmdList.bExecuting = true;
+
+	CommandListContext Context;
+	auto& DefaultContext = CmdList.GetContext();
+	auto& DefaultCompute = CmdList.GetComputeContext();
+
+	CommandStreamState State;
+	const CommandStreamState NoEvents;
+	std::vector<TranslateRange> Ranges;
+
+	auto TranslateSegment = [&]
+	{
+		std::vector<CommandContext*> Contexts;
+		if (Ranges.size() > 2)
+		{
+			if (auto First = GRenderIF->ObtainParallelCommandContext())
+			{
+				Contexts.emplace_back(First);
+				while (Contexts.size() + 2 != Ranges.size())
+					Contexts.emplace_back(GRenderIF->ObtainParallelCommandContext());
+			}
+		}
+
+		if (Contexts.empty())
+		{
+			for (auto& Range : Ranges)
+				Range.Translate(DefaultContext, DefaultCompute);
+			Ranges.clear();
+			return;
+		}
+
+		WhiteEngine::ParallelFor(std::execution::par, static_cast<white::int32>(Contexts.size() + 1), [&](white::int32 Index)
+			{
+				if (Index == 0)
+				{
+					Ranges[0].Translate(DefaultContext, DefaultCompute);
+					return;
+				}
+
+				auto& Target = *Contexts[Index - 1];
+				auto& Range = Ranges[Index];
+				Range.Start.ReconcileEvents(Target, NoEvents);
+				Range.Start.Apply(Target, !Range.StartsWithRenderPass());
+				Range.Translate(Target, Target);
+				Ranges[Index + 1].Start.CloseEvents(Target);
+			});
+
+		GRenderIF->SubmitParallelCommandContexts(white::make_const_span(Contexts));
+
+		auto& Last = Ranges.back();
+		Last.Start.ReconcileEvents(DefaultCompute, Ranges[1].Start);
+		Last.Start.Apply(DefaultContext, !Last.StartsWithRenderPass());
+		Last.Translate(DefaultContext, DefaultCompute);
+		Ranges.clear();
+	};
+
+	for (auto Cmd = CmdList.Root; Cmd;)
+	{
+		auto Next = Cmd->Next;
+		if (Cmd->bPacket)
+		{
+			auto Packet = static_cast<CommandPacket*>(Cmd);
+			for (auto Header = Packet->Begin(); Header != Packet->End(); Header = NextCommand(Header))
+			{
+				if (Ranges.empty() || (IsCommandSplitPoint(*Header) && Ranges.back().NumCommands >= GRenderInterfaceMinCommandsPerTranslateRange))
+					Ranges.emplace_back(State);
+				Ranges.back().Add(Header);
+
+				// Only the list's own context may close events opened before this list.
+				if (!State.Track(*Header))
+				{
+					for (std::size_t Index = 1; Index != Ranges.size(); ++Index)
+					{
+						auto& Spans = Ranges[Index].Spans;
+						Ranges[0].Spans.insert(Ranges[0].Spans.end(), Spans.begin(), Spans.end());
+						Ranges[0].NumCommands += Ranges[Index].NumCommands;
+					}
+					Ranges.erase(Ranges.begin() + 1, Ranges.end());
+				}
+			}
+		}
+		else
+		{
+			TranslateSegment();
+			Cmd->ExecuteAndDestruct(CmdList, Context);
+		}
+		Cmd = Next;
+	}
+	TranslateSegment();
+
+	CmdList.Reset();
+}
+
 void CommandListBase::Flush()
 {
 	GCommandList.ExecuteList(*this);
@@ -0,0 +1,260 @@
+#include "CommandStream.h"
+#include <algorithm>
+
+namespace platform::Render {
+	namespace
+	{
+		template<TCommandRecord TRecord>
+		const TRecord& As(const CommandHeader* Header)
+		{
+			wconstraint(Header->Op == TRecord::Op);
+			return *reinterpret_cast<const TRecord*>(Header);
+		}
+
+		// Graphics stages bind through CommandContext, compute through ComputeContext.
+		template<typename Function>
+		void ForStage(const CommandHeader* Header, const HardwareShader* Shader, CommandContext& Context, ComputeContext& Compute, Function&& Bind)
+		{
+			switch (Header->Stage)
+			{
+			case ECommandStage::Vertex:
+				Bind(Context, const_cast<VertexHWShader*>(static_cast<const VertexHWShader*>(Shader)));
+				break;
+			case ECommandStage::Pixel:
+				Bind(Context, const_cast<PixelHWShader*>(static_cast<const PixelHWShader*>(Shader)));
+				break;
+			default:
+				Bind(Compute, static_cast<const ComputeHWShader*>(Shader));
+				break;
+			}
+		}
+
+		RenderTargetActions ResumeAction(RenderTargetActions Action)
+		{
+			if (GetLoadAction(Action) != RenderTargetLoadAction::Clear)
+				return Action;
+			return MakeRenderTargetActions(RenderTargetLoadAction::Load, GetStoreAction(Action));
+		}
+	}
+
+	void TranslateCommands(const CommandHeader* Begin, const CommandHeader* End, CommandContext& Context, ComputeContext& Compute)
+	{
+		for (auto Header = Begin; Header != End; Header = NextCommand(Header))
+		{
+			switch (Header->Op)
+			{
+			case ECommandOp::BeginRenderPass:
+			{
+				auto& Cmd = As<Commands::BeginRenderPass>(Header);
+				Context.BeginRenderPass(Cmd.Info, Cmd.GetName());
+				break;
+			}
+			case ECommandOp::SetViewport:
+			{
+				auto& Cmd = As<Commands::SetViewport>(Header);
+				Context.SetViewport(Cmd.MinX, Cmd.MinY, Cmd.MinZ, Cmd.MaxX, Cmd.MaxY, Cmd.MaxZ);
+				break;
+			}
+			case ECommandOp::SetScissorRect:
+			{
+				auto& Cmd = As<Commands::SetScissorRect>(Header);
+				Context.SetScissorRect(Cmd.bEnable, Cmd.MinX, Cmd.MinY, Cmd.MaxX, Cmd.MaxY);
+				break;
+			}
+			case ECommandOp::SetVertexBuffer:
+			{
+				auto& Cmd = As<Commands::SetVertexBuffer>(Header);
+				Context.SetVertexBuffer(Cmd.Slot, Cmd.VertexBuffer);
+				break;
+			}
+			case ECommandOp::SetIndexBuffer:
+				Context.SetIndexBuffer(As<Commands::SetIndexBuffer>(Header).IndexBuffer);
+				break;
+			case ECommandOp::SetGraphicsPipelineState:
+				Context.SetGraphicsPipelineState(As<Commands::SetGraphicsPipelineState>(Header).PSO);
+				break;
+			case ECommandOp::SetComputePipelineState:
+				Compute.SetComputePipelineState(As<Commands::SetComputePipelineState>(Header).PSO);
+				break;
+			case ECommandOp::SetShaderSampler:
+			{
+				auto& Cmd = As<Commands::SetShaderSampler>(Header);
+				ForStage(Header, Cmd.Shader, Context, Compute, [&](auto& Target, auto* Shader) {
+					Target.SetShaderSampler(Shader, Cmd.SamplerIndex, Cmd.Desc);
+					});
+				break;
+			}
+			case ECommandOp::SetShaderTexture:
+			{
+				auto& Cmd = As<Commands::SetShaderTexture>(Header);
+				ForStage(Header, Cmd.Shader, Context, Compute, [&](auto& Target, auto* Shader) {
+					Target.SetShaderTexture(Shader, Cmd.TextureIndex, Cmd.Texture);
+					});
+				break;
+			}
+			case ECommandOp::SetShaderResourceView:
+			{
+				auto& Cmd = As<Commands::SetShaderResourceView>(Header);
+				ForStage(Header, Cmd.Shader, Context, Compute, [&](auto& Target, auto* Shader) {
+					Target.SetShaderResourceView(Shader, Cmd.TextureIndex, Cmd.SRV);
+					});
+				break;
+			}
+			case ECommandOp::SetShaderConstantBuffer:
+			{
+				auto& Cmd = As<Commands::SetShaderConstantBuffer>(Header);
+				ForStage(Header, Cmd.Shader, Context, Compute, [&](auto& Target, auto* Shader) {
+					Target.SetShaderConstantBuffer(Shader, Cmd.BaseIndex, Cmd.Buffer);
+					});
+				break;
+			}
+			case ECommandOp::SetShaderParameter:
+			{
+				auto& Cmd = As<Commands::SetShaderParameter>(Header);
+				ForStage(Header, Cmd.Shader, Context, Compute, [&](auto& Target, auto* Shader) {
+					Target.SetShaderParameter(Shader, Cmd.BufferIndex, Cmd.BaseIndex, Cmd.NumBytes, Cmd.GetValue());
+					});
+				break;
+			}
+			case ECommandOp::SetUAVParameter:
+			{
+				auto& Cmd = As<Commands::SetUAVParameter>(Header);
+				if (Cmd.bInitialCount)
+					Compute.SetUAVParameter(Cmd.Shader, Cmd.UAVIndex, Cmd.UAV, Cmd.InitialCount);
+				else
+					Compute.SetUAVParameter(Cmd.Shader, Cmd.UAVIndex, Cmd.UAV);
+				break;
+			}
+			case ECommandOp::DrawIndexedPrimitive:
+			{
+				auto& Cmd = As<Commands::DrawIndexedPrimitive>(Header);
+				Context.DrawIndexedPrimitive(Cmd.IndexBuffer, Cmd.BaseVertexIndex, Cmd.FirstInstance, Cmd.NumVertices, Cmd.StartIndex, Cmd.NumPrimitives, Cmd.NumInstances);
+				break;
+			}
+			case ECommandOp::DrawPrimitive:
+			{
+				auto& Cmd = As<Commands::DrawPrimitive>(Header);
+				Context.DrawPrimitive(Cmd.BaseVertexIndex, Cmd.FirstInstance, Cmd.NumPrimitives, Cmd.NumInstances);
+				break;
+			}
+			case ECommandOp::DrawIndirect:
+			{
+				auto& Cmd = As<Commands::DrawIndirect>(Header);
+				Context.DrawIndirect(Cmd.Sig, Cmd.MaxCmdCount, Cmd.IndirectBuffer, Cmd.BufferOffset, Cmd.CountBuffer, Cmd.CountBufferOffset);
+				break;
+			}
+			case ECommandOp::DispatchComputeShader:
+			{
+				auto& Cmd = As<Commands::DispatchComputeShader>(Header);
+				Compute.DispatchComputeShader(Cmd.ThreadGroupCountX, Cmd.ThreadGroupCountY, Cmd.ThreadGroupCountZ);
+				break;
+			}
+			case ECommandOp::PushEvent:
+			{
+				auto& Cmd = As<Commands::PushEvent>(Header);
+				Compute.PushEvent(Cmd.GetName(), Cmd.Color);
+				break;
+			}
+			case ECommandOp::PopEvent:
+				Compute.PopEvent();
+				break;
+			}
+		}
+	}
+
+	bool CommandStreamState::Track(const CommandHeader& Header)
+	{
+		switch (Header.Op)
+		{
+		case ECommandOp::BeginRenderPass:
+			RenderPass = &As<Commands::BeginRenderPass>(&Header);
+			break;
+		case ECommandOp::SetViewport:
+			Viewport = &As<Commands::SetViewport>(&Header);
+			break;
+		case ECommandOp::SetScissorRect:
+			Scissor = &As<Commands::SetScissorRect>(&Header);
+			break;
+		case ECommandOp::SetVertexBuffer:
+		{
+			auto& Cmd = As<Commands::SetVertexBuffer>(&Header);
+			wconstraint(Cmd.Slot < MaxVertexStreams);
+			VertexBuffers[Cmd.Slot] = Cmd.VertexBuffer;
+			NumVertexBuffers = std::max(NumVertexBuffers, Cmd.Slot + 1);
+			break;
+		}
+		case ECommandOp::SetIndexBuffer:
+			IndexBuffer = As<Commands::SetIndexBuffer>(&Header).IndexBuffer;
+			break;
+		case ECommandOp::DrawIndexedPrimitive:
+			IndexBuffer = As<Commands::DrawIndexedPrimitive>(&Header).IndexBuffer;
+			break;
+		case ECommandOp::SetGraphicsPipelineState:
+			GraphicsPSO = As<Commands::SetGraphicsPipelineState>(&Header).PSO;
+			break;
+		case ECommandOp::SetComputePipelineState:
+			ComputePSO = As<Commands::SetComputePipelineState>(&Header).PSO;
+			break;
+		case ECommandOp::PushEvent:
+			Events.emplace_back(&As<Commands::PushEvent>(&Header));
+			break;
+		case ECommandOp::PopEvent:
+			if (Events.empty())
+				return false;
+			Events.pop_back();
+			break;
+		default:
+			break;
+		}
+		return true;
+	}
+
+	void CommandStreamState::Apply(CommandContext& Context, bool bResumeRenderPass) const
+	{
+		if (bResumeRenderPass && RenderPass)
+		{
+			auto Info = RenderPass->Info;
+			for (auto& Entry : Info.ColorRenderTargets)
+				Entry.Action = ResumeAction(Entry.Action);
+
+			auto& DepthStencil = Info.DepthStencilRenderTarget;
+			DepthStencil.Action = MakeDepthStencilTargetActions(ResumeAction(GetDepthActions(DepthStencil.Action)), ResumeAction(GetStencilActions(DepthStencil.Action)));
+
+			Context.BeginRenderPass(Info, RenderPass->GetName());
+		}
+
+		if (Viewport)
+			Context.SetViewport(Viewport->MinX, Viewport->MinY, Viewport->MinZ, Viewport->MaxX, Viewport->MaxY, Viewport->MaxZ);
+		if (Scissor)
+			Context.SetScissorRect(Scissor->bEnable, Scissor->MinX, Scissor->MinY, Scissor->MaxX, Scissor->MaxY);
+
+		if (GraphicsPSO)
+			Context.SetGraphicsPipelineState(GraphicsPSO);
+		if (ComputePSO)
+			Context.SetComputePipelineState(ComputePSO);
+
+		for (uint32 Slot = 0; Slot != NumVertexBuffers; ++Slot)
+		{
+			if (VertexBuffers[Slot])
+				Context.SetVertexBuffer(Slot, VertexBuffers[Slot]);
+		}
+		if (IndexBuffer)
+			Context.SetIndexBuffer(IndexBuffer);
+	}
+
+	void CommandStreamState::ReconcileEvents(ComputeContext& Context, const CommandStreamState& From) const
+	{
+		auto Common = static_cast<std::size_t>(std::mismatch(Events.begin(), Events.end(), From.Events.begin(), From.Events.end()).first - Events.begin());
+
+		for (auto Index = From.Events.size(); Index != Common; --Index)
+			Context.PopEvent();
+		for (auto Index = Common; Index != Events.size(); ++Index)
+			Context.PushEvent(Events[Index]->GetName(), Events[Index]->Color);
+	}
+
+	void CommandStreamState::CloseEvents(ComputeContext& Context) const
+	{
+		for (std::size_t Index = 0; Index != Events.size(); ++Index)
+			Context.PopEvent();
+	}
+}
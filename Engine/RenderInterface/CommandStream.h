@@ -0,0 +1,327 @@
+#pragma once
+
+#include "ICommandContext.h"
+#include <type_traits>
+#include <vector>
+
+//POD encoding of the hot CommandList commands: an opcode header followed by an inline payload.
+//Records of one run are contiguous and translate with a switch instead of a virtual call each.
+
+namespace platform::Render {
+	enum class ECommandOp : uint8
+	{
+		BeginRenderPass,
+		SetViewport,
+		SetScissorRect,
+		SetVertexBuffer,
+		SetIndexBuffer,
+		SetGraphicsPipelineState,
+		SetComputePipelineState,
+		SetShaderSampler,
+		SetShaderTexture,
+		SetShaderResourceView,
+		SetShaderConstantBuffer,
+		SetShaderParameter,
+		SetUAVParameter,
+		DrawIndexedPrimitive,
+		DrawPrimitive,
+		DrawIndirect,
+		DispatchComputeShader,
+		PushEvent,
+		PopEvent,
+	};
+
+	enum class ECommandStage : uint8
+	{
+		None,
+		Vertex,
+		Pixel,
+		Compute,
+	};
+
+	template<THardwareShader T>
+	constexpr ECommandStage GetCommandStage()
+	{
+		if constexpr (std::is_same_v<std::remove_cv_t<T>, VertexHWShader>)
+			return ECommandStage::Vertex;
+		else if constexpr (std::is_same_v<std::remove_cv_t<T>, PixelHWShader>)
+			return ECommandStage::Pixel;
+		else
+		{
+			static_assert(std::is_same_v<std::remove_cv_t<T>, ComputeHWShader>, "CommandContext only binds vertex, pixel and compute shaders");
+			return ECommandStage::Compute;
+		}
+	}
+
+	constexpr uint32 CommandAlignment = 8;
+
+	struct CommandHeader
+	{
+		ECommandOp Op;
+		ECommandStage Stage;
+		// Bytes of the whole record, inline payload included, a multiple of CommandAlignment.
+		uint32 Size;
+	};
+
+	namespace Commands
+	{
+		// Inline payload: null terminated name.
+		struct BeginRenderPass
+		{
+			static constexpr ECommandOp Op = ECommandOp::BeginRenderPass;
+
+			CommandHeader Header;
+			RenderPassInfo Info;
+
+			const char* GetName() const { return reinterpret_cast<const char*>(this + 1); }
+		};
+
+		struct SetViewport
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetViewport;
+
+			CommandHeader Header;
+			uint32 MinX;
+			uint32 MinY;
+			float MinZ;
+			uint32 MaxX;
+			uint32 MaxY;
+			float MaxZ;
+		};
+
+		struct SetScissorRect
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetScissorRect;
+
+			CommandHeader Header;
+			bool bEnable;
+			uint32 MinX;
+			uint32 MinY;
+			uint32 MaxX;
+			uint32 MaxY;
+		};
+
+		struct SetVertexBuffer
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetVertexBuffer;
+
+			CommandHeader Header;
+			uint32 Slot;
+			GraphicsBuffer* VertexBuffer;
+		};
+
+		struct SetIndexBuffer
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetIndexBuffer;
+
+			CommandHeader Header;
+			GraphicsBuffer* IndexBuffer;
+		};
+
+		struct SetGraphicsPipelineState
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetGraphicsPipelineState;
+
+			CommandHeader Header;
+			GraphicsPipelineState* PSO;
+		};
+
+		struct SetComputePipelineState
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetComputePipelineState;
+
+			CommandHeader Header;
+			ComputePipelineState* PSO;
+		};
+
+		// Shader binding records keep the stage in the header.
+		struct SetShaderSampler
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetShaderSampler;
+
+			CommandHeader Header;
+			const HardwareShader* Shader;
+			uint32 SamplerIndex;
+			TextureSampleDesc Desc;
+		};
+
+		struct SetShaderTexture
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetShaderTexture;
+
+			CommandHeader Header;
+			const HardwareShader* Shader;
+			uint32 TextureIndex;
+			Texture* Texture;
+		};
+
+		struct SetShaderResourceView
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetShaderResourceView;
+
+			CommandHeader Header;
+			const HardwareShader* Shader;
+			uint32 TextureIndex;
+			ShaderResourceView* SRV;
+		};
+
+		struct SetShaderConstantBuffer
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetShaderConstantBuffer;
+
+			CommandHeader Header;
+			const HardwareShader* Shader;
+			uint32 BaseIndex;
+			ConstantBuffer* Buffer;
+		};
+
+		// Inline payload: NumBytes of parameter value.
+		struct SetShaderParameter
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetShaderParameter;
+
+			CommandHeader Header;
+			const HardwareShader* Shader;
+			uint32 BufferIndex;
+			uint32 BaseIndex;
+			uint32 NumBytes;
+
+			const void* GetValue() const { return this + 1; }
+		};
+
+		struct SetUAVParameter
+		{
+			static constexpr ECommandOp Op = ECommandOp::SetUAVParameter;
+
+			CommandHeader Header;
+			const ComputeHWShader* Shader;
+			uint32 UAVIndex;
+			bool bInitialCount;
+			uint32 InitialCount;
+			UnorderedAccessView* UAV;
+		};
+
+		struct DrawIndexedPrimitive
+		{
+			static constexpr ECommandOp Op = ECommandOp::DrawIndexedPrimitive;
+
+			CommandHeader Header;
+			GraphicsBuffer* IndexBuffer;
+			int32 BaseVertexIndex;
+			uint32 FirstInstance;
+			uint32 NumVertices;
+			uint32 StartIndex;
+			uint32 NumPrimitives;
+			uint32 NumInstances;
+		};
+
+		struct DrawPrimitive
+		{
+			static constexpr ECommandOp Op = ECommandOp::DrawPrimitive;
+
+			CommandHeader Header;
+			uint32 BaseVertexIndex;
+			uint32 FirstInstance;
+			uint32 NumPrimitives;
+			uint32 NumInstances;
+		};
+
+		struct DrawIndirect
+		{
+			static constexpr ECommandOp Op = ECommandOp::DrawIndirect;
+
+			CommandHeader Header;
+			CommandSignature* Sig;
+			uint32 MaxCmdCount;
+			uint32 BufferOffset;
+			GraphicsBuffer* IndirectBuffer;
+			GraphicsBuffer* CountBuffer;
+			uint32 CountBufferOffset;
+		};
+
+		struct DispatchComputeShader
+		{
+			static constexpr ECommandOp Op = ECommandOp::DispatchComputeShader;
+
+			CommandHeader Header;
+			uint32 ThreadGroupCountX;
+			uint32 ThreadGroupCountY;
+			uint32 ThreadGroupCountZ;
+		};
+
+		// Inline payload: null terminated name.
+		struct PushEvent
+		{
+			static constexpr ECommandOp Op = ECommandOp::PushEvent;
+
+			CommandHeader Header;
+			platform::FColor Color;
+
+			const char16_t* GetName() const { return reinterpret_cast<const char16_t*>(this + 1); }
+		};
+
+		struct PopEvent
+		{
+			static constexpr ECommandOp Op = ECommandOp::PopEvent;
+
+			CommandHeader Header;
+		};
+	}
+
+	// Packets are released without running destructors, records must not own anything.
+	template<typename TRecord>
+	concept TCommandRecord = std::is_trivially_destructible_v<TRecord>
+		&& alignof(TRecord) <= CommandAlignment
+		&& std::is_same_v<decltype(TRecord::Header), CommandHeader>;
+
+	inline const CommandHeader* NextCommand(const CommandHeader* Header)
+	{
+		return reinterpret_cast<const CommandHeader*>(reinterpret_cast<const byte*>(Header) + Header->Size);
+	}
+
+	/*
+	\brief Translates the records in [Begin,End) in order.
+	\note Graphics commands go to Context, compute commands and events to Compute, the same split CommandList uses.
+	*/
+	void TranslateCommands(const CommandHeader* Begin, const CommandHeader* End, CommandContext& Context, ComputeContext& Compute);
+
+	/*
+	\brief Bound state a command inherits from the records before it.
+	Lists are only split where the stream rebinds everything a draw reads (a render pass or a pipeline state),
+	so what still has to be carried over is the render pass, streams, viewport, scissor, pipeline states and open events.
+	Records are referenced in place, they live until the command list is reset.
+	*/
+	class CommandStreamState
+	{
+	public:
+		// Returns false for a pop of an event pushed before the stream, only the context that pushed it may translate it.
+		bool Track(const CommandHeader& Header);
+
+		// Rebinds the state on a context that has not seen the records before, reopens the pass without clearing it.
+		void Apply(CommandContext& Context, bool bResumeRenderPass) const;
+
+		// Brings the events of a context that last saw From in line with this state.
+		void ReconcileEvents(ComputeContext& Context, const CommandStreamState& From) const;
+
+		// Pops the events open at this point, leaves a context that translated up to here balanced.
+		void CloseEvents(ComputeContext& Context) const;
+	private:
+		const Commands::BeginRenderPass* RenderPass = nullptr;
+		const Commands::SetViewport* Viewport = nullptr;
+		const Commands::SetScissorRect* Scissor = nullptr;
+		GraphicsPipelineState* GraphicsPSO = nullptr;
+		ComputePipelineState* ComputePSO = nullptr;
+		GraphicsBuffer* IndexBuffer = nullptr;
+
+		static constexpr uint32 MaxVertexStreams = 16;
+		GraphicsBuffer* VertexBuffers[MaxVertexStreams] = {};
+		uint32 NumVertexBuffers = 0;
+
+		std::vector<const Commands::PushEvent*> Events;
+	};
+
+	inline bool IsCommandSplitPoint(const CommandHeader& Header)
+	{
+		return Header.Op == ECommandOp::BeginRenderPass || Header.Op == ECommandOp::SetGraphicsPipelineState || Header.Op == ECommandOp::SetComputePipelineState;
+	}
+}
@@ -14,7 +14,8 @@ namespace platform{
 	namespace Render {
 		struct DeviceCaps {
 			enum class Type {
-				D3D12
+				D3D12,
+				Null
 			};
 
 			Type type;
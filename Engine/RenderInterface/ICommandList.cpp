@@ -28,6 +28,12 @@ void platform::Render::CommandListBase::Reset()
 
 	Root = nullptr;
 	CommandLink = &Root;
+	Packet = nullptr;
+}
+
+void platform::Render::CommandPacket::ExecuteAndDestruct(CommandListBase& CmdList, CommandListContext& Context)
+{
+	TranslateCommands(Begin(), End(), CmdList.GetContext(), CmdList.GetComputeContext());
 }
 
 void platform::Render::CommandList::BeginFrame()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ICommandContext.h"
+#include "CommandStream.h"
 #include "IRayTracingGeometry.h"
 #include "IRayTracingScene.h"
 #include "Runtime/MemStack.h"
@@ -70,9 +71,29 @@ namespace platform::Render {
 	{
 		CommandBase* Next = nullptr;
 
+		// Set by CommandPacket, parallel translation only splits runs of packets.
+		bool bPacket = false;
+
 		virtual void ExecuteAndDestruct(CommandListBase& CmdList, CommandListContext& Context) = 0;
 	};
 
+	//A run of POD records, appended to while it is the last command and the records stay contiguous.
+	struct alignas(CommandAlignment) CommandPacket : public CommandBase
+	{
+		uint32 NumCommands = 0;
+		uint32 NumBytes = 0;
+
+		CommandPacket()
+		{
+			bPacket = true;
+		}
+
+		const CommandHeader* Begin() const { return reinterpret_cast<const CommandHeader*>(this + 1); }
+		const CommandHeader* End() const { return reinterpret_cast<const CommandHeader*>(reinterpret_cast<const byte*>(this + 1) + NumBytes); }
+
+		void ExecuteAndDestruct(CommandListBase& CmdList, CommandListContext& Context) override final;
+	};
+
 	template <typename TCmd>
 	struct LadmbdaCommand : public CommandBase
 	{
@@ -163,6 +184,31 @@ namespace platform::Render {
 			return AllocCommand(sizeof(TCmd), alignof(TCmd));
 		}
 
+		template<TCommandRecord TRecord, typename... Args>
+		TRecord* AllocCommandRecord(ECommandStage Stage, uint32 InlineBytes, Args&&... args)
+		{
+			auto Size = (static_cast<uint32>(sizeof(TRecord)) + InlineBytes + CommandAlignment - 1) & ~(CommandAlignment - 1);
+			return new (AllocCommandRecordBytes(Size)) TRecord{ {TRecord::Op, Stage, Size}, std::forward<Args>(args)... };
+		}
+
+		void* AllocCommandRecordBytes(uint32 Size)
+		{
+			if (Packet && CommandLink == &Packet->Next)
+			{
+				if (auto Result = MemManager.AllocContiguous(Packet->End(), static_cast<int32>(Size)))
+				{
+					++Packet->NumCommands;
+					Packet->NumBytes += Size;
+					return Result;
+				}
+			}
+
+			Packet = new (AllocCommand(static_cast<int32>(sizeof(CommandPacket) + Size), alignof(CommandPacket))) CommandPacket();
+			Packet->NumCommands = 1;
+			Packet->NumBytes = Size;
+			return const_cast<CommandHeader*>(Packet->Begin());
+		}
+
 		void ExchangeCmdList(CommandListBase& CmdList)
 		{
 			byte storage[sizeof(CommandListBase)];
@@ -190,6 +236,7 @@ namespace platform::Render {
 	protected:
 		CommandBase* Root;
 		CommandBase** CommandLink;
+		CommandPacket* Packet;
 
 		CommandContext* Context;
 		ComputeContext* ComputeContext;
@@ -229,65 +276,48 @@ namespace platform::Render {
 
 		void SetShaderSampler(const ComputeHWShader* Shader, uint32 SamplerIndex, const TextureSampleDesc& Desc)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().SetShaderSampler(Shader, SamplerIndex, Desc);
-			});
+			AllocCommandRecord<Commands::SetShaderSampler>(ECommandStage::Compute, 0, Shader, SamplerIndex, Desc);
 		}
 
 		void SetShaderTexture(const ComputeHWShader* Shader, uint32 TextureIndex, Texture* Texture)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().SetShaderTexture(Shader, TextureIndex, Texture);
-			});
+			AllocCommandRecord<Commands::SetShaderTexture>(ECommandStage::Compute, 0, Shader, TextureIndex, Texture);
 		}
 
 		void SetShaderResourceView(const ComputeHWShader* Shader, uint32 TextureIndex, ShaderResourceView* Texture)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().SetShaderResourceView(Shader, TextureIndex, Texture);
-				});
+			AllocCommandRecord<Commands::SetShaderResourceView>(ECommandStage::Compute, 0, Shader, TextureIndex, Texture);
 		}
 
 		void SetShaderParameter(const ComputeHWShader* Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue)
 		{
-			InsertCommand([=, UseValue = AllocBuffer(NumBytes, NewValue)](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().SetShaderParameter(Shader, BufferIndex, BaseIndex, NumBytes, UseValue);
-				});
+			auto Cmd = AllocCommandRecord<Commands::SetShaderParameter>(ECommandStage::Compute, NumBytes, Shader, BufferIndex, BaseIndex, NumBytes);
+			std::memcpy(Cmd + 1, NewValue, NumBytes);
 		}
 
 		void SetUAVParameter(const ComputeHWShader* Shader, uint32 UAVIndex, UnorderedAccessView* UAV)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().SetUAVParameter(Shader, UAVIndex, UAV);
-				});
+			AllocCommandRecord<Commands::SetUAVParameter>(ECommandStage::Compute, 0, Shader, UAVIndex, false, 0u, UAV);
 		}
 
 		void SetUAVParameter(const ComputeHWShader* Shader, uint32 UAVIndex, UnorderedAccessView* UAV, uint32 InitialCount)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().SetUAVParameter(Shader, UAVIndex, UAV, InitialCount);
-				});
+			AllocCommandRecord<Commands::SetUAVParameter>(ECommandStage::Compute, 0, Shader, UAVIndex, true, InitialCount, UAV);
 		}
 
 		void SetComputePipelineState(ComputePipelineState* pso)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().SetComputePipelineState(pso);
-				});
+			AllocCommandRecord<Commands::SetComputePipelineState>(ECommandStage::None, 0, pso);
 		}
 
 		void SetShaderConstantBuffer(const ComputeHWShader* Shader, uint32 BaseIndex, ConstantBuffer* Buffer)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().SetShaderConstantBuffer(Shader, BaseIndex, Buffer);
-				});
+			AllocCommandRecord<Commands::SetShaderConstantBuffer>(ECommandStage::Compute, 0, Shader, BaseIndex, Buffer);
 		}
 
 		void DispatchComputeShader(uint32 ThreadGroupCountX, uint32 ThreadGroupCountY, uint32 ThreadGroupCountZ)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().DispatchComputeShader(ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ);
-				});
+			AllocCommandRecord<Commands::DispatchComputeShader>(ECommandStage::None, 0, ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ);
 		}
 	};
 
@@ -297,10 +327,9 @@ namespace platform::Render {
 	public:
 		void BeginRenderPass(const RenderPassInfo& Info, const char* Name)
 		{
-			auto NameCopy = AllocString(Name);
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().BeginRenderPass(Info, NameCopy);
-			});
+			auto NameLength = static_cast<uint32>(std::char_traits<char>::length(Name) + 1);
+			auto Cmd = AllocCommandRecord<Commands::BeginRenderPass>(ECommandStage::None, NameLength, Info);
+			std::char_traits<char>::copy(reinterpret_cast<char*>(Cmd + 1), Name, NameLength);
 
 			RenderTargetsInfo RTInfo(Info);
 			
@@ -309,45 +338,33 @@ namespace platform::Render {
 
 		void SetViewport(uint32 MinX, uint32 MinY, float MinZ, uint32 MaxX, uint32 MaxY, float MaxZ)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().SetViewport(MinX, MinY, MinZ, MaxX, MaxY, MaxZ);
-			});
+			AllocCommandRecord<Commands::SetViewport>(ECommandStage::None, 0, MinX, MinY, MinZ, MaxX, MaxY, MaxZ);
 		}
 
 		void SetScissorRect(bool bEnable, uint32 MinX, uint32 MinY, uint32 MaxX, uint32 MaxY)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().SetScissorRect(bEnable, MinX, MinY, MaxX, MaxY);
-				});
+			AllocCommandRecord<Commands::SetScissorRect>(ECommandStage::None, 0, bEnable, MinX, MinY, MaxX, MaxY);
 		}
 
 		void SetVertexBuffer(uint32 slot, GraphicsBuffer* VertexBuffer)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().SetVertexBuffer(slot, VertexBuffer);
-				});
+			AllocCommandRecord<Commands::SetVertexBuffer>(ECommandStage::None, 0, slot, VertexBuffer);
 		}
 
 		void SetIndexBuffer(platform::Render::GraphicsBuffer* IndexBuffer)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().SetIndexBuffer(IndexBuffer);
-				});
+			AllocCommandRecord<Commands::SetIndexBuffer>(ECommandStage::None, 0, IndexBuffer);
 		}
 
 		void SetGraphicsPipelineState(GraphicsPipelineState* pso)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().SetGraphicsPipelineState(pso);
-				});
+			AllocCommandRecord<Commands::SetGraphicsPipelineState>(ECommandStage::None, 0, pso);
 		}
 
 		template<THardwareShader T>
 		void SetShaderSampler(T* Shader, uint32 SamplerIndex, const TextureSampleDesc& Desc)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().SetShaderSampler(Shader, SamplerIndex, Desc);
-				});
+			AllocCommandRecord<Commands::SetShaderSampler>(GetCommandStage<T>(), 0, Shader, SamplerIndex, Desc);
 		}
 
 		using ComputeCommandList::SetShaderSampler;
@@ -355,9 +372,7 @@ namespace platform::Render {
 		template<THardwareShader T>
 		void SetShaderTexture(T* Shader, uint32 TextureIndex, Texture* Texture)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().SetShaderTexture(Shader, TextureIndex, Texture);
-				});
+			AllocCommandRecord<Commands::SetShaderTexture>(GetCommandStage<T>(), 0, Shader, TextureIndex, Texture);
 		}
 
 		using ComputeCommandList::SetShaderTexture;
@@ -366,9 +381,7 @@ namespace platform::Render {
 
 		void SetShaderResourceView(T* Shader, uint32 TextureIndex, ShaderResourceView* SRV)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().SetShaderResourceView(Shader, TextureIndex, SRV);
-				});
+			AllocCommandRecord<Commands::SetShaderResourceView>(GetCommandStage<T>(), 0, Shader, TextureIndex, SRV);
 		}
 
 		using ComputeCommandList::SetShaderResourceView;
@@ -376,40 +389,31 @@ namespace platform::Render {
 		template<THardwareShader T>
 		void SetShaderConstantBuffer(T* Shader, uint32 BaseIndex, ConstantBuffer* Buffer)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().SetShaderConstantBuffer(Shader, BaseIndex, Buffer);
-				});
+			AllocCommandRecord<Commands::SetShaderConstantBuffer>(GetCommandStage<T>(), 0, Shader, BaseIndex, Buffer);
 		}
 
 		void DrawIndexedPrimitive(GraphicsBuffer* IndexBuffer, int32 BaseVertexIndex, uint32 FirstInstance, uint32 NumVertices, uint32 StartIndex, uint32 NumPrimitives, uint32 NumInstances)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().DrawIndexedPrimitive(IndexBuffer, BaseVertexIndex, FirstInstance, NumVertices, StartIndex, NumPrimitives, NumInstances);
-				});
+			AllocCommandRecord<Commands::DrawIndexedPrimitive>(ECommandStage::None, 0, IndexBuffer, BaseVertexIndex, FirstInstance, NumVertices, StartIndex, NumPrimitives, NumInstances);
 		}
 
 		template<THardwareShader T>
 		void SetShaderParameter(T* Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue)
 		{
-			InsertCommand([=,UseValue=AllocBuffer(NumBytes,NewValue)](CommandListBase& CmdList) {
-				CmdList.GetContext().SetShaderParameter(Shader, BufferIndex, BaseIndex, NumBytes, UseValue);
-				});
+			auto Cmd = AllocCommandRecord<Commands::SetShaderParameter>(GetCommandStage<T>(), NumBytes, Shader, BufferIndex, BaseIndex, NumBytes);
+			std::memcpy(Cmd + 1, NewValue, NumBytes);
 		}
 
 		using ComputeCommandList::SetShaderParameter;
 
 		void DrawPrimitive(uint32 BaseVertexIndex, uint32 FirstInstance, uint32 NumPrimitives, uint32 NumInstances)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().DrawPrimitive(BaseVertexIndex, FirstInstance, NumPrimitives, NumInstances);
-				});
+			AllocCommandRecord<Commands::DrawPrimitive>(ECommandStage::None, 0, BaseVertexIndex, FirstInstance, NumPrimitives, NumInstances);
 		}
 
 		void DrawIndirect(CommandSignature* Sig, uint32 MaxCmdCount, GraphicsBuffer* IndirectBuffer, uint32 BufferOffset, GraphicsBuffer* CountBuffer, uint32 CountBufferOffset)
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetContext().DrawIndirect(Sig, MaxCmdCount, IndirectBuffer, BufferOffset, CountBuffer, CountBufferOffset);
-				});
+			AllocCommandRecord<Commands::DrawIndirect>(ECommandStage::None, 0, Sig, MaxCmdCount, BufferOffset, IndirectBuffer, CountBuffer, CountBufferOffset);
 		}
 
 		void FillRenderTargetsInfo(GraphicsPipelineStateInitializer& GraphicsPSOInit)
@@ -459,16 +463,14 @@ namespace platform::Render {
 
 		void PushEvent(const char16_t* Name, platform::FColor Color)
 		{
-			InsertCommand([=,Name= AllocString(Name)](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().PushEvent(Name, Color);
-				});
+			auto NameLength = static_cast<uint32>(std::char_traits<char16_t>::length(Name) + 1);
+			auto Cmd = AllocCommandRecord<Commands::PushEvent>(ECommandStage::None, NameLength * static_cast<uint32>(sizeof(char16_t)), Color);
+			std::char_traits<char16_t>::copy(reinterpret_cast<char16_t*>(Cmd + 1), Name, NameLength);
 		}
 
 		void PopEvent()
 		{
-			InsertCommand([=](CommandListBase& CmdList) {
-				CmdList.GetComputeContext().PopEvent();
-				});
+			AllocCommandRecord<Commands::PopEvent>(ECommandStage::None, 0);
 		}
 
 		void BeginFrame();
@@ -520,6 +522,7 @@ namespace platform::Render {
 		void ExecuteInner(CommandListBase& CmdList);
 
 		static void Execute(CommandListBase& CmdList);
+		static void ExecuteParallel(CommandListBase& CmdList);
 
 		CommandListImmediate Immediate;
 	};
@@ -563,6 +566,11 @@ namespace platform::Render {
 
 	bool extern GRenderInterfaceSupportCommandThread;
 
+	// Translate runs of POD commands on worker threads into contexts from Context::ObtainParallelCommandContext.
+	bool extern GRenderInterfaceParallelTranslate;
+	// A range handed to a worker holds at least this many commands.
+	uint32 extern GRenderInterfaceMinCommandsPerTranslateRange;
+
 	inline bool IsRunningCommandInThread()
 	{
 		return GRenderInterfaceSupportCommandThread;
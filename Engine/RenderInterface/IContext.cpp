@@ -3,9 +3,11 @@
 
 platform::Render::Context* GRenderIF;
 platform::Render::DeviceCaps platform::Render::Caps;
+bool GUseNullRenderInterface = false;
 
 enum ContextType {
-	Context_D3D12
+	Context_D3D12,
+	Context_Null
 };
 
 namespace platform_ex {
@@ -15,6 +17,11 @@ namespace platform_ex {
 			platform::Render::Context& GetContext();
 		}
 	}
+
+	namespace Null {
+		bool Support();
+		platform::Render::Context& GetContext();
+	}
 }
 
 namespace platform::Render {
@@ -23,12 +30,26 @@ namespace platform::Render {
 
 	Context& Context::Instance() {
 		static bool call_onece = [&]()->bool {
-			GRenderIF = &platform_ex::Windows::D3D12::GetContext();
+			auto type = GUseNullRenderInterface ? Context_Null : Context_D3D12;
+			if (type == Context_Null)
+				GRenderIF = &platform_ex::Null::GetContext();
+			else
+				GRenderIF = &platform_ex::Windows::D3D12::GetContext();
 			return GRenderIF != nullptr;
 		}();
 		return *GRenderIF;
 	}
 
+	CommandContext* Context::ObtainParallelCommandContext()
+	{
+		return nullptr;
+	}
+
+	void Context::SubmitParallelCommandContexts(white::span<CommandContext* const> Contexts)
+	{
+		WAssert(Contexts.empty(), "backend has no parallel command contexts");
+	}
+
 	void Context::SetFrame(const std::shared_ptr<FrameBuffer>& framebuffer)
 	{
 		if (!framebuffer && curr_frame_buffer)
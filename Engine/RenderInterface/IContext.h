@@ -32,6 +32,11 @@ namespace platform::Render {
 
 		virtual void AdvanceFrameFence() = 0;
 		virtual void AdvanceDisplayBuffer() = 0;
+
+		// Extra contexts CommandListExecutor translates command ranges into on worker threads, nullptr if the backend has none.
+		virtual CommandContext* ObtainParallelCommandContext();
+		// Submits the contexts after the work already on the default context, in order, and takes them back.
+		virtual void SubmitParallelCommandContexts(white::span<CommandContext* const> Contexts);
 	public:
 		virtual void CreateDeviceAndDisplay(DisplaySetting setting) = 0;
 	private:
@@ -51,4 +56,7 @@ namespace platform::Render {
 
 extern platform::Render::Context* GRenderIF;
 
+// Set before the first Context::Instance() to run the render thread without a GPU.
+extern bool GUseNullRenderInterface;
+
 #endif
\ No newline at end of file
@@ -1,17 +1,63 @@
 #include "PipelineStateUtility.h"
 #include "IContext.h"
+#include "BuiltInShader.h"
 #include <WBase/smart_ptr.hpp>
+#include <WBase/ConcurrentHashMap.h>
+#include <WBase/concurrency.h>
 #include "Core/Hash/CityHash.h"
-#include <shared_mutex>
+#include "spdlog/spdlog.h"
+#include <atomic>
+#include <exception>
+#include <fstream>
 using namespace platform::Render;
 
 RootSignature::~RootSignature() = default;
 PipelineStateObject::~PipelineStateObject() = default;
 CommandSignature::~CommandSignature() = default;
 
+bool platform::Render::GPipelineStateAsyncCreation = false;
+
 namespace platform::Render::PipelineStateCache
 {
-	class FGraphicsPipelineState
+	// A cache entry is published before its pipeline is created, creation may finish on a background worker.
+	// A failed creation still completes the entry, with a null pipeline and the exception kept for the waiters.
+	class FPipelineState
+	{
+	public:
+		bool IsComplete() const
+		{
+			return bComplete.load(std::memory_order_acquire);
+		}
+
+		void WaitCompletion() const
+		{
+			bComplete.wait(false, std::memory_order_acquire);
+		}
+
+		void Complete()
+		{
+			bComplete.store(true, std::memory_order_release);
+			bComplete.notify_all();
+		}
+
+		void Fail(std::exception_ptr InException)
+		{
+			Exception = InException;
+			Complete();
+		}
+
+		// Only valid after completion.
+		void RethrowIfFailed() const
+		{
+			if (Exception)
+				std::rethrow_exception(Exception);
+		}
+	private:
+		std::atomic<bool> bComplete = false;
+		std::exception_ptr Exception;
+	};
+
+	class FGraphicsPipelineState : public FPipelineState
 	{
 	public:
 		std::shared_ptr<GraphicsPipelineState> IPipeline;
@@ -22,7 +68,7 @@ namespace platform::Render::PipelineStateCache
 		return PipelineState->IPipeline.get();
 	}
 
-	class FComputePipelineState
+	class FComputePipelineState : public FPipelineState
 	{
 	public:
 		std::shared_ptr<ComputePipelineState> IPipeline;
@@ -103,12 +149,11 @@ struct PipelineStateCacheKeyFuncs
 	}
 };
 
-//TODO: local thread cache
-template<class TMyKey, class TMyValue>
+template<class TMyKey, class TMyValue, class TKeyFuncs = std::hash<TMyKey>>
 class TSharedPipelineStateCache
 {
 public:
-	bool Find(const TMyKey& InKey, TMyValue& OutResult)
+	bool Find(const TMyKey& InKey, TMyValue& OutResult) const
 	{
 		auto itr = CurrentMap.find(InKey);
 		if (itr != CurrentMap.end())
@@ -119,350 +164,346 @@ public:
 		return false;
 	}
 
+	// Fails when another thread added the key first, OutResult is then set to its entry.
 	bool Add(const TMyKey& InKey, TMyValue& OutResult)
 	{
-		return CurrentMap.emplace(InKey, OutResult).second;
+		auto [itr, inserted] = CurrentMap.insert(InKey, OutResult);
+		if (!inserted)
+			OutResult = itr->second;
+		return inserted;
 	}
-private:
-	std::unordered_map< TMyKey, TMyValue, PipelineStateCacheKeyFuncs, PipelineStateCacheKeyFuncs> CurrentMap;
-};
 
-using FGraphicsPipelineCache = TSharedPipelineStateCache< GraphicsPipelineStateInitializer, PipelineStateCache::FGraphicsPipelineState*>;
-
-FGraphicsPipelineCache GGraphicsPipelineCache;
-
-PipelineStateCache::FGraphicsPipelineState* PipelineStateCache::GetAndOrCreateGraphicsPipelineState(CommandList& cmdlist, const GraphicsPipelineStateInitializer& OriginalInitializer)
-{
-	const auto Initializer = &OriginalInitializer;
-
-	FGraphicsPipelineState* OutCachedState = nullptr;
-
-	bool bWasFound = GGraphicsPipelineCache.Find(*Initializer, OutCachedState);
-
-	if (bWasFound == false)
+	template<typename Function>
+	void ForEach(Function&& Func) const
 	{
-		// create new graphics state
-		OutCachedState = new FGraphicsPipelineState();
-
-		OutCachedState->IPipeline = white::share_raw(Context::Instance().GetDevice().CreateGraphicsPipelineState(*Initializer));
-
-		GGraphicsPipelineCache.Add(*Initializer, OutCachedState);
+		for (auto& Pair : CurrentMap)
+			Func(Pair.first, Pair.second);
 	}
+private:
+	using KeyEqualType = std::conditional_t<std::is_same_v<TKeyFuncs, std::hash<TMyKey>>, std::equal_to<TMyKey>, TKeyFuncs>;
 
-	return OutCachedState;
-}
-
-template<class KeyType, class ValueType>
-class DiscardableKeyValueCache
-{
-public:
-
-	/* Flags used when calling Find() */
-	struct LockFlags
-	{
-		enum Flags
-		{
-			ReadLock = (1 << 0),
-			WriteLock = (1 << 1),
-			WriteLockOnAddFail = (1 << 2),
-		};
-	};
-
-	typedef std::unordered_map<KeyType, ValueType> TypedMap;
-
-	DiscardableKeyValueCache() :
-		CurrentMap(&Map1)
-		, BackfillMap(&Map2) {}
-
-	/* Access to the internal locking object */
-	std::shared_mutex& RWLock() { return LockObject; }
+	white::ConcurrentHashMap<TMyKey, TMyValue, TKeyFuncs, KeyEqualType> CurrentMap;
+};
 
-	/* Reference to the current map */
-	TypedMap& Current() { return *CurrentMap; }
+using FGraphicsPipelineCache = TSharedPipelineStateCache< GraphicsPipelineStateInitializer, PipelineStateCache::FGraphicsPipelineState*, PipelineStateCacheKeyFuncs>;
+using FComputePipelineCache = TSharedPipelineStateCache<const ComputeHWShader*, PipelineStateCache::FComputePipelineState*>;
 
-	/* Reference to the current map */
-	TypedMap& Backfill() { return *BackfillMap; }
+FGraphicsPipelineCache GGraphicsPipelineCache;
+FComputePipelineCache GComputePipelineCache;
 
-	/* Returns the total number of items in the cache*/
-	int32 Num()
+namespace
+{
+	struct FPipelineStateStats
 	{
-		uint32 LockFlags = ApplyLock(0, LockFlags::ReadLock);
-
-		int32 Count = Map1.Num() + Map2.Num();
-
-		Unlock(LockFlags);
-
-		return Count;
-	}
-
-	/**
-	*  Returns true and sets OutType to the value with the associated key if it exists.
-	*/
-	bool  Find(const KeyType& Key, ValueType& OutType)
+		std::atomic<uint64> Hits;
+		std::atomic<uint64> Misses;
+		std::atomic<uint64> InFlightHits;
+		std::atomic<uint64> Pending;
+		std::atomic<uint64> Created;
+	} GPipelineStateStats;
+
+	void Count(std::atomic<uint64>& Counter)
 	{
-		uint32 LockFlags = ApplyLock(0, LockFlags::ReadLock);
-
-		bool Found = InternalFindWhileLocked(Key, OutType, LockFlags, LockFlags);
-
-		Unlock(LockFlags);
-		return Found;
+		Counter.fetch_add(1, std::memory_order_relaxed);
 	}
 
-	/**
-	 *  Externally-lock-aware Find function.
-	 *
-	 *	InFlags represents the currently locked state of the object, OutFlags the state after the
-	 *	find operation has completed. Caller should be sure to unlock this object with OutFlags
-	 */
-	bool Find(const KeyType& Key, ValueType& OutType, uint32 InCurrentLockFlags, uint32& OutLockFlags)
+	white::thread_pool& GetCreationPool()
 	{
-		return InternalFindWhileLocked(Key, OutType, InCurrentLockFlags, OutLockFlags);
+		static white::thread_pool Pool(std::max(std::thread::hardware_concurrency() / 4, 2u));
+		return Pool;
 	}
 
-	/**
-	* Add an entry to the current map. Can fail if another thread has inserted
-	* a matching object, in which case another call to Find() should succeed
-	*/
-	bool Add(const KeyType& Key, const ValueType& Value)
+	enum class ECreation
 	{
-		uint32 LockFlags = ApplyLock(0, LockFlags::WriteLock);
-		bool Success = Add(Key, Value, LockFlags);
-		Unlock(LockFlags);
-		return Success;
-	}
+		Immediate,
+		Background,
+	};
 
-	/**
-	* Add an entry to the current map. Can fail if another thread has inserted
-	* a matching object, in which case another call to Find() should succeed
+	/*
+	\brief Returns the cached entry for Key, publishing a new one on a miss.
+	A new entry is created by Create on the calling thread or on a creation worker, the entry is not complete before that.
+	Exceptions from Create fail the entry instead of escaping, the entry is complete either way.
 	*/
-	bool Add(const KeyType& Key, const ValueType& Value, const uint32 LockFlags)
+	template<class TState, class TCache, class TKey, class TCreate>
+	TState* FindOrAdd(TCache& Cache, const TKey& Key, ECreation Creation, TCreate&& Create)
 	{
-		bool Success = true;
-
-		WAssert((LockFlags & LockFlags::WriteLock) != 0,"Cache is not locked for write during Add!");
+		TState* OutCachedState = nullptr;
 
-		// key is already here! likely another thread may have filled the cache. calling code should handle this
-		// or request that a write lock be left after a Find() fails.
-		if (CurrentMap->contains(Key) == false)
+		if (Cache.Find(Key, OutCachedState))
 		{
-			CurrentMap->emplace(Key, Value);
+			Count(OutCachedState->IsComplete() ? GPipelineStateStats.Hits : GPipelineStateStats.InFlightHits);
+			return OutCachedState;
 		}
-		else
+
+		OutCachedState = new TState();
+		auto NewState = OutCachedState;
+		if (!Cache.Add(Key, OutCachedState))
 		{
-			Success = false;
+			// another thread published the key between the find and the add
+			delete NewState;
+			Count(OutCachedState->IsComplete() ? GPipelineStateStats.Hits : GPipelineStateStats.InFlightHits);
+			return OutCachedState;
 		}
 
-		return Success;
-	}
+		Count(GPipelineStateStats.Misses);
+		Count(GPipelineStateStats.Pending);
 
-	/*
-		Discard all items left in the backfill and swap the current & backfill pointers
-	*/
-	int32 Discard()
-	{
-		uint32 LockFlags = ApplyLock(0, LockFlags::WriteLock);
+		auto CreateAndComplete = [NewState, Key, Create = std::forward<TCreate>(Create)]() {
+			try
+			{
+				Create(*NewState, Key);
+				NewState->Complete();
+				Count(GPipelineStateStats.Created);
+			}
+			catch (std::exception& e)
+			{
+				spdlog::error("PipelineStateCache: creation failed: {}", e.what());
+				NewState->Fail(std::current_exception());
+			}
+			catch (...)
+			{
+				spdlog::error("PipelineStateCache: creation failed");
+				NewState->Fail(std::current_exception());
+			}
 
-		int32 Discarded = Discard(LockFlags, LockFlags, [](ValueType& Type) {});
+			GPipelineStateStats.Pending.fetch_sub(1, std::memory_order_release);
+			GPipelineStateStats.Pending.notify_all();
+		};
 
-		Unlock(LockFlags);
+		if (Creation == ECreation::Background)
+			GetCreationPool().enqueue(std::move(CreateAndComplete));
+		else
+			CreateAndComplete();
 
-		return Discarded;
+		return NewState;
 	}
 
-	template<typename DeleteFunc>
-	int32 Discard(DeleteFunc Func)
+	void CreateGraphics(PipelineStateCache::FGraphicsPipelineState& State, const GraphicsPipelineStateInitializer& Initializer)
 	{
-		uint32 LockFlags = ApplyLock(0, LockFlags::WriteLock);
-
-		int32 Discarded = Discard(LockFlags, LockFlags, Func);
-
-		Unlock(LockFlags);
-
-		return Discarded;
+		State.IPipeline = white::share_raw(Context::Instance().GetDevice().CreateGraphicsPipelineState(Initializer));
 	}
 
-	/**
-	 * Discard all items in the backfill and swap the current & backfill pointers
-	 */
-	template<typename DeleteFunc>
-	int32 Discard(uint32 InCurrentLockFlags, uint32& OutNewLockFlags, DeleteFunc Func)
+	void CreateCompute(PipelineStateCache::FComputePipelineState& State, const ComputeHWShader* Shader)
 	{
-		if ((InCurrentLockFlags & LockFlags::WriteLock) == 0)
-		{
-			InCurrentLockFlags = ApplyLock(InCurrentLockFlags, LockFlags::WriteLock);
-		}
+		State.IPipeline = white::share_raw(Context::Instance().GetDevice().CreateComputePipelineState(Shader));
+	}
+}
 
-		for (auto& KV : *BackfillMap)
-		{
-			Func(KV.Value);
-		}
+PipelineStateCache::FGraphicsPipelineState* PipelineStateCache::GetAndOrCreateGraphicsPipelineState(CommandList& cmdlist, const GraphicsPipelineStateInitializer& OriginalInitializer)
+{
+	auto OutCachedState = FindOrAdd<FGraphicsPipelineState>(GGraphicsPipelineCache, OriginalInitializer, ECreation::Immediate, CreateGraphics);
 
-		int32 Discarded = BackfillMap->size();
+	// precached or queued by TrySetGraphicsPipelineState, the caller needs it now
+	OutCachedState->WaitCompletion();
+	OutCachedState->RethrowIfFailed();
 
-		// free anything still in the backfill map
-		BackfillMap->clear();
+	return OutCachedState;
+}
 
-		if (CurrentMap == &Map1)
-		{
-			CurrentMap = &Map2;
-			BackfillMap = &Map1;
-		}
-		else
-		{
-			CurrentMap = &Map1;
-			BackfillMap = &Map2;
-		}
+PipelineStateCache::FGraphicsPipelineState* PipelineStateCache::GetOrQueueGraphicsPipelineState(const GraphicsPipelineStateInitializer& Initializer)
+{
+	return FindOrAdd<FGraphicsPipelineState>(GGraphicsPipelineCache, Initializer, ECreation::Background, CreateGraphics);
+}
 
-		OutNewLockFlags = InCurrentLockFlags;
-		return Discarded;
-	}
+bool PipelineStateCache::IsComplete(const FGraphicsPipelineState* PipelineState)
+{
+	return PipelineState->IsComplete();
+}
 
-public:
-	uint32 ApplyLock(uint32 CurrentFlags, uint32 NewFlags)
+bool platform::Render::TrySetGraphicsPipelineState(CommandList& cmdlist, const GraphicsPipelineStateInitializer& initializer)
+{
+	if (!GPipelineStateAsyncCreation)
 	{
-		bool IsLockedForRead = (CurrentFlags & LockFlags::ReadLock) != 0;
-		bool IsLockedForWrite = (CurrentFlags & LockFlags::WriteLock) != 0;
-
-		bool WantLockForRead = (NewFlags & LockFlags::ReadLock) != 0;
-		bool WantLockForWrite = (NewFlags & LockFlags::WriteLock) != 0;
+		SetGraphicsPipelineState(cmdlist, initializer);
+		return true;
+	}
 
+	auto PipelineState = PipelineStateCache::GetOrQueueGraphicsPipelineState(initializer);
+	if (!PipelineState->IsComplete())
+		return false;
 
-		// if already locked for write, nothing to do
-		if (IsLockedForWrite && (WantLockForWrite || WantLockForRead))
-		{
-			return LockFlags::WriteLock;
-		}
+	auto IPipeline = PipelineStateCache::ExecuteSetGraphicsPipelineState(PipelineState);
+	if (!IPipeline)
+		return false;
 
-		// if locked for reads and that's all that's needed, d
-		if (IsLockedForRead && WantLockForRead && !WantLockForWrite)
-		{
-			return LockFlags::ReadLock;
-		}
+	cmdlist.SetGraphicsPipelineState(IPipeline);
+	return true;
+}
 
-		Unlock(CurrentFlags);
+PipelineStateCache::FComputePipelineState* PipelineStateCache::GetAndOrCreateComputePipelineState(ComputeCommandList& cmdlist, const ComputeHWShader* Shader)
+{
+	auto OutCachedState = FindOrAdd<FComputePipelineState>(GComputePipelineCache, Shader, ECreation::Immediate, CreateCompute);
 
-		// chance they asked for both Read/Write, so check this first
-		if (WantLockForWrite)
-		{
-			LockObject.lock();
-		}
-		else if (WantLockForRead)
-		{
-			LockObject.lock_shared();
-		}
+	OutCachedState->WaitCompletion();
+	OutCachedState->RethrowIfFailed();
 
-		return NewFlags;
-	}
+	return OutCachedState;
+}
 
-	void Unlock(uint32 Flags)
-	{
-		bool LockedForRead = (Flags & LockFlags::ReadLock) != 0;
-		bool LockedForWrite = (Flags & LockFlags::WriteLock) != 0;
+PipelineStateCache::Stats PipelineStateCache::GetStats()
+{
+	return {
+		.Hits = GPipelineStateStats.Hits.load(std::memory_order_relaxed),
+		.Misses = GPipelineStateStats.Misses.load(std::memory_order_relaxed),
+		.InFlightHits = GPipelineStateStats.InFlightHits.load(std::memory_order_relaxed),
+		.Pending = GPipelineStateStats.Pending.load(std::memory_order_relaxed),
+		.Created = GPipelineStateStats.Created.load(std::memory_order_relaxed),
+	};
+}
 
-		if (LockedForWrite)
-		{
-			LockObject.unlock();
-		}
-		else if (LockedForRead)
-		{
-			LockObject.unlock_shared();
-		}
-	}
+void PipelineStateCache::ResetStats()
+{
+	// Pending tracks live work and is not reset.
+	GPipelineStateStats.Hits = 0;
+	GPipelineStateStats.Misses = 0;
+	GPipelineStateStats.InFlightHits = 0;
+	GPipelineStateStats.Created = 0;
+}
 
-protected:
+void PipelineStateCache::WaitForPendingCreation()
+{
+	for (auto Pending = GPipelineStateStats.Pending.load(std::memory_order_acquire); Pending != 0; Pending = GPipelineStateStats.Pending.load(std::memory_order_acquire))
+		GPipelineStateStats.Pending.wait(Pending, std::memory_order_acquire);
+}
 
-	/**
-	*	Checks for the entry in our current map, and if not found the backfill. If the entry is in the backfill it is moved
-	*	to the current map so it will not be discarded when DiscardUnusedEntries is called
-	*/
-	bool  InternalFindWhileLocked(const KeyType& Key, ValueType& OutType, uint32 InCurrentLockFlags, uint32& OutFlags)
-	{
-		// by default we'll do exactly what was asked...
+/*
+Pipeline state list layout:
+	header: magic, version, bytes of the raw initializer tail, number of entries
+	entry: vertex, pixel, geometry, hull and domain shader hashes, number of vertex elements, the elements,
+		the initializer from RasterizerState on, stored as raw bytes the way PipelineStateCacheKeyFuncs hashes it
+*/
+namespace
+{
+	constexpr uint32 PipelineStateListMagic = 0x4C4F5350; // "PSOL"
+	constexpr uint32 PipelineStateListVersion = 1;
 
-		bool LockedForWrite = (InCurrentLockFlags & LockFlags::WriteLock) != 0;
-		bool LeaveWriteLockOnFailure = (InCurrentLockFlags & LockFlags::WriteLockOnAddFail) != 0;
+	constexpr std::size_t InitializerTailOffset = offsetof(GraphicsPipelineStateInitializer, RasterizerState);
+	constexpr uint32 InitializerTailSize = static_cast<uint32>(sizeof(GraphicsPipelineStateInitializer) - InitializerTailOffset);
 
-		uint32 CurrentFlags = InCurrentLockFlags;
+	template<typename T>
+	void Write(std::ofstream& File, const T& Value)
+	{
+		File.write(reinterpret_cast<const char*>(&Value), sizeof(T));
+	}
 
-		WAssert((CurrentFlags & LockFlags::ReadLock) != 0
-			|| (CurrentFlags & LockFlags::WriteLock) != 0,
-			"Cache is not locked for read or write during Find!");
+	template<typename T>
+	bool Read(std::ifstream& File, T& Value)
+	{
+		return static_cast<bool>(File.read(reinterpret_cast<char*>(&Value), sizeof(T)));
+	}
 
-		// Do we have this?
-		auto Found = CurrentMap->find(Key);
+	void GetShaderPassShaders(const ShaderPassInput& ShaderPass, HardwareShader* (&OutShaders)[5])
+	{
+		OutShaders[0] = ShaderPass.VertexShader;
+		OutShaders[1] = ShaderPass.PixelShader;
+		OutShaders[2] = ShaderPass.GeometryShader;
+		OutShaders[3] = ShaderPass.HullShader;
+		OutShaders[4] = ShaderPass.DomainShader;
+	}
+}
 
-		// If not check the backfill,  if it's there remove it add it to our map. 
-		if (Found == CurrentMap->end())
+bool PipelineStateCache::SaveGraphicsPipelineStateList(const std::filesystem::path& Path)
+{
+	std::vector<const GraphicsPipelineStateInitializer*> Initializers;
+	GGraphicsPipelineCache.ForEach([&](const GraphicsPipelineStateInitializer& Initializer, FGraphicsPipelineState* State) {
+		if (!State->IsComplete() || !State->IPipeline)
+			return;
+
+		HardwareShader* Shaders[5];
+		GetShaderPassShaders(Initializer.ShaderPass, Shaders);
+		for (auto Shader : Shaders)
 		{
-			auto BackfillFound = BackfillMap->find(Key);
+			// not loaded through a shader map, nothing to find it by on the next run
+			if (Shader && Shader->GetHash() == Digest::SHAHash{})
+				return;
+		}
+		Initializers.emplace_back(&Initializer);
+		});
 
-			// we either need to lock to adjust our cache, or lock because the user wants to...
-			bool NeedWriteLock = (BackfillFound != BackfillMap->end() || LeaveWriteLockOnFailure);
+	std::ofstream File(Path, std::ios::binary);
+	if (!File)
+		return false;
 
-			if (NeedWriteLock)
-			{
-				// lock the buffer (nop if we were already locked!)
-				CurrentFlags = ApplyLock(CurrentFlags, CurrentFlags | LockFlags::WriteLock);
-
-				// check again, there's a chance these may have changed filled between the unlock/lock
-				// above..
-				Found = CurrentMap->find(Key);
-				if (Found == CurrentMap->end())
-				{
-					BackfillFound = BackfillMap->find(Key);
-				}
-			}
+	Write(File, PipelineStateListMagic);
+	Write(File, PipelineStateListVersion);
+	Write(File, InitializerTailSize);
+	Write(File, static_cast<uint32>(Initializers.size()));
 
-			// If we found a backfill, move it to the primary
-			if (Found == CurrentMap->end() && BackfillFound != BackfillMap->end())
-			{
-				// if shared refs, add/remove order is important
-				Found = CurrentMap->emplace(Key, BackfillFound->second).first;
-				BackfillMap->erase(Key);
-			}
-		}
+	for (auto Initializer : Initializers)
+	{
+		HardwareShader* Shaders[5];
+		GetShaderPassShaders(Initializer->ShaderPass, Shaders);
+		for (auto Shader : Shaders)
+			Write(File, Shader ? Shader->GetHash() : Digest::SHAHash{});
 
-		if (Found != CurrentMap->end())
-		{
-			OutType = Found->second;
-		}
+		auto& VertexDeclaration = Initializer->ShaderPass.VertexDeclaration;
+		Write(File, static_cast<uint32>(VertexDeclaration.size()));
+		File.write(reinterpret_cast<const char*>(VertexDeclaration.data()), VertexDeclaration.size() * sizeof(VertexElement));
 
-		OutFlags = CurrentFlags;
-		return Found != CurrentMap->end();
+		File.write(reinterpret_cast<const char*>(Initializer) + InitializerTailOffset, InitializerTailSize);
 	}
 
+	return static_cast<bool>(File);
+}
 
-	std::shared_mutex			LockObject;
-	TypedMap* CurrentMap;
-	TypedMap* BackfillMap;
-	TypedMap		Map1;
-	TypedMap		Map2;
-};
-
-using FComputePipelineCache = DiscardableKeyValueCache<const ComputeHWShader*, PipelineStateCache::FComputePipelineState*>;
-FComputePipelineCache GComputePipelineCache;
-
-PipelineStateCache::FComputePipelineState* PipelineStateCache::GetAndOrCreateComputePipelineState(ComputeCommandList& cmdlist, const ComputeHWShader* Shader)
+uint32 PipelineStateCache::PrecacheGraphicsPipelineStateList(const std::filesystem::path& Path, const ShaderResolver& Resolve)
 {
-	FComputePipelineState* OutCachedState = nullptr;
-
-	uint32 LockFlags = GComputePipelineCache.ApplyLock(0, FComputePipelineCache::LockFlags::ReadLock);
+	std::ifstream File(Path, std::ios::binary);
 
-	bool WasFound = GComputePipelineCache.Find(Shader, OutCachedState, LockFlags | FComputePipelineCache::LockFlags::WriteLockOnAddFail, LockFlags);
+	uint32 Magic = 0, Version = 0, TailSize = 0, Num = 0;
+	if (!Read(File, Magic) || !Read(File, Version) || !Read(File, TailSize) || !Read(File, Num))
+		return 0;
+	// a list written by another build is stale, it is rewritten on exit
+	if (Magic != PipelineStateListMagic || Version != PipelineStateListVersion || TailSize != InitializerTailSize)
+		return 0;
 
-	if (!WasFound)
+	uint32 NumQueued = 0;
+	for (uint32 Index = 0; Index != Num; ++Index)
 	{
-		OutCachedState = new FComputePipelineState();
-
-		OutCachedState->IPipeline = white::share_raw(Context::Instance().GetDevice().CreateComputePipelineState(Shader));
-
-		GComputePipelineCache.Add(Shader, OutCachedState, LockFlags);
+		Digest::SHAHash Hashes[5];
+		for (auto& Hash : Hashes)
+			Read(File, Hash);
+
+		GraphicsPipelineStateInitializer Initializer;
+
+		uint32 NumElements = 0;
+		if (!Read(File, NumElements))
+			break;
+		Initializer.ShaderPass.VertexDeclaration.resize(NumElements);
+		File.read(reinterpret_cast<char*>(Initializer.ShaderPass.VertexDeclaration.data()), NumElements * sizeof(VertexElement));
+		File.read(reinterpret_cast<char*>(&Initializer) + InitializerTailOffset, InitializerTailSize);
+		if (!File)
+			break;
+
+		HardwareShader* Shaders[5] = {};
+		bool bResolved = true;
+		for (int i = 0; i != 5; ++i)
+		{
+			if (Hashes[i] == Digest::SHAHash{})
+				continue;
+			Shaders[i] = Resolve(Hashes[i]);
+			bResolved = bResolved && Shaders[i];
+		}
+		// a shader was removed or renamed since the list was written
+		if (!bResolved)
+			continue;
+
+		Initializer.ShaderPass.VertexShader = static_cast<VertexHWShader*>(Shaders[0]);
+		Initializer.ShaderPass.PixelShader = static_cast<PixelHWShader*>(Shaders[1]);
+		Initializer.ShaderPass.GeometryShader = static_cast<GeometryHWShader*>(Shaders[2]);
+		Initializer.ShaderPass.HullShader = Shaders[3];
+		Initializer.ShaderPass.DomainShader = Shaders[4];
+
+		GetOrQueueGraphicsPipelineState(Initializer);
+		++NumQueued;
 	}
 
-	GComputePipelineCache.Unlock(LockFlags);
-
-	return OutCachedState;
+	return NumQueued;
 }
 
-
-
+uint32 PipelineStateCache::PrecacheGraphicsPipelineStateList(const std::filesystem::path& Path)
+{
+	return PrecacheGraphicsPipelineStateList(Path, [](const Digest::SHAHash& Hash) {
+		return GetBuiltInShaderMap()->FindHWShader(Hash);
+		});
+}
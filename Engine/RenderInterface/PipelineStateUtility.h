@@ -1,18 +1,69 @@
 #pragma once
 
 #include "ICommandList.h"
+#include <filesystem>
+#include <functional>
 
 namespace platform::Render {
 	void SetGraphicsPipelineState(CommandList& cmdlist, const GraphicsPipelineStateInitializer& initializer);
 	void SetComputePipelineState(ComputeCommandList& cmdlist, const ComputeHWShader* Shader);
 
+	/*
+	\brief Binds the pipeline state if it has been created.
+	\return false when the state is still being created on a background worker, nothing is bound and the caller skips the draw or binds a fallback.
+	\note Same as SetGraphicsPipelineState unless GPipelineStateAsyncCreation is set.
+	*/
+	bool TrySetGraphicsPipelineState(CommandList& cmdlist, const GraphicsPipelineStateInitializer& initializer);
+
+	// Misses in TrySetGraphicsPipelineState are created on background workers instead of the calling thread.
+	bool extern GPipelineStateAsyncCreation;
 
 	namespace PipelineStateCache
 	{
 		class FGraphicsPipelineState;
 		class FComputePipelineState;
 
+		// Blocks until the state is created, a failed creation is rethrown to every caller.
 		FGraphicsPipelineState* GetAndOrCreateGraphicsPipelineState(CommandList& cmdlist, const GraphicsPipelineStateInitializer& initializer);
 		FComputePipelineState* GetAndOrCreateComputePipelineState(ComputeCommandList& cmdlist, const ComputeHWShader* Shader);
+
+		// Never blocks, a miss queues the creation on the background workers.
+		FGraphicsPipelineState* GetOrQueueGraphicsPipelineState(const GraphicsPipelineStateInitializer& initializer);
+
+		bool IsComplete(const FGraphicsPipelineState* PipelineState);
+
+		struct Stats
+		{
+			uint64 Hits;
+			uint64 Misses;
+			// Lookups that found a state still being created.
+			uint64 InFlightHits;
+			// States queued or being created right now.
+			uint64 Pending;
+			uint64 Created;
+		};
+
+		Stats GetStats();
+		void ResetStats();
+
+		// Blocks until the background workers have created every queued state.
+		void WaitForPendingCreation();
+
+		using ShaderResolver = std::function<HardwareShader*(const Digest::SHAHash&)>;
+
+		/*
+		\brief Writes the descriptor of every graphics state in the cache, shaders are referenced by hash.
+		\note States using a shader without a hash are skipped.
+		*/
+		bool SaveGraphicsPipelineStateList(const std::filesystem::path& Path);
+
+		/*
+		\brief Queues the creation of every descriptor in a saved list whose shaders Resolve finds.
+		\return The number of states queued.
+		*/
+		uint32 PrecacheGraphicsPipelineStateList(const std::filesystem::path& Path, const ShaderResolver& Resolve);
+
+		// Resolves shaders through the built-in shader map.
+		uint32 PrecacheGraphicsPipelineStateList(const std::filesystem::path& Path);
 	}
 }
\ No newline at end of file
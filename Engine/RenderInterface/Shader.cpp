@@ -339,7 +339,7 @@ namespace platform::Render::Shader
 		FillParameterMapByShaderInfo(Output.ParameterMap, *initializer.pInfo);
 
 		Output.GenerateOutputHash();
-		Output.CompressOutput(GetShaderCompressionFormat());
+		Output.CompressOutput(GetShaderCompressionCodec());
 	}
 
 	void InsertCompileOuput(BuiltInShaderMeta* meta, platform::Render::ShaderInitializer initializer, int32 PermutationId)
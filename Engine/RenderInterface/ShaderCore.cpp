@@ -152,7 +152,7 @@ void ShaderParameterMap::UpdateHash(Digest::SHA1& HashState) const
 	}
 }
 
-void ShaderCode::Compress(const std::string& ShaderCompressionFormat)
+void ShaderCode::Compress(const Compression::FormatCodec& Codec)
 {
 	WAssert(OptionalDataSize == -1, "ShaderCode::Compress() was called before calling ShaderCode::FinalizeShaderCode()");
 
@@ -161,14 +161,14 @@ void ShaderCode::Compress(const std::string& ShaderCompressionFormat)
 	Compressed.resize(CompressedSize);
 
 	// there is code that assumes that if CompressedSize == CodeSize, the shader isn't compressed. Because of that, do not accept equal compressed size (very unlikely anyway)
-	if (Compression::CompressMemory(ShaderCompressionFormat, Compressed.data(), CompressedSize, ShaderCodeWithOptionalData.data(),static_cast<int32>(ShaderCodeWithOptionalData.size())) && CompressedSize < static_cast<int32>(ShaderCodeWithOptionalData.size()))
+	if (Compression::CompressMemory(Codec.Codec, Codec.Level, Compressed.data(), CompressedSize, ShaderCodeWithOptionalData.data(),static_cast<int32>(ShaderCodeWithOptionalData.size())) && CompressedSize < static_cast<int32>(ShaderCodeWithOptionalData.size()))
 	{
 		// cache the ShaderCodeSize since it will no longer possible to get it as the reader will fail to parse the compressed data
 		ShaderCodeReader Wrapper(ShaderCodeWithOptionalData);
 		ShaderCodeSize = Wrapper.GetShaderCodeSize();
 
 		// finalize the compression
-		CompressionFormat = ShaderCompressionFormat;
+		CompressionFormat = Codec.Name;
 		UncompressedSize =static_cast<int32>(ShaderCodeWithOptionalData.size());
 
 		Compressed.resize(CompressedSize);
@@ -194,10 +194,10 @@ void ShaderCompilerOutput::GenerateOutputHash()
 	HashState.GetHash(&OutputHash.Hash[0]);
 }
 
-void ShaderCompilerOutput::CompressOutput(const std::string& ShaderCompressionFormat)
+void ShaderCompilerOutput::CompressOutput(const Compression::FormatCodec& Codec)
 {
 	// make sure the hash has been generated
 	WAssert(OutputHash !=Digest::SHAHash(), "Output hash must be generated before compressing the shader code.");
-	WAssert(!ShaderCompressionFormat.empty(), "Compression format should be valid");
-	ShaderCode.Compress(ShaderCompressionFormat);
+	WAssert(!Codec.Name.empty(), "Compression format should be valid");
+	ShaderCode.Compress(Codec);
 }
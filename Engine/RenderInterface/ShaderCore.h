@@ -8,6 +8,7 @@
 #include <optional>
 #include <WBase/span.hpp>
 #include "Core/Hash/MessageDigest.h"
+#include "Runtime/Compression.h"
 #include <cstddef>
 
 #if WFL_Win32
@@ -334,6 +335,8 @@ namespace platform::Render {
 		};
 
 		const std::string& GetShaderCompressionFormat();
+		//codec of GetShaderCompressionFormat,resolved once for all shaders
+		const WhiteEngine::Compression::FormatCodec& GetShaderCompressionCodec();
 
 		#ifndef WB_ATTRIBUTE_UNALIGNED
 		// TODO find out if using GCC_ALIGN(1) instead of this new #define break on all kinds of platforms...
@@ -532,7 +535,7 @@ namespace platform::Render {
 				}
 			}
 
-			void Compress(const std::string& ShaderCompressionFormat);
+			void Compress(const WhiteEngine::Compression::FormatCodec& Codec);
 
 			// Write access for regular microcode: Optional Data must be added AFTER regular microcode and BEFORE Finalize
 			std::vector<uint8>& GetWriteAccess()
@@ -622,7 +625,7 @@ namespace platform::Render {
 			ShaderParameterMap ParameterMap;
 			Digest::SHAHash OutputHash;
 
-			void CompressOutput(const std::string& ShaderCompressionFormat);
+			void CompressOutput(const WhiteEngine::Compression::FormatCodec& Codec);
 
 			void GenerateOutputHash();
 		};
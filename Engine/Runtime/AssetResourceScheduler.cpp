@@ -3,7 +3,14 @@
 
 namespace platform {
 
-	ImplDeCtor(AssetResourceScheduler)
+	AssetResourceScheduler::AssetResourceScheduler()
+	{
+		stats.budget_bytes = 1ull << 30;
+		asset_loaded_caches.flush = [this](decltype(asset_loaded_caches)::value_type& value) {
+			stats.resident_bytes -= value.second.bytes;
+			++stats.evictions;
+		};
+	}
 
 	AssetResourceScheduler::~AssetResourceScheduler()
 	{
@@ -16,12 +23,47 @@ namespace platform {
 		static AssetResourceScheduler instance;
 		return instance;
 	}
-	const asset::path& AssetResourceScheduler::FindAssetPath(const void * pAsset)
+	asset::path AssetResourceScheduler::FindAssetPath(const void * pAsset)
 	{
+		std::shared_lock read_lock{ caches_mutex };
 		for (auto &pair : asset_loaded_caches) {
 			if (pair.second.loaded_asset.get() == pAsset)
 				return pair.first->Path();
 		}
 		throw white::GeneralEvent(white::sfmt("Can't Find Asset's loader,so can't retrieve path pAsset=%p", pAsset));
 	}
+
+	AssetResourceScheduler::CacheStats AssetResourceScheduler::GetStats()
+	{
+		std::shared_lock read_lock{ caches_mutex };
+		return stats;
+	}
+
+	void AssetResourceScheduler::ResetStats()
+	{
+		std::unique_lock write_lock{ caches_mutex };
+		stats.hits = stats.misses = stats.coalesced = stats.evictions = 0;
+	}
+
+	void AssetResourceScheduler::SetBudget(std::size_t budget_bytes)
+	{
+		std::unique_lock write_lock{ caches_mutex };
+		stats.budget_bytes = budget_bytes;
+		EvictOverBudget();
+	}
+
+	void AssetResourceScheduler::EvictOverBudget()
+	{
+		//walk from the least recently used,keep the most recent one even if it alone exceeds budget
+		auto itr = asset_loaded_caches.end();
+		while (stats.resident_bytes > stats.budget_bytes && itr != asset_loaded_caches.begin())
+		{
+			if (--itr == asset_loaded_caches.begin())
+				break;
+			//still referenced outside the cache,evicting it would only lose its path
+			if (itr->second.loaded_asset.use_count() > 1)
+				continue;
+			itr = asset_loaded_caches.erase(itr);
+		}
+	}
 }
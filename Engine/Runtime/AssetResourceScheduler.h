@@ -12,6 +12,9 @@
 #include "Core/Coroutine/SyncWait.h"
 #include <WBase/sutility.h>
 #include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 
 namespace platform {
 
@@ -29,28 +32,67 @@ namespace platform {
 		{
 			std::shared_ptr<asset::IAssetLoading> key{ new Loading(wforward(args)...) };
 
+			std::shared_ptr<InFlightLoad> inflight;
 			{
-				std::shared_lock read_lock{ caches_mutex };
+				//find refresh used list,so it's a write
+				std::unique_lock write_lock{ caches_mutex };
 				auto itr = asset_loaded_caches.find(key);
 				if (itr != asset_loaded_caches.end()) {
+					++stats.hits;
 					co_return std::static_pointer_cast<typename Loading::AssetType>(itr->second.loaded_asset);
 				}
+
+				auto [inflight_itr, inserted] = inflight_loads.try_emplace(key);
+				if (!inserted)
+				{
+					++stats.coalesced;
+					inflight = inflight_itr->second;
+				}
+				else
+				{
+					++stats.misses;
+					inflight_itr->second = std::make_shared<InFlightLoad>();
+				}
 			}
 
+			//another coroutine is loading the same asset
+			if (inflight)
+				co_return std::static_pointer_cast<typename Loading::AssetType>(co_await *inflight);
+
 			std::shared_ptr<Loading> loading = std::static_pointer_cast<Loading>(key);
 			std::shared_ptr<typename Loading::AssetType> ret{};
 
-			ret = co_await loading->GetAwaiter();
-			AssetLoadedDesc desc;
-			desc.loaded_asset = std::static_pointer_cast<void>(ret);
-			desc.loaded_tick = 0;
-			desc.delay_tick = 0;
+			std::exception_ptr exception;
+			try {
+				ret = co_await loading->GetAwaiter();
+			}
+			catch (...) {
+				exception = std::current_exception();
+			}
 
 			{
 				std::unique_lock write_lock{ caches_mutex };
-				asset_loaded_caches.emplace(key, desc);
+				auto inflight_itr = inflight_loads.find(key);
+				inflight = inflight_itr->second;
+				inflight_loads.erase(inflight_itr);
+
+				if (!exception && ret)
+				{
+					AssetLoadedDesc desc;
+					desc.loaded_asset = std::static_pointer_cast<void>(ret);
+					desc.bytes = loading->GetAssetBytes(*ret);
+
+					if (asset_loaded_caches.emplace(key, desc).second)
+						stats.resident_bytes += desc.bytes;
+					EvictOverBudget();
+				}
 			}
 
+			inflight->Complete(std::static_pointer_cast<void>(ret), exception);
+
+			if (exception)
+				std::rethrow_exception(exception);
+
 			co_return ret;
 		}
 
@@ -60,22 +102,90 @@ namespace platform {
 		static AssetResourceScheduler& Instance();
 
 		//\brief ȡĳԴ·,޷ȡʱ׳쳣
-		const asset::path& FindAssetPath(const void* pAsset);
+		asset::path FindAssetPath(const void* pAsset);
+
+		struct CacheStats {
+			white::uint64 hits = 0;
+			white::uint64 misses = 0;
+			//request which awaited another in-flight load
+			white::uint64 coalesced = 0;
+			white::uint64 evictions = 0;
+			std::size_t resident_bytes = 0;
+			std::size_t budget_bytes = 0;
+		};
+
+		CacheStats GetStats();
+		void ResetStats();
+
+		//\brief evict least recently used assets until resident bytes fit budget
+		//\note assets still referenced outside the cache are kept,FindAssetPath must find them
+		void SetBudget(std::size_t budget_bytes);
 
 	private:
 		AssetResourceScheduler();
 		~AssetResourceScheduler();
 
+		//\pre caches_mutex locked
+		void EvictOverBudget();
+
 	private:
 		struct AssetLoadedDesc {
-			//@{
-			/*!\breif loaded_tick delay_tickLoaded֮ˢ
-			   \warning SpawnResource ˢ״̬
-			*/
-			white::uint32 loaded_tick;
-			white::uint8 delay_tick;
-			//@}
+			//\brief bytes reported by IAssetLoading,used by budget eviction
+			std::size_t bytes = 0;
+			std::shared_ptr<void> loaded_asset;
+		};
+
+		class InFlightLoad {
+		public:
+			struct awaiter {
+				InFlightLoad& load;
+
+				bool await_ready() const noexcept
+				{
+					return load.ready.load(std::memory_order_acquire);
+				}
+
+				bool await_suspend(std::coroutine_handle<> handle)
+				{
+					std::unique_lock lock{ load.waiters_mutex };
+					if (load.ready.load(std::memory_order_acquire))
+						return false;
+					load.waiters.emplace_back(handle);
+					return true;
+				}
+
+				std::shared_ptr<void> await_resume()
+				{
+					if (load.exception)
+						std::rethrow_exception(load.exception);
+					return load.loaded_asset;
+				}
+			};
+
+			awaiter operator co_await() noexcept
+			{
+				return { *this };
+			}
+
+			void Complete(std::shared_ptr<void> asset, std::exception_ptr e)
+			{
+				std::vector<std::coroutine_handle<>> resumes;
+				{
+					std::unique_lock lock{ waiters_mutex };
+					loaded_asset = std::move(asset);
+					exception = e;
+					ready.store(true, std::memory_order_release);
+					resumes.swap(waiters);
+				}
+				for (auto handle : resumes)
+					handle.resume();
+			}
+		private:
+			std::atomic<bool> ready = false;
+			std::mutex waiters_mutex;
+			std::vector<std::coroutine_handle<>> waiters;
 			std::shared_ptr<void> loaded_asset;
+			std::exception_ptr exception;
 		};
 
 		struct IAssetLoadingHash {
@@ -86,12 +196,16 @@ namespace platform {
 
 		struct IAssetLoadingEqual {
 			bool operator()(const std::shared_ptr<asset::IAssetLoading>& lhs, const std::shared_ptr<asset::IAssetLoading>& rhs) const wnoexcept {
-				return lhs->Hash() == rhs->Hash();
+				return lhs->Hash() == rhs->Hash() && lhs->Type() == rhs->Type() && lhs->Path() == rhs->Path();
 			}
 		};
 
 		white::used_list_cache<std::shared_ptr<asset::IAssetLoading>, AssetLoadedDesc, IAssetLoadingEqual, IAssetLoadingHash> asset_loaded_caches{ 8192 };
 
+		std::unordered_map<std::shared_ptr<asset::IAssetLoading>, std::shared_ptr<InFlightLoad>, IAssetLoadingHash, IAssetLoadingEqual> inflight_loads;
+
+		CacheStats stats;
+
 		std::shared_mutex caches_mutex;
 	};
 }
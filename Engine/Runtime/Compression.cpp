@@ -1,34 +1,251 @@
+#define LZ4_STATIC_LINKING_ONLY
 #include "Compression.h"
 #include "Core/Compression/lz4hc.h"
+#include "Runtime/ParallelFor.h"
+#include <WBase/cassert.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
 
 namespace WhiteEngine
 {
 	std::string NAME_LZ4 = "LZ4";
 
-	bool Compression::CompressMemory(const std::string& FormatName, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, int32 CompressionData)
+	namespace
 	{
-		bool bCompressSucceeded = false;
+		using namespace Compression;
+
+		struct Codec
+		{
+			CodecInfo Info;
+
+			int (*Compress)(const char* src, char* dst, int srcSize, int dstCapacity, int level);
+		};
+
+		const Codec Codecs[] = {
+			{
+				{"LZ4",1,65537,1},
+				[](const char* src, char* dst, int srcSize, int dstCapacity, int level) {
+					return LZ4_compress_fast(src, dst, srcSize, dstCapacity, level);
+				}
+			},
+			{
+				{"LZ4HC",LZ4HC_CLEVEL_MIN,LZ4HC_CLEVEL_MAX,LZ4HC_CLEVEL_DEFAULT},
+				[](const char* src, char* dst, int srcSize, int dstCapacity, int level) {
+					return LZ4_compress_HC(src, dst, srcSize, dstCapacity, level);
+				}
+			},
+		};
+
+		static_assert(std::size(Codecs) == static_cast<std::size_t>(ECodec::Count));
+
+		const Codec& GetCodec(ECodec InCodec)
+		{
+			wconstraint(InCodec < ECodec::Count);
+			return Codecs[static_cast<std::size_t>(InCodec)];
+		}
+
+		constexpr uint32 RawChunkFlag = 1u << 31;
 
-		if (_strnicmp(NAME_LZ4.c_str(), FormatName.c_str(), NAME_LZ4.size()) == 0)
+		int32 GetNumChunks(int32 UncompressedSize, int32 ChunkSize)
 		{
-			// hardcoded lz4
-			CompressedSize = LZ4_compress_HC((const char*)UncompressedBuffer, (char*)CompressedBuffer, UncompressedSize, CompressedSize, LZ4HC_CLEVEL_MAX);
-			bCompressSucceeded = CompressedSize > 0;
+			return (UncompressedSize + ChunkSize - 1) / ChunkSize;
 		}
 
-		return bCompressSucceeded;
+		int32 GetChunkedHeaderSize(int32 NumChunks)
+		{
+			return static_cast<int32>(sizeof(uint32) * (2 + NumChunks));
+		}
 	}
 
-	bool Compression::UnCompressMemory(const std::string& FormatName, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize)
+	const Compression::CodecInfo& Compression::GetCodecInfo(ECodec Codec)
+	{
+		return GetCodec(Codec).Info;
+	}
+
+	Compression::ECodec Compression::FindCodec(const std::string& FormatName)
+	{
+		for (std::size_t i = 0; i != std::size(Codecs); ++i)
+		{
+			if (_stricmp(Codecs[i].Info.Name, FormatName.c_str()) == 0)
+				return static_cast<ECodec>(i);
+		}
+		return ECodec::Invalid;
+	}
+
+	Compression::FormatCodec Compression::FindFormatCodec(const std::string& FormatName)
+	{
+		auto Codec = FindCodec(FormatName);
+		if (Codec == ECodec::Invalid)
+			return {};
+
+		// hardcoded lz4
+		if (Codec == ECodec::LZ4)
+			return { ECodec::LZ4HC,LZ4HC_CLEVEL_MAX,FormatName };
+
+		return { Codec,GetCodecInfo(Codec).DefaultLevel,FormatName };
+	}
+
+	int32 Compression::CompressMemoryBound(ECodec Codec, int32 UncompressedSize)
+	{
+		return LZ4_compressBound(UncompressedSize);
+	}
+
+	bool Compression::CompressMemory(ECodec Codec, int32 Level, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize)
+	{
+		if (Codec >= ECodec::Count)
+			return false;
+
+		auto& Info = GetCodec(Codec).Info;
+		Level = std::clamp(Level, Info.MinLevel, Info.MaxLevel);
+
+		CompressedSize = GetCodec(Codec).Compress((const char*)UncompressedBuffer, (char*)CompressedBuffer, UncompressedSize, CompressedSize, Level);
+		return CompressedSize > 0;
+	}
+
+	bool Compression::UnCompressMemory(ECodec Codec, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize)
+	{
+		if (Codec >= ECodec::Count)
+			return false;
+
+		return LZ4_decompress_safe((const char*)CompressedBuffer, (char*)UncompressedBuffer, CompressedSize, UncompressedSize) == UncompressedSize;
+	}
+
+	int32 Compression::GetInPlaceBufferSize(ECodec Codec, int32 UncompressedSize)
 	{
-		bool bUncompressSucceeded = false;
+		return LZ4_DECOMPRESS_INPLACE_BUFFER_SIZE(UncompressedSize);
+	}
+
+	bool Compression::UnCompressMemoryInPlace(ECodec Codec, void* Buffer, int32 BufferSize, int32 UncompressedSize, int32 CompressedSize)
+	{
+		if (Codec >= ECodec::Count || BufferSize < GetInPlaceBufferSize(Codec, UncompressedSize) || CompressedSize > BufferSize)
+			return false;
+
+		auto Compressed = (const char*)Buffer + BufferSize - CompressedSize;
+		return LZ4_decompress_safe(Compressed, (char*)Buffer, CompressedSize, UncompressedSize) == UncompressedSize;
+	}
+
+	int32 Compression::CompressMemoryChunkedBound(ECodec Codec, int32 UncompressedSize, int32 ChunkSize)
+	{
+		auto NumChunks = GetNumChunks(UncompressedSize, ChunkSize);
+
+		//raw chunk fallback bound every chunk by ChunkSize
+		return GetChunkedHeaderSize(NumChunks) + UncompressedSize;
+	}
+
+	bool Compression::CompressMemoryChunked(ECodec Codec, int32 Level, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, int32 ChunkSize)
+	{
+		if (Codec >= ECodec::Count || ChunkSize <= 0)
+			return false;
+
+		auto NumChunks = GetNumChunks(UncompressedSize, ChunkSize);
+		auto HeaderSize = GetChunkedHeaderSize(NumChunks);
+		if (CompressedSize < HeaderSize)
+			return false;
+
+		//codec and level are resolved once for all chunks
+		auto Compress = GetCodec(Codec).Compress;
+		Level = std::clamp(Level, GetCodecInfo(Codec).MinLevel, GetCodecInfo(Codec).MaxLevel);
+
+		auto ChunkBound = CompressMemoryBound(Codec, ChunkSize);
+		std::vector<uint8> Scratch(static_cast<std::size_t>(ChunkBound) * NumChunks);
+		std::vector<uint32> ChunkSizes(NumChunks);
+
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+			{
+				auto Offset = ChunkIndex * ChunkSize;
+				auto RawSize = std::min(ChunkSize, UncompressedSize - Offset);
+				auto Src = (const uint8*)UncompressedBuffer + Offset;
+				auto Dst = Scratch.data() + static_cast<std::size_t>(ChunkBound) * ChunkIndex;
+
+				int32 ChunkCompressedSize = Compress((const char*)Src, (char*)Dst, RawSize, ChunkBound, Level);
+				if (ChunkCompressedSize > 0 && ChunkCompressedSize < RawSize)
+					ChunkSizes[ChunkIndex] = ChunkCompressedSize;
+				else
+				{
+					std::memcpy(Dst, Src, RawSize);
+					ChunkSizes[ChunkIndex] = RawSize | RawChunkFlag;
+				}
+			});
+
+		auto Header = (uint32*)CompressedBuffer;
+		Header[0] = ChunkSize;
+		Header[1] = NumChunks;
+
+		auto Dst = (uint8*)CompressedBuffer + HeaderSize;
+		auto DstEnd = (uint8*)CompressedBuffer + CompressedSize;
+		for (int32 ChunkIndex = 0; ChunkIndex != NumChunks; ++ChunkIndex)
+		{
+			auto Size = ChunkSizes[ChunkIndex] & ~RawChunkFlag;
+			if (Dst + Size > DstEnd)
+				return false;
 
-		if (_strnicmp(NAME_LZ4.c_str(), FormatName.c_str(), NAME_LZ4.size()) == 0)
+			Header[2 + ChunkIndex] = ChunkSizes[ChunkIndex];
+			std::memcpy(Dst, Scratch.data() + static_cast<std::size_t>(ChunkBound) * ChunkIndex, Size);
+			Dst += Size;
+		}
+
+		CompressedSize = static_cast<int32>(Dst - (uint8*)CompressedBuffer);
+		return true;
+	}
+
+	bool Compression::UnCompressMemoryChunked(ECodec Codec, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize)
+	{
+		if (Codec >= ECodec::Count || CompressedSize < GetChunkedHeaderSize(0))
+			return false;
+
+		auto Header = (const uint32*)CompressedBuffer;
+		auto ChunkSize = static_cast<int32>(Header[0]);
+		auto NumChunks = static_cast<int32>(Header[1]);
+		if (ChunkSize <= 0 || NumChunks != GetNumChunks(UncompressedSize, ChunkSize) || CompressedSize < GetChunkedHeaderSize(NumChunks))
+			return false;
+
+		std::vector<int32> ChunkOffsets(NumChunks);
+		int32 Offset = GetChunkedHeaderSize(NumChunks);
+		for (int32 ChunkIndex = 0; ChunkIndex != NumChunks; ++ChunkIndex)
 		{
-			// hardcoded lz4
-			bUncompressSucceeded = LZ4_decompress_safe((const char*)CompressedBuffer, (char*)UncompressedBuffer, CompressedSize, UncompressedSize) > 0;
+			ChunkOffsets[ChunkIndex] = Offset;
+			Offset += Header[2 + ChunkIndex] & ~RawChunkFlag;
 		}
+		if (Offset > CompressedSize)
+			return false;
+
+		std::atomic<bool> bSucceeded = true;
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+			{
+				auto RawSize = std::min(ChunkSize, UncompressedSize - ChunkIndex * ChunkSize);
+				auto Src = (const uint8*)CompressedBuffer + ChunkOffsets[ChunkIndex];
+				auto Dst = (uint8*)UncompressedBuffer + ChunkIndex * ChunkSize;
+				auto SizeAndFlag = Header[2 + ChunkIndex];
+
+				if (SizeAndFlag & RawChunkFlag)
+				{
+					if (static_cast<int32>(SizeAndFlag & ~RawChunkFlag) != RawSize)
+						bSucceeded = false;
+					else
+						std::memcpy(Dst, Src, RawSize);
+				}
+				else if (LZ4_decompress_safe((const char*)Src, (char*)Dst, static_cast<int32>(SizeAndFlag), RawSize) != RawSize)
+					bSucceeded = false;
+			});
+
+		return bSucceeded;
+	}
+
+	bool Compression::CompressMemory(const std::string& FormatName, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, int32 CompressionData)
+	{
+		auto Format = FindFormatCodec(FormatName);
+
+		return CompressMemory(Format.Codec, Format.Level, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize);
+	}
+
+	bool Compression::UnCompressMemory(const std::string& FormatName, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize)
+	{
+		auto Codec = FindCodec(FormatName);
+		if (Codec == ECodec::Invalid)
+			return false;
 
-		return bUncompressSucceeded;
+		return UnCompressMemory(Codec, UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
 	}
-}
\ No newline at end of file
+}
@@ -8,8 +8,80 @@ namespace WhiteEngine
 
 	namespace Compression
 	{
+		//all codecs of LZ4 family share the LZ4 block format,they only differ in encoder
+		enum class ECodec : uint8
+		{
+			//level is acceleration factor,higher is faster
+			LZ4,
+			//level between LZ4HC_CLEVEL_MIN and LZ4HC_CLEVEL_MAX,levels >= LZ4HC_CLEVEL_OPT_MIN use optimal parser
+			LZ4HC,
+
+			Count,
+			Invalid = Count
+		};
+
+		struct CodecInfo
+		{
+			const char* Name;
+			int32 MinLevel;
+			int32 MaxLevel;
+			int32 DefaultLevel;
+		};
+
+		const CodecInfo& GetCodecInfo(ECodec Codec);
+
+		//\brief resolve a format name once,ECodec::Invalid if unknown
+		ECodec FindCodec(const std::string& FormatName);
+
+		//codec and level a format name compress with
+		struct FormatCodec
+		{
+			ECodec Codec = ECodec::Invalid;
+			int32 Level = 0;
+			//the format name it was resolved from,stored with the compressed data
+			std::string Name;
+		};
+
+		//\brief resolve a format name once per stream,format name "LZ4" map to LZ4HC max level
+		FormatCodec FindFormatCodec(const std::string& FormatName);
+
+		int32 CompressMemoryBound(ECodec Codec, int32 UncompressedSize);
+
+		bool CompressMemory(ECodec Codec, int32 Level, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize);
+
+		bool UnCompressMemory(ECodec Codec, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize);
+
+		//\brief size of buffer which can decompress compressed data stored at its tail
+		int32 GetInPlaceBufferSize(ECodec Codec, int32 UncompressedSize);
+
+		/*!
+		\brief decompress into the same buffer
+		\pre compressed data is stored at [Buffer + BufferSize - CompressedSize,Buffer + BufferSize)
+		\pre BufferSize >= GetInPlaceBufferSize(Codec,UncompressedSize)
+		*/
+		bool UnCompressMemoryInPlace(ECodec Codec, void* Buffer, int32 BufferSize, int32 UncompressedSize, int32 CompressedSize);
+
+		/*!
+		\brief chunked stream,each chunk is compressed independently and in parallel
+		layout: uint32 ChunkSize,uint32 NumChunks,uint32 ChunkCompressedSize[NumChunks],chunks...
+		\note chunk which can't be compressed is stored raw and flagged by the high bit of its size
+		*/
+		//@{
+		constexpr int32 DefaultChunkSize = 256 * 1024;
+
+		int32 CompressMemoryChunkedBound(ECodec Codec, int32 UncompressedSize, int32 ChunkSize = DefaultChunkSize);
+
+		bool CompressMemoryChunked(ECodec Codec, int32 Level, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, int32 ChunkSize = DefaultChunkSize);
+
+		bool UnCompressMemoryChunked(ECodec Codec, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize);
+		//@}
+
+		//\note format name "LZ4" keep LZ4HC max level for compatibility of existing caches
+		//\note resolve the name on every call,streams of many buffers should use FindFormatCodec
+		//@{
 		bool CompressMemory(const std::string& FormatName, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize,int32 CompressionData = 0);
 
 		bool UnCompressMemory(const std::string& FormatName, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize);
+		//@}
 	}
-}
\ No newline at end of file
+}
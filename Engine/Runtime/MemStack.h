@@ -70,6 +70,21 @@ namespace WhiteEngine
 			return Result;
 		}
 
+		/** Grows the last allocation in place, returns nullptr unless Expected is the current top and the chunk has room. */
+		void* AllocContiguous(const void* Expected, int32 AllocSize)
+		{
+			wconstraint(AllocSize >= 0);
+
+			if (Top != Expected || Top + AllocSize > End)
+			{
+				return nullptr;
+			}
+
+			uint8* Result = Top;
+			Top += AllocSize;
+			return Result;
+		}
+
 		/** return true if this stack is empty. */
 		bool IsEmpty() const
 		{
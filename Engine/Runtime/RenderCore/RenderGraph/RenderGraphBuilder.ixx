@@ -4,6 +4,7 @@ module;
 #include "RenderInterface/DeviceCaps.h"
 
 #include <span>
+#include <algorithm>
 
 export module RenderGraph:builder;
 
@@ -71,6 +72,14 @@ export namespace RenderGraph
 
 		RGArray<RGViewHandle> Views;
 
+		/** Buffers accessed by the pass, each listed once. */
+		RGArray<RGBufferRef> Buffers;
+
+		/** Passes whose writes this pass reads or modifies. */
+		RGArray<RGPassHandle> Producers;
+
+		uint8 bCulled : 1 = 0;
+
 		friend RGPassRegistry;
 		friend RGBuilder;
 	};
@@ -181,6 +190,21 @@ export namespace RenderGraph
 		}
 	}
 
+	/** Result of RGBuilder::Compile, kept around for profiling and headless validation of graphs. */
+	struct RGCompileStats
+	{
+		uint32 PassCount = 0;
+		uint32 CulledPassCount = 0;
+
+		uint32 TransientBufferCount = 0;
+		/** Bytes the transient buffers would need without aliasing. */
+		uint64 TransientBufferBytes = 0;
+
+		/** Shared allocations backing the transient buffers and their total size. */
+		uint32 TransientAllocationCount = 0;
+		uint64 PeakTransientBytes = 0;
+	};
+
 	template <typename TAccessFunction>
 	void EnumerateBufferAccess(RGParameterStruct PassParameters, ERGPassFlags PassFlags, TAccessFunction AccessFunction)
 	{
@@ -219,7 +243,6 @@ export namespace RenderGraph
 	public:
 		RGBuilder(CommandListImmediate& InCmdList, RGEventName InName = {}, ERGBuilderFlags Flags = ERGBuilderFlags::None)
 			:CmdList(InCmdList), BuilderName(InName)
-			, bParallelSetupEnabled(white::has_anyflags(Flags, ERGBuilderFlags::AllowParallelExecute))
 			, bParallelExecuteEnabled(white::has_anyflags(Flags, ERGBuilderFlags::AllowParallelExecute))
 		{}
 
@@ -364,9 +387,222 @@ export namespace RenderGraph
 			return Buffer;
 		}
 
+		/**
+		 * Culls passes whose outputs are never consumed, computes buffer lifetimes over the remaining passes
+		 * and aliases transient buffers with disjoint lifetimes onto shared allocations.
+		 * Doesn't touch the RHI, called by Execute if needed.
+		 */
+		const RGCompileStats& Compile()
+		{
+			if (bCompiled)
+				return Stats;
+			bCompiled = true;
+
+			Stats = {};
+			Stats.PassCount = Passes.Num();
+			TransientSlots.clear();
+
+			CullPasses();
+			ComputeBufferLifetimes();
+			AllocateTransientSlots();
+
+			return Stats;
+		}
+
+		const RGCompileStats& GetCompileStats() const
+		{
+			return Stats;
+		}
+
 		void Execute()
-		{}
+		{
+			Compile();
+
+			for (auto& Slot : TransientSlots)
+			{
+				Slot.Allocation = GRenderGraphResourcePool.FindFreeBuffer(Slot.Desc, Slot.Name);
+			}
+
+			for (auto Handle = Passes.Begin(); Handle != Passes.End(); ++Handle)
+			{
+				auto Pass = Passes[Handle];
+				if (Pass->bCulled)
+					continue;
+
+				for (auto Buffer : Pass->Buffers)
+				{
+					if (Buffer->FirstPass == Handle)
+						BeginResource(Handle, Buffer);
+				}
+
+				Pass->Execute(CmdList);
+			}
+
+			// The pool hands allocations out again once nothing else references them.
+			TransientSlots.clear();
+		}
 	private:
+		struct RGTransientSlot
+		{
+			RGBufferDesc Desc;
+			const char* Name;
+			bool bFree;
+
+			white::ref_ptr<RGPooledBuffer> Allocation;
+		};
+
+		void CullPasses()
+		{
+			// Start from passes with side effects and keep everything they depend on.
+			RGArray<RGPassHandle> Stack;
+
+			for (auto Handle = Passes.Begin(); Handle != Passes.End(); ++Handle)
+			{
+				auto Pass = Passes[Handle];
+				Pass->bCulled = 1;
+
+				if (white::has_anyflags(Pass->Flags, ERGPassFlags::NeverCull))
+					Stack.emplace_back(Handle);
+			}
+
+			Buffers.Enumerate([&](RGBuffer* Buffer)
+				{
+					if (Buffer->bExternal && Buffer->LastProducer.IsValid())
+						Stack.emplace_back(Buffer->LastProducer);
+				});
+
+			while (!Stack.empty())
+			{
+				auto Pass = Passes[Stack.back()];
+				Stack.pop_back();
+
+				if (!Pass->bCulled)
+					continue;
+				Pass->bCulled = 0;
+
+				Stack.insert(Stack.end(), Pass->Producers.begin(), Pass->Producers.end());
+			}
+
+			Passes.Enumerate([&](const RGPass* Pass)
+				{
+					Stats.CulledPassCount += Pass->bCulled;
+				});
+		}
+
+		void ComputeBufferLifetimes()
+		{
+			Buffers.Enumerate([](RGBuffer* Buffer)
+				{
+					if (!Buffer->HasRObject())
+						Buffer->FirstPass = RGPassHandle::Null;
+					Buffer->LastPass = RGPassHandle::Null;
+				});
+
+			for (auto Handle = Passes.Begin(); Handle != Passes.End(); ++Handle)
+			{
+				auto Pass = Passes[Handle];
+				if (Pass->bCulled)
+					continue;
+
+				for (auto Buffer : Pass->Buffers)
+				{
+					Buffer->FirstPass = RGPassHandle::Min(Buffer->FirstPass, Handle);
+					Buffer->LastPass = RGPassHandle::Max(Buffer->LastPass, Handle);
+				}
+			}
+
+			Buffers.Enumerate([](RGBuffer* Buffer)
+				{
+					Buffer->bTransient = !Buffer->bExternal && !Buffer->bForceNonTransient && !Buffer->HasRObject()
+						&& !white::has_anyflags(Buffer->Flags, ERGBufferFlags::MultiFrame)
+						&& Buffer->LastPass.IsValid();
+				});
+		}
+
+		/**
+		 * Sweeps the passes in order, acquiring a slot when a transient buffer is first used and releasing it after its last use.
+		 * Buffers only share a slot when usage and stride match since the RHI has no placed resources,
+		 * the slot is sized for its largest occupant.
+		 */
+		void AllocateTransientSlots()
+		{
+			RGArray<RGBufferRef> ByFirstPass;
+			Buffers.Enumerate([&](RGBuffer* Buffer)
+				{
+					if (Buffer->bTransient)
+						ByFirstPass.emplace_back(Buffer);
+				});
+
+			RGArray<RGBufferRef> ByLastPass = ByFirstPass;
+			std::stable_sort(ByFirstPass.begin(), ByFirstPass.end(), [](RGBufferRef A, RGBufferRef B) { return A->FirstPass < B->FirstPass; });
+			std::stable_sort(ByLastPass.begin(), ByLastPass.end(), [](RGBufferRef A, RGBufferRef B) { return A->LastPass < B->LastPass; });
+
+			auto Acquire = [&](RGBufferRef Buffer)
+				{
+					uint32 BestFit = ~0u;
+					uint32 Largest = ~0u;
+					for (uint32 i = 0; i < TransientSlots.size(); ++i)
+					{
+						const auto& Slot = TransientSlots[i];
+						if (!Slot.bFree || Slot.Desc.Usage != Buffer->Desc.Usage || Slot.Desc.BytesPerElement != Buffer->Desc.BytesPerElement)
+							continue;
+
+						if (Slot.Desc.NumElements >= Buffer->Desc.NumElements)
+						{
+							if (BestFit == ~0u || Slot.Desc.NumElements < TransientSlots[BestFit].Desc.NumElements)
+								BestFit = i;
+						}
+						else if (Largest == ~0u || Slot.Desc.NumElements > TransientSlots[Largest].Desc.NumElements)
+						{
+							Largest = i;
+						}
+					}
+
+					// Growing a free slot costs less than opening a new one.
+					if (BestFit == ~0u)
+						BestFit = Largest;
+
+					if (BestFit == ~0u)
+					{
+						BestFit = static_cast<uint32>(TransientSlots.size());
+						TransientSlots.emplace_back(RGTransientSlot{ .Desc = Buffer->Desc, .Name = Buffer->Name, .bFree = true });
+					}
+
+					auto& Slot = TransientSlots[BestFit];
+					Slot.Desc.NumElements = std::max(Slot.Desc.NumElements, Buffer->Desc.NumElements);
+					Slot.bFree = false;
+
+					Buffer->TransientSlot = BestFit;
+
+					++Stats.TransientBufferCount;
+					Stats.TransientBufferBytes += Buffer->Desc.GetSize();
+				};
+
+			auto FirstItr = ByFirstPass.begin();
+			auto LastItr = ByLastPass.begin();
+			while (FirstItr != ByFirstPass.end())
+			{
+				auto Handle = (*FirstItr)->FirstPass;
+
+				// Buffers used by a pass for the last time free their slot for the passes after it.
+				for (; LastItr != ByLastPass.end() && (*LastItr)->LastPass < Handle; ++LastItr)
+				{
+					TransientSlots[(*LastItr)->TransientSlot].bFree = true;
+				}
+
+				for (; FirstItr != ByFirstPass.end() && (*FirstItr)->FirstPass == Handle; ++FirstItr)
+				{
+					Acquire(*FirstItr);
+				}
+			}
+
+			Stats.TransientAllocationCount = static_cast<uint32>(TransientSlots.size());
+			for (auto& Slot : TransientSlots)
+			{
+				Stats.PeakTransientBytes += Slot.Desc.GetSize();
+			}
+		}
+
 		RGPassHandle GetProloguePassHandle() const
 		{
 			return RGPassHandle(0);
@@ -394,6 +630,9 @@ export namespace RenderGraph
 			Passes.Insert(Pass);
 			SetupParameterPass(Pass);
 
+			// A pass added after Compile may keep culled passes alive or extend lifetimes.
+			bCompiled = false;
+
 			return Pass;
 		}
 
@@ -427,20 +666,18 @@ export namespace RenderGraph
 
 				SetRObject(Buffer, GRenderGraphResourcePool.FindFreeBuffer(Buffer->Desc, Buffer->Name, Alignment), PassHandle);
 			}
+			else
+			{
+				SetRObject(Buffer, TransientSlots[Buffer->TransientSlot].Allocation, PassHandle);
+			}
 		}
 
 		RGPass* SetupParameterPass(RGPass* Pass)
 		{
 			SetupPassInternals(Pass);
 
-			if (bParallelSetupEnabled)
-			{
-				throw white::unimplemented();
-			}
-			else
-			{
-				SetupPassResources(Pass);
-			}
+			// Producer tracking depends on recording order, resource setup stays on the recording thread.
+			SetupPassResources(Pass);
 
 			return Pass;
 		}
@@ -489,6 +726,21 @@ export namespace RenderGraph
 
 			EnumerateBufferAccess(PassParameters, PassFlags, [&](RGViewRef BufferView, RGBufferRef Buffer, EAccessHint Access)
 				{
+					TryAddView(BufferView);
+
+					if (std::find(Pass->Buffers.begin(), Pass->Buffers.end(), Buffer) == Pass->Buffers.end())
+						Pass->Buffers.emplace_back(Buffer);
+
+					// Reads and UAV read-modify-writes both depend on the previous writer.
+					const auto Producer = Buffer->LastProducer;
+					if (Producer.IsValid() && Producer != PassHandle
+						&& std::find(Pass->Producers.begin(), Pass->Producers.end(), Producer) == Pass->Producers.end())
+					{
+						Pass->Producers.emplace_back(Producer);
+					}
+
+					if (BufferView->Type == ERGViewType::BufferUAV)
+						Buffer->LastProducer = PassHandle;
 				});
 		}
 
@@ -496,7 +748,6 @@ export namespace RenderGraph
 		CommandListImmediate& CmdList;
 		const RGEventName BuilderName;
 
-		bool bParallelSetupEnabled;
 		bool bParallelExecuteEnabled;
 
 		RGPassRegistry Passes;
@@ -511,8 +762,13 @@ export namespace RenderGraph
 			std::equal_to<GraphicsBuffer*>,
 			RGSTLAllocator<std::pair<GraphicsBuffer* const, RGBufferRef>>> ExternalBuffers;
 
-		uint32 AsyncComputePassCount;
-		uint32 RasterPassCount;
+		uint32 AsyncComputePassCount = 0;
+		uint32 RasterPassCount = 0;
+
+		bool bCompiled = false;
+		RGCompileStats Stats;
+
+		RGArray<RGTransientSlot> TransientSlots;
 	};
 }
 
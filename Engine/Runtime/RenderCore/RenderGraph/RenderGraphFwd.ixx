@@ -6,6 +6,7 @@ export module RenderGraphFwd;
 export namespace RenderGraph
 {
 	using white::int64;
+	using white::uint64;
 	using white::int32;
 	using white::uint16;
 	using white::uint8;
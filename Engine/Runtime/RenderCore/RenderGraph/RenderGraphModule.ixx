@@ -16,4 +16,10 @@ export namespace RenderGraph
 	{
 		return GRenderGraphResourcePool.FindFreeBuffer(Desc, Name, Alignment);
 	}
+
+	// Once per frame before anything of the frame is recorded, pooled buffers not requested for a while are released.
+	void BeginFrame()
+	{
+		GRenderGraphResourcePool.Tick();
+	}
 }
\ No newline at end of file
@@ -447,6 +447,13 @@ export namespace RenderGraph
 		white::ref_ptr<RGPooledBuffer> Allocation;
 
 		RGPassHandle FirstPass;
+		RGPassHandle LastPass;
+
+		/** The last pass that wrote the buffer while recording, consumers depend on it. */
+		RGPassHandle LastProducer;
+
+		/** Index of the shared allocation a transient buffer is aliased onto. */
+		uint32 TransientSlot = ~0u;
 
 		friend RGBuilder;
 		friend RGBufferRegistry;
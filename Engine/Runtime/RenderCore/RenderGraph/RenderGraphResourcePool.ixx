@@ -1,6 +1,8 @@
 module;
 
 #include "WBase/smart_ptr.hpp"
+#include "Core/Container/HashedFreeLists.h"
+#include "Core/Container/PoolRequestTrace.h"
 #include "Core/Math/PlatformMath.h"
 #include "RenderInterface/IContext.h"
 #include "RenderInterface/RenderResource.h"
@@ -24,36 +26,29 @@ export namespace RenderGraph
 		{
 			const uint32 kFramesUntilRelease = 31;
 
-			int32 BufferIndex = 0;
 			int32 NumReleasedBuffers = 0;
 			int64 NumReleasedBufferBytes = 0;
 
-			while (BufferIndex < AllocatedBuffers.size())
-			{
-				auto& Buffer = AllocatedBuffers[BufferIndex];
-
-				const bool bIsUnused = Buffer.count() == 1;
-
-				const bool bNotRequestedRecently = (FrameCounter - Buffer->LastUsedFrame) > kFramesUntilRelease;
-
-				if (bIsUnused && bNotRequestedRecently)
+			FreeBuffers.Tick(FrameCounter, kFramesUntilRelease, [&](const white::ref_ptr<RGPooledBuffer>& Buffer)
 				{
 					NumReleasedBufferBytes += Buffer->GetAlignDesc().GetSize();
-
-					white::remove_at_swap(AllocatedBuffers, BufferIndex);
-					white::remove_at_swap(AllocatedBufferHashes, BufferIndex);
-
 					++NumReleasedBuffers;
-				}
-				else
-				{
-					++BufferIndex;
-				}
-			}
+				});
 
 			++FrameCounter;
 		}
 
+		uint32 GetNumBuffers() const
+		{
+			return FreeBuffers.Num();
+		}
+
+		// Records every FindFreeBuffer request for Tools/PoolTraceBench, null stops recording.
+		void SetRequestTrace(std::vector<white::FPoolRequestTraceOp>* InRequestTrace)
+		{
+			RequestTrace = InRequestTrace;
+		}
+
 		white::ref_ptr<RGPooledBuffer> FindFreeBuffer(const RGBufferDesc& Desc, const char* InName, ERGPooledBufferAlignment Alignment = ERGPooledBufferAlignment::Page)
 		{
 			const uint64 BufferPageSize = 64 * 1024;
@@ -77,23 +72,13 @@ export namespace RenderGraph
 
 			const uint32 BufferHash = AlignedDesc.HashCode();
 
-			// First find if available.
-			for (uint64 Index = 0; Index < AllocatedBufferHashes.size(); ++Index)
+			if (RequestTrace)
 			{
-				if (AllocatedBufferHashes[Index] != BufferHash)
-				{
-					continue;
-				}
-
-				const auto& PooledBuffer = AllocatedBuffers[Index];
-
-				// Still being used outside the pool.
-				if (PooledBuffer.count() > 1)
-				{
-					continue;
-				}
+				RequestTrace->push_back({ FrameCounter, BufferHash, AlignedDesc.GetSize() });
+			}
 
-				PooledBuffer->LastUsedFrame = FrameCounter;
+			if (auto PooledBuffer = FreeBuffers.Find(BufferHash, FrameCounter))
+			{
 				PooledBuffer->Name = InName;
 
 				// We need the external-facing desc to match what the user requested.
@@ -114,12 +99,9 @@ export namespace RenderGraph
 					Desc.Usage, NumBytes, Desc.BytesPerElement);
 
 				white::ref_ptr<RGPooledBuffer> PooledBuffer = new RGPooledBuffer(CmdList, std::move(BufferRobjcet), Desc, AlignedDesc.NumElements, InName);
-				AllocatedBuffers.emplace_back(PooledBuffer);
-				AllocatedBufferHashes.emplace_back(BufferHash);
+				FreeBuffers.Add(BufferHash, PooledBuffer, FrameCounter);
 				wassume(PooledBuffer.count() == 2);
 
-				PooledBuffer->LastUsedFrame = FrameCounter;
-
 				return PooledBuffer;
 			}
 		}
@@ -127,12 +109,12 @@ export namespace RenderGraph
 	private:
 		void ReleaseRenderResource() override
 		{
-			AllocatedBuffers.clear();
-			AllocatedBufferHashes.clear();
+			FreeBuffers.Clear();
 		}
 
-		std::vector<white::ref_ptr<RGPooledBuffer>> AllocatedBuffers;
-		std::vector<uint32> AllocatedBufferHashes;
+		white::THashedFreeLists<RGPooledBuffer> FreeBuffers;
+
+		std::vector<white::FPoolRequestTraceOp>* RequestTrace = nullptr;
 
 		uint32 FrameCounter = 0;
 	};
@@ -14,7 +14,7 @@ const uint8* Shader::TryUncompressCode(const std::vector<uint8>& Code, int32 UnC
 	if (static_cast<int32>(Code.size()) != UnCompressSize)
 	{
 		UnCompressCode.resize(white::Align(UnCompressSize, 16));
-		Compression::UnCompressMemory(GetShaderCompressionFormat(), UnCompressCode.data(), UnCompressSize, ShaderCode,static_cast<int32>(Code.size()));
+		Compression::UnCompressMemory(GetShaderCompressionCodec().Codec, UnCompressCode.data(), UnCompressSize, ShaderCode,static_cast<int32>(Code.size()));
 
 		ShaderCode = UnCompressCode.data();
 	}
@@ -27,6 +27,12 @@ const std::string& Shader::GetShaderCompressionFormat()
 	return NAME_LZ4;
 }
 
+const Compression::FormatCodec& Shader::GetShaderCompressionCodec()
+{
+	static const auto Codec = Compression::FindFormatCodec(GetShaderCompressionFormat());
+	return Codec;
+}
+
 Shader::ShaderMapResource::ShaderMapResource(std::size_t Num)
 	:NumHWShaders(static_cast<int32>(Num))
 {
@@ -3,6 +3,9 @@
 #include "Runtime/AssetResourceScheduler.h"
 #include "Asset/MaterialX.h"
 #include "Asset/TextureX.h"
+#include "Core/Coroutine/WhenAllReady.h"
+#include "System/SystemEnvironment.h"
+#include <map>
 
 using namespace platform;
 using namespace scheme;
@@ -17,7 +20,9 @@ platform::Material::Material(const asset::MaterailAsset & asset, const std::stri
 {
 	for (auto& bind_value : asset.GetBindValues()) {
 		if WB_UNLIKELY(bind_value.second.GetContent().type() == white::type_id<MaterialEvaluator::InstanceDelayedTerm>()){
-			auto ret = GetInstanceEvaluator().Reduce(bind_value.second.Access<MaterialEvaluator::InstanceDelayedTerm>());
+			auto ret = AccessInstanceEvaluator([&](MaterialEvaluator& evaluator) {
+				return evaluator.Reduce(bind_value.second.Access<MaterialEvaluator::InstanceDelayedTerm>());
+			});
 
 			MaterialEvaluator::CheckReductionStatus(ret.second);
 			bind_values.emplace_back(bind_value.first,
@@ -59,7 +64,9 @@ void platform::Material::UpdateParams(const Renderable* pRenderable, Render::Eff
 		target_effect->TrySetParametr(bind_value.first, bind_value.second);
 	}
 	for (auto& delay_value : delay_values) {
-		auto ret = GetInstanceEvaluator().Reduce(delay_value.second);
+		auto ret = AccessInstanceEvaluator([&](MaterialEvaluator& evaluator) {
+			return evaluator.Reduce(delay_value.second);
+		});
 		if (ret.second == ReductionStatus::Clean)
 			target_effect->TrySetParametr(delay_value.first, Render::Effect::Parameter::any_cast(ret.first.Value.GetContent()));
 		else
@@ -88,6 +95,12 @@ MaterialEvaluator & platform::Material::GetInstanceEvaluator()
 	return instance;
 }
 
+std::mutex& platform::Material::GetInstanceEvaluatorMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
 template<>
 std::shared_ptr<Material> platform::AssetResourceScheduler::SyncSpawnResource<Material, const X::path&, const std::string&>(const X::path& path, const std::string & name) {
 	auto pAsset = X::LoadMaterialAsset(path);
@@ -99,6 +112,49 @@ std::shared_ptr<Material> platform::AssetResourceScheduler::SyncSpawnResource<Ma
 
 template std::shared_ptr<Material> platform::AssetResourceScheduler::SyncSpawnResource<Material, const X::path&, const std::string&>(const X::path& path, const std::string & name);
 
+white::coroutine::Task<void> platform::X::AsyncLoadMaterials(white::span<const X::path> pathes, white::span<const std::string> names, white::span<std::shared_ptr<Material>> materials)
+{
+	//unique (path,name) -> first index
+	std::map<std::pair<X::path, std::string>, std::size_t> unique_indices;
+	std::vector<std::size_t> remap(pathes.size());
+	std::vector<std::size_t> uniques;
+	for (std::size_t i = 0; i < pathes.size(); ++i)
+	{
+		auto [itr, inserted] = unique_indices.try_emplace({ pathes[i], names[i] }, i);
+		if (inserted)
+			uniques.emplace_back(i);
+		remap[i] = itr->second;
+	}
+
+	std::vector<std::shared_ptr<asset::MaterailAsset>> assets(pathes.size());
+
+	std::vector<white::coroutine::Task<void>> tasks;
+	for (auto index : uniques)
+	{
+		tasks.emplace_back([](const X::path& path, std::shared_ptr<asset::MaterailAsset>& asset) -> white::coroutine::Task<void> {
+			co_await Environment->Scheduler->schedule();
+
+			asset = co_await X::AsyncLoadMaterialAsset(path);
+			if (!asset)
+				throw white::GeneralEvent(white::sfmt("Can't Load Material Asset %s", path.string().c_str()));
+		}(pathes[index], assets[index]));
+	}
+
+	auto loaded = co_await white::coroutine::WhenAllReady(std::move(tasks));
+	for (auto& task : loaded)
+		task.result();
+
+	co_await Environment->Scheduler->schedule_render();
+
+	for (auto index : uniques)
+		materials[index] = std::make_shared<Material>(*assets[index], names[index]);
+
+	for (std::size_t i = 0; i < pathes.size(); ++i)
+		materials[i] = materials[remap[i]];
+
+	co_await Environment->Scheduler->schedule();
+}
+
 
 
 
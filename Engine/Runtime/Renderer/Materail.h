@@ -13,6 +13,7 @@
 #include "RenderInterface/Effect/Effect.hpp"
 
 #include <unordered_set>
+#include <mutex>
 
 namespace platform {
 	class MaterialEvaluator;
@@ -47,7 +48,15 @@ namespace platform {
 		std::shared_ptr<Render::Effect::Effect> bind_effects;
 		std::string identity_name;
 	public:
+		//! \brief ʹʵֵʻڹ߳ϲء
+		template<typename _func>
+		static decltype(auto) AccessInstanceEvaluator(_func f) {
+			std::lock_guard lock(GetInstanceEvaluatorMutex());
+			return f(GetInstanceEvaluator());
+		}
+	private:
 		static MaterialEvaluator& GetInstanceEvaluator();
+		static std::mutex& GetInstanceEvaluatorMutex();
 	};
 
 	class MaterialEvaluator :public WSLEvaluator {
@@ -77,11 +77,13 @@ namespace platform {
 	}
 	const asset::MeshAsset::SubMeshDescrption::LodDescription & Mesh::GetSubMeshCurretnLodDescription(int submesh_index)
 	{
-		return GetSubMeshLodDescription(submesh_index, mesh_lod);
+		//meshes without generated lods keep drawing lod0
+		auto lod_index = std::min<int>(mesh_lod, static_cast<int>(sub_meshes[submesh_index].LodsDescription.size()) - 1);
+		return GetSubMeshLodDescription(submesh_index, lod_index);
 	}
 	const asset::MeshAsset::SubMeshDescrption::LodDescription & Mesh::GetSubMeshLodDescription(int submesh_index, int lod_index)
 	{
-		return sub_meshes[submesh_index].LodsDescription[mesh_lod];
+		return sub_meshes[submesh_index].LodsDescription[lod_index];
 	}
 	white::uint8 Mesh::GetSubMeshMaterialIndex(int submesh_index)
 	{
@@ -0,0 +1,249 @@
+#include "SceneBVH.h"
+#include "Core/Math/VectorKernels.h"
+#include "Runtime/ParallelFor.h"
+#include <algorithm>
+#include <numeric>
+#include <bit>
+
+using namespace WhiteEngine;
+
+namespace
+{
+	// Enough subtrees per volume to keep the workers busy with a handful of views
+	constexpr uint32 kParallelSubtrees = 64;
+
+	// First position in [First, Last) whose code differs from Codes[First] in the highest bit of Codes[First] ^ Codes[Last - 1]
+	uint32 FindSplit(const std::vector<uint32>& Codes, uint32 First, uint32 Last)
+	{
+		auto Different = Codes[First] ^ Codes[Last - 1];
+		if (Different == 0)
+			return (First + Last) / 2;
+
+		auto Bit = 1u << (31 - std::countl_zero(Different));
+		auto Split = std::partition_point(Codes.begin() + First, Codes.begin() + Last, [&](uint32 Code) {
+			return (Code & Bit) == 0;
+			});
+		return static_cast<uint32>(Split - Codes.begin());
+	}
+}
+
+void SceneBVH::Build(white::span<const BoxSphereBounds> Bounds)
+{
+	auto Count = static_cast<uint32>(Bounds.size());
+
+	Nodes.clear();
+	Origins.resize(Count);
+	Extents.resize(Count);
+	Ids.resize(Count);
+	Slots.resize(Count);
+	Leaves.resize(Count);
+	DirtyNodes.clear();
+	bDirty = false;
+
+	if (Count == 0)
+		return;
+
+	std::vector<wm::float3> Centers(Count);
+	wm::float3 Min = Bounds[0].Origin, Max = Bounds[0].Origin;
+	for (uint32 Index = 0; Index != Count; ++Index)
+	{
+		Centers[Index] = Bounds[Index].Origin;
+		Min = wm::min(Min, Centers[Index]);
+		Max = wm::max(Max, Centers[Index]);
+	}
+
+	std::vector<uint32> Codes(Count);
+	white::math::MortonEncode3(Centers.data(), Count, Min, wm::max(Max - Min, wm::float3(1e-6f, 1e-6f, 1e-6f)), Codes.data());
+
+	std::iota(Ids.begin(), Ids.end(), 0);
+	std::sort(Ids.begin(), Ids.end(), [&](uint32 L, uint32 R) {
+		return Codes[L] != Codes[R] ? Codes[L] < Codes[R] : L < R;
+		});
+
+	std::vector<uint32> SortedCodes(Count);
+	for (uint32 Position = 0; Position != Count; ++Position)
+	{
+		auto Id = Ids[Position];
+		Origins[Position] = Bounds[Id].Origin;
+		Extents[Position] = Bounds[Id].Extent;
+		SortedCodes[Position] = Codes[Id];
+		Slots[Id] = Position;
+	}
+
+	// Breadth first, so children always come after their parent and Refit can go backwards
+	Nodes.push_back({ {}, {}, 0, Count, 0, 0 });
+	for (uint32 Index = 0; Index != Nodes.size(); ++Index)
+	{
+		auto First = Nodes[Index].First;
+		auto Last = First + Nodes[Index].Count;
+		if (Last - First <= MaxLeafSize)
+		{
+			for (auto Position = First; Position != Last; ++Position)
+				Leaves[Position] = Index;
+			continue;
+		}
+
+		auto Split = FindSplit(SortedCodes, First, Last);
+		if (Split == First || Split == Last)
+			Split = (First + Last) / 2;
+
+		Nodes[Index].Left = static_cast<uint32>(Nodes.size());
+		Nodes.push_back({ {}, {}, First, Split - First, 0, Index });
+		Nodes.push_back({ {}, {}, Split, Last - Split, 0, Index });
+	}
+
+	for (auto Index = Nodes.size(); Index-- != 0;)
+		ComputeBounds(Nodes[Index]);
+
+	DirtyNodes.assign(Nodes.size(), 0);
+}
+
+void SceneBVH::Update(uint32 Id, const BoxSphereBounds& Bounds)
+{
+	auto Position = Slots[Id];
+	Origins[Position] = Bounds.Origin;
+	Extents[Position] = Bounds.Extent;
+
+	// Ancestors of a dirty node are dirty already
+	for (auto Index = Leaves[Position]; !DirtyNodes[Index]; Index = Nodes[Index].Parent)
+	{
+		DirtyNodes[Index] = 1;
+		if (Index == 0)
+			break;
+	}
+	bDirty = true;
+}
+
+void SceneBVH::Refit()
+{
+	if (!bDirty)
+		return;
+
+	for (auto Index = Nodes.size(); Index-- != 0;)
+	{
+		if (DirtyNodes[Index])
+		{
+			ComputeBounds(Nodes[Index]);
+			DirtyNodes[Index] = 0;
+		}
+	}
+	bDirty = false;
+}
+
+void SceneBVH::ComputeBounds(Node& InNode) const
+{
+	if (InNode.Left != 0)
+	{
+		auto& Left = Nodes[InNode.Left];
+		auto& Right = Nodes[InNode.Left + 1];
+		InNode.Min = wm::min(Left.Min, Right.Min);
+		InNode.Max = wm::max(Left.Max, Right.Max);
+		return;
+	}
+
+	InNode.Min = Origins[InNode.First] - Extents[InNode.First];
+	InNode.Max = Origins[InNode.First] + Extents[InNode.First];
+	for (auto Position = InNode.First + 1; Position != InNode.First + InNode.Count; ++Position)
+	{
+		InNode.Min = wm::min(InNode.Min, Origins[Position] - Extents[Position]);
+		InNode.Max = wm::max(InNode.Max, Origins[Position] + Extents[Position]);
+	}
+}
+
+void SceneBVH::Cull(const ConvexVolume& Volume, std::vector<uint32>& OutVisible) const
+{
+	if (!Nodes.empty())
+		CullNode(Volume, 0, OutVisible);
+}
+
+void SceneBVH::CullNode(const ConvexVolume& Volume, uint32 Root, std::vector<uint32>& OutVisible) const
+{
+	uint32 Stack[64];
+	uint32 StackSize = 0;
+	Stack[StackSize++] = Root;
+
+	uint8 Visible[MaxLeafSize];
+	while (StackSize != 0)
+	{
+		auto& Current = Nodes[Stack[--StackSize]];
+
+		auto Intersect = Volume.IntersectBox((Current.Min + Current.Max) * 0.5f, (Current.Max - Current.Min) * 0.5f);
+		if (Intersect == ConvexVolume::EIntersect::Outside)
+			continue;
+
+		if (Intersect == ConvexVolume::EIntersect::Inside)
+		{
+			OutVisible.insert(OutVisible.end(), Ids.begin() + Current.First, Ids.begin() + Current.First + Current.Count);
+			continue;
+		}
+
+		if (Current.Left != 0)
+		{
+			// Right first so the left range is emitted first
+			wconstraint(StackSize + 2 <= std::size(Stack));
+			Stack[StackSize++] = Current.Left + 1;
+			Stack[StackSize++] = Current.Left;
+			continue;
+		}
+
+		white::math::CullBoxes(Volume.Planes, Volume.NumPlanes, &Origins[Current.First], &Extents[Current.First], Current.Count, Visible);
+		for (uint32 Index = 0; Index != Current.Count; ++Index)
+		{
+			if (Visible[Index])
+				OutVisible.push_back(Ids[Current.First + Index]);
+		}
+	}
+}
+
+void SceneBVH::CullParallel(white::span<const ConvexVolume> Volumes, white::span<std::vector<uint32>> OutVisible) const
+{
+	wconstraint(Volumes.size() == OutVisible.size());
+
+	for (auto& Visible : OutVisible)
+		Visible.clear();
+	if (Nodes.empty() || Volumes.empty())
+		return;
+
+	// Subtree roots covering every primitive in order. A node outside or inside the volume has all its
+	// descendants outside or inside too, so skipping the nodes above the roots gives the same lists.
+	std::vector<uint32> Roots{ 0 };
+	while (Roots.size() < kParallelSubtrees)
+	{
+		std::vector<uint32> Expanded;
+		Expanded.reserve(Roots.size() * 2);
+		for (auto Root : Roots)
+		{
+			if (Nodes[Root].Left != 0)
+			{
+				Expanded.push_back(Nodes[Root].Left);
+				Expanded.push_back(Nodes[Root].Left + 1);
+			}
+			else
+				Expanded.push_back(Root);
+		}
+		if (Expanded.size() == Roots.size())
+			break;
+		Roots = std::move(Expanded);
+	}
+
+	auto NumRoots = static_cast<uint32>(Roots.size());
+	std::vector<std::vector<uint32>> Partial(Volumes.size() * NumRoots);
+	ParallelFor(static_cast<white::int32>(Partial.size()), [&](white::int32 Task) {
+		CullNode(Volumes[Task / NumRoots], Roots[Task % NumRoots], Partial[Task]);
+		});
+
+	for (std::size_t VolumeIndex = 0; VolumeIndex != Volumes.size(); ++VolumeIndex)
+	{
+		auto& Visible = OutVisible[VolumeIndex];
+		std::size_t Total = 0;
+		for (uint32 Root = 0; Root != NumRoots; ++Root)
+			Total += Partial[VolumeIndex * NumRoots + Root].size();
+
+		Visible.reserve(Total);
+		for (uint32 Root = 0; Root != NumRoots; ++Root)
+		{
+			auto& Part = Partial[VolumeIndex * NumRoots + Root];
+			Visible.insert(Visible.end(), Part.begin(), Part.end());
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <WBase/wmath.hpp>
+#include <WBase/span.hpp>
+#include "Core/Math/BoxSphereBounds.h"
+#include "Core/Math/ConvexVolume.h"
+#include <vector>
+
+namespace WhiteEngine
+{
+	using namespace white::inttype;
+	namespace wm = white::math;
+
+	/*
+	\brief Bounding volume hierarchy over primitive bounds for culling on the CPU.
+	Build orders the primitives along the Morton curve of their centers, so every node covers a contiguous
+	range of them. Moving primitives keep their place, only the node bounds above them are refitted.
+	*/
+	class SceneBVH
+	{
+	public:
+		static constexpr uint32 MaxLeafSize = 8;
+
+		//! \brief Primitive ids are the indices into Bounds.
+		void Build(white::span<const BoxSphereBounds> Bounds);
+
+		//! \brief Takes effect for culling after the next Refit.
+		void Update(uint32 Id, const BoxSphereBounds& Bounds);
+
+		//! \brief Recomputes the bounds of the nodes above primitives updated since the last Refit.
+		void Refit();
+
+		uint32 GetNumPrimitives() const
+		{
+			return static_cast<uint32>(Ids.size());
+		}
+
+		//! \brief Appends the ids of the primitives not outside Volume, in tree order.
+		void Cull(const ConvexVolume& Volume, std::vector<uint32>& OutVisible) const;
+
+		/*!
+		\brief One visible list per volume, same content and order as Cull.
+		\note The volumes and the top subtrees of each are culled in parallel.
+		*/
+		void CullParallel(white::span<const ConvexVolume> Volumes, white::span<std::vector<uint32>> OutVisible) const;
+	private:
+		struct Node
+		{
+			wm::float3 Min;
+			wm::float3 Max;
+			// Range in the primitive order
+			uint32 First;
+			uint32 Count;
+			// Children are Left and Left + 1, 0 for a leaf
+			uint32 Left;
+			uint32 Parent;
+		};
+
+		void CullNode(const ConvexVolume& Volume, uint32 Root, std::vector<uint32>& OutVisible) const;
+
+		void ComputeBounds(Node& InNode) const;
+
+		std::vector<Node> Nodes;
+
+		// Primitive order, origin and extent apart for the batched test
+		std::vector<wm::float3> Origins;
+		std::vector<wm::float3> Extents;
+		std::vector<uint32> Ids;
+
+		// Id to position in primitive order
+		std::vector<uint32> Slots;
+		// Position in primitive order to leaf
+		std::vector<uint32> Leaves;
+
+		std::vector<uint8> DirtyNodes;
+		bool bDirty = false;
+	};
+}
@@ -14,8 +14,11 @@ using RenderGraph::RGBufferDesc;
 
 platform::Render::GlobalResource<StreamingScene> Trinf::Scene;
 
-int32 Trinf::GrowOnlySpanAllocator::Allocate(int32 Num)
+int32 Trinf::SpanAllocator::Allocate(int32 Num)
 {
+	if (Num == 0)
+		return MaxSize;
+
 	const int32 FoundIndex = SearchFreeList(Num);
 
 	// Use an existing free span if one is found
@@ -25,13 +28,13 @@ int32 Trinf::GrowOnlySpanAllocator::Allocate(int32 Num)
 
 		if (FreeSpan.Num > Num)
 		{
-			// Update existing free span with remainder
+			// Update existing free span with remainder, it keeps its place in the order
 			FreeSpans[FoundIndex] = LinearAlloc(FreeSpan.StartOffset + Num, FreeSpan.Num - Num);
 		}
 		else
 		{
 			// Fully consumed the free span
-			white::remove_at_swap(FreeSpans, FoundIndex);
+			FreeSpans.erase(FreeSpans.begin() + FoundIndex);
 		}
 
 		return FreeSpan.StartOffset;
@@ -44,20 +47,159 @@ int32 Trinf::GrowOnlySpanAllocator::Allocate(int32 Num)
 	return StartOffset;
 }
 
-int32 Trinf::GrowOnlySpanAllocator::SearchFreeList(int32 Num)
+void Trinf::SpanAllocator::Free(int32 StartOffset, int32 Num)
+{
+	if (Num == 0)
+		return;
+
+	LinearAlloc Span(StartOffset, Num);
+	wconstraint(Span.End() <= MaxSize);
+
+	auto Next = std::lower_bound(FreeSpans.begin(), FreeSpans.end(), Span);
+	wconstraint(Next == FreeSpans.end() || Span.End() <= Next->StartOffset);
+
+	// Merge with the spans on either side
+	if (Next != FreeSpans.end() && Span.End() == Next->StartOffset)
+	{
+		Span.Num += Next->Num;
+		Next = FreeSpans.erase(Next);
+	}
+	if (Next != FreeSpans.begin())
+	{
+		auto Prev = std::prev(Next);
+		wconstraint(Prev->End() <= Span.StartOffset);
+		if (Prev->End() == Span.StartOffset)
+		{
+			Span = LinearAlloc(Prev->StartOffset, Prev->Num + Span.Num);
+			Next = FreeSpans.erase(Prev);
+		}
+	}
+
+	// A span reaching the end gives the space back to the tail
+	if (Span.End() == MaxSize)
+	{
+		MaxSize = Span.StartOffset;
+		return;
+	}
+
+	FreeSpans.insert(Next, Span);
+}
+
+int32 Trinf::SpanAllocator::SearchFreeList(int32 Num) const
 {
-	// Search free list for first matching
+	// Best fit, an exact match ends the search
+	int32 BestIndex = white::INDEX_NONE;
 	for (int32 i = 0; i < FreeSpans.size(); i++)
 	{
 		auto CurrentSpan = FreeSpans[i];
 
-		if (CurrentSpan.Num >= Num)
-		{
+		if (CurrentSpan.Num == Num)
 			return i;
+
+		if (CurrentSpan.Num > Num && (BestIndex == white::INDEX_NONE || CurrentSpan.Num < FreeSpans[BestIndex].Num))
+			BestIndex = i;
+	}
+
+	return BestIndex;
+}
+
+Trinf::SpanAllocator::Stats Trinf::SpanAllocator::GetStats() const
+{
+	Stats Result{};
+	for (auto& Span : FreeSpans)
+	{
+		Result.FreeSize += Span.Num;
+		Result.LargestFreeSpan = std::max(Result.LargestFreeSpan, Span.Num);
+	}
+	Result.NumFreeSpans = static_cast<int32>(FreeSpans.size());
+	Result.UsedSize = MaxSize - Result.FreeSize;
+
+	return Result;
+}
+
+void Trinf::ResidencyBudget::Add(uint64 Key, uint64 Bytes, uint64 Frame)
+{
+	wconstraint(!Entries.contains(Key));
+
+	Entries.emplace(Key, LRU.insert(LRU.end(), Entry{ Key, Bytes, Frame, true }));
+	UsedBytes += Bytes;
+}
+
+void Trinf::ResidencyBudget::Remove(uint64 Key)
+{
+	auto itr = Entries.find(Key);
+	if (itr == Entries.end())
+		return;
+
+	UsedBytes -= itr->second->Bytes;
+	LRU.erase(itr->second);
+	Entries.erase(itr);
+}
+
+void Trinf::ResidencyBudget::Touch(uint64 Key, uint64 Frame)
+{
+	auto itr = Entries.find(Key);
+	if (itr == Entries.end())
+		return;
+
+	itr->second->LastRequestedFrame = Frame;
+	LRU.splice(LRU.end(), LRU, itr->second);
+}
+
+void Trinf::ResidencyBudget::Unpin(uint64 Key)
+{
+	auto itr = Entries.find(Key);
+	if (itr != Entries.end())
+		itr->second->bPinned = false;
+}
+
+bool Trinf::ResidencyBudget::MakeRoom(uint64 Bytes, uint64 Frame, std::vector<uint64>& Evicted)
+{
+	if (Bytes > BudgetBytes)
+		return false;
+
+	const uint64 Target = BudgetBytes - Bytes;
+	if (UsedBytes <= Target)
+		return true;
+
+	uint64 Reclaimable = 0;
+	for (auto& entry : LRU)
+	{
+		if (IsEvictable(entry, Frame))
+			Reclaimable += entry.Bytes;
+	}
+	if (UsedBytes - Reclaimable > Target)
+		return false;
+
+	for (auto itr = LRU.begin(); itr != LRU.end() && UsedBytes > Target;)
+	{
+		if (!IsEvictable(*itr, Frame))
+		{
+			++itr;
+			continue;
 		}
+
+		Evicted.emplace_back(itr->Key);
+		UsedBytes -= itr->Bytes;
+		Entries.erase(itr->Key);
+		itr = LRU.erase(itr);
 	}
 
-	return white::INDEX_NONE;
+	return true;
+}
+
+bool Trinf::ResidencyBudget::EvictLeastRecent(uint64 Frame, uint64& Key)
+{
+	auto itr = std::find_if(LRU.begin(), LRU.end(), [&](const Entry& entry) { return IsEvictable(entry, Frame); });
+	if (itr == LRU.end())
+		return false;
+
+	Key = itr->Key;
+	UsedBytes -= itr->Bytes;
+	Entries.erase(itr->Key);
+	LRU.erase(itr);
+
+	return true;
 }
 
 StreamingScene::StreamingScene()
@@ -81,7 +223,7 @@ RenderGraph::RGBufferRef StreamingScene::TrinfBuffer<T>::ResizeByteAddressBuffer
 		};
 
 		platform::Render::MemcpyResource(Builder, NewDataBuffer, InternalBufferOld, params);
-		Builder.ToExternal(NewDataBuffer);
+		DataBuffer = Builder.ToExternal(NewDataBuffer);
 
 		return NewDataBuffer;
 	}
@@ -101,21 +243,107 @@ void StreamingScene::InitRenderResource(platform::Render::CommandListBase&)
 
 void StreamingScene::AddResource(std::shared_ptr<Resources> pResource)
 {
-	if (pResource->TrinfKey == -1)
+	pResource->LastRequestedFrame = FrameIndex;
+
+	if (pResource->State == Resources::StreamingState::None)
 	{
-		pResource->TrinfKey = KeyAllocator.Allocate(1);
+		pResource->State = Resources::StreamingState::Pending;
+		PendingAdds.emplace_back(pResource);
+	}
+	else if (pResource->TrinfKey != -1)
+		Budget.Touch(pResource->TrinfKey, FrameIndex);
+}
+
+uint64 StreamingScene::GetResidentBytes(const Resources& Resource) const
+{
+	uint64 NumPages = 0;
+	NumPages += Index.GetNumPages(Resource.Metadata->Index);
+	NumPages += Position.GetNumPages(Resource.Metadata->Position);
+	NumPages += Tangent.GetNumPages(Resource.Metadata->Tangent);
+	NumPages += TexCoord.GetNumPages(Resource.Metadata->TexCoord);
 
-		TrinfKey key{};
-		key.Index = Index.Allocate(pResource->Metadata->Index);
-		key.Position = Position.Allocate(pResource->Metadata->Position);
-		key.Tangent = Tangent.Allocate(pResource->Metadata->Tangent);
-		key.TexCoord = TexCoord.Allocate(pResource->Metadata->TexCoord);
+	return NumPages * Index.kPageSize;
+}
 
-		Keys.resize(std::max(Keys.size(), pResource->TrinfKey + 1));
-		Keys[pResource->TrinfKey] = key;
+uint64 StreamingScene::GetCapacityBytes() const
+{
+	uint64 NumPages = 0;
+	NumPages += Index.Allocator.GetMaxSize();
+	NumPages += Position.Allocator.GetMaxSize();
+	NumPages += Tangent.Allocator.GetMaxSize();
+	NumPages += TexCoord.Allocator.GetMaxSize();
 
-		PendingAdds.emplace_back(pResource);
+	return NumPages * Index.kPageSize;
+}
+
+uint64 StreamingScene::GetGrowthBytes(const Resources& Resource) const
+{
+	uint64 NumPages = 0;
+	NumPages += Index.GetGrowth(Resource.Metadata->Index);
+	NumPages += Position.GetGrowth(Resource.Metadata->Position);
+	NumPages += Tangent.GetGrowth(Resource.Metadata->Tangent);
+	NumPages += TexCoord.GetGrowth(Resource.Metadata->TexCoord);
+
+	return NumPages * Index.kPageSize;
+}
+
+bool StreamingScene::AllocateResource(Resources& Resource)
+{
+	auto Bytes = GetResidentBytes(Resource);
+
+	std::vector<uint64> Evicted;
+	if (!Budget.MakeRoom(Bytes, FrameIndex, Evicted))
+		return false;
+
+	for (auto Key : Evicted)
+		EvictResource(Key);
+
+	// Freed spans may be too fragmented for the new pages, evict before growing the buffers past the budget
+	while (GetCapacityBytes() + GetGrowthBytes(Resource) > Budget.GetBudget())
+	{
+		uint64 Key;
+		if (!Budget.EvictLeastRecent(FrameIndex, Key))
+			return false;
+
+		EvictResource(Key);
 	}
+
+	Resource.TrinfKey = KeyAllocator.Allocate(1);
+
+	TrinfKey key{};
+	key.Index = Index.Allocate(Resource.Metadata->Index);
+	key.Position = Position.Allocate(Resource.Metadata->Position);
+	key.Tangent = Tangent.Allocate(Resource.Metadata->Tangent);
+	key.TexCoord = TexCoord.Allocate(Resource.Metadata->TexCoord);
+
+	Keys.resize(std::max(Keys.size(), Resource.TrinfKey + 1));
+	Keys[Resource.TrinfKey] = key;
+
+	// Pinned until the copy into the scene buffers is recorded
+	Budget.Add(Resource.TrinfKey, Bytes, Resource.LastRequestedFrame);
+
+	return true;
+}
+
+void StreamingScene::EvictResource(uint64 Key)
+{
+	auto itr = std::find_if(Resident.begin(), Resident.end(), [=](auto& resource) { return resource->TrinfKey == Key; });
+	wconstraint(itr != Resident.end());
+
+	auto& Resource = **itr;
+	auto key = Keys[Resource.TrinfKey];
+
+	Index.Free(key.Index, Resource.Metadata->Index);
+	Position.Free(key.Position, Resource.Metadata->Position);
+	Tangent.Free(key.Tangent, Resource.Metadata->Tangent);
+	TexCoord.Free(key.TexCoord, Resource.Metadata->TexCoord);
+
+	KeyAllocator.Free(static_cast<int32>(Resource.TrinfKey), 1);
+
+	Resource.TrinfKey = -1;
+	Resource.State = Resources::StreamingState::None;
+
+	Resident.erase(itr);
 }
 
 void StreamingScene::BeginAsyncUpdate(RenderGraph::RGBuilder& Builder)
@@ -178,22 +406,35 @@ void StreamingScene::EndAsyncUpdate(RenderGraph::RGBuilder& Builder)
 		Resident.emplace_back(resource);
 		resource->State = Resources::StreamingState::Resident;
 		resource->GpuStream.reset();
+		Budget.Unpin(resource->TrinfKey);
 
 		itr = GpuStreaming.erase(itr);
 	}
+
+	++FrameIndex;
 }
 
 void StreamingScene::ProcessNewResources(RenderGraph::RGBuilder& Builder)
 {
+	std::vector<std::shared_ptr<Resources>> Allocated;
+	for (auto itr = PendingAdds.begin(); itr != PendingAdds.end();)
+	{
+		if (AllocateResource(**itr))
+		{
+			Allocated.emplace_back(*itr);
+			itr = PendingAdds.erase(itr);
+		}
+		else
+			++itr;
+	}
+
 	Position.ResizeByteAddressBufferIfNeeded(Builder);
 	Tangent.ResizeByteAddressBufferIfNeeded(Builder);
 	TexCoord.ResizeByteAddressBufferIfNeeded(Builder);
 	Index.ResizeByteAddressBufferIfNeeded(Builder);
 
-	for (auto resource : PendingAdds)
+	for (auto resource : Allocated)
 	{
-		auto key = Keys[resource->TrinfKey];
-
 		DStorageFile2GpuRequest::Buffer target{};
 
 		auto GpuStreamingSize = 0;
@@ -247,8 +488,6 @@ void StreamingScene::ProcessNewResources(RenderGraph::RGBuilder& Builder)
 
 		Streaming.emplace_back(resource);
 	}
-
-	PendingAdds.clear();
 }
 
 
@@ -5,6 +5,9 @@
 #include "RenderInterface/ICommandList.h"
 #include "RenderInterface/DStorage.h"
 #include "RenderInterface/RenderResource.h"
+#include <limits>
+#include <list>
+#include <unordered_map>
 
 import RenderGraph;
 
@@ -20,6 +23,7 @@ namespace Trinf
 		enum class StreamingState
 		{
 			None,
+			Pending,
 			Streaming,
 			GPUStreaming,
 			Resident,
@@ -27,6 +31,7 @@ namespace Trinf
 
 		uint64 TrinfKey = -1;
 		StreamingState State = StreamingState::None;
+		uint64 LastRequestedFrame = 0;
 
 		std::shared_ptr<DStorageFile> File;
 		std::shared_ptr<DStorageSyncPoint> IORequest;
@@ -48,17 +53,45 @@ namespace Trinf
 		}
 	};
 
-	struct GrowOnlySpanAllocator
+	/*
+	Spans are kept sorted by offset so a free span merges with its neighbours,
+	allocation takes the smallest span that fits and falls back to growing MaxSize.
+	Callers bounding the size check GetGrowth first and free spans until it is 0.
+	*/
+	struct SpanAllocator
 	{
 		int32 Allocate(int32 Num);
 
-		int32 GetMaxSize()
+		void Free(int32 StartOffset, int32 Num);
+
+		int32 GetMaxSize() const
 		{
 			return MaxSize;
 		}
 
-		int32 SearchFreeList(int32 Num);
+		int32 SearchFreeList(int32 Num) const;
+
+		// Elements Allocate(Num) would add to MaxSize, 0 when a free span fits.
+		int32 GetGrowth(int32 Num) const
+		{
+			return Num == 0 || SearchFreeList(Num) != white::INDEX_NONE ? 0 : Num;
+		}
+
+		struct Stats
+		{
+			int32 UsedSize;
+			int32 FreeSize;
+			int32 LargestFreeSpan;
+			int32 NumFreeSpans;
+
+			// 0 when every free element is in one span, approaches 1 as free space splinters.
+			float GetFragmentation() const
+			{
+				return FreeSize ? 1.f - float(LargestFreeSpan) / FreeSize : 0.f;
+			}
+		};
 
+		Stats GetStats() const;
 	private:
 		struct LinearAlloc
 		{
@@ -70,9 +103,14 @@ namespace Trinf
 			int32 StartOffset;
 			int32 Num;
 
-			bool Contains(LinearAlloc Other)
+			int32 End() const
 			{
-				return StartOffset <= Other.StartOffset && (StartOffset + Num) >= (Other.StartOffset + Other.Num);
+				return StartOffset + Num;
+			}
+
+			bool Contains(LinearAlloc Other) const
+			{
+				return StartOffset <= Other.StartOffset && End() >= Other.End();
 			}
 
 			bool operator<(const LinearAlloc& Other) const
@@ -81,10 +119,72 @@ namespace Trinf
 			}
 		};
 
-		int32 MaxSize;
+		int32 MaxSize = 0;
 		std::vector<LinearAlloc> FreeSpans;
 	};
 
+	/*
+	\brief Least recently requested first eviction over a byte budget, knows nothing about the GPU side
+	so it can be driven by synthetic request streams.
+	\note Pinned entries (still streaming) and entries requested in the current frame are never evicted.
+	*/
+	class ResidencyBudget
+	{
+	public:
+		void SetBudget(uint64 InBudgetBytes)
+		{
+			BudgetBytes = InBudgetBytes;
+		}
+
+		uint64 GetBudget() const
+		{
+			return BudgetBytes;
+		}
+
+		uint64 GetUsed() const
+		{
+			return UsedBytes;
+		}
+
+		void Add(uint64 Key, uint64 Bytes, uint64 Frame);
+		void Remove(uint64 Key);
+
+		void Touch(uint64 Key, uint64 Frame);
+		void Unpin(uint64 Key);
+
+		/*
+		\brief Evicts until Bytes more fit in the budget, the evicted keys are appended to Evicted.
+		\return false without evicting anything when even evicting every candidate would not be enough.
+		*/
+		bool MakeRoom(uint64 Bytes, uint64 Frame, std::vector<uint64>& Evicted);
+
+		/*
+		\brief Evicts the least recently requested candidate, used when the budget holds but the freed spans are too fragmented.
+		\return false when every entry is pinned or requested in Frame.
+		*/
+		bool EvictLeastRecent(uint64 Frame, uint64& Key);
+	private:
+		struct Entry
+		{
+			uint64 Key;
+			uint64 Bytes;
+			uint64 LastRequestedFrame;
+			bool bPinned;
+		};
+
+		bool IsEvictable(const Entry& entry, uint64 Frame) const
+		{
+			return !entry.bPinned && entry.LastRequestedFrame != Frame;
+		}
+
+		// Front is the least recently requested.
+		std::list<Entry> LRU;
+		std::unordered_map<uint64, std::list<Entry>::iterator> Entries;
+
+		uint64 BudgetBytes = std::numeric_limits<uint64>::max();
+		uint64 UsedBytes = 0;
+	};
+
 	class StreamingScene :public platform::Render::RenderResource
 	{
 	public:
@@ -92,25 +192,62 @@ namespace Trinf
 
 		void InitRenderResource(platform::Render::CommandListBase& CmdList) override;
 
+		// Requests the resource for this frame, it is streamed in if it is not resident.
 		void AddResource(std::shared_ptr<Resources> pResource);
 
+		// Resident resources not requested in the current frame are evicted to stay under the budget.
+		void SetResidencyBudget(uint64 Bytes)
+		{
+			Budget.SetBudget(Bytes);
+		}
+
+		const ResidencyBudget& GetResidencyBudget() const
+		{
+			return Budget;
+		}
+
 		void BeginAsyncUpdate(RenderGraph::RGBuilder& Builder);
 
 		void EndAsyncUpdate(RenderGraph::RGBuilder& Builder);
 	private:
 		void ProcessNewResources(RenderGraph::RGBuilder& Builder);
+
+		uint64 GetResidentBytes(const Resources& Resource) const;
+		// Bytes of the scene buffers, including the free spans.
+		uint64 GetCapacityBytes() const;
+		// Bytes the scene buffers grow by when the free spans can't hold the resource.
+		uint64 GetGrowthBytes(const Resources& Resource) const;
+
+		// False when the budget cannot make room this frame, the resource stays pending.
+		bool AllocateResource(Resources& Resource);
+		void EvictResource(uint64 Key);
 	public:
 		template<typename T>
 		struct TrinfBuffer
 		{
 			static constexpr uint32 kPageSize = 64 * 1024;
 
-			GrowOnlySpanAllocator Allocator;
+			SpanAllocator Allocator;
 			white::ref_ptr<RenderGraph::RGPooledBuffer> DataBuffer;
 
+			static int32 GetNumPages(DSFileFormat::GpuRegion region)
+			{
+				return static_cast<int32>((region.UncompressedSize + kPageSize - 1) / kPageSize);
+			}
+
+			int32 GetGrowth(DSFileFormat::GpuRegion region) const
+			{
+				return Allocator.GetGrowth(GetNumPages(region));
+			}
+
 			int32 Allocate(DSFileFormat::GpuRegion region)
 			{
-				return Allocator.Allocate((region.UncompressedSize + kPageSize - 1) / kPageSize);
+				return Allocator.Allocate(GetNumPages(region));
+			}
+
+			void Free(int32 StartPage, DSFileFormat::GpuRegion region)
+			{
+				Allocator.Free(StartPage, GetNumPages(region));
 			}
 
 			RenderGraph::RGBufferRef ResizeByteAddressBufferIfNeeded(RenderGraph::RGBuilder& Builder);
@@ -130,9 +267,12 @@ namespace Trinf
 		};
 
 
-		GrowOnlySpanAllocator KeyAllocator;
+		SpanAllocator KeyAllocator;
 		std::vector<TrinfKey> Keys;
 
+		ResidencyBudget Budget;
+		uint64 FrameIndex = 1;
+
 		std::vector<std::shared_ptr<Resources>> PendingAdds;
 
 		std::vector<std::shared_ptr<Resources>> Streaming;
@@ -0,0 +1,48 @@
+#ifndef Tools_BenchCommon_h
+#define Tools_BenchCommon_h 1
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// Helpers shared by the Tools/*Bench programs
+namespace bench
+{
+	// Seed of the random inputs, fixed so runs are comparable
+	inline constexpr unsigned Seed = 0x5eed;
+
+	//! \brief Seconds of the fastest of Repeat runs.
+	template<typename Function>
+	double Best(unsigned Repeat, Function&& Run)
+	{
+		double Result = 1e30;
+		for (unsigned Iteration = 0; Iteration != Repeat; ++Iteration)
+		{
+			auto Start = std::chrono::steady_clock::now();
+			Run();
+			Result = std::min(Result, std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count());
+		}
+		return Result;
+	}
+
+	template<typename Function>
+	double Time(Function&& Run)
+	{
+		return Best(1, Run);
+	}
+
+	//! \brief Prints the usage and returns true when the first argument asks for help.
+	inline bool Usage(int argc, char** argv, const char* Arguments, const char* Description)
+	{
+		if (argc > 1 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))
+		{
+			std::cout << "usage: " << Arguments << std::endl
+				<< "  " << Description << std::endl;
+			return true;
+		}
+		return false;
+	}
+}
+
+#endif
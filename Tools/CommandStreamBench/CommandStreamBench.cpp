@@ -0,0 +1,201 @@
+#include <Engine/RenderInterface/ICommandList.h>
+#include <Engine/RenderInterface/IContext.h>
+#include <Engine/RenderInterface/IDevice.h>
+#include <Engine/RenderInterface/IDisplay.h>
+#include <Engine/NullRHI/Stats.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace platform::Render;
+using platform_ex::Null::GetStats;
+
+namespace
+{
+	constexpr uint32 kDrawsPerPSO = 64;
+	constexpr uint32 kNumPSOs = 4;
+
+	struct Scene
+	{
+		std::shared_ptr<Texture2D> RenderTarget;
+		std::shared_ptr<GraphicsBuffer> VertexBuffer;
+		std::shared_ptr<GraphicsBuffer> IndexBuffer;
+		std::shared_ptr<HardwareShader> VertexShader;
+		std::vector<std::shared_ptr<GraphicsPipelineState>> PSOs;
+	};
+
+	struct RunResult
+	{
+		double RecordSeconds;
+		double TranslateSeconds;
+		uint64 Commands;
+		uint64 Draws;
+		uint64 StateChanges;
+	};
+
+	Scene CreateScene()
+	{
+		auto& Device = Context::Instance().GetDevice();
+
+		Scene Result;
+		Result.RenderTarget = white::share_raw(Device.CreateTexture(1920, 1080, 1, 1, EF_ARGB8, EAccessHint::RTV | EAccessHint::SRV, {}));
+		Result.VertexBuffer = white::share_raw(Device.CreateVertexBuffer(Buffer::Usage::Static,
+			EAccessHint::VertexOrIndexBuffer | EAccessHint::Immutable, 1 << 16, EF_Unknown));
+		Result.IndexBuffer = white::share_raw(Device.CreateIndexBuffer(Buffer::Usage::Static,
+			EAccessHint::VertexOrIndexBuffer | EAccessHint::Immutable, 1 << 16, EF_R16UI));
+
+		const uint8 Code[4] = {};
+		Result.VertexShader = white::share_raw(Device.CreateVertexShader(white::make_const_span(Code)));
+
+		for (uint32 Index = 0; Index != kNumPSOs; ++Index)
+		{
+			GraphicsPipelineStateInitializer Initializer;
+			Initializer.ShaderPass.VertexShader = static_cast<VertexHWShader*>(Result.VertexShader.get());
+			Initializer.Primitive = Index % 2 ? PrimtivteType::TriangleStrip : PrimtivteType::TriangleList;
+			Result.PSOs.emplace_back(white::share_raw(Device.CreateGraphicsPipelineState(Initializer)));
+		}
+		return Result;
+	}
+
+	// The hot commands of a mesh pass: a pipeline state every kDrawsPerPSO draws, a parameter, a stream and a draw each.
+	void RecordRecords(CommandList& CmdList, const Scene& InScene, uint32 NumDraws)
+	{
+		auto VS = static_cast<VertexHWShader*>(InScene.VertexShader.get());
+
+		CmdList.PushEvent(u"CommandStreamBench", platform::FColor(0, 255, 0));
+		CmdList.BeginRenderPass(RenderPassInfo(InScene.RenderTarget.get(), RenderTargetActions::Clear_Store), "Bench");
+		CmdList.SetViewport(0, 0, 0, 1920, 1080, 1);
+		for (uint32 Draw = 0; Draw != NumDraws; ++Draw)
+		{
+			if (Draw % kDrawsPerPSO == 0)
+				CmdList.SetGraphicsPipelineState(InScene.PSOs[Draw / kDrawsPerPSO % kNumPSOs].get());
+
+			float Transform[4] = { static_cast<float>(Draw), 0, 0, 1 };
+			CmdList.SetShaderParameter(VS, 0, 0, sizeof(Transform), Transform);
+			CmdList.SetVertexBuffer(0, InScene.VertexBuffer.get());
+			CmdList.DrawIndexedPrimitive(InScene.IndexBuffer.get(), 0, 0, 4, 0, 2, 1);
+		}
+		CmdList.PopEvent();
+	}
+
+	// The same stream through lambda commands, the way CommandList recorded it before the POD records.
+	void RecordLambdas(CommandList& CmdList, const Scene& InScene, uint32 NumDraws)
+	{
+		auto VS = static_cast<VertexHWShader*>(InScene.VertexShader.get());
+		auto RenderTarget = InScene.RenderTarget.get();
+		auto VertexBuffer = InScene.VertexBuffer.get();
+		auto IndexBuffer = InScene.IndexBuffer.get();
+
+		CmdList.InsertCommand([=](CommandListBase& CmdList) {
+			CmdList.GetComputeContext().PushEvent(u"CommandStreamBench", platform::FColor(0, 255, 0));
+			});
+		CmdList.InsertCommand([=](CommandListBase& CmdList) {
+			CmdList.GetContext().BeginRenderPass(RenderPassInfo(RenderTarget, RenderTargetActions::Clear_Store), "Bench");
+			});
+		CmdList.InsertCommand([=](CommandListBase& CmdList) {
+			CmdList.GetContext().SetViewport(0, 0, 0, 1920, 1080, 1);
+			});
+		for (uint32 Draw = 0; Draw != NumDraws; ++Draw)
+		{
+			if (Draw % kDrawsPerPSO == 0)
+			{
+				auto PSO = InScene.PSOs[Draw / kDrawsPerPSO % kNumPSOs].get();
+				CmdList.InsertCommand([=](CommandListBase& CmdList) {
+					CmdList.GetContext().SetGraphicsPipelineState(PSO);
+					});
+			}
+
+			float Transform[4] = { static_cast<float>(Draw), 0, 0, 1 };
+			auto Value = CmdList.AllocBuffer(sizeof(Transform), Transform);
+			CmdList.InsertCommand([=](CommandListBase& CmdList) {
+				CmdList.GetContext().SetShaderParameter(VS, 0, 0, sizeof(Transform), Value);
+				});
+			CmdList.InsertCommand([=](CommandListBase& CmdList) {
+				CmdList.GetContext().SetVertexBuffer(0, VertexBuffer);
+				});
+			CmdList.InsertCommand([=](CommandListBase& CmdList) {
+				CmdList.GetContext().DrawIndexedPrimitive(IndexBuffer, 0, 0, 4, 0, 2, 1);
+				});
+		}
+		CmdList.InsertCommand([=](CommandListBase& CmdList) {
+			CmdList.GetComputeContext().PopEvent();
+			});
+	}
+
+	template<typename RecordFunction>
+	RunResult Run(RecordFunction&& Record, const Scene& InScene, uint32 NumDraws, bool bParallel, uint32 Repeat)
+	{
+		GRenderInterfaceParallelTranslate = bParallel;
+
+		RunResult Best{ 1e30, 1e30 };
+		for (uint32 Iteration = 0; Iteration != Repeat; ++Iteration)
+		{
+			CommandList CmdList;
+			CmdList.SetContext(GRenderIF->GetDefaultCommandContext());
+			GetStats().Reset();
+
+			auto RecordSeconds = bench::Time([&] { Record(CmdList, InScene, NumDraws); });
+			auto TranslateSeconds = bench::Time([&] { CmdList.Flush(); });
+
+			Best.RecordSeconds = std::min(Best.RecordSeconds, RecordSeconds);
+			Best.TranslateSeconds = std::min(Best.TranslateSeconds, TranslateSeconds);
+			Best.Commands = GetStats().Commands;
+			Best.Draws = GetStats().Draws;
+			Best.StateChanges = GetStats().StateChanges;
+		}
+
+		GRenderInterfaceParallelTranslate = false;
+		return Best;
+	}
+
+	void Report(const char* Name, const RunResult& Result, uint32 NumDraws)
+	{
+		auto NumCommands = NumDraws * 3 + NumDraws / kDrawsPerPSO + 4;
+		std::cout << Name << ": record " << Result.RecordSeconds * 1e9 / NumCommands << " ns/cmd, translate "
+			<< Result.TranslateSeconds * 1e9 / NumCommands << " ns/cmd, "
+			<< Result.Draws << " draws, " << Result.StateChanges << " state changes, "
+			<< Result.Commands << " context calls" << std::endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "CommandStreamBench [draws] [repeat] [min commands per range]",
+		"records a mesh pass through lambda commands and through POD records on the null RHI"))
+		return 0;
+
+	uint32 NumDraws = argc > 1 ? static_cast<uint32>(std::stoul(argv[1])) : 100000;
+	uint32 Repeat = argc > 2 ? std::max(static_cast<uint32>(std::stoul(argv[2])), 1u) : 5;
+	if (argc > 3)
+		GRenderInterfaceMinCommandsPerTranslateRange = static_cast<uint32>(std::stoul(argv[3]));
+
+	GUseNullRenderInterface = true;
+	GRenderInterfaceSupportCommandThread = false;
+
+	DisplaySetting Setting;
+	Setting.screen_width = 1920;
+	Setting.screen_height = 1080;
+	Context::Instance().CreateDeviceAndDisplay(Setting);
+
+	auto BenchScene = CreateScene();
+
+	std::cout << NumDraws << " draws, best of " << Repeat << std::endl;
+
+	auto Lambdas = Run(RecordLambdas, BenchScene, NumDraws, false, Repeat);
+	auto Records = Run(RecordRecords, BenchScene, NumDraws, false, Repeat);
+	auto Parallel = Run(RecordRecords, BenchScene, NumDraws, true, Repeat);
+
+	Report("lambda", Lambdas, NumDraws);
+	Report("record", Records, NumDraws);
+	Report("record parallel", Parallel, NumDraws);
+
+	if (Records.Draws != Lambdas.Draws || Parallel.Draws != Lambdas.Draws)
+	{
+		std::cerr << "draw count mismatch" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,243 @@
+#include <Engine/Runtime/Compression.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace WhiteEngine;
+using Compression::ECodec;
+
+namespace
+{
+	// Shader bytecode sized blocks compressed one by one, like the shader map does
+	constexpr int32 kBlockSize = 4 * 1024;
+
+	/*
+	A third of text drawn from a small vocabulary, a third of slowly varying floats like vertex streams
+	and a third of random bytes, so every codec hits matches, near matches and incompressible chunks.
+	*/
+	std::vector<uint8> Generate(int32 Size)
+	{
+		static const char* Words[] = { "float4", "return", "uniform", "struct", "position", "normal", "texcoord", "sample", "matrix", "void", " ", ";\n", "(", ")" };
+
+		std::mt19937 Engine(bench::Seed);
+		std::vector<uint8> Result;
+		Result.reserve(Size);
+		while (static_cast<int32>(Result.size()) < Size / 3)
+		{
+			auto Word = Words[Engine() % std::size(Words)];
+			Result.insert(Result.end(), Word, Word + std::strlen(Word));
+		}
+
+		std::normal_distribution<float> Step(0.f, 0.01f);
+		float Value = 0;
+		while (static_cast<int32>(Result.size()) < Size * 2 / 3)
+		{
+			Value += Step(Engine);
+			auto Bytes = reinterpret_cast<const uint8*>(&Value);
+			Result.insert(Result.end(), Bytes, Bytes + sizeof(Value));
+		}
+
+		while (static_cast<int32>(Result.size()) < Size)
+			Result.push_back(static_cast<uint8>(Engine()));
+
+		Result.resize(Size);
+		return Result;
+	}
+
+	std::vector<uint8> Load(const char* Path)
+	{
+		std::ifstream File(Path, std::ios::binary);
+		return { std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>() };
+	}
+
+	// The texels of a .dds file: the magic, DDS_HEADER and, when its four cc is DX10, DDS_HEADER_DXT10 are dropped
+	std::vector<uint8> StripDDSHeader(std::vector<uint8> File)
+	{
+		constexpr std::size_t kHeaderSize = 4 + 124;
+		constexpr std::size_t kFourCCOffset = 4 + 80;
+		constexpr std::size_t kDX10HeaderSize = 20;
+
+		auto Size = kHeaderSize;
+		if (File.size() >= kHeaderSize && std::memcmp(File.data() + kFourCCOffset, "DX10", 4) == 0)
+			Size += kDX10HeaderSize;
+		File.erase(File.begin(), File.begin() + std::min(Size, File.size()));
+		return File;
+	}
+
+	double Throughput(std::size_t Bytes, double Seconds)
+	{
+		return Bytes / Seconds / (1024 * 1024);
+	}
+
+	// Chunked round trip of the whole input, false when the output differs
+	bool RunChunked(const std::vector<uint8>& Input, ECodec Codec, int32 Level, int32 ChunkSize, unsigned Repeat)
+	{
+		auto UncompressedSize = static_cast<int32>(Input.size());
+		std::vector<uint8> Compressed(Compression::CompressMemoryChunkedBound(Codec, UncompressedSize, ChunkSize));
+		std::vector<uint8> Output(Input.size());
+
+		int32 CompressedSize = 0;
+		bool bPass = true;
+		auto Compress = bench::Best(Repeat, [&] {
+			CompressedSize = static_cast<int32>(Compressed.size());
+			bPass &= Compression::CompressMemoryChunked(Codec, Level, Compressed.data(), CompressedSize, Input.data(), UncompressedSize, ChunkSize);
+			});
+		auto UnCompress = bench::Best(Repeat, [&] {
+			bPass &= Compression::UnCompressMemoryChunked(Codec, Output.data(), UncompressedSize, Compressed.data(), CompressedSize);
+			});
+		bPass &= Output == Input;
+
+		std::cout << Compression::GetCodecInfo(Codec).Name << " level " << Level << ", " << ChunkSize / 1024 << " KB chunks: ratio "
+			<< double(UncompressedSize) / CompressedSize << ", compress " << Throughput(Input.size(), Compress) << " MB/s, decompress "
+			<< Throughput(Input.size(), UnCompress) << " MB/s" << (bPass ? "" : ", round trip failed") << std::endl;
+		return bPass;
+	}
+
+	// The whole input compressed as one block, then decompressed in place
+	bool RunInPlace(const std::vector<uint8>& Input, ECodec Codec, int32 Level)
+	{
+		auto UncompressedSize = static_cast<int32>(Input.size());
+		std::vector<uint8> Compressed(Compression::CompressMemoryBound(Codec, UncompressedSize));
+		int32 CompressedSize = static_cast<int32>(Compressed.size());
+		if (!Compression::CompressMemory(Codec, Level, Compressed.data(), CompressedSize, Input.data(), UncompressedSize))
+			return false;
+
+		std::vector<uint8> Buffer(Compression::GetInPlaceBufferSize(Codec, UncompressedSize));
+		std::memcpy(Buffer.data() + Buffer.size() - CompressedSize, Compressed.data(), CompressedSize);
+		auto Seconds = bench::Time([&] {
+			Compression::UnCompressMemoryInPlace(Codec, Buffer.data(), static_cast<int32>(Buffer.size()), UncompressedSize, CompressedSize);
+			});
+
+		bool bPass = std::equal(Input.begin(), Input.end(), Buffer.begin());
+		std::cout << Compression::GetCodecInfo(Codec).Name << " level " << Level << ", one block in place: ratio "
+			<< double(UncompressedSize) / CompressedSize << ", decompress " << Throughput(Input.size(), Seconds) << " MB/s"
+			<< (bPass ? "" : ", round trip failed") << std::endl;
+		return bPass;
+	}
+
+	/*
+	Every page compressed on its own with LZ4HC at the default level, like NaniteEncode does before pages are streamed.
+	The input is cut at Nanite::CLUSTER_PAGE_GPU_SIZE, the upper bound of an uncompressed page.
+	*/
+	bool RunPages(const std::vector<uint8>& Input, unsigned Repeat)
+	{
+		constexpr int32 kPageSize = 1 << 17;
+		auto Level = Compression::GetCodecInfo(ECodec::LZ4HC).DefaultLevel;
+		auto NumPages = static_cast<int32>((Input.size() + kPageSize - 1) / kPageSize);
+		auto PageSize = [&](int32 Page) {
+			return static_cast<int32>(std::min<std::size_t>(kPageSize, Input.size() - std::size_t(Page) * kPageSize));
+			};
+
+		std::vector<std::vector<uint8>> Compressed(NumPages);
+		std::vector<int32> CompressedSizes(NumPages);
+		std::vector<uint8> Output(Input.size());
+
+		bool bPass = true;
+		auto Compress = bench::Best(Repeat, [&] {
+			for (int32 Page = 0; Page != NumPages; ++Page)
+			{
+				Compressed[Page].resize(Compression::CompressMemoryBound(ECodec::LZ4HC, PageSize(Page)));
+				CompressedSizes[Page] = static_cast<int32>(Compressed[Page].size());
+				bPass &= Compression::CompressMemory(ECodec::LZ4HC, Level, Compressed[Page].data(), CompressedSizes[Page], Input.data() + std::size_t(Page) * kPageSize, PageSize(Page));
+			}
+			});
+		auto UnCompress = bench::Best(Repeat, [&] {
+			for (int32 Page = 0; Page != NumPages; ++Page)
+				bPass &= Compression::UnCompressMemory(ECodec::LZ4HC, Output.data() + std::size_t(Page) * kPageSize, PageSize(Page), Compressed[Page].data(), CompressedSizes[Page]);
+			});
+		bPass &= Output == Input;
+
+		std::size_t TotalCompressed = 0;
+		for (auto Size : CompressedSizes)
+			TotalCompressed += Size;
+		std::cout << NumPages << " pages, LZ4HC level " << Level << ": ratio " << double(Input.size()) / TotalCompressed
+			<< ", compress " << Throughput(Input.size(), Compress) << " MB/s, decompress " << Throughput(Input.size(), UnCompress) << " MB/s"
+			<< (bPass ? "" : ", round trip failed") << std::endl;
+		return bPass;
+	}
+
+	// Small blocks through the format name API, which looks the codec up per call, and through a codec resolved once
+	bool RunBlocks(const std::vector<uint8>& Input, unsigned Repeat)
+	{
+		auto NumBlocks = static_cast<int32>(Input.size() / kBlockSize);
+		std::vector<uint8> Compressed(Compression::CompressMemoryBound(ECodec::LZ4, kBlockSize));
+		std::vector<int32> CompressedSizes(NumBlocks);
+		std::vector<uint8> Output(kBlockSize);
+
+		bool bPass = true;
+		for (int32 Block = 0; Block != NumBlocks; ++Block)
+		{
+			CompressedSizes[Block] = static_cast<int32>(Compressed.size());
+			bPass &= Compression::CompressMemory(NAME_LZ4, Compressed.data(), CompressedSizes[Block], Input.data() + Block * kBlockSize, kBlockSize);
+		}
+
+		// Only the last block stays in the buffer, decompressing it over and over isolates the per call cost
+		auto ByName = bench::Best(Repeat, [&] {
+			for (int32 Block = 0; Block != NumBlocks; ++Block)
+				bPass &= Compression::UnCompressMemory(NAME_LZ4, Output.data(), kBlockSize, Compressed.data(), CompressedSizes.back());
+			});
+		auto Format = Compression::FindFormatCodec(NAME_LZ4);
+		auto ByCodec = bench::Best(Repeat, [&] {
+			for (int32 Block = 0; Block != NumBlocks; ++Block)
+				bPass &= Compression::UnCompressMemory(Format.Codec, Output.data(), kBlockSize, Compressed.data(), CompressedSizes.back());
+			});
+		bPass &= std::equal(Output.begin(), Output.end(), Input.begin() + (NumBlocks - 1) * kBlockSize);
+
+		std::cout << NumBlocks << " blocks of " << kBlockSize / 1024 << " KB: decompress by name " << ByName * 1e9 / NumBlocks
+			<< " ns/block, by codec " << ByCodec * 1e9 / NumBlocks << " ns/block" << std::endl;
+		return bPass;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "CompressionBench [megabytes] [repeat] [file [raw|dds|pages]]",
+		"measures ratio and throughput of every codec at several levels and chunk sizes on generated data or a file, and checks the round trips\n"
+		"  dds measures the texels of a .dds file without its headers,\n"
+		"  pages also compresses the file page by page like Nanite streaming pages"))
+		return 0;
+
+	int32 Size = (argc > 1 ? std::max(std::stoi(argv[1]), 1) : 16) * 1024 * 1024;
+	unsigned Repeat = argc > 2 ? std::max(static_cast<unsigned>(std::stoul(argv[2])), 1u) : 3;
+	std::string Kind = argc > 4 ? argv[4] : "raw";
+	if (Kind != "raw" && Kind != "dds" && Kind != "pages")
+	{
+		std::cerr << "unknown input kind " << Kind << std::endl;
+		return 1;
+	}
+	auto Input = argc > 3 ? Load(argv[3]) : Generate(Size);
+	if (Kind == "dds")
+		Input = StripDDSHeader(std::move(Input));
+	if (Input.size() < kBlockSize)
+	{
+		std::cerr << "input smaller than " << kBlockSize << " bytes" << std::endl;
+		return 1;
+	}
+	std::cout << Input.size() / 1024 << " KB " << (argc > 3 ? Kind : "generated") << " input" << std::endl;
+
+	bool bPass = true;
+	for (auto Codec : { ECodec::LZ4, ECodec::LZ4HC })
+	{
+		auto& Info = Compression::GetCodecInfo(Codec);
+		// LZ4 levels are accelerations, LZ4HC levels go up to the optimal parser
+		std::vector<int32> Levels = Codec == ECodec::LZ4 ? std::vector<int32>{ 1, 8, 64 } : std::vector<int32>{ Info.MinLevel, Info.DefaultLevel, Info.MaxLevel };
+		for (auto Level : Levels)
+		{
+			for (auto ChunkSize : { 64 * 1024, Compression::DefaultChunkSize, 1024 * 1024 })
+				bPass &= RunChunked(Input, Codec, Level, ChunkSize, Repeat);
+		}
+		bPass &= RunInPlace(Input, Codec, Info.DefaultLevel);
+	}
+	bPass &= RunBlocks(Input, Repeat);
+	if (Kind == "pages")
+		bPass &= RunPages(Input, Repeat);
+
+	std::cout << (bPass ? "round trips match" : "round trips differ") << std::endl;
+	return bPass ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+#include <Engine/Runtime/Renderer/SceneBVH.h>
+#include <Engine/Core/Math/VectorKernels.h>
+#include <Engine/Runtime/Camera.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace WhiteEngine;
+
+namespace
+{
+	std::vector<BoxSphereBounds> Generate(uint32 Count, std::mt19937& Engine)
+	{
+		std::uniform_real_distribution<float> Position(-1000.f, 1000.f);
+		std::uniform_real_distribution<float> Size(0.5f, 8.f);
+
+		std::vector<BoxSphereBounds> Result;
+		Result.reserve(Count);
+		for (uint32 Index = 0; Index != Count; ++Index)
+		{
+			wm::float3 Extent(Size(Engine), Size(Engine), Size(Engine));
+			Result.emplace_back(wm::float3(Position(Engine), Position(Engine) * 0.1f, Position(Engine)), Extent, wm::length(Extent));
+		}
+		return Result;
+	}
+
+	// Cameras spread around the scene looking at different directions
+	std::vector<ConvexVolume> MakeViews(uint32 Count)
+	{
+		auto Projection = X::perspective_fov_lh(3.14159265f / 3, 16.f / 9, 1.f, 600.f);
+
+		std::vector<ConvexVolume> Result;
+		for (uint32 Index = 0; Index != Count; ++Index)
+		{
+			float Angle = 6.2831853f * Index / Count;
+			wm::float3 Eye(std::cos(Angle) * 300.f, 50.f, std::sin(Angle) * 300.f);
+			auto View = X::look_at_lh(Eye, wm::float3(0, 0, 0), wm::float3(0, 1, 0));
+			Result.emplace_back(ConvexVolume::FromViewProjection(View * Projection));
+		}
+		return Result;
+	}
+
+	// The reference every BVH path has to match: the batched test over all primitives
+	std::vector<uint32> BruteForce(const ConvexVolume& Volume, const std::vector<wm::float3>& Origins, const std::vector<wm::float3>& Extents)
+	{
+		std::vector<uint8> Visible(Origins.size());
+		white::math::CullBoxes(Volume.Planes, Volume.NumPlanes, Origins.data(), Extents.data(), static_cast<uint32>(Origins.size()), Visible.data());
+
+		std::vector<uint32> Result;
+		for (uint32 Index = 0; Index != Visible.size(); ++Index)
+		{
+			if (Visible[Index])
+				Result.push_back(Index);
+		}
+		return Result;
+	}
+
+	bool SameSet(std::vector<uint32> L, std::vector<uint32> R)
+	{
+		std::sort(L.begin(), L.end());
+		std::sort(R.begin(), R.end());
+		return L == R;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "CullBench [count] [views] [repeat]",
+		"culls synthetic bounds with SceneBVH and checks the result against the brute force test"))
+		return 0;
+
+	uint32 Count = argc > 1 ? static_cast<uint32>(std::stoul(argv[1])) : 100000;
+	uint32 NumViews = argc > 2 ? std::max(static_cast<uint32>(std::stoul(argv[2])), 1u) : 4;
+	uint32 Repeat = argc > 3 ? std::max(static_cast<uint32>(std::stoul(argv[3])), 1u) : 10;
+
+	std::mt19937 Engine(bench::Seed);
+	auto Bounds = Generate(Count, Engine);
+	auto Views = MakeViews(NumViews);
+
+	SceneBVH BVH;
+	auto BuildTime = bench::Best(Repeat, [&] { BVH.Build(Bounds); });
+
+	std::cout << Count << " bounds, " << NumViews << " views, best of " << Repeat << ", " << wm::GetKernelInstructionSet() << " kernels" << std::endl;
+	std::cout << "build: " << BuildTime * 1e3 << " ms" << std::endl;
+
+	std::vector<wm::float3> Origins, Extents;
+	for (auto& Bound : Bounds)
+	{
+		Origins.emplace_back(Bound.Origin);
+		Extents.emplace_back(Bound.Extent);
+	}
+
+	bool bMatch = true;
+	auto Check = [&](const char* Name) {
+		std::vector<std::vector<uint32>> Parallel(NumViews);
+		BVH.CullParallel(Views, white::make_span(Parallel));
+		for (uint32 View = 0; View != NumViews; ++View)
+		{
+			std::vector<uint32> Serial;
+			BVH.Cull(Views[View], Serial);
+			auto Reference = BruteForce(Views[View], Origins, Extents);
+			if (!SameSet(Serial, Reference) || Parallel[View] != Serial)
+			{
+				std::cout << Name << ": view " << View << " mismatch, bvh " << Serial.size() << ", parallel " << Parallel[View].size()
+					<< ", brute force " << Reference.size() << std::endl;
+				bMatch = false;
+			}
+		}
+		};
+	Check("build");
+
+	{
+		std::vector<uint32> Visible;
+		auto Brute = bench::Best(Repeat, [&] {
+			for (auto& View : Views)
+				BruteForce(View, Origins, Extents);
+			});
+		auto Serial = bench::Best(Repeat, [&] {
+			for (auto& View : Views)
+			{
+				Visible.clear();
+				BVH.Cull(View, Visible);
+			}
+			});
+		std::vector<std::vector<uint32>> Parallel(NumViews);
+		auto Threaded = bench::Best(Repeat, [&] { BVH.CullParallel(Views, white::make_span(Parallel)); });
+
+		std::size_t NumVisible = 0;
+		for (auto& List : Parallel)
+			NumVisible += List.size();
+		std::cout << "cull: brute force " << Brute * 1e3 << " ms, bvh " << Serial * 1e3 << " ms, bvh parallel " << Threaded * 1e3
+			<< " ms, " << NumVisible / NumViews << " visible per view" << std::endl;
+	}
+
+	{
+		// Move a tenth of the primitives a little, as animated entities would between two frames
+		std::uniform_int_distribution<uint32> Pick(0, Count - 1);
+		std::uniform_real_distribution<float> Offset(-20.f, 20.f);
+		std::vector<uint32> Moved(Count / 10);
+		for (auto& Id : Moved)
+			Id = Pick(Engine);
+
+		auto Refit = bench::Best(Repeat, [&] {
+			for (auto Id : Moved)
+			{
+				Bounds[Id].Origin = Bounds[Id].Origin + wm::float3(Offset(Engine), Offset(Engine), Offset(Engine));
+				Origins[Id] = Bounds[Id].Origin;
+				BVH.Update(Id, Bounds[Id]);
+			}
+			BVH.Refit();
+			});
+		std::cout << "refit: " << Moved.size() << " updates " << Refit * 1e3 << " ms" << std::endl;
+		Check("refit");
+	}
+
+	std::cout << (bMatch ? "results match" : "results differ") << std::endl;
+	return bMatch ? 0 : 1;
+}
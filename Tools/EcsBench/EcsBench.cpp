@@ -0,0 +1,275 @@
+#include <WTest/EngineTest/EntityComponentSystem/World.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	struct Position { float X, Y, Z; };
+	struct Velocity { float X, Y, Z; };
+	struct Rotation { float Yaw, Rate; };
+	struct Health { float Value, Regen; };
+	struct Lifetime { float Remaining; };
+
+	// The layout of ecs::Entity: components behind a per entity map of owning pointers, systems look them up by type
+	namespace Legacy
+	{
+		struct Component
+		{
+			virtual ~Component() = default;
+		};
+
+		template<typename Data>
+		struct Boxed : Component
+		{
+			Data Value;
+
+			explicit Boxed(const Data& InValue)
+				:Value(InValue)
+			{}
+		};
+
+		struct Entity
+		{
+			std::unordered_multimap<std::type_index, std::unique_ptr<Component>> Components;
+
+			template<typename Data>
+			void Add(const Data& Value)
+			{
+				Components.emplace(std::type_index(typeid(Data)), std::make_unique<Boxed<Data>>(Value));
+			}
+
+			template<typename Data>
+			Data* Get()
+			{
+				auto Itr = Components.find(std::type_index(typeid(Data)));
+				return Itr == Components.end() ? nullptr : &static_cast<Boxed<Data>*>(Itr->second.get())->Value;
+			}
+		};
+
+		struct System
+		{
+			virtual ~System() = default;
+			virtual void Update(std::vector<std::unique_ptr<Entity>>& Entities, float TimeStep) = 0;
+		};
+
+		struct MoveSystem : System
+		{
+			void Update(std::vector<std::unique_ptr<Entity>>& Entities, float TimeStep) override
+			{
+				for (auto& pEntity : Entities)
+				{
+					auto pPosition = pEntity->Get<Position>();
+					auto pVelocity = pEntity->Get<Velocity>();
+					if (pPosition && pVelocity)
+					{
+						pPosition->X += pVelocity->X * TimeStep;
+						pPosition->Y += pVelocity->Y * TimeStep;
+						pPosition->Z += pVelocity->Z * TimeStep;
+					}
+				}
+			}
+		};
+
+		struct SpinSystem : System
+		{
+			void Update(std::vector<std::unique_ptr<Entity>>& Entities, float TimeStep) override
+			{
+				for (auto& pEntity : Entities)
+				{
+					if (auto pRotation = pEntity->Get<Rotation>())
+						pRotation->Yaw += pRotation->Rate * TimeStep;
+				}
+			}
+		};
+
+		struct HealthSystem : System
+		{
+			void Update(std::vector<std::unique_ptr<Entity>>& Entities, float TimeStep) override
+			{
+				for (auto& pEntity : Entities)
+				{
+					auto pHealth = pEntity->Get<Health>();
+					auto pLifetime = pEntity->Get<Lifetime>();
+					if (pHealth && pLifetime)
+					{
+						pHealth->Value = std::min(pHealth->Value + pHealth->Regen * TimeStep, 100.f);
+						pLifetime->Remaining -= TimeStep;
+					}
+				}
+			}
+		};
+	}
+
+	// Entities get 3, 4 or 5 components depending on their index
+	Position MakePosition(unsigned Index) { return { float(Index % 1000), float(Index % 7), float(Index % 13) }; }
+	Velocity MakeVelocity(unsigned Index) { return { 1.f, float(Index % 3), -1.f }; }
+	Rotation MakeRotation(unsigned Index) { return { 0.f, float(Index % 5) }; }
+	Health MakeHealth(unsigned Index) { return { 50.f, float(Index % 4) }; }
+	Lifetime MakeLifetime(unsigned Index) { return { float(Index % 100) }; }
+
+	constexpr float kTimeStep = 1.f / 60;
+
+	void MoveKernel(white::uint32 Count, const ecs::EntityId*, Position* Positions, const Velocity* Velocities)
+	{
+		for (white::uint32 Index = 0; Index != Count; ++Index)
+		{
+			Positions[Index].X += Velocities[Index].X * kTimeStep;
+			Positions[Index].Y += Velocities[Index].Y * kTimeStep;
+			Positions[Index].Z += Velocities[Index].Z * kTimeStep;
+		}
+	}
+
+	void SpinKernel(white::uint32 Count, const ecs::EntityId*, Rotation* Rotations)
+	{
+		for (white::uint32 Index = 0; Index != Count; ++Index)
+			Rotations[Index].Yaw += Rotations[Index].Rate * kTimeStep;
+	}
+
+	void HealthKernel(white::uint32 Count, const ecs::EntityId*, Health* Healths, Lifetime* Lifetimes)
+	{
+		for (white::uint32 Index = 0; Index != Count; ++Index)
+		{
+			Healths[Index].Value = std::min(Healths[Index].Value + Healths[Index].Regen * kTimeStep, 100.f);
+			Lifetimes[Index].Remaining -= kTimeStep;
+		}
+	}
+
+	// Order independent digest so the storages can be compared after the same updates
+	struct Digest
+	{
+		double Position = 0, Yaw = 0, Health = 0, Lifetime = 0;
+
+		bool operator==(const Digest& Other) const
+		{
+			auto Near = [](double L, double R) { return std::abs(L - R) <= 1e-6 * std::max(1.0, std::abs(L)); };
+			return Near(Position, Other.Position) && Near(Yaw, Other.Yaw) && Near(Health, Other.Health) && Near(Lifetime, Other.Lifetime);
+		}
+	};
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "EcsBench [entities] [frames]",
+		"updates entities with 3 to 5 components stored per entity and by archetype, and checks both agree"))
+		return 0;
+
+	unsigned Count = argc > 1 ? static_cast<unsigned>(std::stoul(argv[1])) : 1000000;
+	unsigned Frames = argc > 2 ? std::max(static_cast<unsigned>(std::stoul(argv[2])), 1u) : 10;
+	std::cout << Count << " entities, " << Frames << " frames" << std::endl;
+
+	std::vector<std::unique_ptr<Legacy::Entity>> LegacyEntities;
+	std::vector<std::unique_ptr<Legacy::System>> LegacySystems;
+	auto LegacyCreate = bench::Time([&] {
+		for (unsigned Index = 0; Index != Count; ++Index)
+		{
+			auto& Entity = *LegacyEntities.emplace_back(std::make_unique<Legacy::Entity>());
+			Entity.Add(MakePosition(Index));
+			Entity.Add(MakeVelocity(Index));
+			Entity.Add(MakeRotation(Index));
+			if (Index % 4 != 0)
+				Entity.Add(MakeHealth(Index));
+			if (Index % 4 == 3)
+				Entity.Add(MakeLifetime(Index));
+		}
+		});
+	LegacySystems.emplace_back(std::make_unique<Legacy::MoveSystem>());
+	LegacySystems.emplace_back(std::make_unique<Legacy::SpinSystem>());
+	LegacySystems.emplace_back(std::make_unique<Legacy::HealthSystem>());
+
+	ecs::World World;
+	std::vector<ecs::EntityId> Ids(Count);
+	auto WorldCreate = bench::Time([&] {
+		for (unsigned Index = 0; Index != Count; ++Index)
+		{
+			switch (Index % 4)
+			{
+			case 0:
+				Ids[Index] = World.Create(MakePosition(Index), MakeVelocity(Index), MakeRotation(Index));
+				break;
+			case 3:
+				Ids[Index] = World.Create(MakePosition(Index), MakeVelocity(Index), MakeRotation(Index), MakeHealth(Index), MakeLifetime(Index));
+				break;
+			default:
+				Ids[Index] = World.Create(MakePosition(Index), MakeVelocity(Index), MakeRotation(Index), MakeHealth(Index));
+				break;
+			}
+		}
+		});
+	std::cout << "create: per entity " << LegacyCreate * 1e3 << " ms, archetype " << WorldCreate * 1e3 << " ms" << std::endl;
+
+	auto LegacyFrame = bench::Best(Frames, [&] {
+		for (auto& pSystem : LegacySystems)
+			pSystem->Update(LegacyEntities, kTimeStep);
+		});
+	auto SerialFrame = bench::Best(Frames, [&] {
+		World.ForEachChunk<Position, const Velocity>(MoveKernel);
+		World.ForEachChunk<Rotation>(SpinKernel);
+		World.ForEachChunk<Health, Lifetime>(HealthKernel);
+		});
+	auto ParallelFrame = bench::Best(Frames, [&] {
+		World.ParallelForEachChunk<Position, const Velocity>(MoveKernel);
+		World.ParallelForEachChunk<Rotation>(SpinKernel);
+		World.ParallelForEachChunk<Health, Lifetime>(HealthKernel);
+		});
+	std::cout << "frame: per entity " << LegacyFrame * 1e3 << " ms, archetype " << SerialFrame * 1e3 << " ms, archetype parallel "
+		<< ParallelFrame * 1e3 << " ms" << std::endl;
+
+	// The archetype storage ran the frames twice, once serially and once in parallel
+	for (unsigned Frame = 0; Frame != Frames; ++Frame)
+	{
+		for (auto& pSystem : LegacySystems)
+			pSystem->Update(LegacyEntities, kTimeStep);
+	}
+
+	Digest LegacyDigest, WorldDigest;
+	for (auto& pEntity : LegacyEntities)
+	{
+		auto& Entity = *pEntity;
+		LegacyDigest.Position += Entity.Get<Position>()->X + Entity.Get<Position>()->Y + Entity.Get<Position>()->Z;
+		LegacyDigest.Yaw += Entity.Get<Rotation>()->Yaw;
+		if (auto pHealth = Entity.Get<Health>())
+			LegacyDigest.Health += pHealth->Value;
+		if (auto pLifetime = Entity.Get<Lifetime>())
+			LegacyDigest.Lifetime += pLifetime->Remaining;
+	}
+	World.ForEach<const Position, const Rotation>([&](const Position& InPosition, const Rotation& InRotation) {
+		WorldDigest.Position += InPosition.X + InPosition.Y + InPosition.Z;
+		WorldDigest.Yaw += InRotation.Yaw;
+		});
+	World.ForEach<const Health>([&](const Health& InHealth) { WorldDigest.Health += InHealth.Value; });
+	World.ForEach<const Lifetime>([&](const Lifetime& InLifetime) { WorldDigest.Lifetime += InLifetime.Remaining; });
+	bool bMatch = LegacyDigest == WorldDigest;
+
+	{
+		// Structural churn: a tenth of the entities lose their velocity and get it back, then are destroyed and created again
+		unsigned NumChurn = Count / 10;
+		auto Churn = bench::Time([&] {
+			for (unsigned Index = 0; Index < Count; Index += 10)
+				World.Remove<Velocity>(Ids[Index]);
+			for (unsigned Index = 0; Index < Count; Index += 10)
+				World.Add<Velocity>(Ids[Index], MakeVelocity(Index));
+			for (unsigned Index = 0; Index < Count; Index += 10)
+				World.Destroy(Ids[Index]);
+			for (unsigned Index = 0; Index < Count; Index += 10)
+				Ids[Index] = World.Create(MakePosition(Index), MakeVelocity(Index), MakeRotation(Index));
+			});
+		std::cout << "churn: " << NumChurn << " remove, add, destroy and create " << Churn * 1e3 << " ms" << std::endl;
+
+		for (unsigned Index = 0; Index != Count; ++Index)
+		{
+			auto pVelocity = World.Get<Velocity>(Ids[Index]);
+			if (!pVelocity || pVelocity->Y != float(Index % 3))
+				bMatch = false;
+		}
+		bMatch = bMatch && World.GetEntityCount() == Count;
+	}
+
+	std::cout << (bMatch ? "results match" : "results differ") << std::endl;
+	return bMatch ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+#include <Engine/Core/Container/BinaryHeap.h>
+#include <Engine/Core/Container/BinaryHeapTrace.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace white;
+
+namespace
+{
+	//! \brief Replays the trace, returns the pops whose recorded top had an equal key sibling on top in this layout.
+	template<uint32 Arity>
+	uint32 Replay(span<const FBinaryHeapTraceOp> Ops)
+	{
+		FBinaryHeap<float, uint32, Arity> Heap;
+		std::vector<float> BuildKeys;
+		std::vector<uint32> BuildIndexes;
+
+		uint32 TieMismatches = 0;
+		for (std::size_t i = 0; i < Ops.size(); ++i)
+		{
+			const auto& Op = Ops[i];
+			switch (Op.Type)
+			{
+			case FBinaryHeapTraceOp::Build:
+			{
+				BuildKeys.clear();
+				BuildIndexes.clear();
+				for (; i < Ops.size() && Ops[i].Type == FBinaryHeapTraceOp::Build; ++i)
+				{
+					BuildKeys.push_back(Ops[i].Key);
+					BuildIndexes.push_back(Ops[i].Index);
+				}
+				--i;
+				Heap.Resize(static_cast<uint32>(BuildKeys.size()), static_cast<uint32>(BuildKeys.size()));
+				Heap.Build(BuildKeys.data(), BuildIndexes.data(), static_cast<uint32>(BuildKeys.size()));
+				break;
+			}
+			case FBinaryHeapTraceOp::Add:
+				Heap.Add(Op.Key, Op.Index);
+				break;
+			case FBinaryHeapTraceOp::Remove:
+				Heap.Remove(Op.Index);
+				break;
+			case FBinaryHeapTraceOp::Pop:
+				// Keep the replay on the recorded path when ties resolve differently.
+				if (Heap.Top() == Op.Index)
+				{
+					Heap.Pop();
+				}
+				else
+				{
+					++TieMismatches;
+					Heap.Remove(Op.Index);
+				}
+				break;
+			}
+		}
+
+		return TieMismatches;
+	}
+
+	// Simplifier shaped trace: bulk build, then every pop removes a few neighbours and adds them back with higher cost.
+	std::vector<FBinaryHeapTraceOp> SynthesizeTrace(uint32 NumPairs)
+	{
+		std::vector<FBinaryHeapTraceOp> Ops;
+		std::mt19937 Rand(bench::Seed ^ NumPairs);
+		std::uniform_real_distribution<float> Cost(0.0f, 1.0f);
+		std::uniform_int_distribution<uint32> Pick(0, NumPairs - 1);
+
+		FBinaryHeap<float> Heap;
+		std::vector<float> Keys(NumPairs);
+		std::vector<uint32> Indexes(NumPairs);
+		for (uint32 i = 0; i < NumPairs; ++i)
+		{
+			Keys[i] = Cost(Rand);
+			Indexes[i] = i;
+			Ops.push_back({ FBinaryHeapTraceOp::Build, i, Keys[i] });
+		}
+		Heap.Build(Keys.data(), Indexes.data(), NumPairs);
+
+		std::vector<uint32> Reevaluate;
+		while (Heap.Num() > NumPairs / 4)
+		{
+			uint32 Top = Heap.Top();
+			float TopKey = Heap.GetKey(Top);
+			Ops.push_back({ FBinaryHeapTraceOp::Pop, Top, 0.0f });
+			Heap.Pop();
+
+			Reevaluate.clear();
+			for (uint32 j = 0; j < 6; ++j)
+			{
+				uint32 Index = Pick(Rand);
+				if (Heap.IsPresent(Index))
+				{
+					Ops.push_back({ FBinaryHeapTraceOp::Remove, Index, 0.0f });
+					Heap.Remove(Index);
+					Reevaluate.push_back(Index);
+				}
+			}
+			// Collapses usually retire a couple of pairs for good.
+			for (std::size_t j = 2; j < Reevaluate.size(); ++j)
+			{
+				float Key = TopKey + Cost(Rand) * 0.1f;
+				Ops.push_back({ FBinaryHeapTraceOp::Add, Reevaluate[j], Key });
+				Heap.Add(Key, Reevaluate[j]);
+			}
+		}
+		return Ops;
+	}
+
+	template<uint32 Arity>
+	void Report(span<const FBinaryHeapTraceOp> Ops, uint32 Repeat)
+	{
+		uint32 TieMismatches = 0;
+		auto Seconds = bench::Best(Repeat, [&] { TieMismatches = Replay<Arity>(Ops); });
+
+		std::cout << Arity << "-ary: " << Seconds * 1000.0 << " ms, "
+			<< Ops.size() / Seconds / 1e6 << " Mops/s, "
+			<< TieMismatches << " tie mismatches" << std::endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "HeapTraceBench <trace file> [repeat]\n       HeapTraceBench -synthetic [pairs] [repeat]",
+		"replays a heap trace in the 2, 4 and 8-ary layouts, trace files are written by FMeshSimplifier::SetHeapTrace and SaveBinaryHeapTrace"))
+		return 0;
+
+	bool bSynthetic = argc < 2 || std::string(argv[1]) == "-synthetic";
+	int RepeatArg = bSynthetic ? 3 : 2;
+
+	std::vector<FBinaryHeapTraceOp> Ops;
+	if (bSynthetic)
+	{
+		uint32 NumPairs = argc > 2 ? static_cast<uint32>(std::stoul(argv[2])) : (1u << 20);
+		Ops = SynthesizeTrace(std::max(NumPairs, 16u));
+	}
+	else if (!LoadBinaryHeapTrace(argv[1], Ops))
+	{
+		std::cerr << "failed to load heap trace " << argv[1] << std::endl;
+		return 1;
+	}
+
+	uint32 Repeat = argc > RepeatArg ? std::max(static_cast<uint32>(std::stoul(argv[RepeatArg])), 1u) : 5;
+
+	std::cout << Ops.size() << " heap operations, best of " << Repeat << std::endl;
+
+	Report<2>(Ops, Repeat);
+	Report<4>(Ops, Repeat);
+	Report<8>(Ops, Repeat);
+
+	return 0;
+}
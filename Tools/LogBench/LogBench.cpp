@@ -0,0 +1,94 @@
+#include <WFramework/WCLib/Logger.h>
+#include <Tools/BenchCommon.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using platform::Logger;
+using namespace platform::Descriptions;
+
+namespace
+{
+	constexpr unsigned kNumProducers = 32;
+
+	struct RunResult
+	{
+		// Until every producer returned from its last Log call
+		double ProduceSeconds;
+		// Until every record reached the file
+		double TotalSeconds;
+		std::size_t Dropped;
+	};
+
+	// Same path as the trace macros: filter, format on the calling thread, then DoLog.
+	RunResult Run(std::FILE* File, unsigned PerProducer, bool bAsync, Logger::OverflowPolicy Policy, std::size_t Capacity)
+	{
+		Logger logger;
+		logger.FilterLevel = Debug;
+		logger.SetSender([File](Logger::Level lv, Logger& logger, const char* str) {
+			Logger::SendLogToFile(File, lv, logger, str);
+			});
+		if (bAsync)
+			logger.StartAsync(Capacity, Policy);
+
+		auto Produce = bench::Time([&] {
+			std::vector<std::thread> Producers;
+			for (unsigned Producer = 0; Producer != kNumProducers; ++Producer)
+			{
+				Producers.emplace_back([&, Producer] {
+					for (unsigned Index = 0; Index != PerProducer; ++Index)
+					{
+						logger.Log(Informative, [&] {
+							return platform::sfmt("producer %u loaded asset %u of %u", Producer, Index, PerProducer);
+							});
+					}
+					});
+			}
+			for (auto& Producer : Producers)
+				Producer.join();
+			});
+
+		std::size_t Dropped = 0;
+		auto Drain = bench::Time([&] {
+			logger.Flush();
+			Dropped = logger.GetDroppedCount();
+			logger.StopAsync();
+			});
+		return { Produce, Produce + Drain, Dropped };
+	}
+
+	void Report(const char* Name, const RunResult& Result, unsigned PerProducer)
+	{
+		double Records = double(kNumProducers) * PerProducer;
+		std::cout << Name << ": " << Records / Result.ProduceSeconds / 1e3 << "k records/s on producers, "
+			<< Result.TotalSeconds * 1e3 << " ms until written, " << Result.Dropped << " dropped" << std::endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "LogBench [records per producer] [queue capacity] [log file]",
+		("logs from " + std::to_string(kNumProducers) + " threads synchronously and through the asynchronous modes").c_str()))
+		return 0;
+
+	unsigned PerProducer = argc > 1 ? static_cast<unsigned>(std::stoul(argv[1])) : 10000;
+	std::size_t Capacity = argc > 2 ? std::stoul(argv[2]) : 8192;
+	std::string Path = argc > 3 ? argv[3] : "LogBench.log";
+
+	auto File = std::fopen(Path.c_str(), "w");
+	if (!File)
+	{
+		std::cerr << "failed to open " << Path << std::endl;
+		return 1;
+	}
+
+	std::cout << kNumProducers << " producers, " << PerProducer << " records each, capacity " << Capacity << ", writing " << Path << std::endl;
+	Report("sync", Run(File, PerProducer, false, Logger::OverflowPolicy::Block, Capacity), PerProducer);
+	Report("async block", Run(File, PerProducer, true, Logger::OverflowPolicy::Block, Capacity), PerProducer);
+	Report("async drop", Run(File, PerProducer, true, Logger::OverflowPolicy::Drop, Capacity), PerProducer);
+
+	std::fclose(File);
+	return 0;
+}
@@ -0,0 +1,183 @@
+#include <WBase/wmath.hpp>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace white::math;
+using white::uint8;
+using white::uint32;
+
+namespace
+{
+	struct Inputs
+	{
+		std::vector<float4x4> Matrices;
+		std::vector<float4> Vectors;
+		std::vector<float3> Points;
+	};
+
+	Inputs Generate(std::size_t Count)
+	{
+		std::mt19937 Engine(bench::Seed);
+		std::uniform_real_distribution<float> Value(-4.f, 4.f);
+
+		Inputs Result;
+		while (Result.Matrices.size() != Count)
+		{
+			float4x4 M;
+			for (uint8 Row = 0; Row != 4; ++Row)
+				M[Row] = float4(Value(Engine), Value(Engine), Value(Engine), Value(Engine));
+			// Keep the inverse comparison away from near singular matrices
+			if (std::fabs(determinant(M)) > 0.5f)
+				Result.Matrices.emplace_back(M);
+		}
+		for (std::size_t Index = 0; Index != Count; ++Index)
+		{
+			Result.Vectors.emplace_back(Value(Engine), Value(Engine), Value(Engine), 1.f);
+			Result.Points.emplace_back(Value(Engine), Value(Engine), Value(Engine));
+		}
+		return Result;
+	}
+
+	// Relative to the magnitude so large inverse entries are not over weighted.
+	float Difference(float L, float R)
+	{
+		return std::fabs(L - R) / (1.f + std::fabs(L));
+	}
+
+	float Difference(const float4& L, const float4& R)
+	{
+		return std::max({ Difference(L.x, R.x), Difference(L.y, R.y), Difference(L.z, R.z), Difference(L.w, R.w) });
+	}
+
+	float Difference(const float3& L, const float3& R)
+	{
+		return std::max({ Difference(L.x, R.x), Difference(L.y, R.y), Difference(L.z, R.z) });
+	}
+
+	float Difference(const float4x4& L, const float4x4& R)
+	{
+		return std::max({ Difference(L[0], R[0]), Difference(L[1], R[1]), Difference(L[2], R[2]), Difference(L[3], R[3]) });
+	}
+
+	// Folds outputs into a value that is printed, so the loops are not optimized away.
+	float Sink = 0;
+
+	void Report(const char* Name, double Scalar, double Simd, std::size_t Count, float MaxDifference)
+	{
+		std::cout << Name << ": scalar " << Scalar * 1e9 / Count << " ns, simd " << Simd * 1e9 / Count
+			<< " ns, speedup " << Scalar / Simd << "x, max difference " << MaxDifference << std::endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "MathBench [count] [repeat]", "compares the scalar and SIMD float4x4 paths on random inputs"))
+		return 0;
+
+	std::size_t Count = argc > 1 ? std::stoul(argv[1]) : 1 << 16;
+	uint32 Repeat = argc > 2 ? std::max(static_cast<uint32>(std::stoul(argv[2])), 1u) : 10;
+
+#if WB_MATH_SIMD == WB_MATH_SIMD_NONE
+	std::cout << "built without a SIMD backend, nothing to compare" << std::endl;
+	return 0;
+#else
+	std::cout << (WB_MATH_SIMD == WB_MATH_SIMD_SSE ? "sse" : "neon") << ", " << Count << " elements, best of " << Repeat << std::endl;
+
+	auto In = Generate(Count);
+	std::vector<float4x4> ScalarMatrices(Count), SimdMatrices(Count);
+	std::vector<float4> ScalarVectors(Count), SimdVectors(Count);
+	std::vector<float3> ScalarPoints(Count), SimdPoints(Count);
+	auto& Transform = In.Matrices.front();
+
+	float MaxDifference = 0;
+	auto Compare = [&](const auto& L, const auto& R) {
+		MaxDifference = 0;
+		for (std::size_t Index = 0; Index != Count; ++Index)
+			MaxDifference = std::max(MaxDifference, Difference(L[Index], R[Index]));
+		Sink += Difference(L[Count / 2], R[Count / 2]);
+		};
+
+	{
+		auto Scalar = bench::Best(Repeat, [&] {
+			for (std::size_t Index = 0; Index != Count; ++Index)
+				ScalarMatrices[Index] = scalar::mul(In.Matrices[Index], In.Matrices[Count - 1 - Index]);
+			});
+		auto Simd = bench::Best(Repeat, [&] {
+			for (std::size_t Index = 0; Index != Count; ++Index)
+				SimdMatrices[Index] = simd::mul(In.Matrices[Index], In.Matrices[Count - 1 - Index]);
+			});
+		Compare(ScalarMatrices, SimdMatrices);
+		Report("mul", Scalar, Simd, Count, MaxDifference);
+	}
+
+	{
+		auto Scalar = bench::Best(Repeat, [&] {
+			for (std::size_t Index = 0; Index != Count; ++Index)
+				ScalarMatrices[Index] = scalar::inverse(In.Matrices[Index]);
+			});
+		auto Simd = bench::Best(Repeat, [&] {
+			float Det;
+			for (std::size_t Index = 0; Index != Count; ++Index)
+				SimdMatrices[Index] = simd::inverse(In.Matrices[Index], Det);
+			});
+		Compare(ScalarMatrices, SimdMatrices);
+		Report("inverse", Scalar, Simd, Count, MaxDifference);
+	}
+
+	{
+		auto Scalar = bench::Best(Repeat, [&] {
+			for (std::size_t Index = 0; Index != Count; ++Index)
+				ScalarMatrices[Index] = scalar::transpose(In.Matrices[Index]);
+			});
+		auto Simd = bench::Best(Repeat, [&] {
+			for (std::size_t Index = 0; Index != Count; ++Index)
+				SimdMatrices[Index] = simd::transpose(In.Matrices[Index]);
+			});
+		Compare(ScalarMatrices, SimdMatrices);
+		Report("transpose", Scalar, Simd, Count, MaxDifference);
+	}
+
+	{
+		auto Scalar = bench::Best(Repeat, [&] {
+			for (std::size_t Index = 0; Index != Count; ++Index)
+				ScalarVectors[Index] = scalar::transform(In.Vectors[Index], In.Matrices[Index]);
+			});
+		auto Simd = bench::Best(Repeat, [&] {
+			for (std::size_t Index = 0; Index != Count; ++Index)
+				SimdVectors[Index] = simd::transform(In.Vectors[Index], In.Matrices[Index]);
+			});
+		Compare(ScalarVectors, SimdVectors);
+		Report("transform", Scalar, Simd, Count, MaxDifference);
+	}
+
+	{
+		auto Scalar = bench::Best(Repeat, [&] {
+			scalar::transform(In.Vectors.data(), ScalarVectors.data(), Count, Transform);
+			});
+		auto Simd = bench::Best(Repeat, [&] {
+			simd::transform(In.Vectors.data(), SimdVectors.data(), Count, Transform);
+			});
+		Compare(ScalarVectors, SimdVectors);
+		Report("transform batch", Scalar, Simd, Count, MaxDifference);
+	}
+
+	{
+		auto Scalar = bench::Best(Repeat, [&] {
+			scalar::transformpoint(In.Points.data(), ScalarPoints.data(), Count, Transform);
+			});
+		auto Simd = bench::Best(Repeat, [&] {
+			simd::transformpoint(In.Points.data(), SimdPoints.data(), Count, Transform);
+			});
+		Compare(ScalarPoints, SimdPoints);
+		Report("transformpoint batch", Scalar, Simd, Count, MaxDifference);
+	}
+
+	std::cout << "checksum " << Sink << std::endl;
+	return 0;
+#endif
+}
@@ -0,0 +1,198 @@
+#include <Engine/Developer/MeshSimplifier/MeshLodBuilder.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace platform::Render;
+using namespace WhiteEngine;
+
+namespace
+{
+	constexpr uint32 kVertSize = 8;
+	// Lod0 fits in 16 bit indices, lod0 and half of it don't
+	constexpr uint32 kGridSize = 100;
+
+	// Size x Size quads of a height field per submesh, position, normal and uv in separate streams like the geometry section
+	std::unique_ptr<asset::MeshAsset> MakeGrid(uint32 Size, uint32 NumSubMeshes, EFormat IndexFormat)
+	{
+		std::vector<float> Verts;
+		std::vector<uint32> Indexes;
+		auto Mesh = std::make_unique<asset::MeshAsset>();
+
+		for (uint32 SubMeshIndex = 0; SubMeshIndex != NumSubMeshes; ++SubMeshIndex)
+		{
+			asset::MeshAsset::SubMeshDescrption::LodDescription Lod;
+			Lod.VertexBase = static_cast<uint32>(Verts.size() / kVertSize);
+			Lod.VertexNum = (Size + 1) * (Size + 1);
+			Lod.IndexBase = static_cast<uint32>(Indexes.size());
+			Lod.IndexNum = Size * Size * 6;
+
+			for (uint32 Y = 0; Y <= Size; ++Y)
+			{
+				for (uint32 X = 0; X <= Size; ++X)
+				{
+					float U = float(X) / Size, V = float(Y) / Size;
+					float Height = std::sin(U * 12.f + SubMeshIndex) * std::cos(V * 9.f);
+					Verts.insert(Verts.end(), { U * 10.f + SubMeshIndex * 12.f, Height, V * 10.f, 0.f, 1.f, 0.f, U, V });
+				}
+			}
+			for (uint32 Y = 0; Y != Size; ++Y)
+			{
+				for (uint32 X = 0; X != Size; ++X)
+				{
+					uint32 Corner = Y * (Size + 1) + X;
+					Indexes.insert(Indexes.end(), { Corner, Corner + Size + 1, Corner + 1, Corner + 1, Corner + Size + 1, Corner + Size + 2 });
+				}
+			}
+
+			auto& SubMesh = Mesh->GetSubMeshDescesRef().emplace_back();
+			SubMesh.MaterialIndex = 0;
+			SubMesh.LodsDescription.push_back(Lod);
+		}
+
+		const uint32 NumVerts = static_cast<uint32>(Verts.size() / kVertSize);
+		auto& Elements = Mesh->GetVertexElementsRef();
+		Elements = { Vertex::Element(Vertex::Position, 0, EF_BGR32F), Vertex::Element(Vertex::Normal, 0, EF_BGR32F), Vertex::Element(Vertex::TextureCoord, 0, EF_GR32F) };
+		uint32 Offset = 0;
+		for (auto& Element : Elements)
+		{
+			const uint32 NumFloats = Element.GetElementSize() / sizeof(float);
+			auto Stream = std::make_unique<byte[]>(Element.GetElementSize() * NumVerts);
+			for (uint32 i = 0; i != NumVerts; ++i)
+				std::memcpy(Stream.get() + Element.GetElementSize() * i, &Verts[i * kVertSize + Offset], NumFloats * sizeof(float));
+			Mesh->GetVertexStreamsRef().push_back(std::move(Stream));
+			Offset += NumFloats;
+		}
+
+		auto IndexStream = std::make_unique<byte[]>(NumFormatBytes(IndexFormat) * Indexes.size());
+		for (size_t i = 0; i != Indexes.size(); ++i)
+		{
+			if (IndexFormat == EF_R16UI)
+				reinterpret_cast<uint16*>(IndexStream.get())[i] = static_cast<uint16>(Indexes[i]);
+			else
+				reinterpret_cast<uint32*>(IndexStream.get())[i] = Indexes[i];
+		}
+		Mesh->GetIndexStreamsRef() = std::move(IndexStream);
+		Mesh->SetIndexFormat(IndexFormat);
+		Mesh->SetVertexCount(NumVerts);
+		Mesh->SetIndexCount(static_cast<uint32>(Indexes.size()));
+		return Mesh;
+	}
+
+	uint32 ReadIndex(const asset::MeshAsset& Mesh, uint32 Index)
+	{
+		if (Mesh.GetIndexFormat() == EF_R16UI)
+			return reinterpret_cast<const uint16*>(Mesh.GetIndexStreams().get())[Index];
+		return reinterpret_cast<const uint32*>(Mesh.GetIndexStreams().get())[Index];
+	}
+
+	bool Check(const char* What, bool bValue)
+	{
+		if (!bValue)
+			std::cerr << What << std::endl;
+		return bValue;
+	}
+
+	// Lod0 draws the same triangles and every lod range stays inside the streams, below its target and in the geometry section limits
+	bool Validate(const asset::MeshAsset& Source, const asset::MeshAsset& Mesh, const std::vector<FMeshLodTarget>& Targets, const std::vector<FMeshLodReport>& Reports)
+	{
+		bool bPass = Check("lod0 changed", [&] {
+			for (size_t SubMeshIndex = 0; SubMeshIndex != Source.GetSubMeshDesces().size(); ++SubMeshIndex)
+			{
+				auto& SourceLod0 = Source.GetSubMeshDesces()[SubMeshIndex].LodsDescription[0];
+				auto& Lod0 = Mesh.GetSubMeshDesces()[SubMeshIndex].LodsDescription[0];
+				if (SourceLod0.IndexNum != Lod0.IndexNum)
+					return false;
+				for (uint32 i = 0; i != Lod0.IndexNum; ++i)
+				{
+					auto SourceVertex = SourceLod0.VertexBase + ReadIndex(Source, SourceLod0.IndexBase + i);
+					auto Vertex = Lod0.VertexBase + ReadIndex(Mesh, Lod0.IndexBase + i);
+					if (std::memcmp(Source.GetVertexStreams()[0].get() + 12 * SourceVertex, Mesh.GetVertexStreams()[0].get() + 12 * Vertex, 12) != 0)
+						return false;
+				}
+			}
+			return true;
+			}());
+		bPass &= Check("16 bit format past 65535", Mesh.GetIndexFormat() == EF_R32UI || std::max(Mesh.GetVertexCount(), Mesh.GetIndexCount()) <= 0xFFFF);
+		bPass &= Check("missing reports", Reports.size() == Source.GetSubMeshDesces().size() * Targets.size());
+
+		for (auto& SubMesh : Mesh.GetSubMeshDesces())
+		{
+			auto& Lods = SubMesh.LodsDescription;
+			bPass &= Check("missing lods", Lods.size() == Targets.size() + 1);
+			for (size_t LodIndex = 1; LodIndex < Lods.size(); ++LodIndex)
+			{
+				auto& Lod = Lods[LodIndex];
+				bPass &= Check("vertex range out of the streams", Lod.VertexBase + Lod.VertexNum <= Mesh.GetVertexCount());
+				bPass &= Check("index range out of the streams", Lod.IndexBase + Lod.IndexNum <= Mesh.GetIndexCount());
+				// An error limit may stop the simplification before the ratio
+				auto& Target = Targets[LodIndex - 1];
+				bPass &= Check("lod above its target", Target.MaxError < FLT_MAX
+					|| Lod.IndexNum / 3 <= std::max(1u, static_cast<uint32>(Lods[0].IndexNum / 3 * Target.TriangleRatio)));
+				for (uint32 i = 0; i != Lod.IndexNum; ++i)
+				{
+					if (ReadIndex(Mesh, Lod.IndexBase + i) >= Lod.VertexNum)
+						return Check("index past the lod vertices", false);
+				}
+			}
+		}
+		return bPass;
+	}
+
+	bool Run(const char* Name, uint32 Size, uint32 NumSubMeshes, EFormat IndexFormat, const std::vector<FMeshLodTarget>& Targets, EFormat ExpectedFormat)
+	{
+		auto Source = MakeGrid(Size, NumSubMeshes, IndexFormat);
+		auto Mesh = MakeGrid(Size, NumSubMeshes, IndexFormat);
+
+		std::vector<FMeshLodReport> Reports;
+		auto Seconds = bench::Time([&] { Reports = BuildMeshLods(*Mesh, white::make_const_span(Targets)); });
+
+		std::cout << Name << ": " << Source->GetVertexCount() << " -> " << Mesh->GetVertexCount() << " verts, "
+			<< Source->GetIndexCount() << " -> " << Mesh->GetIndexCount() << " indices, "
+			<< (Mesh->GetIndexFormat() == EF_R16UI ? 16 : 32) << " bit indices in " << Seconds * 1e3 << " ms" << std::endl;
+		for (auto& Report : Reports)
+			std::cout << "  submesh " << Report.SubMeshIndex << " lod " << Report.LodIndex << ": " << Report.NumTris << " tris, error " << Report.Error << std::endl;
+
+		return Validate(*Source, *Mesh, Targets, Reports) & Check("unexpected index format", Mesh->GetIndexFormat() == ExpectedFormat);
+	}
+
+	// Building again replaces the lods of the first build instead of leaving them in the streams
+	bool Rebuild(const char* Name, uint32 Size, uint32 NumSubMeshes, const std::vector<FMeshLodTarget>& First, const std::vector<FMeshLodTarget>& Targets)
+	{
+		auto Source = MakeGrid(Size, NumSubMeshes, EF_R32UI);
+		auto Fresh = MakeGrid(Size, NumSubMeshes, EF_R32UI);
+		auto Mesh = MakeGrid(Size, NumSubMeshes, EF_R32UI);
+
+		BuildMeshLods(*Fresh, white::make_const_span(Targets));
+		BuildMeshLods(*Mesh, white::make_const_span(First));
+
+		std::vector<FMeshLodReport> Reports;
+		auto Seconds = bench::Time([&] { Reports = BuildMeshLods(*Mesh, white::make_const_span(Targets)); });
+
+		std::cout << Name << ": " << Mesh->GetVertexCount() << " verts, " << Mesh->GetIndexCount() << " indices in " << Seconds * 1e3 << " ms, "
+			<< Fresh->GetVertexCount() << " verts, " << Fresh->GetIndexCount() << " indices built once" << std::endl;
+
+		return Validate(*Source, *Mesh, Targets, Reports)
+			& Check("earlier lods left in the streams", Mesh->GetVertexCount() == Fresh->GetVertexCount() && Mesh->GetIndexCount() == Fresh->GetIndexCount());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "MeshLodBench",
+		"builds lods of 16 bit index grids with BuildMeshLods, checks the ranges, the promotion to 32 bit indices and that rebuilding drops the earlier lods"))
+		return 0;
+
+	bool bPass = Run("promoted", kGridSize, 1, EF_R16UI, { { 0.5f }, { 0.25f }, { 0.125f, 1e-3f } }, EF_R32UI);
+	bPass &= Run("kept", kGridSize / 4, 2, EF_R16UI, { { 0.5f }, { 0.25f } }, EF_R16UI);
+	bPass &= Run("32 bit", kGridSize, 2, EF_R32UI, { { 0.5f } }, EF_R32UI);
+	bPass &= Rebuild("rebuilt", kGridSize / 2, 2, { { 0.5f }, { 0.25f }, { 0.125f } }, { { 0.3f } });
+
+	std::cout << (bPass ? "lods valid" : "lods invalid") << std::endl;
+	return bPass ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+#include <Engine/Core/Container/HashedFreeLists.h>
+#include <Engine/Core/Container/PoolRequestTrace.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace white;
+
+namespace
+{
+	// Same release rule as RGBufferPool.
+	constexpr uint32 kFramesUntilRelease = 31;
+
+	struct FPooled : public ref_count_base
+	{
+		uint64 Size;
+		uint32 LastUsedFrame = 0;
+	};
+
+	struct ReplayResult
+	{
+		uint64 NumCreated;
+		uint64 PeakPooledBytes;
+	};
+
+	// The per entry scan RGBufferPool used before the hashed free lists.
+	class LinearPool
+	{
+	public:
+		ref_ptr<FPooled> Find(uint32 Hash, uint32 FrameCounter)
+		{
+			for (std::size_t Index = 0; Index < Hashes.size(); ++Index)
+			{
+				if (Hashes[Index] != Hash || Pooled[Index].count() > 1)
+				{
+					continue;
+				}
+				Pooled[Index]->LastUsedFrame = FrameCounter;
+				return Pooled[Index];
+			}
+			return {};
+		}
+
+		void Add(uint32 Hash, ref_ptr<FPooled> InPooled, uint32 FrameCounter)
+		{
+			InPooled->LastUsedFrame = FrameCounter;
+			Pooled.emplace_back(std::move(InPooled));
+			Hashes.emplace_back(Hash);
+		}
+
+		template<typename FunctionType>
+		void Tick(uint32 FrameCounter, uint32 FramesUntilRelease, FunctionType&& OnRelease)
+		{
+			std::size_t Index = 0;
+			while (Index < Pooled.size())
+			{
+				if (Pooled[Index].count() == 1 && (FrameCounter - Pooled[Index]->LastUsedFrame) > FramesUntilRelease)
+				{
+					OnRelease(Pooled[Index]);
+					std::swap(Pooled[Index], Pooled.back());
+					std::swap(Hashes[Index], Hashes.back());
+					Pooled.pop_back();
+					Hashes.pop_back();
+				}
+				else
+				{
+					++Index;
+				}
+			}
+		}
+
+	private:
+		std::vector<ref_ptr<FPooled>> Pooled;
+		std::vector<uint32> Hashes;
+	};
+
+	template<typename PoolType>
+	ReplayResult Replay(span<const FPoolRequestTraceOp> Ops)
+	{
+		PoolType Pool;
+		std::vector<ref_ptr<FPooled>> Held;
+
+		ReplayResult Result{ 0, 0 };
+		uint64 PooledBytes = 0;
+		auto OnRelease = [&](const ref_ptr<FPooled>& Pooled) { PooledBytes -= Pooled->Size; };
+
+		uint32 FrameCounter = Ops.empty() ? 0 : Ops[0].Frame;
+		for (const auto& Op : Ops)
+		{
+			// Transients of a frame go back to the pool when its graph is destroyed.
+			while (FrameCounter != Op.Frame)
+			{
+				Held.clear();
+				Pool.Tick(FrameCounter, kFramesUntilRelease, OnRelease);
+				++FrameCounter;
+			}
+
+			auto Pooled = Pool.Find(Op.Hash, FrameCounter);
+			if (!Pooled)
+			{
+				Pooled = new FPooled();
+				Pooled->Size = Op.Size;
+				Pool.Add(Op.Hash, Pooled, FrameCounter);
+
+				++Result.NumCreated;
+				PooledBytes += Op.Size;
+				Result.PeakPooledBytes = std::max(Result.PeakPooledBytes, PooledBytes);
+			}
+			Held.emplace_back(std::move(Pooled));
+		}
+		Held.clear();
+		Pool.Tick(FrameCounter, kFramesUntilRelease, OnRelease);
+
+		return Result;
+	}
+
+	// Render graph shaped trace: a skewed set of transient descs per frame, the
+	// set drifts every few hundred frames the way a resolution change does.
+	std::vector<FPoolRequestTraceOp> SynthesizeTrace(uint32 NumFrames, uint32 RequestsPerFrame)
+	{
+		std::vector<FPoolRequestTraceOp> Ops;
+		std::mt19937 Rand(bench::Seed ^ NumFrames ^ RequestsPerFrame);
+
+		const uint32 NumDescs = std::max(RequestsPerFrame / 4, 1u);
+		std::vector<uint64> DescSizes(NumDescs);
+		std::uniform_int_distribution<uint32> PageCount(1, 256);
+		for (auto& Size : DescSizes)
+		{
+			Size = PageCount(Rand) * 64 * 1024ull;
+		}
+
+		std::geometric_distribution<uint32> PickDesc(4.0 / NumDescs);
+		uint32 Generation = 0;
+		for (uint32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			if (Frame != 0 && Frame % 300 == 0)
+			{
+				++Generation;
+			}
+
+			for (uint32 i = 0; i < RequestsPerFrame; ++i)
+			{
+				uint32 Desc = std::min(PickDesc(Rand), NumDescs - 1);
+				uint32 Hash = (Desc * 0x9E3779B9u) ^ (Generation * 0x85EBCA6Bu);
+				Ops.push_back({ Frame, Hash, DescSizes[Desc] });
+			}
+		}
+		return Ops;
+	}
+
+	template<typename PoolType>
+	void Report(const char* Name, span<const FPoolRequestTraceOp> Ops, uint32 Repeat)
+	{
+		ReplayResult Result{ 0, 0 };
+		auto Seconds = bench::Best(Repeat, [&] { Result = Replay<PoolType>(Ops); });
+
+		std::cout << Name << ": " << Seconds * 1000.0 << " ms, "
+			<< Ops.size() / Seconds / 1e6 << " Mrequests/s, "
+			<< Result.NumCreated << " created, "
+			<< Result.PeakPooledBytes / (1024.0 * 1024.0) << " MB peak" << std::endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "PoolTraceBench <trace file> [repeat]\n       PoolTraceBench -synthetic [frames] [requests per frame] [repeat]",
+		"replays a buffer pool trace through the linear and the hashed free lists, trace files are written by RGBufferPool::SetRequestTrace and SavePoolRequestTrace"))
+		return 0;
+
+	bool bSynthetic = argc < 2 || std::string(argv[1]) == "-synthetic";
+	int RepeatArg = bSynthetic ? 4 : 2;
+
+	std::vector<FPoolRequestTraceOp> Ops;
+	if (bSynthetic)
+	{
+		uint32 NumFrames = argc > 2 ? static_cast<uint32>(std::stoul(argv[2])) : 1000;
+		uint32 RequestsPerFrame = argc > 3 ? static_cast<uint32>(std::stoul(argv[3])) : 2000;
+		Ops = SynthesizeTrace(std::max(NumFrames, 1u), std::max(RequestsPerFrame, 1u));
+	}
+	else if (!LoadPoolRequestTrace(argv[1], Ops))
+	{
+		std::cerr << "failed to load pool trace " << argv[1] << std::endl;
+		return 1;
+	}
+
+	uint32 Repeat = argc > RepeatArg ? std::max(static_cast<uint32>(std::stoul(argv[RepeatArg])), 1u) : 3;
+
+	std::cout << Ops.size() << " pool requests, best of " << Repeat << std::endl;
+
+	Report<LinearPool>("linear", Ops, Repeat);
+	Report<THashedFreeLists<FPooled>>("hashed", Ops, Repeat);
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+#include <Engine/Developer/MeshSimplifier/MeshSimplify.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Position, normal and uv
+	constexpr uint32 kNumAttributes = 5;
+	constexpr uint32 kVertSize = 3 + kNumAttributes;
+
+	struct Mesh
+	{
+		std::vector<float> Verts;
+		std::vector<uint32> Indexes;
+		std::vector<int32> MaterialIndexes;
+	};
+
+	// Size x Size quads of a noisy height field, verts shared between quads
+	Mesh MakeGrid(uint32 Size)
+	{
+		std::mt19937 Engine(bench::Seed);
+		std::uniform_real_distribution<float> Noise(-0.05f, 0.05f);
+
+		Mesh Result;
+		for (uint32 Y = 0; Y <= Size; ++Y)
+		{
+			for (uint32 X = 0; X <= Size; ++X)
+			{
+				float U = float(X) / Size, V = float(Y) / Size;
+				float Height = std::sin(U * 12.f) * std::cos(V * 9.f) + Noise(Engine);
+				Result.Verts.insert(Result.Verts.end(), { U * 10.f, Height, V * 10.f, 0.f, 1.f, 0.f, U, V });
+			}
+		}
+		for (uint32 Y = 0; Y != Size; ++Y)
+		{
+			for (uint32 X = 0; X != Size; ++X)
+			{
+				uint32 Corner = Y * (Size + 1) + X;
+				Result.Indexes.insert(Result.Indexes.end(), { Corner, Corner + Size + 1, Corner + 1, Corner + 1, Corner + Size + 1, Corner + Size + 2 });
+			}
+		}
+		Result.MaterialIndexes.resize(Result.Indexes.size() / 3);
+		return Result;
+	}
+
+	struct Output
+	{
+		float MaxErrorSqr;
+		uint32 NumVerts;
+		uint32 NumTris;
+		Mesh Simplified;
+
+		bool operator==(const Output& Other) const
+		{
+			return MaxErrorSqr == Other.MaxErrorSqr && NumVerts == Other.NumVerts && NumTris == Other.NumTris
+				&& Simplified.Verts == Other.Simplified.Verts && Simplified.Indexes == Other.Simplified.Indexes;
+		}
+	};
+
+	Output Simplify(Mesh Input, uint32 TargetNumTris)
+	{
+		static const float AttributeWeights[kNumAttributes] = { 1.f, 1.f, 1.f, 1.f / 1024, 1.f / 1024 };
+
+		FMeshSimplifier Simplifier(Input.Verts.data(), static_cast<uint32>(Input.Verts.size() / kVertSize), Input.Indexes.data(),
+			static_cast<uint32>(Input.Indexes.size()), Input.MaterialIndexes.data(), kNumAttributes);
+		Simplifier.SetAttributeWeights(AttributeWeights);
+		Simplifier.SetEdgeWeight(2.0f);
+
+		Output Result;
+		Result.MaxErrorSqr = Simplifier.Simplify(static_cast<uint32>(Input.Verts.size() / kVertSize), TargetNumTris);
+		Simplifier.Compact();
+		Result.NumVerts = Simplifier.GetRemainingNumVerts();
+		Result.NumTris = Simplifier.GetRemainingNumTris();
+
+		Input.Verts.resize(Result.NumVerts * kVertSize);
+		Input.Indexes.resize(Result.NumTris * 3);
+		Result.Simplified = std::move(Input);
+		return Result;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "SimplifyBench [size] [ratio] [repeat]",
+		"simplifies a size x size grid to ratio of its triangles with FMeshSimplifier and checks every run gives the same mesh"))
+		return 0;
+
+	uint32 Size = argc > 1 ? std::max(static_cast<uint32>(std::stoul(argv[1])), 2u) : 128;
+	float Ratio = argc > 2 ? std::clamp(std::stof(argv[2]), 0.01f, 0.99f) : 0.25f;
+	uint32 Repeat = argc > 3 ? std::max(static_cast<uint32>(std::stoul(argv[3])), 1u) : 5;
+
+	auto Grid = MakeGrid(Size);
+	uint32 NumTris = static_cast<uint32>(Grid.Indexes.size() / 3);
+	uint32 TargetNumTris = static_cast<uint32>(NumTris * Ratio);
+
+	// Setup and the initial costing run in parallel, the collapses are serial
+	Output Reference = Simplify(Grid, TargetNumTris);
+	bool bMatch = Reference.NumTris <= TargetNumTris;
+	auto Seconds = bench::Best(Repeat, [&] {
+		bMatch &= Simplify(Grid, TargetNumTris) == Reference;
+		});
+
+	std::cout << NumTris << " -> " << Reference.NumTris << " triangles, " << Reference.NumVerts << " verts, max error "
+		<< std::sqrt(Reference.MaxErrorSqr) << std::endl;
+	std::cout << "best of " << Repeat << ": " << Seconds * 1e3 << " ms, " << Seconds * 1e9 / (NumTris - Reference.NumTris)
+		<< " ns per removed triangle" << std::endl;
+
+	std::cout << (bMatch ? "results match" : "results differ") << std::endl;
+	return bMatch ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+#include <Engine/Runtime/Renderer/Trinf.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using Trinf::SpanAllocator;
+using Trinf::ResidencyBudget;
+
+namespace
+{
+	bool Check(const char* What, int64 Value, int64 Expected)
+	{
+		if (Value != Expected)
+			std::cerr << What << ": " << Value << ", expected " << Expected << std::endl;
+		return Value == Expected;
+	}
+
+	// Freed neighbours merge into one span, a span reaching the end shrinks MaxSize
+	bool ValidateCoalescing()
+	{
+		SpanAllocator Allocator;
+		int32 A = Allocator.Allocate(4), B = Allocator.Allocate(4), C = Allocator.Allocate(4), D = Allocator.Allocate(4);
+
+		Allocator.Free(C, 4);
+		Allocator.Free(B, 4);
+		auto Stats = Allocator.GetStats();
+		bool bPass = Check("merged free spans", Stats.NumFreeSpans, 1);
+		bPass &= Check("merged free span size", Stats.LargestFreeSpan, 8);
+		bPass &= Check("reuse of the merged span", Allocator.Allocate(8), B);
+
+		Allocator.Free(B, 8);
+		Allocator.Free(D, 4);
+		bPass &= Check("max size after the tail is freed", Allocator.GetMaxSize(), 4);
+		bPass &= Check("free spans after the tail is freed", Allocator.GetStats().NumFreeSpans, 0);
+
+		Allocator.Free(A, 4);
+		bPass &= Check("max size after everything is freed", Allocator.GetMaxSize(), 0);
+		return bPass;
+	}
+
+	// Free spans of 8, 3 and 5 between used ones, requests take the smallest span that fits
+	bool ValidateBestFit()
+	{
+		SpanAllocator Allocator;
+		int32 Eight = Allocator.Allocate(8);
+		Allocator.Allocate(1);
+		int32 Three = Allocator.Allocate(3);
+		Allocator.Allocate(1);
+		int32 Five = Allocator.Allocate(5);
+		Allocator.Allocate(1);
+		Allocator.Free(Eight, 8);
+		Allocator.Free(Three, 3);
+		Allocator.Free(Five, 5);
+
+		bool bPass = Check("growth when a span fits", Allocator.GetGrowth(4), 0);
+		bPass &= Check("growth when no span fits", Allocator.GetGrowth(9), 9);
+		bPass &= Check("exact fit", Allocator.Allocate(3), Three);
+		bPass &= Check("smallest fit", Allocator.Allocate(4), Five);
+		bPass &= Check("remainder of the smallest fit", Allocator.Allocate(1), Five + 4);
+		bPass &= Check("largest span left", Allocator.Allocate(6), Eight);
+		bPass &= Check("max size", Allocator.GetMaxSize(), 19);
+		return bPass;
+	}
+
+	// Least recently requested first, pinned entries and entries requested this frame stay
+	bool ValidateEviction()
+	{
+		ResidencyBudget Budget;
+		Budget.SetBudget(400);
+		for (uint64 Key = 1; Key <= 4; ++Key)
+			Budget.Add(Key, 100, 1);
+		Budget.Unpin(1);
+		Budget.Unpin(2);
+		Budget.Unpin(3);
+		Budget.Touch(1, 2);
+
+		std::vector<uint64> Evicted;
+		bool bPass = Check("make room past the candidates", Budget.MakeRoom(400, 2, Evicted), 0);
+		bPass &= Check("evicted without room", Evicted.size(), 0);
+
+		bPass &= Check("make room", Budget.MakeRoom(200, 2, Evicted), 1);
+		bPass &= Check("evicted", Evicted.size(), 2);
+		bPass &= Check("least recent first", Evicted.size() == 2 && Evicted[0] == 2 && Evicted[1] == 3, 1);
+		bPass &= Check("used bytes", Budget.GetUsed(), 200);
+
+		uint64 Key = 0;
+		bPass &= Check("entry requested this frame kept", Budget.EvictLeastRecent(2, Key), 0);
+		bPass &= Check("least recent eviction", Budget.EvictLeastRecent(3, Key), 1);
+		bPass &= Check("least recent key", Key, 1);
+		bPass &= Check("pinned entry kept", Budget.EvictLeastRecent(3, Key), 0);
+		bPass &= Check("used bytes", Budget.GetUsed(), 100);
+		return bPass;
+	}
+
+	struct StreamStats
+	{
+		uint64 Allocations = 0;
+		uint64 Evictions = 0;
+		uint64 Deferred = 0;
+		uint64 PeakUsed = 0;
+		uint64 PeakCapacity = 0;
+		float Fragmentation = 0;
+	};
+
+	/*
+	The residency loop of StreamingScene on a single buffer: every frame requests a random subset of the resources,
+	the ones not resident make room in the budget, then evict until the buffer holds them without growing past the budget.
+	Sizes are in pages.
+	*/
+	StreamStats RunStream(uint32 NumResources, uint32 NumFrames, uint32 Requests, uint64 BudgetPages, bool bEvictBeforeGrow)
+	{
+		std::mt19937 Engine(bench::Seed);
+		std::uniform_int_distribution<int32> Size(1, 16);
+		// Low keys are requested more often, like the near part of a scene
+		std::geometric_distribution<uint32> Request(4.0 / NumResources);
+
+		std::vector<int32> Sizes(NumResources), Offsets(NumResources, white::INDEX_NONE);
+		for (auto& Pages : Sizes)
+			Pages = Size(Engine);
+
+		SpanAllocator Allocator;
+		ResidencyBudget Budget;
+		Budget.SetBudget(BudgetPages);
+
+		StreamStats Stats;
+		std::vector<uint64> Evicted, Streaming;
+		auto Evict = [&](uint64 Key) {
+			Allocator.Free(Offsets[Key], Sizes[Key]);
+			Offsets[Key] = white::INDEX_NONE;
+			++Stats.Evictions;
+		};
+
+		for (uint64 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			// Last frame's requests finished streaming
+			for (auto Key : Streaming)
+				Budget.Unpin(Key);
+			Streaming.clear();
+
+			for (uint32 Index = 0; Index != Requests; ++Index)
+			{
+				uint64 Key = Request(Engine) % NumResources;
+				if (Offsets[Key] != white::INDEX_NONE)
+				{
+					Budget.Touch(Key, Frame);
+					continue;
+				}
+
+				Evicted.clear();
+				if (!Budget.MakeRoom(Sizes[Key], Frame, Evicted))
+				{
+					++Stats.Deferred;
+					continue;
+				}
+				for (auto EvictedKey : Evicted)
+					Evict(EvictedKey);
+
+				bool bFits = true;
+				while (bEvictBeforeGrow && uint64(Allocator.GetMaxSize() + Allocator.GetGrowth(Sizes[Key])) > BudgetPages)
+				{
+					uint64 EvictedKey;
+					if (!(bFits = Budget.EvictLeastRecent(Frame, EvictedKey)))
+						break;
+					Evict(EvictedKey);
+				}
+				if (!bFits)
+				{
+					++Stats.Deferred;
+					continue;
+				}
+
+				Offsets[Key] = Allocator.Allocate(Sizes[Key]);
+				Budget.Add(Key, Sizes[Key], Frame);
+				Streaming.push_back(Key);
+				++Stats.Allocations;
+
+				Stats.PeakUsed = std::max(Stats.PeakUsed, Budget.GetUsed());
+				Stats.PeakCapacity = std::max<uint64>(Stats.PeakCapacity, Allocator.GetMaxSize());
+			}
+			Stats.Fragmentation = std::max(Stats.Fragmentation, Allocator.GetStats().GetFragmentation());
+		}
+		return Stats;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "TrinfBench [resources] [frames] [budget]",
+		"checks coalescing, best fit and LRU eviction of the Trinf span allocator and residency budget, then drives them with a synthetic request stream"))
+		return 0;
+
+	uint32 NumResources = argc > 1 ? std::max(static_cast<uint32>(std::stoul(argv[1])), 16u) : 4096;
+	uint32 NumFrames = argc > 2 ? std::max(static_cast<uint32>(std::stoul(argv[2])), 1u) : 1000;
+	uint64 BudgetPages = argc > 3 ? std::max<uint64>(std::stoull(argv[3]), 16) : 8192;
+	constexpr uint32 kRequests = 256;
+
+	bool bPass = ValidateCoalescing();
+	bPass &= ValidateBestFit();
+	bPass &= ValidateEviction();
+
+	for (bool bEvictBeforeGrow : { false, true })
+	{
+		StreamStats Stats;
+		auto Seconds = bench::Time([&] { Stats = RunStream(NumResources, NumFrames, kRequests, BudgetPages, bEvictBeforeGrow); });
+
+		std::cout << (bEvictBeforeGrow ? "evict before grow: " : "grow: ") << Stats.Allocations << " allocations, " << Stats.Evictions
+			<< " evictions, " << Stats.Deferred << " deferred, peak " << Stats.PeakUsed << " used / " << Stats.PeakCapacity
+			<< " capacity pages of " << BudgetPages << ", fragmentation " << Stats.Fragmentation << ", "
+			<< Seconds * 1e9 / (uint64(NumFrames) * kRequests) << " ns/request" << std::endl;
+
+		bPass &= Check("used past the budget", Stats.PeakUsed > BudgetPages, 0);
+		if (bEvictBeforeGrow)
+			bPass &= Check("capacity past the budget", Stats.PeakCapacity > BudgetPages, 0);
+	}
+
+	std::cout << (bPass ? "budget holds" : "budget broken") << std::endl;
+	return bPass ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+#include <Engine/CoreTypes.h>
+#include <Engine/Core/Math/VectorKernels.h>
+#include <Engine/Core/Hash/Murmur.h>
+#include <Tools/BenchCommon.h>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Position first like FStaticMeshBuildVertex, the kernels read it through a stride
+	struct Vertex
+	{
+		wm::float3 Position;
+		wm::float3 Normal;
+		wm::float2 TexCoord;
+	};
+
+	template<typename Scalar, typename Batch>
+	bool Run(const char* Name, uint32 Count, unsigned Repeat, std::vector<uint32>& Expected, std::vector<uint32>& Result, Scalar&& RunScalar, Batch&& RunBatch)
+	{
+		auto ScalarSeconds = bench::Best(Repeat, RunScalar);
+		auto BatchSeconds = bench::Best(Repeat, RunBatch);
+
+		bool bMatch = Expected == Result;
+		std::cout << Name << ": scalar " << ScalarSeconds * 1e9 / Count << " ns, batch " << BatchSeconds * 1e9 / Count
+			<< " ns per element, " << ScalarSeconds / BatchSeconds << "x" << (bMatch ? "" : ", results differ") << std::endl;
+		return bMatch;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (bench::Usage(argc, argv, "VectorKernelsBench [count] [repeat]",
+		"times the batch position hash, pair hash and Morton kernels against their scalar helpers and checks they are bit exact"))
+		return 0;
+
+	uint32 Count = argc > 1 ? std::max(static_cast<uint32>(std::stoul(argv[1])), 1u) : 1 << 20;
+	unsigned Repeat = argc > 2 ? std::max(static_cast<unsigned>(std::stoul(argv[2])), 1u) : 10;
+
+	std::mt19937 Engine(bench::Seed);
+	std::uniform_real_distribution<float> Coordinate(-100.f, 100.f);
+	std::uniform_int_distribution<uint32> Index(0, Count - 1);
+
+	// A few signed zeros, they must hash like +0
+	std::vector<Vertex> Verts(Count);
+	for (auto& Vert : Verts)
+	{
+		Vert.Position = wm::float3(Coordinate(Engine), Coordinate(Engine), Coordinate(Engine));
+		if (Engine() % 16 == 0)
+			Vert.Position.y = Engine() % 2 ? 0.f : -0.f;
+	}
+	std::vector<uint32> Indexes(Count);
+	for (auto& Value : Indexes)
+		Value = Index(Engine);
+
+	std::vector<uint32> Expected(Count), Result(Count);
+	std::cout << Count << " elements, best of " << Repeat << ", " << wm::GetKernelInstructionSet() << " kernels" << std::endl;
+
+	bool bMatch = Run("HashPositions", Count, Repeat, Expected, Result,
+		[&] {
+			for (uint32 i = 0; i != Count; ++i)
+				Expected[i] = HashPosition(Verts[Indexes[i]].Position);
+		},
+		[&] { wm::HashPositions(&Verts[0].Position, sizeof(Vertex), Indexes.data(), Count, Result.data()); });
+
+	// Edge hashes of the corner hashes, like ClusterTriangles
+	std::vector<uint32> A = Expected, B(Count);
+	std::rotate_copy(A.begin(), A.begin() + 1, A.end(), B.begin());
+	bMatch &= Run("HashPairs", Count, Repeat, Expected, Result,
+		[&] {
+			for (uint32 i = 0; i != Count; ++i)
+				Expected[i] = Murmur32({ A[i], B[i] });
+		},
+		[&] { wm::HashPairs(A.data(), B.data(), Count, Result.data()); });
+
+	std::vector<wm::float3> Centers(Count);
+	for (uint32 i = 0; i != Count; ++i)
+		Centers[i] = Verts[i].Position;
+	const wm::float3 Min(-100.f, -100.f, -100.f), Extent(200.f, 200.f, 200.f);
+	bMatch &= Run("MortonEncode3", Count, Repeat, Expected, Result,
+		[&] {
+			for (uint32 i = 0; i != Count; ++i)
+			{
+				auto Local = (Centers[i] - Min) / Extent;
+				Expected[i] = wm::MortonCode3(static_cast<uint32>(Local.x * 1023))
+					| wm::MortonCode3(static_cast<uint32>(Local.y * 1023)) << 1
+					| wm::MortonCode3(static_cast<uint32>(Local.z * 1023)) << 2;
+			}
+		},
+		[&] { wm::MortonEncode3(Centers.data(), Count, Min, Extent, Result.data()); });
+
+	std::cout << (bMatch ? "results match" : "results differ") << std::endl;
+	return bMatch ? 0 : 1;
+}
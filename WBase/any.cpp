@@ -4,6 +4,7 @@
 */
 #include  "any.h"
 #include "cassert.h"
+#include <atomic>
 
 namespace white
 {
@@ -12,6 +13,27 @@ namespace white
 
 		holder::~holder() = default;
 
+
+		namespace
+		{
+
+			std::atomic<allocation_hook> p_allocation_hook{};
+
+		} // unnamed namespace;
+
+		allocation_hook
+			set_allocation_hook(allocation_hook hook) wnothrow
+		{
+			return p_allocation_hook.exchange(hook);
+		}
+
+		void
+			notify_allocation(const type_info& ti, size_t n) wnothrow
+		{
+			if (const auto hook = p_allocation_hook.load(std::memory_order_acquire))
+				hook(ti, n);
+		}
+
 	} // namespace any_ops;
 
 
@@ -89,8 +111,17 @@ namespace white
 		void
 			any_base::swap(any_base& a) wnothrow
 		{
-			std::swap(storage, a.storage),
-				std::swap(manager, a.manager);
+			// NOTE: Objects stored locally are not assumed to be trivially
+			//	relocatable, so the storage is not swapped bytewise.
+			any_ops::any_storage t;
+
+			if (manager)
+				manager(t, storage, any_ops::relocate);
+			if (a.manager)
+				a.manager(storage, a.storage, any_ops::relocate);
+			if (manager)
+				manager(a.storage, t, any_ops::relocate);
+			std::swap(manager, a.manager);
 		}
 
 	} // namespace details;
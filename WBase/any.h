@@ -22,6 +22,17 @@
 #include "placement.hpp"
 #include <initializer_list>
 #include <memory> //std::unique_ptr
+#include <string> //std::string
+
+/*!
+\def WB_AnyStorageSize
+\brief any ڲ洢ֽ
+\note δʱΪ ValueObject ʹõ std::string ߵĴСʱܸС
+\note ʹ any ģӦһ¶塣
+
+ nothrow תƹҴСͶҪ󲻳ڲ洢ֱֵӱ any ڣ
+ڶϷ䡣
+*/
 
 namespace white
 {
@@ -201,17 +212,65 @@ namespace white
 			destroy,
 			get_holder_type,
 			get_holder_ptr,
+			/*!
+			\brief תԴ洢еĶδʼĿ洢Դ
+			\note ׳쳣
+			*/
+			relocate,
 			//! \since build 1,3
 			end_base_op
 		};
 
 
-		//! \since build 1.3
-		using any_storage
-			= standard_layout_storage<aligned_storage_t<sizeof(void*), walignof(void*)>>;
+		/*!
+		\brief  std::string ĳֵָ߲֣
+		\note ͬ value_holder<std::string>  ValueObject ʹõĳߣֻȡС
+		*/
+		struct string_holder_layout : holder
+		{
+			std::string value;
+		};
+
+		//! \sa WB_AnyStorageSize
+#ifdef WB_AnyStorageSize
+		wconstexpr size_t any_storage_size = WB_AnyStorageSize;
+#else
+		wconstexpr size_t any_storage_size = sizeof(string_holder_layout);
+#endif
+
+		/*!
+		\warning ֱӱڶڵֵ any תƻ򽻻ַı䡣
+		\sa WB_AnyStorageSize
+		\since build 1.3
+		*/
+		using any_storage = standard_layout_storage<aligned_storage_t<
+			(any_storage_size < sizeof(void*) ? sizeof(void*)
+			: any_storage_size), walignof(void*)>>;
+
+		static_assert(is_aligned_storable<any_storage, string_holder_layout>(),
+			"WB_AnyStorageSize is too small to hold strings in place.");
 		//! \since build 1.3
 		using any_manager = void(*)(any_storage&, any_storage&, op_code);
 
+		/*!
+		\brief ѷ֪ͨصΪĶͺʹС
+		\note ͳƲֱӱ any ڵֵĶѷ䡣
+		*/
+		using allocation_hook = void(*)(const type_info&, size_t) wnothrow;
+
+		/*!
+		\brief öѷ֪ͨص
+		\return ֮ǰõĻص
+		\note ̰߳ȫΪָʱ֪ͨ
+		*/
+		WB_API allocation_hook
+			set_allocation_hook(allocation_hook) wnothrow;
+
+		//! \brief ֪ͨѷ䣺ûصá
+		WB_API void
+			notify_allocation(const type_info&, size_t) wnothrow;
+
+
 		/*!
 		\brief ʹָʼ洢
 		\since build 1.4
@@ -369,6 +428,7 @@ namespace white
 				init_impl(false_, any_storage& d, _tParams&&... args)
 			{
 				d.construct<value_type*>(new value_type(wforward(args)...));
+				notify_allocation(white::type_id<value_type>(), sizeof(value_type));
 			}
 			template<typename... _tParams>
 			static WB_ATTR(always_inline) void
@@ -402,9 +462,25 @@ namespace white
 					break;
 				case get_holder_ptr:
 					d = static_cast<holder*>(nullptr);
+					break;
+				case relocate:
+					relocate_impl(local_storage(), d, s);
 				}
 			}
 
+		private:
+			static void
+				relocate_impl(false_, any_storage& d, any_storage& s) wnothrow
+			{
+				d = s;
+			}
+			static void
+				relocate_impl(true_, any_storage& d, any_storage& s) wnothrow
+			{
+				d.construct<value_type>(std::move(get_reference_impl(true_(), s)));
+				s.destroy<value_type>();
+			}
+
 		private:
 			//! \since build 1.4
 			//@{
@@ -515,6 +591,7 @@ namespace white
 				init(false_, any_storage& d, std::unique_ptr<_tHolder> p)
 			{
 				d.construct<value_type*>(p.release());
+				notify_allocation(type_id<_tHolder>(), sizeof(_tHolder));
 			}
 			//! \since build 1.4
 			static void
@@ -794,6 +871,8 @@ namespace white
 	\brief ͲĶ̬Ͷ
 	\note  ֵ,ڽӿںͬ std::experimental::any 
 	\warning 
+	\warning ֱӱڶڵֵתơתƸֵַı䣬
+		֮ǰȡõֵָúָʧЧڶϷֵӰ졣
 	\see WG21 N4582 20.6.3[any.class] 
 	\see http://www.boost.org/doc/libs/1_53_0/doc/html/any/reference.html#any.ValueType
 	*/
@@ -53,6 +53,8 @@ namespace white
 
 		using list_type::end;
 
+		using list_type::erase;
+
 		using list_type::front;
 
 		iterator
@@ -289,6 +291,16 @@ namespace white
 		}
 		//@}
 
+		//! \brief Ƴָĵ
+		iterator
+			erase(iterator i)
+		{
+			if (flush)
+				flush(*i);
+			used_cache.erase(i->first);
+			return used_list.erase(i);
+		}
+
 		iterator
 			find(const key_type& k)
 		{
@@ -5,6 +5,7 @@
 
 #include "wmathtype.hpp"
 #include "wmathquaternion.hpp"
+#include "wmathsimd.hpp"
 
 #ifndef WBase_wmath_hpp
 #define WBase_wmath_hpp 1
@@ -532,15 +533,6 @@ namespace white::math {
 		return !(l == r);
 	}
 
-	inline float4x4 transpose(const float4x4& m) {
-		return{
-			{ m[0][0],m[1][0] ,m[2][0] ,m[3][0] },
-		{ m[0][1],m[1][1] ,m[2][1] ,m[3][1] },
-		{ m[0][2],m[1][2] ,m[2][2] ,m[3][2] },
-		{ m[0][3],m[1][3] ,m[2][3] ,m[3][3] }
-		};
-	}
-
 	inline float4x4 operator*(float l, const float4x4& m) {
 		return{
 			m[0] * l,
@@ -559,32 +551,6 @@ namespace white::math {
 		};
 	}
 
-	inline float4x4 mul(const float4x4& lhs, const float4x4& rhs) noexcept {
-		auto tmp(transpose(rhs));
-
-		return {
-			{dot(lhs[0],tmp[0]),dot(lhs[0],tmp[1]),dot(lhs[0],tmp[2]),dot(lhs[0],tmp[3])},
-			{ dot(lhs[1],tmp[0]),dot(lhs[1],tmp[1]),dot(lhs[1],tmp[2]),dot(lhs[1],tmp[3]) },
-			{ dot(lhs[2],tmp[0]),dot(lhs[2],tmp[1]),dot(lhs[2],tmp[2]),dot(lhs[2],tmp[3]) },
-			{ dot(lhs[3],tmp[0]),dot(lhs[3],tmp[1]),dot(lhs[3],tmp[2]),dot(lhs[3],tmp[3]) },
-		};
-	}
-
-	inline float4x4 operator*(const float4x4& lhs, const float4x4& rhs) noexcept {
-		return mul(lhs, rhs);
-	}
-
-	inline float4 transform(const float4& l, const float4x4& m) noexcept {
-		auto tm = transpose(m);
-		return{ dot(l,tm[0]),dot(l,tm[1]) ,dot(l,tm[2]) ,dot(l,tm[3]) };
-	}
-
-	inline float3 transformpoint(const float3&l, const float4x4&m) noexcept {
-		auto v = float4(l, 1);
-		auto tm = transpose(m);
-		return { dot(v,tm[0]),dot(v,tm[1]) ,dot(v,tm[2]) };
-	}
-
 	inline float determinant(const float4x4& rhs) noexcept {
 		float const _3142_3241(rhs(2, 0) * rhs(3, 1) - rhs(2, 1) * rhs(3, 0));
 		float const _3143_3341(rhs(2, 0) * rhs(3, 2) - rhs(2, 2) * rhs(3, 0));
@@ -599,66 +565,153 @@ namespace white::math {
 			- rhs(0, 3) * (rhs(1, 0) * _3243_3342 - rhs(1, 1) * _3143_3341 + rhs(1, 2) * _3142_3241);
 	}
 
-	inline float4x4 inverse(const float4x4& rhs) noexcept {
-		float const _2132_2231(rhs(1, 0) * rhs(2, 1) - rhs(1, 1) * rhs(2, 0));
-		float const _2133_2331(rhs(1, 0) * rhs(2, 2) - rhs(1, 2) * rhs(2, 0));
-		float const _2134_2431(rhs(1, 0) * rhs(2, 3) - rhs(1, 3) * rhs(2, 0));
-		float const _2142_2241(rhs(1, 0) * rhs(3, 1) - rhs(1, 1) * rhs(3, 0));
-		float const _2143_2341(rhs(1, 0) * rhs(3, 2) - rhs(1, 2) * rhs(3, 0));
-		float const _2144_2441(rhs(1, 0) * rhs(3, 3) - rhs(1, 3) * rhs(3, 0));
-		float const _2233_2332(rhs(1, 1) * rhs(2, 2) - rhs(1, 2) * rhs(2, 1));
-		float const _2234_2432(rhs(1, 1) * rhs(2, 3) - rhs(1, 3) * rhs(2, 1));
-		float const _2243_2342(rhs(1, 1) * rhs(3, 2) - rhs(1, 2) * rhs(3, 1));
-		float const _2244_2442(rhs(1, 1) * rhs(3, 3) - rhs(1, 3) * rhs(3, 1));
-		float const _2334_2433(rhs(1, 2) * rhs(2, 3) - rhs(1, 3) * rhs(2, 2));
-		float const _2344_2443(rhs(1, 2) * rhs(3, 3) - rhs(1, 3) * rhs(3, 2));
-		float const _3142_3241(rhs(2, 0) * rhs(3, 1) - rhs(2, 1) * rhs(3, 0));
-		float const _3143_3341(rhs(2, 0) * rhs(3, 2) - rhs(2, 2) * rhs(3, 0));
-		float const _3144_3441(rhs(2, 0) * rhs(3, 3) - rhs(2, 3) * rhs(3, 0));
-		float const _3243_3342(rhs(2, 1) * rhs(3, 2) - rhs(2, 2) * rhs(3, 1));
-		float const _3244_3442(rhs(2, 1) * rhs(3, 3) - rhs(2, 3) * rhs(3, 1));
-		float const _3344_3443(rhs(2, 2) * rhs(3, 3) - rhs(2, 3) * rhs(3, 2));
-
-		float const det(determinant(rhs));
-		if (zero_float(det))
-		{
-			return rhs;
+	//reference implementation, the SIMD path is checked against it
+	namespace scalar {
+		inline float4x4 transpose(const float4x4& m) {
+			return{
+				{ m[0][0],m[1][0] ,m[2][0] ,m[3][0] },
+			{ m[0][1],m[1][1] ,m[2][1] ,m[3][1] },
+			{ m[0][2],m[1][2] ,m[2][2] ,m[3][2] },
+			{ m[0][3],m[1][3] ,m[2][3] ,m[3][3] }
+			};
 		}
-		else
-		{
-			float invDet(1 / det);
+
+		inline float4x4 mul(const float4x4& lhs, const float4x4& rhs) noexcept {
+			auto tmp(transpose(rhs));
 
 			return {
-				{
-					+invDet * (rhs(1, 1) * _3344_3443 - rhs(1, 2) * _3244_3442 + rhs(1, 3) * _3243_3342),
-					-invDet * (rhs(0, 1) * _3344_3443 - rhs(0, 2) * _3244_3442 + rhs(0, 3) * _3243_3342),
-					+invDet * (rhs(0, 1) * _2344_2443 - rhs(0, 2) * _2244_2442 + rhs(0, 3) * _2243_2342),
-					-invDet * (rhs(0, 1) * _2334_2433 - rhs(0, 2) * _2234_2432 + rhs(0, 3) * _2233_2332)
-				},
+				{dot(lhs[0],tmp[0]),dot(lhs[0],tmp[1]),dot(lhs[0],tmp[2]),dot(lhs[0],tmp[3])},
+				{ dot(lhs[1],tmp[0]),dot(lhs[1],tmp[1]),dot(lhs[1],tmp[2]),dot(lhs[1],tmp[3]) },
+				{ dot(lhs[2],tmp[0]),dot(lhs[2],tmp[1]),dot(lhs[2],tmp[2]),dot(lhs[2],tmp[3]) },
+				{ dot(lhs[3],tmp[0]),dot(lhs[3],tmp[1]),dot(lhs[3],tmp[2]),dot(lhs[3],tmp[3]) },
+			};
+		}
 
-				{
-					-invDet * (rhs(1, 0) * _3344_3443 - rhs(1, 2) * _3144_3441 + rhs(1, 3) * _3143_3341),
-					+invDet * (rhs(0, 0) * _3344_3443 - rhs(0, 2) * _3144_3441 + rhs(0, 3) * _3143_3341),
-					-invDet * (rhs(0, 0) * _2344_2443 - rhs(0, 2) * _2144_2441 + rhs(0, 3) * _2143_2341),
-					+invDet * (rhs(0, 0) * _2334_2433 - rhs(0, 2) * _2134_2431 + rhs(0, 3) * _2133_2331) },
+		inline float4 transform(const float4& l, const float4x4& m) noexcept {
+			auto tm = transpose(m);
+			return{ dot(l,tm[0]),dot(l,tm[1]) ,dot(l,tm[2]) ,dot(l,tm[3]) };
+		}
 
-				{
-					+invDet * (rhs(1, 0) * _3244_3442 - rhs(1, 1) * _3144_3441 + rhs(1, 3) * _3142_3241),
-					-invDet * (rhs(0, 0) * _3244_3442 - rhs(0, 1) * _3144_3441 + rhs(0, 3) * _3142_3241),
-					+invDet * (rhs(0, 0) * _2244_2442 - rhs(0, 1) * _2144_2441 + rhs(0, 3) * _2142_2241),
-					-invDet * (rhs(0, 0) * _2234_2432 - rhs(0, 1) * _2134_2431 + rhs(0, 3) * _2132_2231)
-				},
+		inline float3 transformpoint(const float3&l, const float4x4&m) noexcept {
+			auto v = float4(l, 1);
+			auto tm = transpose(m);
+			return { dot(v,tm[0]),dot(v,tm[1]) ,dot(v,tm[2]) };
+		}
 
-				{
-					-invDet * (rhs(1, 0) * _3243_3342 - rhs(1, 1) * _3143_3341 + rhs(1, 2) * _3142_3241),
-					+invDet * (rhs(0, 0) * _3243_3342 - rhs(0, 1) * _3143_3341 + rhs(0, 2) * _3142_3241),
-					-invDet * (rhs(0, 0) * _2243_2342 - rhs(0, 1) * _2143_2341 + rhs(0, 2) * _2142_2241),
-					+invDet * (rhs(0, 0) * _2233_2332 - rhs(0, 1) * _2133_2331 + rhs(0, 2) * _2132_2231)
-				}
-			};
+		inline void transform(const float4* first, float4* dst, std::size_t n, const float4x4& m) noexcept {
+			for (std::size_t i = 0; i != n; ++i)
+				dst[i] = transform(first[i], m);
+		}
+
+		inline void transformpoint(const float3* first, float3* dst, std::size_t n, const float4x4& m) noexcept {
+			for (std::size_t i = 0; i != n; ++i)
+				dst[i] = transformpoint(first[i], m);
+		}
+
+		inline float4x4 inverse(const float4x4& rhs) noexcept {
+			float const _2132_2231(rhs(1, 0) * rhs(2, 1) - rhs(1, 1) * rhs(2, 0));
+			float const _2133_2331(rhs(1, 0) * rhs(2, 2) - rhs(1, 2) * rhs(2, 0));
+			float const _2134_2431(rhs(1, 0) * rhs(2, 3) - rhs(1, 3) * rhs(2, 0));
+			float const _2142_2241(rhs(1, 0) * rhs(3, 1) - rhs(1, 1) * rhs(3, 0));
+			float const _2143_2341(rhs(1, 0) * rhs(3, 2) - rhs(1, 2) * rhs(3, 0));
+			float const _2144_2441(rhs(1, 0) * rhs(3, 3) - rhs(1, 3) * rhs(3, 0));
+			float const _2233_2332(rhs(1, 1) * rhs(2, 2) - rhs(1, 2) * rhs(2, 1));
+			float const _2234_2432(rhs(1, 1) * rhs(2, 3) - rhs(1, 3) * rhs(2, 1));
+			float const _2243_2342(rhs(1, 1) * rhs(3, 2) - rhs(1, 2) * rhs(3, 1));
+			float const _2244_2442(rhs(1, 1) * rhs(3, 3) - rhs(1, 3) * rhs(3, 1));
+			float const _2334_2433(rhs(1, 2) * rhs(2, 3) - rhs(1, 3) * rhs(2, 2));
+			float const _2344_2443(rhs(1, 2) * rhs(3, 3) - rhs(1, 3) * rhs(3, 2));
+			float const _3142_3241(rhs(2, 0) * rhs(3, 1) - rhs(2, 1) * rhs(3, 0));
+			float const _3143_3341(rhs(2, 0) * rhs(3, 2) - rhs(2, 2) * rhs(3, 0));
+			float const _3144_3441(rhs(2, 0) * rhs(3, 3) - rhs(2, 3) * rhs(3, 0));
+			float const _3243_3342(rhs(2, 1) * rhs(3, 2) - rhs(2, 2) * rhs(3, 1));
+			float const _3244_3442(rhs(2, 1) * rhs(3, 3) - rhs(2, 3) * rhs(3, 1));
+			float const _3344_3443(rhs(2, 2) * rhs(3, 3) - rhs(2, 3) * rhs(3, 2));
+
+			float const det(determinant(rhs));
+			if (zero_float(det))
+			{
+				return rhs;
+			}
+			else
+			{
+				float invDet(1 / det);
+
+				return {
+					{
+						+invDet * (rhs(1, 1) * _3344_3443 - rhs(1, 2) * _3244_3442 + rhs(1, 3) * _3243_3342),
+						-invDet * (rhs(0, 1) * _3344_3443 - rhs(0, 2) * _3244_3442 + rhs(0, 3) * _3243_3342),
+						+invDet * (rhs(0, 1) * _2344_2443 - rhs(0, 2) * _2244_2442 + rhs(0, 3) * _2243_2342),
+						-invDet * (rhs(0, 1) * _2334_2433 - rhs(0, 2) * _2234_2432 + rhs(0, 3) * _2233_2332)
+					},
+
+					{
+						-invDet * (rhs(1, 0) * _3344_3443 - rhs(1, 2) * _3144_3441 + rhs(1, 3) * _3143_3341),
+						+invDet * (rhs(0, 0) * _3344_3443 - rhs(0, 2) * _3144_3441 + rhs(0, 3) * _3143_3341),
+						-invDet * (rhs(0, 0) * _2344_2443 - rhs(0, 2) * _2144_2441 + rhs(0, 3) * _2143_2341),
+						+invDet * (rhs(0, 0) * _2334_2433 - rhs(0, 2) * _2134_2431 + rhs(0, 3) * _2133_2331) },
+
+					{
+						+invDet * (rhs(1, 0) * _3244_3442 - rhs(1, 1) * _3144_3441 + rhs(1, 3) * _3142_3241),
+						-invDet * (rhs(0, 0) * _3244_3442 - rhs(0, 1) * _3144_3441 + rhs(0, 3) * _3142_3241),
+						+invDet * (rhs(0, 0) * _2244_2442 - rhs(0, 1) * _2144_2441 + rhs(0, 3) * _2142_2241),
+						-invDet * (rhs(0, 0) * _2234_2432 - rhs(0, 1) * _2134_2431 + rhs(0, 3) * _2132_2231)
+					},
+
+					{
+						-invDet * (rhs(1, 0) * _3243_3342 - rhs(1, 1) * _3143_3341 + rhs(1, 2) * _3142_3241),
+						+invDet * (rhs(0, 0) * _3243_3342 - rhs(0, 1) * _3143_3341 + rhs(0, 2) * _3142_3241),
+						-invDet * (rhs(0, 0) * _2243_2342 - rhs(0, 1) * _2143_2341 + rhs(0, 2) * _2142_2241),
+						+invDet * (rhs(0, 0) * _2233_2332 - rhs(0, 1) * _2133_2331 + rhs(0, 2) * _2132_2231)
+					}
+				};
+			}
 		}
 	}
 
+#if WB_MATH_SIMD != WB_MATH_SIMD_NONE
+	inline float4x4 transpose(const float4x4& m) noexcept {
+		return simd::transpose(m);
+	}
+
+	inline float4x4 mul(const float4x4& lhs, const float4x4& rhs) noexcept {
+		return simd::mul(lhs, rhs);
+	}
+
+	inline float4 transform(const float4& l, const float4x4& m) noexcept {
+		return simd::transform(l, m);
+	}
+
+	inline float3 transformpoint(const float3& l, const float4x4& m) noexcept {
+		return simd::transformpoint(l, m);
+	}
+
+	//batch form, dst may alias first
+	inline void transform(const float4* first, float4* dst, std::size_t n, const float4x4& m) noexcept {
+		simd::transform(first, dst, n, m);
+	}
+
+	inline void transformpoint(const float3* first, float3* dst, std::size_t n, const float4x4& m) noexcept {
+		simd::transformpoint(first, dst, n, m);
+	}
+
+	inline float4x4 inverse(const float4x4& rhs) noexcept {
+		float det;
+		auto result = simd::inverse(rhs, det);
+		return zero_float(det) ? rhs : result;
+	}
+#else
+	using scalar::transpose;
+	using scalar::mul;
+	using scalar::transform;
+	using scalar::transformpoint;
+	using scalar::inverse;
+#endif
+
+	inline float4x4 operator*(const float4x4& lhs, const float4x4& rhs) noexcept {
+		return mul(lhs, rhs);
+	}
+
 	inline float4x4 to_matrix(quaternion quat) {
 		float const x2(quat.x + quat.x);
 		float const y2(quat.y + quat.y);
@@ -0,0 +1,256 @@
+/*!	\file wmathsimd.hpp
+\ingroup WBase
+\brief float4x4 operations on 4-wide registers, the backend is selected at compile time.
+\note Define WB_MATH_SIMD to WB_MATH_SIMD_NONE to force the scalar path.
+*/
+
+#ifndef WBase_wmathsimd_hpp
+#define WBase_wmathsimd_hpp 1
+
+#include "wmathtype.hpp"
+#include <cstddef>
+
+#define WB_MATH_SIMD_NONE 0
+#define WB_MATH_SIMD_SSE 1
+#define WB_MATH_SIMD_NEON 2
+
+#ifndef WB_MATH_SIMD
+#	if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#		define WB_MATH_SIMD WB_MATH_SIMD_SSE
+#	elif defined(__aarch64__) || defined(_M_ARM64)
+#		define WB_MATH_SIMD WB_MATH_SIMD_NEON
+#	else
+#		define WB_MATH_SIMD WB_MATH_SIMD_NONE
+#	endif
+#endif
+
+#if WB_MATH_SIMD == WB_MATH_SIMD_SSE
+#include <emmintrin.h>
+#elif WB_MATH_SIMD == WB_MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#if WB_MATH_SIMD != WB_MATH_SIMD_NONE
+namespace white::math::simd {
+	//register layer, the only part that differs between backends
+#if WB_MATH_SIMD == WB_MATH_SIMD_SSE
+	using vfloat4 = __m128;
+
+	inline vfloat4 load(const float* p) noexcept { return _mm_loadu_ps(p); }
+	inline void store(float* p, vfloat4 v) noexcept { _mm_storeu_ps(p, v); }
+	inline vfloat4 splat(float s) noexcept { return _mm_set1_ps(s); }
+	inline vfloat4 set(float x, float y, float z, float w) noexcept { return _mm_setr_ps(x, y, z, w); }
+
+	inline vfloat4 add(vfloat4 l, vfloat4 r) noexcept { return _mm_add_ps(l, r); }
+	inline vfloat4 sub(vfloat4 l, vfloat4 r) noexcept { return _mm_sub_ps(l, r); }
+	inline vfloat4 mul(vfloat4 l, vfloat4 r) noexcept { return _mm_mul_ps(l, r); }
+	inline vfloat4 div(vfloat4 l, vfloat4 r) noexcept { return _mm_div_ps(l, r); }
+
+	inline float first(vfloat4 v) noexcept { return _mm_cvtss_f32(v); }
+
+	//(l[x], l[y], r[z], r[w])
+	template<int x, int y, int z, int w>
+	inline vfloat4 shuffle(vfloat4 l, vfloat4 r) noexcept {
+		return _mm_shuffle_ps(l, r, _MM_SHUFFLE(w, z, y, x));
+	}
+#else
+	using vfloat4 = float32x4_t;
+
+	inline vfloat4 load(const float* p) noexcept { return vld1q_f32(p); }
+	inline void store(float* p, vfloat4 v) noexcept { vst1q_f32(p, v); }
+	inline vfloat4 splat(float s) noexcept { return vdupq_n_f32(s); }
+	inline vfloat4 set(float x, float y, float z, float w) noexcept {
+		const float v[4] = { x, y, z, w };
+		return vld1q_f32(v);
+	}
+
+	inline vfloat4 add(vfloat4 l, vfloat4 r) noexcept { return vaddq_f32(l, r); }
+	inline vfloat4 sub(vfloat4 l, vfloat4 r) noexcept { return vsubq_f32(l, r); }
+	inline vfloat4 mul(vfloat4 l, vfloat4 r) noexcept { return vmulq_f32(l, r); }
+	inline vfloat4 div(vfloat4 l, vfloat4 r) noexcept { return vdivq_f32(l, r); }
+
+	inline float first(vfloat4 v) noexcept { return vgetq_lane_f32(v, 0); }
+
+	//lane moves, the compiler folds the constant pattern into permutes
+	template<int x, int y, int z, int w>
+	inline vfloat4 shuffle(vfloat4 l, vfloat4 r) noexcept {
+		vfloat4 v = vdupq_n_f32(vgetq_lane_f32(l, x));
+		v = vsetq_lane_f32(vgetq_lane_f32(l, y), v, 1);
+		v = vsetq_lane_f32(vgetq_lane_f32(r, z), v, 2);
+		return vsetq_lane_f32(vgetq_lane_f32(r, w), v, 3);
+	}
+#endif
+
+	template<int x, int y, int z, int w>
+	inline vfloat4 swizzle(vfloat4 v) noexcept {
+		return shuffle<x, y, z, w>(v, v);
+	}
+
+	template<int i>
+	inline vfloat4 splat(vfloat4 v) noexcept {
+		return swizzle<i, i, i, i>(v);
+	}
+
+	inline vfloat4 load(const float4& v) noexcept { return load(v.data); }
+	inline void store(float4& v, vfloat4 r) noexcept { store(v.data, r); }
+
+	struct matrix {
+		vfloat4 r[4];
+
+		explicit matrix(const float4x4& m) noexcept
+			:r{ load(m[0]),load(m[1]),load(m[2]),load(m[3]) }
+		{
+		}
+
+		matrix(vfloat4 r0, vfloat4 r1, vfloat4 r2, vfloat4 r3) noexcept
+			:r{ r0,r1,r2,r3 }
+		{
+		}
+
+		operator float4x4() const noexcept {
+			float4x4 m;
+			for (int i = 0; i != 4; ++i)
+				store(m[static_cast<uint8>(i)], r[i]);
+			return m;
+		}
+	};
+
+	//row vector times matrix, same order of operations as dot in the scalar path
+	inline vfloat4 transform(vfloat4 v, const matrix& m) noexcept {
+		auto r = mul(splat<0>(v), m.r[0]);
+		r = add(r, mul(splat<1>(v), m.r[1]));
+		r = add(r, mul(splat<2>(v), m.r[2]));
+		return add(r, mul(splat<3>(v), m.r[3]));
+	}
+
+	inline vfloat4 transformpoint(float x, float y, float z, const matrix& m) noexcept {
+		auto r = mul(splat(x), m.r[0]);
+		r = add(r, mul(splat(y), m.r[1]));
+		r = add(r, mul(splat(z), m.r[2]));
+		return add(r, m.r[3]);
+	}
+
+	inline float4x4 transpose(const float4x4& in) noexcept {
+		matrix m(in);
+		auto t0 = shuffle<0, 1, 0, 1>(m.r[0], m.r[1]);
+		auto t1 = shuffle<2, 3, 2, 3>(m.r[0], m.r[1]);
+		auto t2 = shuffle<0, 1, 0, 1>(m.r[2], m.r[3]);
+		auto t3 = shuffle<2, 3, 2, 3>(m.r[2], m.r[3]);
+
+		return matrix(
+			shuffle<0, 2, 0, 2>(t0, t2),
+			shuffle<1, 3, 1, 3>(t0, t2),
+			shuffle<0, 2, 0, 2>(t1, t3),
+			shuffle<1, 3, 1, 3>(t1, t3));
+	}
+
+	inline float4x4 mul(const float4x4& lhs, const float4x4& rhs) noexcept {
+		matrix l(lhs), r(rhs);
+		return matrix(
+			transform(l.r[0], r),
+			transform(l.r[1], r),
+			transform(l.r[2], r),
+			transform(l.r[3], r));
+	}
+
+	inline float4 transform(const float4& v, const float4x4& m) noexcept {
+		float4 r;
+		store(r, transform(load(v), matrix(m)));
+		return r;
+	}
+
+	inline float3 transformpoint(const float3& v, const float4x4& m) noexcept {
+		float4 r;
+		store(r, transformpoint(v.x, v.y, v.z, matrix(m)));
+		return { r.x,r.y,r.z };
+	}
+
+	inline void transform(const float4* first, float4* dst, std::size_t n, const float4x4& m) noexcept {
+		const matrix sm(m);
+		for (std::size_t i = 0; i != n; ++i)
+			store(dst[i], transform(load(first[i]), sm));
+	}
+
+	inline void transformpoint(const float3* first, float3* dst, std::size_t n, const float4x4& m) noexcept {
+		const matrix sm(m);
+		for (std::size_t i = 0; i != n; ++i)
+		{
+			float4 r;
+			store(r, transformpoint(first[i].x, first[i].y, first[i].z, sm));
+			dst[i] = { r.x,r.y,r.z };
+		}
+	}
+
+	namespace details {
+		//2x2 blocks packed as (m00, m01, m10, m11)
+		inline vfloat4 mat2_mul(vfloat4 l, vfloat4 r) noexcept {
+			return add(mul(l, swizzle<0, 3, 0, 3>(r)),
+				mul(swizzle<1, 0, 3, 2>(l), swizzle<2, 1, 2, 1>(r)));
+		}
+
+		//adj(l) * r
+		inline vfloat4 mat2_adj_mul(vfloat4 l, vfloat4 r) noexcept {
+			return sub(mul(swizzle<3, 3, 0, 0>(l), r),
+				mul(swizzle<1, 1, 2, 2>(l), swizzle<2, 3, 0, 1>(r)));
+		}
+
+		//l * adj(r)
+		inline vfloat4 mat2_mul_adj(vfloat4 l, vfloat4 r) noexcept {
+			return sub(mul(l, swizzle<3, 0, 3, 0>(r)),
+				mul(swizzle<1, 0, 3, 2>(l), swizzle<2, 1, 2, 1>(r)));
+		}
+	}
+
+	/*
+	\brief Block-wise inverse through the 2x2 sub-matrices.
+	\note The result is undefined when det is zero, the caller decides what to return then.
+	*/
+	inline float4x4 inverse(const float4x4& in, float& det) noexcept {
+		using namespace details;
+
+		matrix m(in);
+		auto A = shuffle<0, 1, 0, 1>(m.r[0], m.r[1]);
+		auto B = shuffle<2, 3, 2, 3>(m.r[0], m.r[1]);
+		auto C = shuffle<0, 1, 0, 1>(m.r[2], m.r[3]);
+		auto D = shuffle<2, 3, 2, 3>(m.r[2], m.r[3]);
+
+		//(|A|, |B|, |C|, |D|)
+		auto det_sub = sub(
+			mul(shuffle<0, 2, 0, 2>(m.r[0], m.r[2]), shuffle<1, 3, 1, 3>(m.r[1], m.r[3])),
+			mul(shuffle<1, 3, 1, 3>(m.r[0], m.r[2]), shuffle<0, 2, 0, 2>(m.r[1], m.r[3])));
+		auto det_A = splat<0>(det_sub);
+		auto det_B = splat<1>(det_sub);
+		auto det_C = splat<2>(det_sub);
+		auto det_D = splat<3>(det_sub);
+
+		auto D_C = mat2_adj_mul(D, C);
+		auto A_B = mat2_adj_mul(A, B);
+
+		auto X = sub(mul(det_D, A), mat2_mul(B, D_C));
+		auto W = sub(mul(det_A, D), mat2_mul(C, A_B));
+		auto Y = sub(mul(det_B, C), mat2_mul_adj(D, A_B));
+		auto Z = sub(mul(det_C, B), mat2_mul_adj(A, D_C));
+
+		//|M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		auto tr = mul(A_B, swizzle<0, 2, 1, 3>(D_C));
+		tr = add(tr, swizzle<1, 0, 3, 2>(tr));
+		tr = add(tr, swizzle<2, 3, 0, 1>(tr));
+		auto det_M = sub(add(mul(det_A, det_D), mul(det_B, det_C)), tr);
+		det = first(det_M);
+
+		auto inv_det = div(set(1.f, -1.f, -1.f, 1.f), det_M);
+		X = mul(X, inv_det);
+		Y = mul(Y, inv_det);
+		Z = mul(Z, inv_det);
+		W = mul(W, inv_det);
+
+		return matrix(
+			shuffle<3, 1, 3, 1>(X, Y),
+			shuffle<2, 0, 2, 0>(X, Y),
+			shuffle<3, 1, 3, 1>(Z, W),
+			shuffle<2, 0, 2, 0>(Z, W));
+	}
+}
+#endif
+
+#endif
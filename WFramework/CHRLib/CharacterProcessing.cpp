@@ -21,6 +21,21 @@ CHRLib::CharacterProcessing
 #include <cctype>
 #include <cstdlib>
 #include <cwchar>
+#include <cstdint> // for std::uintptr_t;
+#include <cstring> // for std::memcpy;
+
+//! \brief Ƿʹ SSE2  ASCII ַеת
+#ifndef CHRLib_Impl_UseSSE2
+#	if defined(__SSE2__) || defined(_M_X64) \
+	|| (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#		define CHRLib_Impl_UseSSE2 1
+#	else
+#		define CHRLib_Impl_UseSSE2 0
+#	endif
+#endif
+#if CHRLib_Impl_UseSSE2
+#	include <emmintrin.h>
+#endif
 
 namespace CHRLib
 {
@@ -32,6 +47,164 @@ namespace CHRLib
 	using white::ntctslen;
 	using std::make_unique;
 
+	namespace
+	{
+
+		/*!
+		\brief ת UTF-8 ַʼ ASCII ַΪ UCS-2  UCS-4 ַС
+		\pre Ŀ껺㹻ת
+		\post Դָָ׸ ASCII ַַΧĽλá
+		\note ʹ SSE2 ʱÿδ 16 ֽڡ
+
+		ʹ÷ΧλʱȡʹöļأԽַڵҳ
+		*/
+		//@{
+		template<typename _tDst>
+		inline void
+			WidenASCIIScalar(_tDst*& d, const char*& s, const char* e = {})
+		{
+			while (s != e && *s != char() && IsASCII(*s))
+				*d++ = _tDst(*s++);
+		}
+
+#if CHRLib_Impl_UseSSE2
+		inline void
+			StoreWidened(ucs2_t*& d, __m128i v)
+		{
+			const auto z(_mm_setzero_si128());
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+				_mm_unpacklo_epi8(v, z));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d + 8),
+				_mm_unpackhi_epi8(v, z));
+			d += 16;
+		}
+		inline void
+			StoreWidened(ucs4_t*& d, __m128i v)
+		{
+			const auto z(_mm_setzero_si128());
+			const auto lo(_mm_unpacklo_epi8(v, z)), hi(_mm_unpackhi_epi8(v, z));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+				_mm_unpacklo_epi16(lo, z));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d + 4),
+				_mm_unpackhi_epi16(lo, z));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d + 8),
+				_mm_unpacklo_epi16(hi, z));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d + 12),
+				_mm_unpackhi_epi16(hi, z));
+			d += 16;
+		}
+
+		//! \brief ж 16 ֽǷڷ ASCII ַַ
+		inline bool
+			HasStopByte(__m128i v)
+		{
+			return _mm_movemask_epi8(_mm_or_si128(v,
+				_mm_cmpeq_epi8(v, _mm_setzero_si128()))) != 0;
+		}
+#endif
+
+		template<typename _tDst>
+		void
+			WidenASCII(_tDst*& d, const char*& s)
+		{
+#if CHRLib_Impl_UseSSE2
+			while ((reinterpret_cast<std::uintptr_t>(s) & 15U) != 0)
+				if (*s != char() && IsASCII(*s))
+					*d++ = _tDst(*s++);
+				else
+					return;
+			while (true)
+			{
+				const auto v(_mm_load_si128(reinterpret_cast<const __m128i*>(s)));
+
+				if (HasStopByte(v))
+					break;
+				StoreWidened(d, v);
+				s += 16;
+			}
+#endif
+			WidenASCIIScalar(d, s);
+		}
+		template<typename _tDst>
+		void
+			WidenASCII(_tDst*& d, const char*& s, const char* e)
+		{
+#if CHRLib_Impl_UseSSE2
+			while (e - s >= 16)
+			{
+				const auto
+					v(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+
+				if (HasStopByte(v))
+					break;
+				StoreWidened(d, v);
+				s += 16;
+			}
+#endif
+			WidenASCIIScalar(d, s, e);
+		}
+		//@}
+
+		/*!
+		\brief ת UCS-2  UCS-4 ַʼ ASCII ַΪ UTF-8 ַС
+		\pre Ŀ껺㹻ת
+		\post Դָָ׸ ASCII ַַ
+		\note ʹ SSE2 ʱÿδ 16 ֽڵĶԴַ
+		*/
+		template<typename _tSrc>
+		void
+			NarrowASCII(char*& d, const _tSrc*& s)
+		{
+#if CHRLib_Impl_UseSSE2
+			static_assert(16 % sizeof(_tSrc) == 0, "Invalid type found.");
+			wconstexpr const size_t n(16 / sizeof(_tSrc));
+
+			while ((reinterpret_cast<std::uintptr_t>(s) & 15U) != 0)
+				if (*s != _tSrc() && IsASCII(*s))
+					*d++ = char(*s++);
+				else
+					return;
+			while (true)
+			{
+				const auto v(_mm_load_si128(reinterpret_cast<const __m128i*>(s)));
+				const auto z(_mm_setzero_si128());
+				// NOTE: Bits other than the low 7 bits in each character are
+				//	tested with the sign bits of the bytes after masking, and null
+				//	characters are detected by the comparison of characters.
+				const auto high(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(v,
+					sizeof(_tSrc) == 2 ? _mm_set1_epi16(short(0xFF80))
+					: _mm_set1_epi32(int(0xFFFFFF80))), z)));
+				const auto nul(_mm_movemask_epi8(sizeof(_tSrc) == 2
+					? _mm_cmpeq_epi16(v, z) : _mm_cmpeq_epi32(v, z)));
+
+				if (high != 0xFFFF || nul != 0)
+					break;
+
+				// NOTE: All characters are in [1, 0x7F] here, so saturation
+				//	does not change any value.
+				auto r(sizeof(_tSrc) == 2 ? v : _mm_packs_epi32(v, v));
+
+				r = _mm_packus_epi16(r, r);
+				if (sizeof(_tSrc) == 2)
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(d), r);
+				else
+				{
+					const auto w(_mm_cvtsi128_si32(r));
+
+					std::memcpy(d, &w, sizeof(w));
+				}
+				d += n;
+				s += n;
+			}
+#endif
+			while (*s != _tSrc() && IsASCII(*s))
+				*d++ = char(*s++);
+		}
+
+	} // unnamed namespace;
+
 	ConversionResult
 		MBCToUC(char16_t& uc, const char*& c, Encoding enc, ConversionState&& st)
 	{
@@ -123,9 +296,20 @@ namespace CHRLib
 
 		if (const auto pfun = FetchMapperPtr<ConversionResult, ucs2_t&,
 			const char*&, ConversionState&&>(enc))
-			while (!is_null(*s) && pfun(*d, s, ConversionState())
-				== ConversionResult::OK)
+		{
+			const bool utf8(enc == CharSet::UTF_8);
+
+			while (true)
+			{
+				// NOTE: ASCII characters are mapped identically in UTF-8.
+				if (utf8 && IsASCII(*s))
+					WidenASCII(d, s);
+				if (is_null(*s)
+					|| pfun(*d, s, ConversionState()) != ConversionResult::OK)
+					break;
 				++d;
+			}
+		}
 		*d = 0;
 		return size_t(d - p);
 	}
@@ -141,9 +325,19 @@ namespace CHRLib
 
 		if (const auto pfun = FetchMapperPtr<ConversionResult, ucs2_t&,
 			GuardPair<const char*>&&, ConversionState&&>(enc))
-			while (!is_null(*s) && pfun(*d, { s, e }, ConversionState())
-				== ConversionResult::OK)
+		{
+			const bool utf8(enc == CharSet::UTF_8);
+
+			while (true)
+			{
+				if (utf8 && s != e && IsASCII(*s))
+					WidenASCII(d, s, e);
+				if (is_null(*s)
+					|| pfun(*d, { s, e }, ConversionState()) != ConversionResult::OK)
+					break;
 				++d;
+			}
+		}
 		*d = 0;
 		return size_t(d - p);
 	}
@@ -160,7 +354,8 @@ namespace CHRLib
 		// TODO: Use UCS-4 internal conversion directly?
 		if (const auto pfun = FetchMapperPtr<ConversionResult, ucs2_t&,
 			const char*&, ConversionState&&>(enc))
-			while (!is_null(*s))
+			while (!is_null(enc == CharSet::UTF_8 && IsASCII(*s)
+				? (WidenASCII(d, s), *s) : *s))
 			{
 				// TODO: Necessary initialization?
 				ucs2_t c;
@@ -189,7 +384,8 @@ namespace CHRLib
 		// TODO: Use UCS-4 internal conversion directly?
 		if (const auto pfun = FetchMapperPtr<ConversionResult, ucs2_t&,
 			GuardPair<const char*>&&, ConversionState&&>(enc))
-			while (!is_null(*s))
+			while (!is_null(enc == CharSet::UTF_8 && s != e && IsASCII(*s)
+				? (WidenASCII(d, s, e), *s) : *s))
 			{
 				// TODO: Necessary initialization?
 				ucs2_t c;
@@ -215,8 +411,12 @@ namespace CHRLib
 		const auto p(d);
 
 		if (const auto pfun = FetchMapperPtr<size_t, char*, ucs4_t>(enc))
-			while (!is_null(*s))
+		{
+			const bool utf8(enc == CharSet::UTF_8);
+
+			while (!is_null(utf8 && IsASCII(*s) ? (NarrowASCII(d, s), *s) : *s))
 				d += pfun(d, *s++);
+		}
 		*d = char();
 		return size_t(d - p);
 	}
@@ -241,8 +441,12 @@ namespace CHRLib
 		const auto p(d);
 
 		if (const auto pfun = FetchMapperPtr<size_t, char*, ucs4_t>(enc))
-			while (!is_null(*s))
+		{
+			const bool utf8(enc == CharSet::UTF_8);
+
+			while (!is_null(utf8 && IsASCII(*s) ? (NarrowASCII(d, s), *s) : *s))
 				d += pfun(d, ucs2_t(*s++));
+		}
 		*d = char();
 		return size_t(d - p);
 	}
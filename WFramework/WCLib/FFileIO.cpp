@@ -35,6 +35,10 @@ using platform_ex::MakePathStringW;
 #elif WFL_API_POSIXFileSystem
 #	include <WBase/CHRLib/CharacterProcessing.h>
 #	include <dirent.h>
+#	if defined(__linux__)
+#		include <sys/sendfile.h> // for ::sendfile;
+#		define WCL_Impl_KernelCopy 1
+#	endif
 
 using namespace CHRLib;
 #else
@@ -314,6 +318,84 @@ namespace platform
 			return {};
 		}
 
+#if WCL_Impl_KernelCopy
+		/*!
+		\brief жں˸ƵĴǷʾļִ֧˷ʽĸơ
+		\note ʱδκݣʹʽ¸ơ
+		*/
+		wconstfn bool
+			IsKernelCopyUnsupported(int err) wnothrow
+		{
+			return err == ENOSYS || err == EXDEV || err == EINVAL
+				|| err == EOPNOTSUPP || err == EBADF;
+		}
+
+		/*!
+		\brief ѭں˸ֱļ
+		\return ļΪ 0 ΪʧܵĴ롣
+		\note  EINTR ʱ
+		*/
+		template<typename _func>
+		int
+			CopyInKernel(_func f, bool& copied) wnothrow
+		{
+			while (true)
+			{
+				const auto n(f());
+
+				if (n > 0)
+					copied = true;
+				else if (n == 0)
+					return 0;
+				else if (errno != EINTR)
+					return errno;
+			}
+		}
+
+		/*!
+		\brief ںиļݣγ copy_file_range  sendfile 
+		\return ɹΪ 0 ֧ûиΪ -1 Ϊ롣
+		\note ļϵͳ֧ʱ copy_file_range ʹӣ reflink ݡ
+		\note δκݼļΪ֧֣
+			procfs  sysfs αļĴСΪ 0 ں˸ֱӷ 0 
+		\note ļĵǰдλÿʼƣ¶дλá
+		*/
+		int
+			CopyContentInKernel(int ofd, int ifd) wnothrow
+		{
+			// NOTE: Each call is bounded to keep the copy interruptible.
+			wconstexpr const size_t chunk(size_t(1) << 30);
+			bool copied{};
+			auto err(CopyInKernel([=] {
+				return ::copy_file_range(ifd, {}, ofd, {}, chunk, 0);
+			}, copied));
+
+			if (copied || (err != 0 && !IsKernelCopyUnsupported(err)))
+				return err;
+			err = CopyInKernel([=] {
+				return ::sendfile(ofd, ifd, {}, chunk);
+			}, copied);
+			return copied || (err != 0 && !IsKernelCopyUnsupported(err)) ? err
+				: -1;
+		}
+
+		//! \brief ȡļӵǰдλʣСʧʱΪ 0 
+		std::uint64_t
+			GetRemainedSize(int fd) wnothrow
+		{
+			struct ::stat st;
+
+			if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+			{
+				const auto pos(::lseek(fd, 0, SEEK_CUR));
+
+				if (pos >= 0 && pos < st.st_size)
+					return std::uint64_t(st.st_size - pos);
+			}
+			return 0;
+		}
+#endif
+
 } // unnamed namespace;
 
 
@@ -561,6 +643,20 @@ namespace platform
 		//	'_FILE_OFFSET_BITS == 1'. Thus it is not safe and would better to be
 		//	ignored slightly.
 		return ::ftruncate(desc, ::off_t(size)) == 0;
+#endif
+	}
+	bool
+		FileDescriptor::Preallocate(std::uint64_t size) wnothrow
+	{
+#if WCL_Impl_KernelCopy
+		const auto pos(::lseek(desc, 0, SEEK_CUR));
+
+		return pos >= 0 && (size == 0 || ::fallocate(desc, FALLOC_FL_KEEP_SIZE, pos,
+			::off_t(size)) == 0);
+#else
+		// TODO: Other platforms.
+		wunused(size);
+		return {};
 #endif
 	}
 	int
@@ -642,6 +738,35 @@ namespace platform
 		FileDescriptor::WriteContent(FileDescriptor ofd, FileDescriptor ifd,
 			size_t size)
 	{
+		WriteContent(ofd, ifd, size, {});
+	}
+	void
+		FileDescriptor::WriteContent(FileDescriptor ofd, FileDescriptor ifd,
+			size_t size, bool preallocate)
+	{
+		WAssertNonnull(ifd),
+			WAssertNonnull(ofd);
+#if WCL_Impl_KernelCopy
+		// NOTE: Failure of preallocation is ignored as it is only an
+		//	optimization.
+		if (preallocate)
+			ofd.Preallocate(GetRemainedSize(*ifd));
+		switch (const int err = CopyContentInKernel(*ofd, *ifd))
+		{
+		case 0:
+			return;
+		case -1:
+			break;
+		default:
+			errno = err;
+			WCL_Raise_SysE(, "Failed copying source file '" + to_string(*ifd)
+				+ "' to destination file '" + to_string(*ofd) + "'", wfsig);
+		}
+#else
+		// TODO: Preallocation on other platforms.
+		wunused(preallocate);
+#endif
+
 		white::temporary_buffer<byte> buf(size);
 
 		WriteContent(ofd, ifd, buf.get().get(), buf.size());
@@ -309,6 +309,15 @@ namespace platform
 		bool
 			SetSize(size_t) wnothrow;
 		/*!
+		\brief ӵǰдλԤָСļռ䡣
+		\pre ָļѾ򿪲д
+		\return Ƿɹֵ֧ƽ̨ false 
+		\note ıļȺͶдλá
+		\note Linux ƽ̨ʹ \c fallocate 
+		*/
+		bool
+			Preallocate(std::uint64_t) wnothrow;
+		/*!
 		\brief ÷ģʽ
 		\note  Win32 ıģʽΪƽ̨ͷֵͬ \c setmode 
 		\note ƽ̨á
@@ -375,12 +384,23 @@ namespace platform
 		static WB_NONNULL(3) void
 			WriteContent(FileDescriptor, FileDescriptor, byte*, size_t);
 		/*!
-		\note һָСޣʧԶ·䡣
+		\note ָСޣʧԶ·䡣
+		\note Linux ƽ̨ʹ \c copy_file_range  \c sendfile ںиƣ
+		֧ʱʹûơ
 		\throw std::bad_alloc ʧܡ
 		*/
+		//@{
 		static void
 			WriteContent(FileDescriptor, FileDescriptor,
-				size_t = wimpl(size_t(BUFSIZ << 4)));
+				size_t = wimpl(size_t(1) << 20U));
+		/*!
+		\brief ڶдһָļԤĿļռ䡣
+		\note ָǷԴļʣСԤ䣻Ԥʧܱԡ
+		\sa Preallocate
+		*/
+		static void
+			WriteContent(FileDescriptor, FileDescriptor, size_t, bool);
+		//@}
 		//@}
 
 		/*!
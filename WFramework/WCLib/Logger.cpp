@@ -8,6 +8,12 @@
 #endif
 #if WF_Multithread == 1
 #include <WBase/concurrency.h>
+#include <atomic>
+#include <bit>
+#include <csignal>
+#include <cstdint>
+#include <exception>
+#include <thread>
 #endif
 #include <iostream>
 #include <cstdarg>
@@ -23,14 +29,26 @@ namespace platform
 		}
 
 #if WF_Multithread == 1
+		//! \brief The producer of the asynchronous record being sent on this thread.
+		thread_local const std::string* p_record_thread_id{};
+
 		std::string
 			FetchCurrentThreadID() wnothrow
 		{
-			TryRet(white::get_this_thread_id())
+			TryRet(p_record_thread_id ? *p_record_thread_id
+				: white::get_this_thread_id())
 				// XXX: Nothing more can be done.
 				CatchIgnore(...)
 				return{};
 		}
+
+		const std::string&
+			FetchCachedThreadID() wnothrow
+		{
+			thread_local const std::string id(FetchCurrentThreadID());
+
+			return id;
+		}
 #endif
 
 #if WFL_Win32
@@ -67,6 +85,362 @@ namespace platform
 #endif
 	}
 
+#if WF_Multithread == 1
+	/*!
+	\brief Bounded multi-producer queue of records and the thread sending them.
+
+	The queue is the sequence numbered ring of D. Vyukov: each slot carries the
+	position it is ready for, producers claim positions by CAS and never block
+	each other. Consumers claim positions the same way, so the crash handlers
+	can drain the queue while the sink thread is still running.
+	*/
+	class Logger::AsyncRecorder
+	{
+	private:
+		struct Record
+		{
+			std::atomic<size_t> Sequence;
+			Level RecordLevel;
+			//! \note False when copying the record threw, the record is skipped.
+			bool Valid;
+			string Text;
+			string ThreadID;
+		};
+
+		static constexpr size_t max_active = 8;
+		//! \brief Records sent by the sink thread under one lock of record_mutex.
+		static constexpr size_t batch_size = 256;
+
+		static inline std::atomic<AsyncRecorder*> active[max_active]{};
+		static inline std::terminate_handler previous_terminate{};
+		static inline const int crash_signals[]{ SIGABRT, SIGSEGV, SIGILL, SIGFPE };
+		static inline void(*previous_signals[std::size(crash_signals)])(int){};
+#if WFL_Win32
+		static inline ::LPTOP_LEVEL_EXCEPTION_FILTER previous_filter{};
+#endif
+		static inline thread_local const AsyncRecorder* p_sending{};
+
+		Logger& logger;
+		const OverflowPolicy policy;
+		const size_t mask;
+		std::unique_ptr<Record[]> records;
+		alignas(64) std::atomic<size_t> enqueue_pos{ 0 };
+		alignas(64) std::atomic<size_t> dequeue_pos{ 0 };
+		alignas(64) std::atomic<size_t> sent{ 0 };
+		std::atomic<size_t> dropped{ 0 };
+		std::atomic<bool> sleeping{};
+		std::atomic<std::uint32_t> wake{ 0 };
+		std::atomic<bool> stopping{};
+		std::thread sink;
+
+	public:
+		AsyncRecorder(Logger& l, size_t capacity, OverflowPolicy p)
+			: logger(l), policy(p),
+			mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+			records(new Record[mask + 1])
+		{
+			for (size_t i(0); i != mask + 1; ++i)
+				records[i].Sequence.store(i, std::memory_order_relaxed);
+			InstallCrashHandlers();
+			sink = std::thread([this] {
+				Run();
+			});
+			for (auto& slot : active)
+			{
+				AsyncRecorder* expected{};
+
+				if (slot.compare_exchange_strong(expected, this))
+					break;
+			}
+		}
+		~AsyncRecorder()
+		{
+			for (auto& slot : active)
+			{
+				auto expected(this);
+
+				slot.compare_exchange_strong(expected, nullptr);
+			}
+			stopping.store(true, std::memory_order_release);
+			Wake();
+			sink.join();
+		}
+
+		DefGetter(const wnothrow, size_t, DroppedCount,
+			dropped.load(std::memory_order_relaxed))
+
+		/*!
+		\return Whether the record is queued or dropped, false when called while
+			sending, the caller then sends it directly.
+		*/
+		bool
+			Push(Level level, const char* str)
+		{
+			if (p_sending == this)
+				return {};
+
+			auto pos(enqueue_pos.load(std::memory_order_relaxed));
+			Record* p;
+
+			while (true)
+			{
+				p = &records[pos & mask];
+
+				const auto diff(std::intptr_t(p->Sequence.load(
+					std::memory_order_acquire)) - std::intptr_t(pos));
+
+				if (diff == 0)
+				{
+					if (enqueue_pos.compare_exchange_weak(pos, pos + 1,
+						std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+				{
+					if (policy == OverflowPolicy::Drop)
+					{
+						dropped.fetch_add(1, std::memory_order_relaxed);
+						return true;
+					}
+					{
+						// NOTE: Sends the oldest record instead of waiting for the
+						//	sink thread, which also works when this thread holds
+						//	record_mutex. Records are only taken under the lock so
+						//	the order is kept.
+						lock_guard<recursive_mutex> lck(logger.record_mutex);
+
+						SendRecords(1);
+					}
+					pos = enqueue_pos.load(std::memory_order_relaxed);
+				}
+				else
+					pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+			p->RecordLevel = level;
+			try
+			{
+				// NOTE: The buffers keep their capacity when the slot is reused.
+				p->Text.assign(str);
+				p->ThreadID.assign(FetchCachedThreadID());
+				p->Valid = true;
+			}
+			catch (...)
+			{
+				// NOTE: The claimed slot has to be published anyway.
+				p->Valid = {};
+				Publish(*p, pos);
+				throw;
+			}
+			Publish(*p, pos);
+			return true;
+		}
+
+		void
+			Flush()
+		{
+			if (p_sending == this)
+				return;
+
+			const auto target(enqueue_pos.load(std::memory_order_acquire));
+
+			for (auto n(sent.load(std::memory_order_acquire)); n < target;
+				n = sent.load(std::memory_order_acquire))
+				sent.wait(n, std::memory_order_acquire);
+		}
+
+	private:
+		void
+			Publish(Record& record, size_t pos) wnothrow
+		{
+			record.Sequence.store(pos + 1, std::memory_order_release);
+			// NOTE: Pairs with the fence in %Run, either the sink thread sees the
+			//	record or this thread sees it sleeping.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (sleeping.load(std::memory_order_relaxed)
+				&& sleeping.exchange({}, std::memory_order_relaxed))
+				Wake();
+		}
+
+		bool
+			Pop(Level& level, bool& valid, string& text, string& thread_id)
+		{
+			auto pos(dequeue_pos.load(std::memory_order_relaxed));
+			Record* p;
+
+			while (true)
+			{
+				p = &records[pos & mask];
+
+				const auto diff(std::intptr_t(p->Sequence.load(
+					std::memory_order_acquire)) - std::intptr_t(pos + 1));
+
+				if (diff == 0)
+				{
+					if (dequeue_pos.compare_exchange_weak(pos, pos + 1,
+						std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+					return {};
+				else
+					pos = dequeue_pos.load(std::memory_order_relaxed);
+			}
+			level = p->RecordLevel;
+			valid = p->Valid;
+			text.swap(p->Text);
+			thread_id.swap(p->ThreadID);
+			p->Sequence.store(pos + mask + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool
+			IsEmpty() const wnothrow
+		{
+			const auto pos(dequeue_pos.load(std::memory_order_relaxed));
+
+			return records[pos & mask].Sequence.load(std::memory_order_acquire)
+				!= pos + 1;
+		}
+
+		//! \return The number of records taken from the queue.
+		size_t
+			SendRecords(size_t n) wnothrow
+		{
+			Level level;
+			bool valid;
+			string text, thread_id;
+			size_t i(0);
+
+			p_sending = this;
+			for (; i != n && Pop(level, valid, text, thread_id); ++i)
+				if (valid)
+				{
+					p_record_thread_id = &thread_id;
+					try
+					{
+						logger.DoLogRaw(level, text.c_str());
+					}
+					CatchExpr(..., white::wtrace(stderr, Descriptions::Emergent,
+						Descriptions::Notice, __FILE__, __LINE__,
+						"Logging error: unhandled exception in asynchronous sending."))
+					p_record_thread_id = {};
+				}
+			p_sending = {};
+			if (i != 0)
+			{
+				sent.fetch_add(i, std::memory_order_release);
+				sent.notify_all();
+			}
+			return i;
+		}
+
+		void
+			Run() wnothrow
+		{
+			while (true)
+			{
+				// NOTE: Loaded before taking records, so nothing queued before
+				//	%StopAsync is left behind.
+				const bool stop(stopping.load(std::memory_order_acquire));
+				size_t n;
+
+				{
+					lock_guard<recursive_mutex> lck(logger.record_mutex);
+
+					n = SendRecords(batch_size);
+				}
+				if (n != 0)
+					continue;
+				if (stop)
+					break;
+
+				const auto ticket(wake.load(std::memory_order_acquire));
+
+				sleeping.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (IsEmpty() && !stopping.load(std::memory_order_acquire))
+					wake.wait(ticket, std::memory_order_acquire);
+				sleeping.store({}, std::memory_order_relaxed);
+			}
+		}
+
+		void
+			Wake() wnothrow
+		{
+			wake.fetch_add(1, std::memory_order_release);
+			wake.notify_one();
+		}
+
+		// XXX: Not async-signal-safe. This is a best effort on the way down, the
+		//	record mutex is not taken since the crashing thread can hold it.
+		static void
+			SendAllOnCrash() wnothrow
+		{
+			for (auto& slot : active)
+				if (const auto p = slot.load(std::memory_order_acquire))
+					p->SendRecords(size_t(-1));
+		}
+
+		static void
+			OnSignal(int sig)
+		{
+			SendAllOnCrash();
+			for (size_t i(0); i != std::size(crash_signals); ++i)
+				if (crash_signals[i] == sig)
+				{
+					const auto previous(previous_signals[i]);
+
+					std::signal(sig, previous == SIG_ERR || previous == SIG_IGN
+						? SIG_DFL : previous);
+				}
+			std::raise(sig);
+		}
+
+#if WFL_Win32
+		static LONG WINAPI
+			OnUnhandledException(::EXCEPTION_POINTERS* p_info)
+		{
+			SendAllOnCrash();
+			return previous_filter ? previous_filter(p_info)
+				: EXCEPTION_CONTINUE_SEARCH;
+		}
+#endif
+
+		static void
+			InstallCrashHandlers()
+		{
+			static once_flag installed;
+
+			call_once(installed, [] {
+				previous_terminate = std::set_terminate([] {
+					SendAllOnCrash();
+					if (previous_terminate)
+						previous_terminate();
+					std::abort();
+				});
+				for (size_t i(0); i != std::size(crash_signals); ++i)
+					previous_signals[i] = std::signal(crash_signals[i], OnSignal);
+#if WFL_Win32
+				previous_filter = ::SetUnhandledExceptionFilter(OnUnhandledException);
+#endif
+			});
+		}
+	};
+#else
+	class Logger::AsyncRecorder
+	{
+	public:
+		DefGetter(const wnothrow, size_t, DroppedCount, 0)
+
+		PDefH(bool, Push, Level, const char*)
+			ImplRet({})
+
+		PDefH(void, Flush, )
+			ImplRet()
+	};
+#endif
+
+	Logger::Logger() = default;
 	Logger::Logger(const Logger& logger)
 		: FilterLevel(logger.FilterLevel), filter(logger.filter),
 		sender(logger.sender)
@@ -76,6 +450,10 @@ namespace platform
 	{
 		swap(logger, *this);
 	}
+	Logger::~Logger()
+	{
+		StopAsync();
+	}
 
 	void
 		Logger::SetFilter(Filter f)
@@ -90,6 +468,38 @@ namespace platform
 			sender = std::move(s);
 	}
 
+	void
+		Logger::StartAsync(size_t capacity, OverflowPolicy policy)
+	{
+#if WF_Multithread == 1
+		if (!p_async)
+			p_async = std::make_unique<AsyncRecorder>(*this, capacity, policy);
+#else
+		wunused(capacity), wunused(policy);
+#endif
+	}
+
+	void
+		Logger::StopAsync() wnothrow
+	{
+		// NOTE: The recorder sends the rest of the queue before its thread ends.
+		TryExpr(p_async.reset())
+			CatchIgnore(...)
+	}
+
+	void
+		Logger::Flush()
+	{
+		if (p_async)
+			p_async->Flush();
+	}
+
+	size_t
+		Logger::GetDroppedCount() const wnothrow
+	{
+		return p_async ? p_async->GetDroppedCount() : 0;
+	}
+
 	bool
 		Logger::DefaultFilter(Level lv, Logger& logger) wnothrow
 	{
@@ -114,6 +524,9 @@ namespace platform
 	{
 		if (str)
 		{
+			if (p_async && p_async->Push(level, str))
+				return;
+
 			lock_guard<recursive_mutex> lck(record_mutex);
 
 			DoLogRaw(level, str);
@@ -142,6 +555,16 @@ namespace platform
 					__FILE__, __LINE__, "Logging error: unhandled exception."))
 		});
 		const auto& msg(e.what());
+
+		if (p_async)
+			// NOTE: Falls back to sending directly when queuing fails.
+			try
+			{
+				if (p_async->Push(lv, sfmt("<%s>: %s", typeid(e).name(), msg).c_str()))
+					return;
+			}
+			CatchIgnore(...)
+
 		lock_guard<recursive_mutex> lck(record_mutex);
 
 		try
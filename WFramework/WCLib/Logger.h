@@ -10,6 +10,7 @@
 #include <WFramework/WCLib/FCommon.h>
 #include <WFramework/WCLib/FContainer.h>
 #include <WFramework/WCLib/Mutex.h>
+#include <memory>
 
 
 /*!	\defgroup diagnostic Diagnostic
@@ -75,6 +76,17 @@ namespace platform
 		//! \note ݵĵǿա
 		using Sender = std::function<void(Level, Logger&, const char*)>;
 
+		/*!
+		\brief 첽ģʽ¼¼ʱĴԡ
+		*/
+		enum class OverflowPolicy
+		{
+			//! \brief ȴ̨߳ڳռ䡣
+			Block,
+			//! \brief ¼¼
+			Drop
+		};
+
 #ifdef NDEBUG
 		Level FilterLevel = Descriptions::Informative;
 #else
@@ -82,6 +94,8 @@ namespace platform
 #endif
 
 	private:
+		class AsyncRecorder;
+
 		//! \invariant <tt>bool(filter)</tt> 
 		Filter filter{ DefaultFilter };
 		//! \invariant <tt>bool(Sender)</tt> 
@@ -93,6 +107,13 @@ namespace platform
 		ʹõݹûڷмӵݹ DoLog  DoLogException 
 		*/
 		Concurrency::recursive_mutex record_mutex;
+		/*!
+		\brief 첽¼
+
+		ǿʱ DoLog  DoLogException Ѽ¼Уɺ̨̳߳ record_mutex з͡
+		ơתƺͽ漰˳Ա
+		*/
+		std::unique_ptr<AsyncRecorder> p_async{};
 
 	public:
 		//@{
@@ -101,7 +122,7 @@ namespace platform
 		\note 쳣ͬ FetchDefaultSender 
 		\note  std::function Ĺģṩı֤ȷ쳣׳
 		*/
-		DefDeCtor(Logger)
+		Logger();
 			//! \brief ƹ죺ƹ˵ȼͷʹ´Ļ
 		Logger(const Logger&);
 		/*!
@@ -110,10 +131,14 @@ namespace platform
 		\see LWG 2062 
 		*/
 		Logger(Logger&&) wnothrow;
+		//! \brief ͣ첽ģʽ
+		~Logger();
 
 		DefDeCopyMoveAssignment(Logger)
 		//@}
 
+		DefPred(const wnothrow, Async, bool(p_async))
+
 		DefGetter(const wnothrow, const Sender&, Sender, sender)
 
 		/*!
@@ -129,6 +154,37 @@ namespace platform
 		void
 			SetSender(Sender);
 
+		/*!
+		\brief 첽ģʽ
+		\pre û̲߳ʹô־¼
+		\note û߳ʱԡ
+		\note һΪпɵļ¼ȡΪ 2 ݡ
+		\note ¼ڵ̸߳ʽΡתں̨߳̽С
+		\note ״ʱװ쳣ֹǰͶʣļ¼
+
+		ΪнĶλ壬еַڸʱ
+		*/
+		void
+			StartAsync(size_t = 8192, OverflowPolicy = OverflowPolicy::Block);
+		/*!
+		\brief ͣ첽ģʽͶʣļ¼̨̡߳
+		\pre û̲߳ʹô־¼
+		*/
+		void
+			StopAsync() wnothrow;
+
+		/*!
+		\brief ȴǰеļ¼ϡ
+		\note 첽ģʽʱá
+		\warning ڷл AccessRecord Ĳеʱ
+		*/
+		void
+			Flush();
+
+		//! \brief ȡ첽ģʽļ¼
+		size_t
+			GetDroppedCount() const wnothrow;
+
 		/*!
 		\brief ־¼ִָ
 		\note ̰߳ȫʡ
@@ -165,6 +221,7 @@ namespace platform
 		\brief תȼ־
 		\note ַӦĿָ
 		\note ֤з͡
+		\note 첽ģʽ¸ַк󷵻أڷеʱֱӷ͡
 		*/
 		//@{
 		void
@@ -225,7 +282,7 @@ namespace platform
 		//@}
 
 		/*!
-		\brief лݳԱ
+		\brief л첽¼ݳԱ
 		*/
 		WF_API friend void
 			swap(Logger&, Logger&) wnothrow;
@@ -672,6 +672,129 @@ namespace scheme
 	{}
 
 
+	namespace
+	{
+
+		/*!
+		\brief յĿ飺̶ȷĿ
+		\note ƽֲ߳̾ȫʡ
+		*/
+		struct RecycledBlocks final
+		{
+			static wconstexpr const size_t Granularity = 64;
+			static wconstexpr const size_t ClassCount
+				= MaxRecycledReducerSize / Granularity;
+			//! \brief ÿ鱣п
+			static wconstexpr const size_t MaxCount = 256;
+
+			struct Block
+			{
+				Block* Next;
+			};
+			struct FreeList
+			{
+				Block* Head;
+				size_t Count;
+			};
+
+			FreeList Lists[ClassCount];
+			//! \brief ͣñǣٻա
+			bool Disabled;
+
+			static PDefH(size_t, GetClassIndex, size_t n) wnothrow
+				ImplRet((n + Granularity - 1) / Granularity - 1)
+
+			void
+				Clear() wnothrow
+			{
+				for (auto& l : Lists)
+				{
+					while (l.Head)
+						::operator delete(white::exchange(l.Head, l.Head->Next));
+					l.Count = 0;
+				}
+			}
+
+			void*
+				Pop(size_t n) wnothrow
+			{
+				auto& l(Lists[GetClassIndex(n)]);
+
+				if (l.Head)
+				{
+					--l.Count;
+					return white::exchange(l.Head, l.Head->Next);
+				}
+				return {};
+			}
+
+			bool
+				Push(void* p, size_t n) wnothrow
+			{
+				auto& l(Lists[GetClassIndex(n)]);
+
+				if (!Disabled && l.Count < MaxCount)
+				{
+					l.Head = ::new(p) Block{l.Head};
+					++l.Count;
+					return true;
+				}
+				return {};
+			}
+		};
+
+		thread_local RecycledBlocks recycled_blocks{};
+
+		RecycledBlocks&
+			FetchRecycledBlocks() wnothrow
+		{
+			// NOTE: Objects with static storage duration (e.g. a global context)
+			//	can release their actions after thread local objects of the main
+			//	thread are destroyed, so the blocks are only cleared here.
+			struct Cleanup final
+			{
+				~Cleanup()
+				{
+					recycled_blocks.Disabled = true;
+					recycled_blocks.Clear();
+				}
+			};
+			static thread_local Cleanup gd;
+
+			static_cast<void>(gd);
+			return recycled_blocks;
+		}
+
+	} // unnamed namespace;
+
+	void*
+		AllocateReducerBlock(size_t n, const white::type_info& ti)
+	{
+		static_assert(MaxRecycledReducerSize % RecycledBlocks::Granularity == 0,
+			"Invalid recycled block size found.");
+
+		if (n <= MaxRecycledReducerSize)
+		{
+			if (const auto p = FetchRecycledBlocks().Pop(n))
+				return p;
+			// NOTE: All blocks in the same class have the largest size of the class.
+			n = (RecycledBlocks::GetClassIndex(n) + 1) * RecycledBlocks::Granularity;
+		}
+
+		const auto p(::operator new(n));
+
+		white::any_ops::notify_allocation(ti, n);
+		return p;
+	}
+
+	void
+		DeallocateReducerBlock(void* p, size_t n) wnothrow
+	{
+		if (!(n <= MaxRecycledReducerSize && FetchRecycledBlocks().Push(p, n)))
+			::operator delete(p);
+	}
+
+
 	ContextNode::ContextNode(const ContextNode& ctx,
 		shared_ptr<Environment>&& p_rec)
 		: p_record([&] {
@@ -700,29 +823,29 @@ namespace scheme
 		ContextNode::Pop() wnothrow
 	{
 		WAssert(!Delimited.empty(), "No continuation is delimited.");
-		SetupTail(std::move(Delimited.front()));
-		Delimited.pop_front();
+		SetupTail(std::move(Delimited.back()));
+		Delimited.pop_back();
 	}
 
 	void
 		ContextNode::Push(const Reducer& reducer)
 	{
 		WAssert(Current, "No continuation can be captured.");
-		Delimited.push_front(reducer);
-		std::swap(Current, Delimited.front());
+		Delimited.push_back(reducer);
+		Current.swap(Delimited.back());
 	}
 	void
 		ContextNode::Push(Reducer&& reducer)
 	{
 		WAssert(Current, "No continuation can be captured.");
-		Delimited.push_front(std::move(reducer));
-		std::swap(Current, Delimited.front());
+		Delimited.push_back(std::move(reducer));
+		Current.swap(Delimited.back());
 	}
 
 	ReductionStatus
 		ContextNode::Rewrite(Reducer reduce)
 	{
-		SetupTail(reduce);
+		SetupTail(std::move(reduce));
 		// NOTE: Rewriting loop until no actions remain.
 		return white::retry_on_cond(std::bind(&ContextNode::Transit, this), [&] {
 			return ApplyTail();
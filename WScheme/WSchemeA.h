@@ -1373,11 +1373,175 @@ namespace scheme {
 			ImplRet(term_ref.get())
 	};
 
+	/*!
+	\brief ԼĶ̬Ͳ
+	\sa ReducerHandler
+	*/
+	enum ReducerOp : white::any_ops::op_code
+	{
+		//! \brief ãĿ洢С
+		InvokeReducer = white::any_ops::end_base_op,
+		EndReducerOp
+	};
+
+	//! \brief ɻտֽ˴СĿֱӷͷš
+	wconstexpr const size_t MaxRecycledReducerSize = 512;
+
+	/*!
+	\brief ԼĿ飺ȸõǰ̻߳յĿ顣
+	\note ·ʱͨ white::any_ops::notify_allocation ֪ͨѷ䡣
+	*/
+	WS_API void*
+		AllocateReducerBlock(size_t, const white::type_info&);
+
+	//! \brief ͷŹԼĿ飺ǰֱ̻߳ͷš
+	WS_API void
+		DeallocateReducerBlock(void*, size_t) wnothrow;
+
+	/*!
+	\brief Լ
+	\note ֱӱ white::any ڵĶ󱣴ڻյĿС
+	\sa AllocateReducerBlock
+	*/
+	template<typename _func, bool _bStoredLocally = white::and_<
+		std::is_nothrow_move_constructible<_func>, white::is_aligned_storable<
+		white::any_ops::any_storage, _func>>::value>
+	class ReducerHandler
+		: public white::any_ops::value_handler<_func, _bStoredLocally>
+	{
+	public:
+		using base = white::any_ops::value_handler<_func, _bStoredLocally>;
+		using value_type = _func;
+		using local_storage = white::bool_<_bStoredLocally>;
+
+		using base::get_reference;
+
+		template<typename... _tParams>
+		static void
+			init(white::any_ops::any_storage& d, _tParams&&... args)
+		{
+			init_impl(local_storage(), d, wforward(args)...);
+		}
+
+	private:
+		template<typename... _tParams>
+		static void
+			init_impl(white::true_, white::any_ops::any_storage& d,
+			_tParams&&... args)
+		{
+			base::init(d, wforward(args)...);
+		}
+		template<typename... _tParams>
+		static void
+			init_impl(white::false_, white::any_ops::any_storage& d,
+			_tParams&&... args)
+		{
+			const auto p(AllocateReducerBlock(sizeof(value_type),
+				white::type_id<value_type>()));
+
+			try
+			{
+				d.construct<value_type*>(::new(p) value_type(wforward(args)...));
+			}
+			catch (...)
+			{
+				DeallocateReducerBlock(p, sizeof(value_type));
+				throw;
+			}
+		}
+
+		static void
+			dispose_impl(white::true_, white::any_ops::any_storage& d) wnothrow
+		{
+			base::dispose(d);
+		}
+		static void
+			dispose_impl(white::false_, white::any_ops::any_storage& d) wnothrow
+		{
+			const auto p(d.access<value_type*>());
+
+			p->~value_type();
+			DeallocateReducerBlock(p, sizeof(value_type));
+		}
+
+	public:
+		//! \note תֻƿָ롣
+		static void
+			manage(white::any_ops::any_storage& d, white::any_ops::any_storage& s,
+			white::any_ops::op_code op)
+		{
+			switch (op)
+			{
+			case InvokeReducer:
+				d.access<ReductionStatus>() = get_reference(s)();
+				break;
+			case white::any_ops::clone:
+				init(d, get_reference(s));
+				break;
+			case white::any_ops::destroy:
+				dispose_impl(local_storage(), d);
+				break;
+			default:
+				base::manage(d, s, op);
+			}
+		}
+	};
+
+
 	/*!
 	\brief ԼͣͰвֵĴȼۡ
-	\warning ٶתƲ׳쳣
+	\warning 
+	\note ӿں std::function<ReductionStatus()> Ӽݡ
+	\sa ContextNode::Current
+
+	ɸƵ޲ʹ white::any Ĵ洢 ReducerHandler 
+	ֱӱ white::any ڵĶ󱣴ڰСĿУ
+	ͷŵĿɵǰ̻߳գ֮ʱȸá
+	ȶβѭУ˹ԼĹתƲѷ䡣
 	*/
-	using Reducer = white::GHEvent<ReductionStatus()>;
+	class Reducer final : private white::any
+	{
+	public:
+		DefDeCtor(Reducer)
+		Reducer(std::nullptr_t) wnothrow
+		{}
+		//! \note պָ빹ն
+		Reducer(ReductionStatus(*f)())
+			: any(f ? any(white::any_ops::with_handler_t<
+			ReducerHandler<ReductionStatus(*)()>>(), f) : any())
+		{}
+		template<typename _func, wimpl(typename = white::exclude_self_t<Reducer,
+			_func>, typename = white::enable_if_t<std::is_convertible<
+			white::invoke_result_t<white::decay_t<_func>&>, ReductionStatus>::value>)>
+		Reducer(_func&& f)
+			: any(white::any_ops::with_handler_t<
+			ReducerHandler<white::decay_t<_func>>>(), wforward(f))
+		{}
+		DefDeCopyMoveCtorAssignment(Reducer)
+
+		ReductionStatus
+			operator()() const
+		{
+			if (has_value())
+				return unchecked_access<ReductionStatus>(white::default_init,
+					InvokeReducer);
+			throw std::bad_function_call();
+		}
+
+		DefBoolNeg(explicit, has_value())
+
+		using any::reset;
+
+		PDefH(void, swap, Reducer& x) wnothrow
+			ImplExpr(any::swap(x))
+		friend PDefH(void, swap, Reducer& x, Reducer& y) wnothrow
+			ImplExpr(x.swap(y))
+
+		using any::target;
+
+		PDefH(const white::type_info&, target_type, ) const wnothrow
+			ImplRet(type())
+	};
 
 
 	/*!
@@ -1412,8 +1576,9 @@ namespace scheme {
 		bool SkipToNextEvaluation{};
 		/*!
 		\brief 綯߽ʣද
+		\note ΪջʹãĩβΪ׸ʱԸá
 		*/
-		white::deque<Reducer> Delimited{};
+		white::vector<Reducer> Delimited{};
 		/*!
 		\brief һιԼ״̬
 		\sa ApplyTail
@@ -26,27 +26,42 @@ Entities::Entities(const fs::path& file) {
 	std::vector<std::shared_ptr<platform::Mesh>> meshs;
 	std::vector<platform::X::path> pathes;
 
+	std::vector<std::shared_ptr<platform::Material>> materials;
+	std::vector<platform::X::path> material_pathes;
+	std::vector<std::string> material_names;
+
 	meshs.resize(entity_nodes.size());
+	materials.resize(entity_nodes.size());
 	for (auto& entity_node : entity_nodes)
 	{
 		auto mesh_name = Access("mesh", entity_node);
 		pathes.emplace_back(mesh_name + ".asset");
-	}
 
-	white::coroutine::SyncWait(platform::X::AsyncLoadMeshes(white::make_const_span(pathes),white::make_span(meshs)));
-
-	int index = 0;
-	for (auto& entity_node : platform::X::SelectNodes("entity", term_node))
-	{
 		auto material_name = Access("material", entity_node);
-		entities.emplace_back(meshs[index++], material_name);
+		material_pathes.emplace_back(material_name + ".mat.wsl");
+		material_names.emplace_back(material_name);
 	}
 
+	std::vector<white::coroutine::Task<void>> tasks;
+	tasks.emplace_back(platform::X::AsyncLoadMeshes(white::make_const_span(pathes), white::make_span(meshs)));
+	tasks.emplace_back(platform::X::AsyncLoadMaterials(white::make_const_span(material_pathes), white::make_const_span(material_names), white::make_span(materials)));
+
+	for (auto& task : white::coroutine::SyncWait(white::coroutine::WhenAllReady(std::move(tasks))))
+		task.result();
+
+	for (std::size_t index = 0; index != entity_nodes.size(); ++index)
+		entities.emplace_back(meshs[index], materials[index]);
+
 	min = white::math::float3(FLT_MAX, FLT_MAX, FLT_MAX);
 	max = white::math::float3(FLT_MIN, FLT_MIN, FLT_MIN);
+	std::vector<WhiteEngine::BoxSphereBounds> bounds;
 	for (auto& entity : entities)
 	{
 		min = white::math::min(min, entity.GetMesh().GetBoundingMin());
 		max = white::math::max(max, entity.GetMesh().GetBoundingMax());
+
+		auto extent = (entity.GetMesh().GetBoundingMax() - entity.GetMesh().GetBoundingMin()) / 2;
+		bounds.emplace_back((entity.GetMesh().GetBoundingMin() + entity.GetMesh().GetBoundingMax()) / 2, extent, white::math::length(extent));
 	}
+	bvh.Build(bounds);
 }
\ No newline at end of file
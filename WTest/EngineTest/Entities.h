@@ -8,6 +8,7 @@
 #include "RenderInterface/IRayDevice.h"
 #include "RenderInterface/IContext.h"
 #include "RenderInterface/IRayContext.h"
+#include "Runtime/Renderer/SceneBVH.h"
 #include "WBase/span.hpp"
 
 #include <string>
@@ -24,6 +25,10 @@ public:
 		pMaterial = platform::X::LoadMaterial(material_name + ".mat.wsl", material_name);
 	}
 
+	Entity(std::shared_ptr<platform::Mesh> mesh, std::shared_ptr<platform::Material> material)
+		:pMesh(mesh), pMaterial(material) {
+	}
+
 	const platform::Material& GetMaterial() const {
 		return *pMaterial;
 	}
@@ -48,6 +53,11 @@ public:
 		return entities;
 	}
 
+	//! \brief Primitive ids are indices into GetRenderables().
+	const WhiteEngine::SceneBVH& GetBVH() const {
+		return bvh;
+	}
+
 	white::shared_ptr<platform::Render::RayTracingScene> CreateRayTracingScene()
 	{
 		platform::Render::RayTracingSceneInitializer initializer;
@@ -73,4 +83,6 @@ public:
 	white::math::float3 max;
 private:
 	std::vector<Entity> entities;
+
+	WhiteEngine::SceneBVH bvh;
 };
\ No newline at end of file
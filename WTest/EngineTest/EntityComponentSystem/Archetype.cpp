@@ -0,0 +1,172 @@
+#include "Archetype.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+using namespace ecs;
+
+namespace {
+	// Chunks start on a cache line so columns of different chunks never share one
+	wconstexpr std::size_t ChunkAlign = 64;
+	// Columns start on 16 bytes at least for the SSE loads of float4 like components
+	wconstexpr white::uint32 ColumnAlign = 16;
+
+	struct ComponentRegistry {
+		std::mutex mutex;
+		std::array<ComponentTypeInfo, MaxComponentTypes> types;
+		std::atomic<white::uint32> count = 0;
+	};
+
+	ComponentRegistry& GetRegistry() {
+		static ComponentRegistry registry;
+		return registry;
+	}
+
+	white::uint32 AlignUp(white::uint32 value, white::uint32 align) {
+		return (value + align - 1) / align * align;
+	}
+
+	void Relocate(const ComponentTypeInfo& type, void* dst, void* src, white::uint32 count) wnoexcept {
+		if (type.Relocate)
+			type.Relocate(dst, src, count);
+		else
+			std::memcpy(dst, src, std::size_t(type.Size) * count);
+	}
+}
+
+const ComponentTypeInfo& ecs::details::RegisterComponentType(white::uint32 size, white::uint32 align,
+	void (*relocate)(void*, void*, white::uint32) wnoexcept, void (*destroy)(void*, white::uint32) wnoexcept)
+{
+	auto& registry = GetRegistry();
+	std::lock_guard lock(registry.mutex);
+
+	auto id = registry.count.load(std::memory_order_relaxed);
+	if (id == MaxComponentTypes)
+		throw ECSException("Too many component types");
+
+	registry.types[id] = { id, size, align, relocate, destroy };
+	registry.count.store(id + 1, std::memory_order_release);
+	return registry.types[id];
+}
+
+const ComponentTypeInfo& ecs::GetComponentType(white::uint32 type_id)
+{
+	auto& registry = GetRegistry();
+	WAssert(type_id < registry.count.load(std::memory_order_acquire), "Component type isn't registered");
+	return registry.types[type_id];
+}
+
+Archetype::Archetype(const Signature& signature_)
+	:signature(signature_)
+{
+	columns.fill(NoColumn);
+	for (white::uint32 type_id = 0; type_id != MaxComponentTypes; ++type_id) {
+		if (signature[type_id]) {
+			columns[type_id] = static_cast<white::uint8>(types.size());
+			types.push_back(&GetComponentType(type_id));
+		}
+	}
+
+	auto layout = [&](white::uint32 rows) {
+		white::uint32 offset = rows * sizeof(EntityId);
+		offsets.clear();
+		for (auto type : types) {
+			offset = AlignUp(offset, std::max(type->Align, ColumnAlign));
+			offsets.push_back(offset);
+			offset += rows * type->Size;
+		}
+		return offset;
+	};
+
+	white::uint32 row_bytes = sizeof(EntityId);
+	for (auto type : types)
+		row_bytes += type->Size;
+
+	// Padding between columns may push the first guess over, then one row less is tried
+	capacity = ChunkBytes / row_bytes;
+	while (capacity > 1 && layout(capacity) > ChunkBytes)
+		--capacity;
+	if (capacity <= 1) {
+		// A single entity larger than a chunk gets a chunk of its own size
+		capacity = 1;
+		chunk_bytes = std::max(ChunkBytes, AlignUp(layout(1), ChunkAlign));
+	}
+	else
+		layout(capacity);
+}
+
+Archetype::~Archetype()
+{
+	for (auto& chunk : chunks) {
+		for (std::size_t column = 0; column != types.size(); ++column) {
+			if (types[column]->Destroy)
+				types[column]->Destroy(GetColumnData(chunk, static_cast<white::uint8>(column)), chunk.Count);
+		}
+		::operator delete(chunk.Data, std::align_val_t(ChunkAlign));
+	}
+}
+
+EntityLocation Archetype::Allocate(EntityId id)
+{
+	if (chunks.empty() || chunks.back().Count == capacity)
+		chunks.push_back({ static_cast<std::byte*>(::operator new(chunk_bytes, std::align_val_t(ChunkAlign))), 0 });
+
+	auto& chunk = chunks.back();
+	EntityLocation location{ static_cast<white::uint32>(chunks.size() - 1), chunk.Count++ };
+	reinterpret_cast<EntityId*>(chunk.Data)[location.Row] = id;
+	++count;
+	return location;
+}
+
+void Archetype::MoveRow(const EntityLocation& location, Archetype& target, const EntityLocation& target_location) wnothrow
+{
+	auto& chunk = chunks[location.ChunkIndex];
+	auto& target_chunk = target.chunks[target_location.ChunkIndex];
+	for (std::size_t column = 0; column != types.size(); ++column) {
+		auto& type = *types[column];
+		auto src = static_cast<std::byte*>(GetColumnData(chunk, static_cast<white::uint8>(column))) + std::size_t(type.Size) * location.Row;
+
+		auto target_column = target.GetColumn(type.Id);
+		if (target_column != NoColumn)
+			Relocate(type, static_cast<std::byte*>(target.GetColumnData(target_chunk, target_column)) + std::size_t(type.Size) * target_location.Row, src, 1);
+		else if (type.Destroy)
+			type.Destroy(src, 1);
+	}
+}
+
+void Archetype::DestroyRow(const EntityLocation& location) wnothrow
+{
+	auto& chunk = chunks[location.ChunkIndex];
+	for (std::size_t column = 0; column != types.size(); ++column) {
+		auto& type = *types[column];
+		if (type.Destroy)
+			type.Destroy(static_cast<std::byte*>(GetColumnData(chunk, static_cast<white::uint8>(column))) + std::size_t(type.Size) * location.Row, 1);
+	}
+}
+
+EntityId Archetype::FillHole(const EntityLocation& location) wnothrow
+{
+	auto& last = chunks.back();
+	auto last_row = last.Count - 1;
+
+	auto moved = InvalidEntityId;
+	if (location.ChunkIndex != chunks.size() - 1 || location.Row != last_row) {
+		auto& chunk = chunks[location.ChunkIndex];
+		for (std::size_t column = 0; column != types.size(); ++column) {
+			auto& type = *types[column];
+			auto data = static_cast<std::byte*>(GetColumnData(chunk, static_cast<white::uint8>(column)));
+			auto last_data = static_cast<std::byte*>(GetColumnData(last, static_cast<white::uint8>(column)));
+			Relocate(type, data + std::size_t(type.Size) * location.Row, last_data + std::size_t(type.Size) * last_row, 1);
+		}
+		moved = GetEntities(last)[last_row];
+		reinterpret_cast<EntityId*>(chunk.Data)[location.Row] = moved;
+	}
+
+	--count;
+	if (--last.Count == 0) {
+		::operator delete(last.Data, std::align_val_t(ChunkAlign));
+		chunks.pop_back();
+	}
+	return moved;
+}
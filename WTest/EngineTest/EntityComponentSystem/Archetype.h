@@ -0,0 +1,165 @@
+#ifndef FrameWork_ECS_Archetype_h
+#define FrameWork_ECS_Archetype_h 1
+
+#include <WBase/wmacro.h>
+#include "ECSCommon.h"
+#include "ECSException.h"
+#include <bitset>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+#include <new>
+
+namespace ecs {
+
+	wconstexpr white::uint32 MaxComponentTypes = 128;
+
+	using Signature = std::bitset<MaxComponentTypes>;
+
+	/*
+	\brief How chunk storage handles one component type.
+	Relocate move constructs count components at dst from src and destroys the sources,
+	both are null for trivially copyable types, which are moved with memcpy.
+	*/
+	struct ComponentTypeInfo {
+		white::uint32 Id;
+		white::uint32 Size;
+		white::uint32 Align;
+		void (*Relocate)(void* dst, void* src, white::uint32 count) wnoexcept;
+		void (*Destroy)(void* p, white::uint32 count) wnoexcept;
+	};
+
+	namespace details {
+		const ComponentTypeInfo& RegisterComponentType(white::uint32 size, white::uint32 align,
+			void (*relocate)(void*, void*, white::uint32) wnoexcept, void (*destroy)(void*, white::uint32) wnoexcept);
+
+		template<typename _type>
+		void RelocateComponents(void* dst, void* src, white::uint32 count) wnoexcept {
+			auto d = static_cast<_type*>(dst);
+			auto s = static_cast<_type*>(src);
+			for (white::uint32 i = 0; i != count; ++i) {
+				::new(d + i) _type(std::move(s[i]));
+				s[i].~_type();
+			}
+		}
+
+		template<typename _type>
+		void DestroyComponents(void* p, white::uint32 count) wnoexcept {
+			auto d = static_cast<_type*>(p);
+			for (white::uint32 i = 0; i != count; ++i)
+				d[i].~_type();
+		}
+	}
+
+	//! \brief Registered on first use, ids are dense in registration order.
+	template<typename _type>
+	const ComponentTypeInfo& GetComponentType() {
+		static_assert(std::is_same_v<_type, std::remove_cvref_t<_type>>);
+		static_assert(std::is_nothrow_move_constructible_v<_type>, "Components are relocated between chunks without a way back");
+
+		static const auto& info = details::RegisterComponentType(sizeof(_type), alignof(_type),
+			std::is_trivially_copyable_v<_type> ? nullptr : &details::RelocateComponents<_type>,
+			std::is_trivially_copyable_v<_type> ? nullptr : &details::DestroyComponents<_type>);
+		return info;
+	}
+
+	const ComponentTypeInfo& GetComponentType(white::uint32 type_id);
+
+	/*
+	\brief Fixed size block holding the same components for up to Archetype::GetChunkCapacity() entities.
+	Columns are laid out one after another: entity ids first, then each component type in id order.
+	*/
+	struct Chunk {
+		std::byte* Data;
+		white::uint32 Count;
+	};
+
+	struct EntityLocation {
+		white::uint32 ChunkIndex;
+		white::uint32 Row;
+	};
+
+	/*
+	\brief All entities with exactly the same set of component types.
+	Rows are kept dense: removing one moves the last entity of the last chunk into the hole.
+	*/
+	class Archetype {
+	public:
+		static wconstexpr white::uint32 ChunkBytes = 16 * 1024;
+		static wconstexpr white::uint8 NoColumn = 0xFF;
+
+		explicit Archetype(const Signature& signature_);
+		~Archetype();
+
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+
+		DefGetter(const wnothrow, const Signature&, Signature, signature)
+		DefGetter(const wnothrow, white::uint32, ChunkCapacity, capacity)
+		DefGetter(const wnothrow, white::uint32, EntityCount, count)
+		DefGetter(const wnothrow, const std::vector<Chunk>&, Chunks, chunks)
+
+		white::uint8 GetColumn(white::uint32 type_id) const wnothrow {
+			return columns[type_id];
+		}
+
+		const EntityId* GetEntities(const Chunk& chunk) const wnothrow {
+			return reinterpret_cast<const EntityId*>(chunk.Data);
+		}
+
+		void* GetColumnData(const Chunk& chunk, white::uint8 column) const wnothrow {
+			return chunk.Data + offsets[column];
+		}
+
+		//! \brief Null when the archetype has no _type column.
+		template<typename _type>
+		_type* GetColumnData(const Chunk& chunk) const {
+			auto column = GetColumn(GetComponentType<_type>().Id);
+			return column == NoColumn ? nullptr : static_cast<_type*>(GetColumnData(chunk, column));
+		}
+
+		template<typename _type>
+		_type* GetComponent(const EntityLocation& location) const {
+			auto column = GetColumnData<_type>(chunks[location.ChunkIndex]);
+			return column ? column + location.Row : nullptr;
+		}
+
+		//! \brief Appends a row for id, its components are left unconstructed.
+		EntityLocation Allocate(EntityId id);
+
+		/*!
+		\brief Relocates the components of the row shared with target into target_location, destroys the others.
+		\note The row becomes a hole to be filled with FillHole.
+		*/
+		void MoveRow(const EntityLocation& location, Archetype& target, const EntityLocation& target_location) wnothrow;
+
+		//! \brief Destroys the components of the row, which becomes a hole.
+		void DestroyRow(const EntityLocation& location) wnothrow;
+
+		//! \brief Moves the last row into the hole, returns the id of the moved entity or InvalidEntityId if the hole was the last row.
+		EntityId FillHole(const EntityLocation& location) wnothrow;
+
+		//! \brief Edges to the archetypes with one component type more or less, filled by the owner.
+		//@{
+		std::unordered_map<white::uint32, Archetype*> AddEdges;
+		std::unordered_map<white::uint32, Archetype*> RemoveEdges;
+		//@}
+
+	private:
+		Signature signature;
+
+		std::vector<const ComponentTypeInfo*> types;
+		// Component type id to index in types
+		std::array<white::uint8, MaxComponentTypes> columns;
+		// Column byte offsets in a chunk, the entity ids are at 0
+		std::vector<white::uint32> offsets;
+
+		white::uint32 chunk_bytes = ChunkBytes;
+		white::uint32 capacity = 0;
+		white::uint32 count = 0;
+		std::vector<Chunk> chunks;
+	};
+}
+
+#endif
@@ -11,6 +11,8 @@ namespace ecs {
 
 	using EntityId = white::uint32;
 
+	wconstexpr EntityId InvalidEntityId = {};
+
 	using namespace platform::Descriptions;
 }
 
@@ -10,8 +10,6 @@
 
 namespace ecs {
 
-	wconstexpr EntityId InvalidEntityId = {};
-
 	class Entity {
 	public:
 		template<typename... _tParams>
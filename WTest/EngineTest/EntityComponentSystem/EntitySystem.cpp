@@ -218,6 +218,11 @@ void ecs::EntitySystem::OnGotMessage(const white::Message & message)
 	}
 }
 
+World& ecs::EntitySystem::GetWorld() wnothrow
+{
+	return world;
+}
+
 EntitySystem & ecs::EntitySystem::Instance()
 {
 	static EntitySystem Instance;
@@ -6,6 +6,7 @@
 #include <WBase/memory.hpp>
 #include "System.h"
 #include "Entity.h"
+#include "World.h"
 #include "ECSException.h"
 
 namespace ecs {
@@ -40,12 +41,17 @@ namespace ecs {
 
 		void OnGotMessage(const white::Message& message) override;
 
+		//! \brief Archetype storage for entities updated in bulk, systems query it from Update.
+		World& GetWorld() wnothrow;
+
 		static EntitySystem& Instance();
 	private:
 		EntityId GenerateEntityId() const wnothrow;
 
 		white::observer_ptr<System> Add(const white::type_info& type_info, std::unique_ptr<System> pSystem);
 		white::observer_ptr<Entity> Add(const white::type_info& type_info,EntityId id,std::unique_ptr<Entity> pEntity);
+
+		World world;
 	};
 }
 
@@ -0,0 +1,128 @@
+#include "World.h"
+
+using namespace ecs;
+
+World::World()
+{
+	records.emplace_back();
+}
+
+ImplDeDtor(World)
+
+void World::Destroy(EntityId id) wnothrow
+{
+	WAssert(IsAlive(id), "Destroy an entity not alive");
+	if (!IsAlive(id))
+		return;
+
+	auto index = IdToIndex(id);
+	auto& record = records[index];
+	auto& archetype = *record.archetype;
+	auto location = record.Location();
+
+	archetype.DestroyRow(location);
+	if (auto moved = archetype.FillHole(location); moved != InvalidEntityId)
+		records[IdToIndex(moved)].Place(archetype, location);
+
+	record.archetype = nullptr;
+	++record.generation;
+	record.next_free = free_index;
+	free_index = index;
+	--entity_count;
+}
+
+bool World::IsAlive(EntityId id) const wnothrow
+{
+	auto index = IdToIndex(id);
+	return index != 0 && index < records.size() && records[index].archetype
+		&& records[index].generation == static_cast<white::uint8>(id >> IndexBits);
+}
+
+EntityId World::AllocateId()
+{
+	auto index = free_index;
+	if (index != 0)
+		free_index = records[index].next_free;
+	else {
+		if (records.size() > MaxEntities)
+			throw ECSException("Entity index range is full");
+		index = static_cast<white::uint32>(records.size());
+		records.emplace_back();
+	}
+
+	++entity_count;
+	return (EntityId(records[index].generation) << IndexBits) | index;
+}
+
+World::EntityRecord& World::GetRecord(EntityId id)
+{
+	if (!IsAlive(id))
+		throw ECSException("Entity isn't alive");
+	return records[IdToIndex(id)];
+}
+
+const World::EntityRecord& World::GetRecord(EntityId id) const
+{
+	if (!IsAlive(id))
+		throw ECSException("Entity isn't alive");
+	return records[IdToIndex(id)];
+}
+
+Archetype& World::GetArchetype(const Signature& signature)
+{
+	if (auto itr = archetype_map.find(signature); itr != archetype_map.end())
+		return *itr->second;
+
+	auto& archetype = *archetypes.emplace_back(std::make_unique<Archetype>(signature));
+	archetype_map.emplace(signature, &archetype);
+	return archetype;
+}
+
+Archetype& World::GetAddEdge(Archetype& archetype, white::uint32 type_id)
+{
+	auto& edge = archetype.AddEdges[type_id];
+	if (!edge) {
+		auto& target = GetArchetype(Signature(archetype.GetSignature()).set(type_id));
+		target.RemoveEdges[type_id] = &archetype;
+		edge = &target;
+	}
+	return *edge;
+}
+
+Archetype& World::GetRemoveEdge(Archetype& archetype, white::uint32 type_id)
+{
+	auto& edge = archetype.RemoveEdges[type_id];
+	if (!edge) {
+		auto& target = GetArchetype(Signature(archetype.GetSignature()).reset(type_id));
+		target.AddEdges[type_id] = &archetype;
+		edge = &target;
+	}
+	return *edge;
+}
+
+EntityLocation World::MoveEntity(EntityId id, Archetype& target)
+{
+	auto& record = records[IdToIndex(id)];
+	auto& source = *record.archetype;
+	auto location = record.Location();
+
+	// Only the allocation may throw, nothing has moved yet
+	auto target_location = target.Allocate(id);
+	source.MoveRow(location, target, target_location);
+	if (auto moved = source.FillHole(location); moved != InvalidEntityId)
+		records[IdToIndex(moved)].Place(source, location);
+
+	record.Place(target, target_location);
+	return target_location;
+}
+
+const std::vector<Archetype*>& World::Match(const Signature& signature)
+{
+	auto& cache = queries[signature];
+	for (; cache.tested != archetypes.size(); ++cache.tested) {
+		auto& archetype = *archetypes[cache.tested];
+		if ((archetype.GetSignature() & signature) == signature)
+			cache.matches.push_back(&archetype);
+	}
+	return cache.matches;
+}
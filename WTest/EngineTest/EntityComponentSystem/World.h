@@ -0,0 +1,217 @@
+#ifndef FrameWork_ECS_World_h
+#define FrameWork_ECS_World_h 1
+
+#include "Archetype.h"
+#include "Runtime/ParallelFor.h"
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace ecs {
+
+	/*
+	\brief Entities stored by archetype in chunks of component columns.
+	An EntityId packs a generation in the high 8 bits over the index in the low 24 bits.
+	\note Structural changes (Create, Destroy, Add, Remove) and queries are called from one thread,
+	only the bodies of the parallel queries run on the workers and must not change the structure.
+	*/
+	class World {
+	public:
+		static wconstexpr white::uint32 IndexBits = 24;
+		static wconstexpr white::uint32 MaxEntities = (1u << IndexBits) - 1;
+
+		World();
+		~World();
+
+		World(const World&) = delete;
+		World& operator=(const World&) = delete;
+
+		template<typename... _types>
+		EntityId Create(_types&&... components) {
+			// Constructed before the row exists so a throwing constructor leaves nothing behind
+			std::tuple<std::decay_t<_types>...> values(wforward(components)...);
+
+			auto& archetype = GetArchetype(MakeSignature<std::decay_t<_types>...>());
+			auto id = AllocateId();
+			auto location = archetype.Allocate(id);
+			std::apply([&](auto&... value) {
+				(Construct(archetype.template GetComponent<std::decay_t<decltype(value)>>(location), std::move(value)), ...);
+				}, values);
+			records[IdToIndex(id)].Place(archetype, location);
+			return id;
+		}
+
+		void Destroy(EntityId id) wnothrow;
+
+		bool IsAlive(EntityId id) const wnothrow;
+
+		//! \brief Moves the entity to the archetype with _type added, throws ECSException if it has one already.
+		template<typename _type, typename... _tParams>
+		_type& Add(EntityId id, _tParams&&... args) {
+			auto& type = GetComponentType<_type>();
+			_type value(wforward(args)...);
+
+			auto& record = GetRecord(id);
+			if (record.archetype->GetColumn(type.Id) != Archetype::NoColumn)
+				throw ECSException("Entity has this component already");
+
+			auto& target = GetAddEdge(*record.archetype, type.Id);
+			auto location = MoveEntity(id, target);
+			return *Construct(target.template GetComponent<_type>(location), std::move(value));
+		}
+
+		//! \brief Moves the entity to the archetype with _type removed, does nothing if it has none.
+		template<typename _type>
+		void Remove(EntityId id) {
+			auto& type = GetComponentType<_type>();
+
+			auto& record = GetRecord(id);
+			if (record.archetype->GetColumn(type.Id) == Archetype::NoColumn)
+				return;
+			MoveEntity(id, GetRemoveEdge(*record.archetype, type.Id));
+		}
+
+		//! \brief Null if the entity has no _type, valid until the next structural change.
+		template<typename _type>
+		_type* Get(EntityId id) {
+			auto& record = GetRecord(id);
+			return record.archetype->template GetComponent<_type>(record.Location());
+		}
+
+		template<typename _type>
+		bool Has(EntityId id) const {
+			auto& record = GetRecord(id);
+			return record.archetype->GetColumn(GetComponentType<_type>().Id) != Archetype::NoColumn;
+		}
+
+		DefGetter(const wnothrow, white::uint32, EntityCount, entity_count)
+
+		/*!
+		\brief Calls f(count, entities, columns...) for every chunk with all of _types, one column pointer per type.
+		\note A const type gives a const column.
+		*/
+		template<typename... _types, typename _func>
+		void ForEachChunk(_func f) {
+			for (auto pArchetype : Match<_types...>()) {
+				for (auto& chunk : pArchetype->GetChunks())
+					InvokeChunk<_types...>(f, *pArchetype, chunk);
+			}
+		}
+
+		//! \brief Calls f(components&...) for every entity with all of _types.
+		template<typename... _types, typename _func>
+		void ForEach(_func f) {
+			ForEachChunk<_types...>([&](white::uint32 count, const EntityId*, _types*... columns) {
+				for (white::uint32 row = 0; row != count; ++row)
+					f(columns[row]...);
+				});
+		}
+
+		//! \brief ForEachChunk with the matching chunks spread over the workers.
+		template<typename... _types, typename _func>
+		void ParallelForEachChunk(_func f) {
+			auto& jobs = parallel_chunks;
+			jobs.clear();
+			for (auto pArchetype : Match<_types...>()) {
+				auto& chunks = pArchetype->GetChunks();
+				for (auto& chunk : chunks)
+					jobs.emplace_back(pArchetype, &chunk);
+			}
+
+			WhiteEngine::ParallelFor(static_cast<white::int32>(jobs.size()), [&](white::int32 index) {
+				InvokeChunk<_types...>(f, *jobs[index].first, *jobs[index].second);
+				});
+		}
+
+		//! \brief ForEach with the matching chunks spread over the workers.
+		template<typename... _types, typename _func>
+		void ParallelForEach(_func f) {
+			ParallelForEachChunk<_types...>([&](white::uint32 count, const EntityId*, _types*... columns) {
+				for (white::uint32 row = 0; row != count; ++row)
+					f(columns[row]...);
+				});
+		}
+
+	private:
+		struct EntityRecord {
+			Archetype* archetype = nullptr;
+			white::uint32 chunk_index = 0;
+			white::uint32 row = 0;
+			// Next free index while the record is unused
+			white::uint32 next_free = 0;
+			white::uint8 generation = 0;
+
+			EntityLocation Location() const wnothrow {
+				return { chunk_index, row };
+			}
+
+			void Place(Archetype& archetype_, const EntityLocation& location) wnothrow {
+				archetype = &archetype_;
+				chunk_index = location.ChunkIndex;
+				row = location.Row;
+			}
+		};
+
+		struct QueryCache {
+			std::vector<Archetype*> matches;
+			// Archetypes already tested, new ones are appended to World::archetypes
+			std::size_t tested = 0;
+		};
+
+		template<typename... _types>
+		static Signature MakeSignature() {
+			Signature signature;
+			(signature.set(GetComponentType<std::remove_const_t<_types>>().Id), ...);
+			if (signature.count() != sizeof...(_types))
+				throw ECSException("Component types are repeated");
+			return signature;
+		}
+
+		template<typename... _types>
+		const std::vector<Archetype*>& Match() {
+			static const auto signature = MakeSignature<_types...>();
+			return Match(signature);
+		}
+
+		const std::vector<Archetype*>& Match(const Signature& signature);
+
+		template<typename _type>
+		static _type* Construct(_type* p, _type&& value) wnoexcept {
+			return ::new(static_cast<void*>(p)) _type(std::move(value));
+		}
+
+		template<typename... _types, typename _func>
+		static void InvokeChunk(_func& f, const Archetype& archetype, const Chunk& chunk) {
+			f(chunk.Count, archetype.GetEntities(chunk), archetype.template GetColumnData<std::remove_const_t<_types>>(chunk)...);
+		}
+
+		static white::uint32 IdToIndex(EntityId id) wnothrow {
+			return id & MaxEntities;
+		}
+
+		EntityId AllocateId();
+
+		EntityRecord& GetRecord(EntityId id);
+		const EntityRecord& GetRecord(EntityId id) const;
+
+		Archetype& GetArchetype(const Signature& signature);
+		Archetype& GetAddEdge(Archetype& archetype, white::uint32 type_id);
+		Archetype& GetRemoveEdge(Archetype& archetype, white::uint32 type_id);
+
+		//! \brief The components not in target are destroyed, the ones only in target are left unconstructed.
+		EntityLocation MoveEntity(EntityId id, Archetype& target);
+
+		// Index 0 stays unused so no id equals InvalidEntityId
+		std::vector<EntityRecord> records;
+		white::uint32 free_index = 0;
+		white::uint32 entity_count = 0;
+
+		std::vector<std::unique_ptr<Archetype>> archetypes;
+		std::unordered_map<Signature, Archetype*> archetype_map;
+		std::unordered_map<Signature, QueryCache> queries;
+
+		std::vector<std::pair<const Archetype*, const Chunk*>> parallel_chunks;
+	};
+}
+
+#endif
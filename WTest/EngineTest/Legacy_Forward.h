@@ -83,6 +83,8 @@ public:
 
 	std::vector<std::unique_ptr<we::ProjectedShadowInfo>> ShadowInfos;
 
+	std::vector<white::uint32> VisibleEntities;
+
 	WhiteEngine::Sphere FreezeSphere[10];
 	int FreezeCount = 0;
 private:
@@ -112,7 +114,9 @@ private:
 	white::uint32 DoUpdate(white::uint32 pass) override {
 		auto& timer = platform::chrono::FetchGlobalTimer();
 		timer.UpdateOnFrameStart();
-		platform::Material::GetInstanceEvaluator().Define("time", timer.GetFrameTime(), true);
+		platform::Material::AccessInstanceEvaluator([&](platform::MaterialEvaluator& evaluator) {
+			evaluator.Define("time", timer.GetFrameTime(), true);
+		});
 
 		auto& CmdList = platform::Render::CommandListExecutor::GetImmediateCommandList();
 
@@ -151,6 +155,10 @@ private:
 
 		auto viewproj = viewmatrix * projmatrix;
 
+		//ComputeViewVisibility
+		VisibleEntities.clear();
+		pEntities->GetBVH().Cull(we::ConvexVolume::FromViewProjection(viewproj), VisibleEntities);
+
 		//SetupViewFrustum
 		scene.NearClippingDistance = -projmatrix[3][2];
 
@@ -209,8 +217,9 @@ private:
 			CmdList.BeginRenderPass(prezPass, "PreZ");
 
 			//pre-z
-			for (auto& entity : pEntities->GetRenderables())
+			for (auto EntityIndex : VisibleEntities)
 			{
+				auto& entity = pEntities->GetRenderables()[EntityIndex];
 				//copy normal map params
 				entity.GetMaterial().UpdateParams(reinterpret_cast<const platform::Renderable*>(&entity), pPreZEffect.get());
 
@@ -234,8 +243,9 @@ private:
 				depth_tex, platform::Render::DepthStencilTargetActions::LoadDepthStencil_StoreDepthStencil);
 			CmdList.BeginRenderPass(GeometryPass, "Geometry");
 
-			for (auto& entity : pEntities->GetRenderables())
+			for (auto EntityIndex : VisibleEntities)
 			{
+				auto& entity = pEntities->GetRenderables()[EntityIndex];
 				entity.GetMaterial().UpdateParams(reinterpret_cast<const platform::Renderable*>(&entity));
 				render::Context::Instance().Render(CmdList, *pEffect, pEffect->GetTechniqueByIndex(0), entity.GetMesh().GetInputLayout());
 			}
@@ -355,36 +365,13 @@ private:
 			ShadowMap = white::share_raw(Device.CreateTexture(LayoutWidth, LayoutHeight, 1, 1, render::EFormat::EF_D32F, EAccessHint::SRV | EAccessHint::DSV, {}));
 
 		//Frustum Cull
-		std::vector<std::vector<const Entity*>> Subjects{ ShadowInfos.size() };
+		//casters touching the cylinder swept by the shadow bounds along the light, every cascade in parallel
+		std::vector<we::ConvexVolume> ShadowVolumes;
+		for (auto& ShadowInfo : ShadowInfos)
+			ShadowVolumes.emplace_back(we::ConvexVolume::FromDirectionalSweep(ShadowInfo->ShadowBounds, sun_light.GetDirection()));
 
-		{
-			std::vector<white::coroutine::Task<>> taskes;
-
-			WhiteEngine::ParallelFor(static_cast<int32>(ShadowInfos.size()),
-				[this, &Subjects](int ShadowIndex) {
-					for (int32 PrimitiveIndex = 0; PrimitiveIndex < pEntities->GetRenderables().size(); ++PrimitiveIndex)
-					{
-						auto& Primitive = pEntities->GetRenderables()[PrimitiveIndex];
-
-						we::Sphere ShadowBounds = ShadowInfos[ShadowIndex]->ShadowBounds;
-
-						we::BoxSphereBounds PrimitiveBounds;
-						PrimitiveBounds.Origin = (Primitive.GetMesh().GetBoundingMin() + Primitive.GetMesh().GetBoundingMax()) / 2;
-						PrimitiveBounds.Extent = (Primitive.GetMesh().GetBoundingMax() - Primitive.GetMesh().GetBoundingMin()) / 2;
-						PrimitiveBounds.Radius = wm::length(PrimitiveBounds.Extent);
-
-						const auto LightDirection = sun_light.GetDirection();
-						const auto PrimitiveToShadowCenter = ShadowBounds.Center - PrimitiveBounds.Origin;
-						const auto ProjectedDistanceFromShadowOriginAlongLightDir = wm::dot(PrimitiveToShadowCenter, LightDirection);
-						const auto PrimitiveDistanceFromCylinderAxisSq = wm::length_sq(LightDirection * (-ProjectedDistanceFromShadowOriginAlongLightDir) + PrimitiveToShadowCenter);
-						const auto CombinedRadiusSq = Square(ShadowBounds.W + PrimitiveBounds.Radius);
-						if (PrimitiveDistanceFromCylinderAxisSq < CombinedRadiusSq)
-						{
-							Subjects[ShadowIndex].emplace_back(&Primitive);
-						}
-					}
-				});
-		}
+		std::vector<std::vector<white::uint32>> Subjects{ ShadowInfos.size() };
+		pEntities->GetBVH().CullParallel(ShadowVolumes, white::make_span(Subjects));
 
 		//RenderShadowDepthMapAtlases
 		auto BeginShadowRenderPass = [this](platform::Render::CommandList& CmdList, bool Clear)
@@ -407,9 +394,9 @@ private:
 			BeginShadowRenderPass(CmdList, false);
 			auto psoInit = ShadowInfos[ShadowIndex]->SetupShadowDepthPass(CmdList, ShadowMap.get());
 
-			for (auto pEntity : Subjects[ShadowIndex])
+			for (auto EntityIndex : Subjects[ShadowIndex])
 			{
-				auto& layout = pEntity->GetMesh().GetInputLayout();
+				auto& layout = pEntities->GetRenderables()[EntityIndex].GetMesh().GetInputLayout();
 
 				DrawInputLayout(CmdList, psoInit, layout);
 			}
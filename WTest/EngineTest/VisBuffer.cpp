@@ -112,6 +112,9 @@ class VisTriangleVS :public BuiltInShader
 
 	BEGIN_SHADER_PARAMETER_STRUCT(Parameters)
 		SHADER_PARAMETER_CBUFFER(ViewArgs, View)
+		// Not read by the shader, they declare the index and indirect argument buffers of the draw to the render graph
+		SHADER_PARAMETER_SRV(ByteAddressBuffer, FliteredIndexBuffer)
+		SHADER_PARAMETER_SRV(StructuredBuffer<uint32>, IndirectDrawArgs)
 		END_SHADER_PARAMETER_STRUCT()
 };
 IMPLEMENT_BUILTIN_SHADER(VisTriangleVS, "VisTriangle.hlsl", "VisTriangleVS", platform::Render::VertexShader);
@@ -284,6 +287,8 @@ void VisBufferTest::RenderTrinf(RenderGraph::RGBuilder& Builder)
 	auto depth_tex = static_cast<render::Texture2D*>(screen_frame->Attached(render::FrameBuffer::DepthStencil));
 
 	auto VSParas = Builder.AllocParameters<VisTriangleVS::Parameters>();
+	VSParas->FliteredIndexBuffer = Builder.CreateSRV({ .Buffer = FliteredIndexBuffer });
+	VSParas->IndirectDrawArgs = Builder.CreateSRV({ .Buffer = CompactedDrawArgs });
 
 	Builder.AddPass(
 		RGEventName("VisBuffer"),
@@ -67,6 +67,8 @@ private:
 	white::uint32 DoUpdate(white::uint32 pass) override {
 		auto& CmdList = render::CommandListExecutor::GetImmediateCommandList();
 
+		RenderGraph::BeginFrame();
+
 		RenderGraph::RGBuilder Builder{ CmdList,RenderGraph::RGEventName{"Frame"} };
 
 		SCOPED_GPU_EVENT(CmdList, Frame);
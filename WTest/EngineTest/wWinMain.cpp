@@ -6,6 +6,7 @@
 #include "Runtime/Path.h"
 #include "WFramework/Win32/WCLib/Mingw32.h"
 #include "Core/Threading/Thread.h"
+#include "RenderInterface/PipelineStateUtility.h"
 
 #include "spdlog/spdlog.h"
 #include "spdlog/sinks/basic_file_sink.h"
@@ -118,8 +119,14 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR cmdLine, int nCmdShow)
 	//ForwardTest Test(L"Forward");
 	VisBufferTest Test(L"VisBuffer");
 	Test.Create();
+
+	platform::Render::PipelineStateCache::PrecacheGraphicsPipelineStateList("PipelineStateList.bin");
+
 	Test.Run();
 
+	platform::Render::PipelineStateCache::WaitForPendingCreation();
+	platform::Render::PipelineStateCache::SaveGraphicsPipelineStateList("PipelineStateList.bin");
+
 	RenderGraph::GetAllocator();
 
 	return 0;
@@ -12,6 +12,10 @@
 #include <iostream>
 #include <fstream>
 #include <typeindex>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <malloc.h>
 //#include YFM_WSL_Configuration
 //#include YFM_Helper_Initialization
 #include <WFramework/WCLib/Debug.h>
@@ -82,6 +86,26 @@ namespace
 		}
 	}
 
+	std::atomic<size_t> any_alloc_count{}, any_alloc_bytes{};
+
+	//! \brief 统计不能直接保存在 white::any 和 Reducer 内的对象引起的堆分配。
+	void
+		CountAnyAllocation(const white::type_info&, size_t n) wnothrow
+	{
+		any_alloc_count.fetch_add(1, std::memory_order_relaxed);
+		any_alloc_bytes.fetch_add(n, std::memory_order_relaxed);
+	}
+
+	std::atomic<size_t> heap_alloc_count{}, heap_alloc_bytes{};
+
+	//! \brief 统计全局 operator new 引起的所有堆分配。
+	void
+		CountHeapAllocation(size_t n) wnothrow
+	{
+		heap_alloc_count.fetch_add(1, std::memory_order_relaxed);
+		heap_alloc_bytes.fetch_add(n, std::memory_order_relaxed);
+	}
+
 	observer_ptr<REPLContext> p_context;
 
 	bool use_debug = {};
@@ -539,6 +563,42 @@ namespace
 		RegisterForm(root, "$crash", [] {
 			white::terminate();
 		});
+		any_ops::set_allocation_hook(CountAnyAllocation);
+		RegisterForm(root, "any-alloc", [] {
+			std::cout << any_alloc_count.load() << " any heap allocation(s), "
+				<< any_alloc_bytes.load() << " byte(s)." << std::endl;
+		});
+		RegisterForm(root, "any-alloc-reset", [] {
+			any_alloc_count = 0;
+			any_alloc_bytes = 0;
+		});
+		// NOTE: The check fails the script when the average exceeds the bound.
+		RegisterStrictBinary<const int>(root, "any-alloc-check", [](int n, int max) {
+			if (n <= 0)
+				throw std::invalid_argument("Non-positive iteration count found.");
+
+			const auto per(double(any_alloc_count.load()) / n);
+
+			std::cout << per << " any heap allocation(s) per iteration." << std::endl;
+			if (per > max)
+				throw LoggedEvent(white::sfmt("Any heap allocation(s) per iteration"
+					" exceed %d.", max));
+		});
+		RegisterForm(root, "heap-alloc", [] {
+			std::cout << heap_alloc_count.load() << " heap allocation(s), "
+				<< heap_alloc_bytes.load() << " byte(s)." << std::endl;
+		});
+		RegisterForm(root, "heap-alloc-reset", [] {
+			heap_alloc_count = 0;
+			heap_alloc_bytes = 0;
+		});
+		// NOTE: The total includes the allocations counted by any-alloc.
+		RegisterStrictUnary<const int>(root, "heap-alloc-per", [](int n) {
+			if (n <= 0)
+				throw std::invalid_argument("Non-positive iteration count found.");
+			std::cout << double(heap_alloc_count.load()) / n
+				<< " heap allocation(s) per iteration." << std::endl;
+		});
 		// NOTE: Derived functions with probable privmitive implementation.
 		// NOTE: Definitions of list, list&, $quote are in
 		//	%LFramework.LSL.Dependency.
@@ -909,6 +969,48 @@ namespace
 } // unnamed namespace;
 
 
+//! \note 替换的全局分配函数，数组和 nothrow 版本默认转发到以下版本。
+//@{
+void*
+operator new(size_t n)
+{
+	CountHeapAllocation(n);
+	if (const auto p = std::malloc(n == 0 ? 1 : n))
+		return p;
+	throw std::bad_alloc();
+}
+void*
+operator new(size_t n, std::align_val_t al)
+{
+	CountHeapAllocation(n);
+	if (const auto p = ::_aligned_malloc(n == 0 ? 1 : n, size_t(al)))
+		return p;
+	throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) wnothrow
+{
+	std::free(p);
+}
+void
+operator delete(void* p, size_t) wnothrow
+{
+	std::free(p);
+}
+void
+operator delete(void* p, std::align_val_t) wnothrow
+{
+	::_aligned_free(p);
+}
+void
+operator delete(void* p, size_t, std::align_val_t) wnothrow
+{
+	::_aligned_free(p);
+}
+//@}
+
+
 /// 304
 int
 main(int argc, char* argv[])